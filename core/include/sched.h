@@ -183,6 +183,19 @@ typedef struct {
                                   scheduled to run */
     unsigned int schedules;  /**< How often the thread was scheduled to run */
     uint64_t runtime_ticks;  /**< The total runtime of this thread in ticks */
+#ifdef MODULE_SCHEDPROF
+    uint32_t readytime;      /**< Time stamp the thread was put on the run
+                                  queue, 0 if it is not waiting to run */
+    uint32_t latency_max;    /**< Longest time from being put on the run
+                                  queue until running in ticks */
+    uint64_t latency_ticks;  /**< Sum of all scheduling latencies in ticks */
+    unsigned int wakeups;    /**< Number of scheduling latencies measured */
+    uint32_t irq_off_max;    /**< Longest time this thread kept IRQs
+                                  disabled in ticks */
+    uint64_t irq_off_ticks;  /**< Total time this thread kept IRQs disabled
+                                  in ticks */
+    unsigned int msg_queue_max; /**< Highest fill level of the message queue */
+#endif
 } schedstat;
 
 /**
@@ -196,6 +209,60 @@ extern schedstat sched_pidlist[KERNEL_PID_LAST + 1];
  *  @param[in] callback The callback functions the will be called
  */
 void sched_register_cb(void (*callback)(uint32_t, uint32_t));
+
+#ifdef MODULE_SCHEDPROF
+/**
+ *  Interrupt statistics
+ *
+ *  @note   These are only recorded on CPUs calling the schedprof_irq_*() and
+ *          schedprof_isr_*() hooks: IRQ disabled times on Cortex-M and native,
+ *          ISR times on native.
+ */
+typedef struct {
+    unsigned int isr_count;  /**< Number of ISRs run */
+    uint32_t isr_max;        /**< Longest ISR run time in ticks */
+    uint64_t isr_ticks;      /**< Total time spent in ISRs in ticks */
+    uint32_t irq_off_max;    /**< Longest time IRQs were disabled in ticks,
+                                  including by ISRs */
+    uint64_t irq_off_ticks;  /**< Total time IRQs were disabled in ticks,
+                                  including by ISRs */
+} schedprof_irq_t;
+
+/**
+ *  Interrupt statistics
+ */
+extern schedprof_irq_t schedprof_irq;
+
+/**
+ *  @brief  Reset the profiling statistics and start recording
+ *
+ *  Nothing is recorded before this was called for the first time, which
+ *  happens after auto_init() initialized the timer.
+ */
+void schedprof_reset(void);
+
+/**
+ *  @brief  To be called by the CPU implementation when IRQs get disabled
+ *          while they were enabled
+ */
+void schedprof_irq_disabled(void);
+
+/**
+ *  @brief  To be called by the CPU implementation when IRQs get enabled
+ *          while they were disabled
+ */
+void schedprof_irq_enabled(void);
+
+/**
+ *  @brief  To be called by the CPU implementation before running an ISR
+ */
+void schedprof_isr_enter(void);
+
+/**
+ *  @brief  To be called by the CPU implementation after running an ISR
+ */
+void schedprof_isr_exit(void);
+#endif /* MODULE_SCHEDPROF */
 #endif /* MODULE_SCHEDSTATISTICS */
 
 #ifdef __cplusplus
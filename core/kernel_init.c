@@ -54,6 +54,10 @@ static void *main_trampoline(void *arg)
     stat->laststart = 0;
 #endif
 
+#ifdef MODULE_SCHEDPROF
+    schedprof_reset();
+#endif
+
     LOG_INFO("main(): This is RIOT! (Version: " RIOT_VERSION ")\n");
 
     main();
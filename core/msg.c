@@ -50,6 +50,12 @@ static int queue_msg(thread_t *target, const msg_t *m)
     DEBUG("queue_msg(): queuing message\n");
     msg_t *dest = &target->msg_array[n];
     *dest = *m;
+#ifdef MODULE_SCHEDPROF
+    unsigned int depth = cib_avail(&target->msg_queue);
+    if (depth > sched_pidlist[target->pid].msg_queue_max) {
+        sched_pidlist[target->pid].msg_queue_max = depth;
+    }
+#endif
 #if MODULE_CORE_THREAD_FLAGS
     target->flags |= THREAD_FLAG_MSG_WAITING;
     thread_flags_wake(target);
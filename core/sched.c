@@ -37,6 +37,11 @@
 #include "xtimer.h"
 #endif
 
+#ifdef MODULE_SCHEDPROF
+#include <stdbool.h>
+#include <string.h>
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -79,6 +84,29 @@ static void (*sched_cb) (uint32_t timestamp, uint32_t value) = NULL;
 schedstat sched_pidlist[KERNEL_PID_LAST + 1];
 #endif
 
+#ifdef MODULE_SCHEDPROF
+schedprof_irq_t schedprof_irq;
+static volatile bool _prof_active = false;
+/* time stamps of the pending measurements, 0 if there is none */
+static uint32_t _irq_off_start;
+static uint32_t _isr_start;
+static kernel_pid_t _irq_off_pid;
+
+static void _record_latency(schedstat *stat, uint32_t now)
+{
+    if (stat->readytime) {
+        uint32_t latency = now - stat->readytime;
+
+        stat->readytime = 0;
+        stat->latency_ticks += latency;
+        stat->wakeups++;
+        if (latency > stat->latency_max) {
+            stat->latency_max = latency;
+        }
+    }
+}
+#endif
+
 int __attribute__((used)) sched_run(void)
 {
     sched_context_switch_request = 0;
@@ -96,6 +124,13 @@ int __attribute__((used)) sched_run(void)
           next_thread->pid);
 
     if (active_thread == next_thread) {
+#ifdef MODULE_SCHEDPROF
+        /* the thread was woken up before it could switch away */
+        if (sched_pidlist[next_thread->pid].readytime) {
+            _record_latency(&sched_pidlist[next_thread->pid],
+                            xtimer_now().ticks32);
+        }
+#endif
         DEBUG("sched_run: done, sched_active_thread was not changed.\n");
         return 0;
     }
@@ -127,6 +162,9 @@ int __attribute__((used)) sched_run(void)
     schedstat *next_stat = &sched_pidlist[next_thread->pid];
     next_stat->laststart = now;
     next_stat->schedules++;
+#ifdef MODULE_SCHEDPROF
+    _record_latency(next_stat, now);
+#endif
     if (sched_cb) {
         sched_cb(now, next_thread->pid);
     }
@@ -158,6 +196,80 @@ void sched_register_cb(void (*callback)(uint32_t, uint32_t))
 }
 #endif
 
+#ifdef MODULE_SCHEDPROF
+void schedprof_reset(void)
+{
+    unsigned state = irq_disable();
+
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        schedstat *stat = &sched_pidlist[i];
+
+        stat->readytime = 0;
+        stat->latency_max = 0;
+        stat->latency_ticks = 0;
+        stat->wakeups = 0;
+        stat->irq_off_max = 0;
+        stat->irq_off_ticks = 0;
+        stat->msg_queue_max = 0;
+    }
+    memset(&schedprof_irq, 0, sizeof(schedprof_irq));
+    _irq_off_start = 0;
+    _isr_start = 0;
+    _prof_active = true;
+    irq_restore(state);
+}
+
+void schedprof_irq_disabled(void)
+{
+    if (_prof_active) {
+        _irq_off_start = xtimer_now().ticks32;
+        _irq_off_pid = irq_is_in() ? KERNEL_PID_UNDEF : sched_active_pid;
+    }
+}
+
+void schedprof_irq_enabled(void)
+{
+    if (_prof_active && _irq_off_start) {
+        uint32_t duration = xtimer_now().ticks32 - _irq_off_start;
+
+        _irq_off_start = 0;
+        schedprof_irq.irq_off_ticks += duration;
+        if (duration > schedprof_irq.irq_off_max) {
+            schedprof_irq.irq_off_max = duration;
+        }
+        if (pid_is_valid(_irq_off_pid)) {
+            schedstat *stat = &sched_pidlist[_irq_off_pid];
+
+            stat->irq_off_ticks += duration;
+            if (duration > stat->irq_off_max) {
+                stat->irq_off_max = duration;
+            }
+        }
+    }
+}
+
+void schedprof_isr_enter(void)
+{
+    if (_prof_active) {
+        _isr_start = xtimer_now().ticks32;
+    }
+}
+
+void schedprof_isr_exit(void)
+{
+    if (_prof_active && _isr_start) {
+        uint32_t duration = xtimer_now().ticks32 - _isr_start;
+
+        _isr_start = 0;
+        schedprof_irq.isr_count++;
+        schedprof_irq.isr_ticks += duration;
+        if (duration > schedprof_irq.isr_max) {
+            schedprof_irq.isr_max = duration;
+        }
+    }
+}
+#endif
+
 void sched_set_status(thread_t *process, unsigned int status)
 {
     if (status >= STATUS_ON_RUNQUEUE) {
@@ -166,6 +278,11 @@ void sched_set_status(thread_t *process, unsigned int status)
                   process->pid, process->priority);
             clist_rpush(&sched_runqueues[process->priority], &(process->rq_entry));
             runqueue_bitcache |= 1 << process->priority;
+#ifdef MODULE_SCHEDPROF
+            if (_prof_active) {
+                sched_pidlist[process->pid].readytime = xtimer_now().ticks32;
+            }
+#endif
         }
     }
     else {
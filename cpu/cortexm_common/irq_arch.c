@@ -22,6 +22,10 @@
 #include "irq.h"
 #include "cpu.h"
 
+#ifdef MODULE_SCHEDPROF
+#include "sched.h"
+#endif
+
 /**
  * @brief Disable all maskable interrupts
  */
@@ -29,6 +33,11 @@ unsigned int irq_disable(void)
 {
     uint32_t mask = __get_PRIMASK();
     __disable_irq();
+#ifdef MODULE_SCHEDPROF
+    if (mask == 0) {
+        schedprof_irq_disabled();
+    }
+#endif
     return mask;
 }
 
@@ -37,6 +46,11 @@ unsigned int irq_disable(void)
  */
 __attribute__((used)) unsigned int irq_enable(void)
 {
+#ifdef MODULE_SCHEDPROF
+    if (__get_PRIMASK()) {
+        schedprof_irq_enabled();
+    }
+#endif
     __enable_irq();
     return __get_PRIMASK();
 }
@@ -46,6 +60,15 @@ __attribute__((used)) unsigned int irq_enable(void)
  */
 void irq_restore(unsigned int state)
 {
+#ifdef MODULE_SCHEDPROF
+    if ((state == 0) && __get_PRIMASK()) {
+        schedprof_irq_enabled();
+    }
+    else if ((state != 0) && (__get_PRIMASK() == 0)) {
+        __disable_irq();
+        schedprof_irq_disabled();
+    }
+#endif
     __set_PRIMASK(state);
 }
 
@@ -24,6 +24,7 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "net/netdev.h"
 
@@ -35,6 +36,19 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+/**
+ * @brief   Maximum number of frames received per interrupt
+ *
+ * When the network interface thread handles an interrupt, the driver
+ * delivers every frame that is pending on the TAP, up to this number. Each
+ * frame is passed up with its own @ref NETDEV_EVENT_RX_COMPLETE, but the
+ * signal handler, event, and message round trip happens only once per batch.
+ * Set to 1 to go through that round trip for every frame.
+ */
+#ifndef NETDEV_TAP_RX_BATCH_MAX
+#define NETDEV_TAP_RX_BATCH_MAX     (16U)
+#endif
+
 /**
  * @brief tap interface state
  */
@@ -44,6 +58,11 @@ typedef struct netdev_tap {
     int tap_fd;                         /**< host file descriptor for the TAP */
     uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the TAP */
     uint8_t promiscous;                 /**< Flag for promiscous mode */
+    bool rx_batch;                      /**< A receive batch is in progress */
+    bool rx_pending;                    /**< More frames are pending in the
+                                             current batch */
+    bool isr_pending;                   /**< An interrupt was signalled and
+                                             not handled yet */
 } netdev_tap_t;
 
 /**
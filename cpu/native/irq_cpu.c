@@ -165,6 +165,12 @@ unsigned irq_disable(void)
     prev_state = native_interrupts_enabled;
     native_interrupts_enabled = 0;
 
+#ifdef MODULE_SCHEDPROF
+    if (prev_state) {
+        schedprof_irq_disabled();
+    }
+#endif
+
     DEBUG("irq_disable(): return\n");
     _native_syscall_leave();
 
@@ -194,6 +200,11 @@ unsigned irq_enable(void)
      */
 
     prev_state = native_interrupts_enabled;
+#ifdef MODULE_SCHEDPROF
+    if (!prev_state) {
+        schedprof_irq_enabled();
+    }
+#endif
     native_interrupts_enabled = 1;
 
     if (sigprocmask(SIG_SETMASK, &_native_sig_set, NULL) == -1) {
@@ -261,7 +272,13 @@ void native_irq_handler(void)
 
         if (native_irq_handlers[sig] != NULL) {
             DEBUG("native_irq_handler: calling interrupt handler for %i\n", sig);
+#ifdef MODULE_SCHEDPROF
+            schedprof_isr_enter();
+#endif
             native_irq_handlers[sig]();
+#ifdef MODULE_SCHEDPROF
+            schedprof_isr_exit();
+#endif
         }
         else if (sig == SIGUSR1) {
             warnx("native_irq_handler: ignoring SIGUSR1");
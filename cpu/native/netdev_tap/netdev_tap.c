@@ -68,6 +68,10 @@
 static int _init(netdev_t *netdev);
 static int _send(netdev_t *netdev, const iolist_t *iolist);
 static int _recv(netdev_t *netdev, void *buf, size_t n, void *info);
+static int _recv_iolist(netdev_t *netdev, const iolist_t *iolist, void *info);
+
+static void _continue_reading(netdev_tap_t *dev);
+static bool _frame_pending(netdev_tap_t *dev);
 
 static inline void _get_mac_addr(netdev_t *netdev, uint8_t *dst)
 {
@@ -94,14 +98,48 @@ static inline int _set_promiscous(netdev_t *netdev, int value)
     return value;
 }
 
-static inline void _isr(netdev_t *netdev)
+static void _isr(netdev_t *netdev)
 {
-    if (netdev->event_callback) {
-        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
-    }
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    unsigned frames = 0;
+#ifdef MODULE_NETSTATS_L2
+    uint32_t rx_count = netdev->stats.rx_count;
+#endif
+
+    if (!netdev->event_callback) {
 #if DEVELHELP
-    else {
         puts("netdev_tap: _isr(): no event_callback set.");
+#endif
+        return;
+    }
+
+    _native_in_syscall++;
+    dev->rx_pending = _frame_pending(dev);
+    _native_in_syscall--;
+
+    /* drain the TAP: every frame read in _recv() or _recv_iolist() updates
+     * dev->rx_pending instead of signalling the next frame. Frames of
+     * signals that arrived before were drained by the previous batch
+     * already, so there might be nothing to read. */
+    dev->rx_batch = true;
+    while (dev->rx_pending && (frames++ < NETDEV_TAP_RX_BATCH_MAX)) {
+        dev->rx_pending = false;
+        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+    }
+    dev->rx_batch = false;
+
+    /* the signals raised while the batch was drained were not passed on, so
+     * signal again if frames arrived in the meantime or the batch limit was
+     * reached */
+    dev->isr_pending = false;
+    _continue_reading(dev);
+#ifdef MODULE_NETSTATS_L2
+    rx_count = netdev->stats.rx_count - rx_count;
+    if (rx_count > 0) {
+        netdev->stats.rx_batches++;
+        if (rx_count > netdev->stats.rx_batch_max) {
+            netdev->stats.rx_batch_max = rx_count;
+        }
     }
 #endif
 }
@@ -160,6 +198,7 @@ static netdev_driver_t netdev_driver_tap = {
     .isr = _isr,
     .get = _get,
     .set = _set,
+    .recv_iolist = _recv_iolist,
 };
 
 /* driver implementation */
@@ -175,18 +214,23 @@ static inline bool _is_addr_multicast(uint8_t *addr)
     return (addr[0] & 0x01);
 }
 
-static void _continue_reading(netdev_tap_t *dev)
+static bool _frame_pending(netdev_tap_t *dev)
 {
-    /* work around lost signals */
     fd_set rfds;
     struct timeval t;
     memset(&t, 0, sizeof(t));
     FD_ZERO(&rfds);
     FD_SET(dev->tap_fd, &rfds);
 
+    return (real_select(dev->tap_fd + 1, &rfds, NULL, NULL, &t) == 1);
+}
+
+static void _continue_reading(netdev_tap_t *dev)
+{
+    /* work around lost signals */
     _native_in_syscall++; /* no switching here */
 
-    if (real_select(dev->tap_fd + 1, &rfds, NULL, NULL, &t) == 1) {
+    if (_frame_pending(dev)) {
         int sig = SIGIO;
         extern int _sig_pipefd[2];
         extern ssize_t (*real_write)(int fd, const void * buf, size_t count);
@@ -202,6 +246,21 @@ static void _continue_reading(netdev_tap_t *dev)
     _native_in_syscall--;
 }
 
+static void _next_frame(netdev_tap_t *dev)
+{
+    if (dev->rx_batch) {
+        /* _isr() decides whether to continue with the batch */
+        _native_in_syscall++;
+        dev->rx_pending = _frame_pending(dev);
+        _native_in_syscall--;
+    }
+    else {
+        _continue_reading(dev);
+    }
+}
+
+static int _recv_done(netdev_tap_t *dev, uint8_t *dst, int nread);
+
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     netdev_tap_t *dev = (netdev_tap_t*)netdev;
@@ -224,7 +283,7 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 
             real_read(dev->tap_fd, buf, sizeof(buf));
 
-            _continue_reading(dev);
+            _next_frame(dev);
         }
 
         /* no way of figuring out packet size without racey buffering,
@@ -235,26 +294,74 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     int nread = real_read(dev->tap_fd, buf, len);
     DEBUG("netdev_tap: read %d bytes\n", nread);
 
+    return _recv_done(dev, (nread > 0) ? ((ethernet_hdr_t *)buf)->dst : NULL,
+                      nread);
+}
+
+static int _recv_iolist(netdev_t *netdev, const iolist_t *iolist, void *info)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    uint8_t dst[ETHERNET_ADDR_LEN];
+    (void)info;
+
+    if (iolist == NULL) {
+        /* same as _recv() with buf == NULL and len > 0 */
+        _recv(netdev, NULL, ETHERNET_FRAME_LEN, NULL);
+        return 0;
+    }
+
+    struct iovec iov[iolist_count(iolist)];
+    unsigned n;
+
+    iolist_to_iovec(iolist, iov, &n);
+    int nread = real_readv(dev->tap_fd, iov, n);
+    DEBUG("netdev_tap: read %d bytes into %u buffers\n", nread, n);
+
+    if ((nread > 0) && (nread < ETHERNET_ADDR_LEN)) {
+        DEBUG("netdev_tap: runt frame => Dropped\n");
+        _next_frame(dev);
+        return 0;
+    }
     if (nread > 0) {
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
-        if (!(dev->promiscous) && !_is_addr_multicast(hdr->dst) &&
-            !_is_addr_broadcast(hdr->dst) &&
-            (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
+        /* destination address may be split over several buffers */
+        for (unsigned i = 0, pos = 0; pos < ETHERNET_ADDR_LEN; i++) {
+            size_t part = iov[i].iov_len;
+
+            if (part > (ETHERNET_ADDR_LEN - pos)) {
+                part = ETHERNET_ADDR_LEN - pos;
+            }
+            memcpy(&dst[pos], iov[i].iov_base, part);
+            pos += part;
+        }
+    }
+    return _recv_done(dev, dst, nread);
+}
+
+static int _recv_done(netdev_tap_t *dev, uint8_t *dst, int nread)
+{
+    if (nread > 0) {
+        if (!(dev->promiscous) && !_is_addr_multicast(dst) &&
+            !_is_addr_broadcast(dst) &&
+            (memcmp(dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
             DEBUG("netdev_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
                   "That's not me => Dropped\n",
-                  hdr->dst[0], hdr->dst[1], hdr->dst[2],
-                  hdr->dst[3], hdr->dst[4], hdr->dst[5]);
+                  dst[0], dst[1], dst[2], dst[3], dst[4], dst[5]);
 
-            native_async_read_continue(dev->tap_fd);
+            if (dev->rx_batch) {
+                _next_frame(dev);
+            }
+            else {
+                native_async_read_continue(dev->tap_fd);
+            }
 
             return 0;
         }
 
-        _continue_reading(dev);
+        _next_frame(dev);
 
 #ifdef MODULE_NETSTATS_L2
-        netdev->stats.rx_count++;
-        netdev->stats.rx_bytes += nread;
+        dev->netdev.stats.rx_count++;
+        dev->netdev.stats.rx_bytes += nread;
 #endif
         return nread;
     }
@@ -305,8 +412,14 @@ static void _tap_isr(int fd, void *arg) {
     (void) fd;
 
     netdev_t *netdev = (netdev_t *)arg;
+    netdev_tap_t *dev = (netdev_tap_t *)netdev;
 
+    if (dev->isr_pending) {
+        /* the pending batch will read this frame as well */
+        return;
+    }
     if (netdev->event_callback) {
+        dev->isr_pending = true;
         netdev->event_callback(netdev, NETDEV_EVENT_ISR);
     }
     else {
@@ -338,6 +451,9 @@ static int _init(netdev_t *netdev)
 #endif
     /* initialize device descriptor */
     dev->promiscous = 0;
+    dev->rx_batch = false;
+    dev->rx_pending = false;
+    dev->isr_pending = false;
     /* implicitly create the tap interface */
     if ((dev->tap_fd = real_open(clonedev, O_RDWR | O_NONBLOCK)) == -1) {
         err(EXIT_FAILURE, "open(%s)", clonedev);
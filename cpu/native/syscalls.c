@@ -97,6 +97,7 @@ int (*real_fseek)(FILE *stream, long offset, int whence);
 int (*real_fputc)(int c, FILE *stream);
 int (*real_fgetc)(FILE *stream);
 mode_t (*real_umask)(mode_t cmask);
+ssize_t (*real_readv)(int fildes, const struct iovec *iov, int iovcnt);
 ssize_t (*real_writev)(int fildes, const struct iovec *iov, int iovcnt);
 
 #ifdef __MACH__
@@ -480,6 +481,7 @@ void _native_init_syscalls(void)
     *(void **)(&real_ferror) = dlsym(RTLD_NEXT, "ferror");
     *(void **)(&real_clearerr) = dlsym(RTLD_NEXT, "clearerr");
     *(void **)(&real_umask) = dlsym(RTLD_NEXT, "umask");
+    *(void **)(&real_readv) = dlsym(RTLD_NEXT, "readv");
     *(void **)(&real_writev) = dlsym(RTLD_NEXT, "writev");
     *(void **)(&real_fclose) = dlsym(RTLD_NEXT, "fclose");
     *(void **)(&real_fseek) = dlsym(RTLD_NEXT, "fseek");
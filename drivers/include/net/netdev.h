@@ -98,6 +98,13 @@
  * This receive sequence can of course be simplified by skipping steps 2 and 3
  * when using fixed sized pre-allocated buffers or similar means. *
  *
+ * Drivers that can write a frame directly into buffers provided by the caller
+ * may additionally implement the optional
+ * @ref netdev_driver_t::recv_iolist "recv_iolist()" function. It reads a frame
+ * in a single call and scatters it over an @ref iolist_t, so e.g. the link
+ * layer header and the payload can be placed into separate buffers without
+ * copying them again afterwards.
+ *
  * @note    The @ref netdev_driver_t::send "send()" and
  *          @ref netdev_driver_t::recv "recv()" functions **must** never be
  *          called from interrupt context.
@@ -386,6 +393,37 @@ typedef struct netdev_driver {
      */
     int (*set)(netdev_t *dev, netopt_t opt,
                const void *value, size_t value_len);
+
+    /**
+     * @brief Get a received frame, scattered over an I/O vector list
+     *
+     * @pre `(dev != NULL)`
+     *
+     * Optional, may be NULL. Supposed to be called from
+     * @ref netdev_t::event_callback "netdev->event_callback()" instead of
+     * @ref netdev_driver_t::recv "recv()".
+     *
+     * The frame is written in order into the buffers of @p iolist, filling
+     * every entry before continuing with the next one. If @p iolist is NULL
+     * the frame is dropped. The buffers can be sized beforehand by calling
+     * @ref netdev_driver_t::recv "recv()" with `buf == NULL` and `len == 0`.
+     *
+     * @param[in]   dev     network device descriptor
+     * @param[in]   iolist  buffers to write into or NULL
+     * @param[out] info     status information for the received packet. Might
+     *                      be of different type for different netdev devices.
+     *                      May be NULL if not needed or applicable.
+     *
+     * @return  number of bytes read
+     * @return  0, if the frame was dropped
+     * @return  -ENOTSUP, if not supported by the device in its current
+     *          configuration (the frame was not consumed, use
+     *          @ref netdev_driver_t::recv "recv()" instead)
+     * @return  -ENOBUFS, if the frame did not fit into @p iolist (it is
+     *          dropped)
+     * @return  `< 0` on other errors
+     */
+    int (*recv_iolist)(netdev_t *dev, const iolist_t *iolist, void *info);
 } netdev_driver_t;
 
 #ifdef __cplusplus
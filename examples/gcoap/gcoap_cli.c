@@ -43,7 +43,8 @@ static const coap_resource_t _resources[] = {
 static gcoap_listener_t _listener = {
     (coap_resource_t *)&_resources[0],
     sizeof(_resources) / sizeof(_resources[0]),
-    NULL
+    NULL,
+    0
 };
 
 /* Counts requests sent by CLI. */
@@ -474,6 +474,14 @@ int lwip_sock_recv(struct netconn *conn, uint32_t timeout, struct netbuf **buf)
 
 ssize_t lwip_sock_send(struct netconn **conn, const void *data, size_t len,
                        int proto, const struct _sock_tl_ep *remote, int type)
+{
+    const iolist_t snip = { NULL, (void *)data, len };
+
+    return lwip_sock_sendv(conn, &snip, proto, remote, type);
+}
+
+ssize_t lwip_sock_sendv(struct netconn **conn, const iolist_t *snips,
+                        int proto, const struct _sock_tl_ep *remote, int type)
 {
     ip_addr_t remote_addr;
     struct netconn *tmp;
@@ -481,6 +489,7 @@ ssize_t lwip_sock_send(struct netconn **conn, const void *data, size_t len,
     int res;
     err_t err;
     u16_t remote_port = 0;
+    size_t len = iolist_size(snips);
 
 #if LWIP_IPV6
     assert(!(type & NETCONN_TYPE_IPV6));
@@ -497,11 +506,19 @@ ssize_t lwip_sock_send(struct netconn **conn, const void *data, size_t len,
     }
 
     buf = netbuf_new();
-    if ((buf == NULL) || (netbuf_alloc(buf, len) == NULL) ||
-        (netbuf_take(buf, data, len) != ERR_OK)) {
+    if ((buf == NULL) || (netbuf_alloc(buf, len) == NULL)) {
         netbuf_delete(buf);
         return -ENOMEM;
     }
+    size_t offset = 0;
+    for (const iolist_t *snip = snips; snip != NULL; snip = snip->iol_next) {
+        if (pbuf_take_at(buf->p, snip->iol_base, snip->iol_len,
+                         offset) != ERR_OK) {
+            netbuf_delete(buf);
+            return -ENOMEM;
+        }
+        offset += snip->iol_len;
+    }
     if (((conn == NULL) || (*conn == NULL)) && (remote != NULL)) {
         if ((res = _create(type, proto, 0, &tmp)) < 0) {
             netbuf_delete(buf);
@@ -530,7 +547,10 @@ ssize_t lwip_sock_send(struct netconn **conn, const void *data, size_t len,
     }
 #if LWIP_TCP
     else if (tmp->type & NETCONN_TCP) {
-        err = netconn_write_partly(tmp, data, len, 0, (size_t *)(&res));
+        /* only sent via lwip_sock_send() */
+        assert(snips->iol_next == NULL);
+        err = netconn_write_partly(tmp, snips->iol_base, len, 0,
+                                   (size_t *)(&res));
     }
 #endif /* LWIP_TCP */
     else {
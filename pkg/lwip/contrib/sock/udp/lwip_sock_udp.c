@@ -66,6 +66,42 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep)
                                0)) ? -ENOTCONN : 0;
 }
 
+/**
+ * @brief   Converts the remote end point of a received netbuf
+ *
+ * @return  0 on success, -EPROTO if the address family is not supported
+ */
+static int _get_remote(sock_udp_t *sock, struct netbuf *buf,
+                       sock_udp_ep_t *remote)
+{
+    size_t addr_len;
+#if LWIP_IPV6
+    if (sock->conn->type & NETCONN_TYPE_IPV6) {
+        addr_len = sizeof(ipv6_addr_t);
+        remote->family = AF_INET6;
+    }
+    else {
+#endif
+#if LWIP_IPV4
+        addr_len = sizeof(ipv4_addr_t);
+        remote->family = AF_INET;
+#else
+        return -EPROTO;
+#endif
+#if LWIP_IPV6
+    }
+#endif
+#if LWIP_NETBUF_RECVINFO
+    remote->netif = lwip_sock_bind_addr_to_netif(&buf->toaddr);
+#else
+    remote->netif = SOCK_ADDR_ANY_NETIF;
+#endif
+    /* copy address */
+    memcpy(&remote->addr, &buf->addr, addr_len);
+    remote->port = buf->port;
+    return 0;
+}
+
 ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                       uint32_t timeout, sock_udp_ep_t *remote)
 {
@@ -82,34 +118,9 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
         netbuf_delete(buf);
         return -ENOBUFS;
     }
-    if (remote != NULL) {
-        /* convert remote */
-        size_t addr_len;
-#if LWIP_IPV6
-        if (sock->conn->type & NETCONN_TYPE_IPV6) {
-            addr_len = sizeof(ipv6_addr_t);
-            remote->family = AF_INET6;
-        }
-        else {
-#endif
-#if LWIP_IPV4
-            addr_len = sizeof(ipv4_addr_t);
-            remote->family = AF_INET;
-#else
-            netbuf_delete(buf);
-            return -EPROTO;
-#endif
-#if LWIP_IPV6
-        }
-#endif
-#if LWIP_NETBUF_RECVINFO
-        remote->netif = lwip_sock_bind_addr_to_netif(&buf->toaddr);
-#else
-        remote->netif = SOCK_ADDR_ANY_NETIF;
-#endif
-        /* copy address */
-        memcpy(&remote->addr, &buf->addr, addr_len);
-        remote->port = buf->port;
+    if ((remote != NULL) && (_get_remote(sock, buf, remote) < 0)) {
+        netbuf_delete(buf);
+        return -EPROTO;
     }
     /* copy data */
     for (struct pbuf *q = buf->p; q != NULL; q = q->next) {
@@ -120,6 +131,44 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     return (ssize_t)res;
 }
 
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
+{
+    struct netbuf *buf;
+    u16_t len;
+    int res;
+
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    if (*buf_ctx != NULL) {
+        /* next pbuf of the chain */
+        buf = *buf_ctx;
+        if (netbuf_next(buf) < 0) {
+            netbuf_delete(buf);
+            *buf_ctx = NULL;
+            *data = NULL;
+            return 0;
+        }
+        netbuf_data(buf, data, &len);
+        return len;
+    }
+    if ((res = lwip_sock_recv(sock->conn, timeout, &buf)) < 0) {
+        return res;
+    }
+    if ((remote != NULL) && (_get_remote(sock, buf, remote) < 0)) {
+        netbuf_delete(buf);
+        return -EPROTO;
+    }
+    netbuf_first(buf);
+    netbuf_data(buf, data, &len);
+    if (len == 0) {
+        netbuf_delete(buf);
+        *data = NULL;
+        return 0;
+    }
+    *buf_ctx = buf;
+    return len;
+}
+
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote)
 {
@@ -133,4 +182,16 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                           NETCONN_UDP);
 }
 
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote)
+{
+    assert((sock != NULL) || (remote != NULL));
+
+    if ((remote != NULL) && (remote->port == 0)) {
+        return -EINVAL;
+    }
+    return lwip_sock_sendv(&sock->conn, snips, 0,
+                           (struct _sock_tl_ep *)remote, NETCONN_UDP);
+}
+
 /** @} */
@@ -79,21 +79,74 @@ static void _del_event_from_list(evtimer_t *evtimer, evtimer_event_t *event)
     }
 }
 
-static void _set_timer(xtimer_t *timer, uint32_t offset)
+static void _set_timer(evtimer_t *evtimer, uint32_t offset)
 {
+    xtimer_t *timer = &evtimer->timer;
     uint64_t offset_in_us = (uint64_t)offset * 1000;
 
     DEBUG("evtimer: now=%" PRIu32 " setting xtimer to %" PRIu32 ":%" PRIu32 "\n",
           xtimer_now_usec(), (uint32_t)(offset_in_us >> 32),
           (uint32_t)(offset_in_us));
+#ifdef MODULE_XTIMER_SLACK
+    if (evtimer->slack) {
+        evtimer->target = xtimer_now_usec() + (uint32_t)offset_in_us;
+        if ((offset_in_us >> 32) == 0) {
+            _xtimer_set_slack(timer, offset_in_us, evtimer->slack * 1000);
+            return;
+        }
+    }
+#else
+    (void)evtimer;
+#endif
     _xtimer_set64(timer, offset_in_us, offset_in_us >> 32);
 }
 
+#ifdef MODULE_XTIMER_SLACK
+/**
+ * @brief   Let the time the timer is late pass for the events following the
+ *          next one
+ *
+ * @return  number of events that expired
+ */
+static unsigned _expire(evtimer_t *evtimer)
+{
+    int32_t diff;
+    uint32_t late;
+    unsigned expired = 0;
+
+    if (!evtimer->slack) {
+        return 0;
+    }
+    diff = xtimer_now_usec() - evtimer->target;
+    /* round to nearest like _get_offset(), so the offsets don't drift */
+    late = (diff > 0) ? (((uint32_t)diff + 500) / 1000) : 0;
+    /* only the slack is expected, don't let other delays pull events in */
+    if (late > evtimer->slack) {
+        late = evtimer->slack;
+    }
+
+    /* the offsets are relative to the current time from now on */
+    evtimer->target += late * 1000;
+
+    for (evtimer_event_t *event = evtimer->events->next;
+         event && late; event = event->next) {
+        uint32_t elapsed = (event->offset < late) ? event->offset : late;
+
+        if (elapsed && (elapsed == event->offset)) {
+            expired++;
+        }
+        event->offset -= elapsed;
+        late -= elapsed;
+    }
+    return expired;
+}
+#endif
+
 static void _update_timer(evtimer_t *evtimer)
 {
     if (evtimer->events) {
         evtimer_event_t *event = evtimer->events;
-        _set_timer(&evtimer->timer, event->offset);
+        _set_timer(evtimer, event->offset);
     }
     else {
         xtimer_remove(&evtimer->timer);
@@ -120,6 +173,13 @@ static void _update_head_offset(evtimer_t *evtimer)
     if (evtimer->events) {
         evtimer_event_t *event = evtimer->events;
         event->offset = _get_offset(&evtimer->timer);
+#ifdef MODULE_XTIMER_SLACK
+        if (event->offset == 0) {
+            /* the timer may be late by up to the slack, so the following
+             * events may have expired as well */
+            evtimer->saved += _expire(evtimer);
+        }
+#endif
         DEBUG("evtimer: _update_head_offset(): new head offset %" PRIu32 "\n", event->offset);
     }
 }
@@ -133,7 +193,7 @@ void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event)
     _update_head_offset(evtimer);
     evtimer_add_event_to_list(evtimer, event);
     if (evtimer->events == event) {
-        _set_timer(&evtimer->timer, event->offset);
+        _set_timer(evtimer, event->offset);
     }
     irq_restore(state);
     if (sched_context_switch_request) {
@@ -176,6 +236,10 @@ static void _evtimer_handler(void *arg)
      * Thus the offset of the first event is down to zero. */
     evtimer_event_t *event = evtimer->events;
     event->offset = 0;
+#ifdef MODULE_XTIMER_SLACK
+    /* handle all events that expired until the timer fired */
+    evtimer->saved += _expire(evtimer);
+#endif
 
     /* iterate the event list */
     while ((event = _get_next(evtimer))) {
@@ -191,7 +255,23 @@ void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler)
     evtimer->timer.callback = _evtimer_handler;
     evtimer->timer.arg = (void *)evtimer;
     evtimer->events = NULL;
+#ifdef MODULE_XTIMER_SLACK
+    evtimer->slack = 0;
+    evtimer->saved = 0;
+#endif
+}
+
+#ifdef MODULE_XTIMER_SLACK
+void evtimer_set_slack(evtimer_t *evtimer, uint32_t slack)
+{
+    unsigned state = irq_disable();
+
+    _update_head_offset(evtimer);
+    evtimer->slack = slack;
+    _update_timer(evtimer);
+    irq_restore(state);
 }
+#endif
 
 void evtimer_print(const evtimer_t *evtimer)
 {
@@ -72,6 +72,16 @@ typedef struct {
     evtimer_callback_t callback;    /**< Handler function for this evtimer's
                                          event type */
     evtimer_event_t *events;        /**< Event queue */
+#if defined(MODULE_XTIMER_SLACK) || DOXYGEN
+    uint32_t slack;                 /**< Milliseconds an event may be delayed
+                                         to be handled together with later
+                                         events (only with `xtimer_slack`) */
+    uint32_t saved;                 /**< Number of events that were handled
+                                         in the wakeup of an earlier event
+                                         (only with `xtimer_slack`) */
+    uint32_t target;                /**< Time in microseconds the timer is
+                                         set to (only with `xtimer_slack`) */
+#endif
 } evtimer_t;
 
 /**
@@ -82,6 +92,20 @@ typedef struct {
  */
 void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler);
 
+#if defined(MODULE_XTIMER_SLACK) || DOXYGEN
+/**
+ * @brief   Sets the slack of an event timer
+ *
+ * The next event of @p evtimer may be handled up to @p slack milliseconds
+ * late, see xtimer_set_slack(). All events that expired until then are
+ * handled in the same wakeup.
+ *
+ * @param[in] evtimer   An event timer
+ * @param[in] slack     Slack in milliseconds
+ */
+void evtimer_set_slack(evtimer_t *evtimer, uint32_t slack);
+#endif
+
 /**
  * @brief   Adds event to an event timer
  *
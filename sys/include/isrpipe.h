@@ -25,7 +25,7 @@
 #include <stdint.h>
 
 #include "mutex.h"
-#include "tsrb.h"
+#include "spscrb.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,13 +36,13 @@ extern "C" {
  */
 typedef struct {
     mutex_t mutex;      /**< isrpipe mutex */
-    tsrb_t tsrb;        /**< isrpipe thread safe ringbuffer */
+    spscrb_t rb;        /**< isrpipe ringbuffer */
 } isrpipe_t;
 
 /**
  * @brief   Static initializer for irspipe
  */
-#define ISRPIPE_INIT(tsrb_buf) { .mutex = MUTEX_INIT, .tsrb = TSRB_INIT(tsrb_buf) }
+#define ISRPIPE_INIT(rb_buf) { .mutex = MUTEX_INIT, .rb = SPSCRB_INIT(rb_buf) }
 
 /**
  * @brief   Initialisation function for isrpipe
@@ -24,6 +24,7 @@
 #include "kernel_types.h"
 #include "universal_address.h"
 #include "mutex.h"
+#include "evtimer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -35,10 +36,19 @@ extern "C" {
  */
 #define FIB_MAX_REGISTERED_RP (5)
 
+/**
+ * @brief Number of prefix trie nodes required to index a FIB table
+ *        holding up to @p entries entries
+ *
+ * Every entry occupies one node, and at most one branching node is needed
+ * per additional entry.
+ */
+#define FIB_TRIE_NODES_NUMOF(entries)   (2 * (entries))
+
 /**
  * @brief Container descriptor for a FIB entry
  */
-typedef struct {
+typedef struct fib_entry {
     /** interface ID */
     kernel_pid_t iface_id;
     /** Lifetime of this entry (an absolute time-point is stored by the FIB) */
@@ -51,8 +61,28 @@ typedef struct {
     uint32_t next_hop_flags;
     /** Pointer to the shared generic address */
     universal_address_container_t *next_hop;
+    /** Event used to invalidate this entry once its lifetime expired */
+    evtimer_event_t expiry;
+    /** Set by the table's expiry timer when the lifetime of this entry expired */
+    uint8_t expired;
+    /** Next entry stored for the same prefix in the prefix trie */
+    struct fib_entry *next;
 } fib_entry_t;
 
+/**
+ * @brief Node of the path-compressed binary prefix trie indexing the
+ *        entries of a single hop FIB table
+ *
+ * Nodes without an entry are branching nodes and always have two children.
+ * All entries of one table are expected to use the same address size.
+ */
+typedef struct fib_trie_node {
+    struct fib_trie_node *child[2]; /**< subtries for the next bit 0 and 1 */
+    fib_entry_t *entry;             /**< list of entries for this prefix,
+                                     *   NULL for branching nodes */
+    uint16_t len;                   /**< prefix length in bits */
+} fib_trie_node_t;
+
 /**
 * @brief Container descriptor for a FIB source route entry
 */
@@ -133,6 +163,16 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+    /** pool of @ref FIB_TRIE_NODES_NUMOF(size) nodes for the prefix trie.
+    *   Must be provided for single hop tables.
+    */
+    fib_trie_node_t *trie_nodes;
+    /** root of the prefix trie indexing the single hop entries */
+    fib_trie_node_t *trie_root;
+    /** list of unused prefix trie nodes */
+    fib_trie_node_t *trie_free;
+    /** timer invalidating entries when their lifetime expired */
+    evtimer_t expiry;
 } fib_table_t;
 
 #ifdef __cplusplus
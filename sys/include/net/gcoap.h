@@ -35,6 +35,8 @@
  * - Server Operation
  * - Client Operation
  * - Observe Server Operation
+ * - Block-wise Transfers
+ * - Response Cache
  * - Implementation Notes
  * - Implementation Status
  *
@@ -51,6 +53,11 @@
  * gcoap itself defines a resource for `/.well-known/core` discovery, which
  * lists all of the registered paths.
  *
+ * By default, gcoap runs the resource handlers in its own thread, so a slow
+ * handler delays all other CoAP messaging. Set GCOAP_WORKERS_NUMOF to run
+ * them on a pool of worker threads instead. Handlers then may run
+ * concurrently, and must be safe to do so.
+ *
  * ### Creating a response ###
  *
  * An application resource includes a callback function, a coap_handler_t. After
@@ -128,8 +135,9 @@
  *
  * A CoAP client may register for Observe notifications for any resource that
  * an application has registered with gcoap. An application does not need to
- * take any action to support Observe client registration. However, gcoap
- * limits registration for a given resource to a _single_ observer.
+ * take any action to support Observe client registration. A resource may have
+ * any number of observers, up to GCOAP_OBS_REGISTRATIONS_MAX registrations
+ * from up to GCOAP_OBS_CLIENTS_MAX clients in total.
  *
  * An Observe notification is considered a response to the original client
  * registration request. So, the Observe server only needs to create and send
@@ -149,7 +157,22 @@
  *    in the coap_pkt_t.
  * -# Call gcoap_finish(), which updates the packet for the payload.
  *
- * Finally, call gcoap_obs_send() for the resource.
+ * Finally, call gcoap_obs_send() for the resource. gcoap sends the same
+ * notification to all observers of the resource, and only rewrites the token
+ * and message ID in the header for each of them.
+ *
+ * ### Notifying from the resource handler ###
+ *
+ * Alternatively, call gcoap_obs_notify() when the resource changed. gcoap
+ * then creates the notification in its own thread by calling the handler of
+ * the resource, as for a GET request with an Observe option, and sends it to
+ * all observers. The handler must create the response with gcoap_resp_init()
+ * and gcoap_finish(), which add the Observe option. As for requests, the
+ * handler may use the gcoap API itself, e.g. to send a request.
+ *
+ * Notifications are sent at most once per GCOAP_OBS_MIN_INTERVAL, so rapid
+ * changes of a resource are coalesced into a single notification with the
+ * latest state.
  *
  * ### Other considerations ###
  *
@@ -161,6 +184,47 @@
  * the Observe option value set to 1. The server does not support cancellation
  * via a reset (RST) response to a non-confirmable notification.
  *
+ * ## Block-wise Transfers ##
+ *
+ * Representations larger than a PDU are transferred block by block
+ * (RFC 7959), so neither side needs to buffer them completely.
+ *
+ * A server resource serves a large representation by returning the result of
+ * coap_reply_block2() from its callback, with a producer function that writes
+ * the representation at a given offset. Likewise, it receives a large request
+ * payload by returning the result of coap_reply_block1(), with a consumer
+ * function for each block. Both functions read the Block options of the
+ * request and write the complete response, so the callback doesn't use
+ * gcoap_resp_init() and gcoap_finish() in this case.
+ *
+ * A client requests the next block of a response with a new request, where
+ * it sets the Block2 option with coap_set_block2() after gcoap_req_init().
+ * Use coap_get_block2() in the response callback to read the block number
+ * and whether more blocks follow. To send a large payload, set the Block1
+ * option with coap_set_block1() for each block, and send the next block when
+ * the response to the previous one, 2.31 (Continue), is received.
+ *
+ * Choose GCOAP_PDU_BUF_SIZE so a block fits into a single link layer frame
+ * to avoid IP fragmentation.
+ *
+ * ## Response Cache ##
+ *
+ * With GCOAP_RESP_CACHE_SIZE set, gcoap keeps the 2.05 (Content) responses
+ * to recent GET requests, so a repeated request is answered from the gcoap
+ * thread without running the resource handler, or waiting for a worker.
+ * Only resources of a listener with a non-zero _max_age_ are cached. A
+ * response is keyed on its resource and the Block2 option of the request,
+ * and is reused until its Max-Age expires. That is the _max_age_ of the
+ * listener, unless the handler sets a Max-Age option itself.
+ *
+ * gcoap adds an ETag and the remaining Max-Age to a cached response. A
+ * client revalidating its copy with that ETag gets a 2.03 (Valid) response
+ * without payload.
+ *
+ * A cached response is dropped when gcoap_obs_init() or gcoap_obs_notify()
+ * is called for its resource. Call gcoap_cache_invalidate() when a resource
+ * without observers changes before its Max-Age expires.
+ *
  * ## Implementation Notes ##
  *
  * ### Building a packet ###
@@ -182,6 +246,11 @@
  * times out. We track the response with an entry in the
  * `_coap_state.open_reqs` array.
  *
+ * The gcoap thread only blocks waiting for a message on its sock, without a
+ * timeout. When the timer expires, it queues a #GCOAP_MSG_TYPE_TIMEOUT
+ * message for the thread and interrupts that wait with a
+ * #GCOAP_MSG_TYPE_INTR message, so a confirmable request is resent on time.
+ *
  * ## Implementation Status ##
  * gcoap includes server and client capability. Available features include:
  *
@@ -195,10 +264,14 @@
  * - Server allows an application to register a 'listener', which includes an
  *   array of endpoint paths and function callbacks used to write a response.
  * - Server listens on a port at startup; defaults to 5683.
+ * - Server optionally runs resource handlers on a pool of worker threads;
+ *   see #GCOAP_WORKERS_NUMOF.
  * - Client operates asynchronously; sends request and then handles response
  *   in a user provided callback.
  * - Client generates token; length defined at compile time.
- * - Options: Supports Content-Format for payload.
+ * - Server optionally caches responses; see #GCOAP_RESP_CACHE_SIZE.
+ * - Options: Supports Content-Format for payload, Block1/Block2 for
+ *   block-wise transfers, and ETag/Max-Age for cached responses.
  *
  * @{
  *
@@ -227,6 +300,8 @@ extern "C" {
 
 /**
  * @brief  Size for module message queue
+ *
+ * Must be greater than #GCOAP_REQ_WAITING_MAX.
  */
 #define GCOAP_MSG_QUEUE_SIZE    (4)
 
@@ -239,6 +314,8 @@ extern "C" {
 
 /**
  * @brief   Size of the buffer used to build a CoAP request or response
+ *
+ * Also limits the block size of block-wise transfers.
  */
 #ifndef GCOAP_PDU_BUF_SIZE
 #define GCOAP_PDU_BUF_SIZE      (128)
@@ -248,16 +325,16 @@ extern "C" {
  * @brief   Size of the buffer used to write options, other than Uri-Path, in a
  *          request
  *
- * Accommodates Content-Format and Uri-Queries
+ * Accommodates Content-Format, Uri-Queries, Block2 and Block1
  */
-#define GCOAP_REQ_OPTIONS_BUF   (40)
+#define GCOAP_REQ_OPTIONS_BUF   (48)
 
 /**
  * @brief   Size of the buffer used to write options in a response
  *
- * Accommodates Content-Format.
+ * Accommodates Content-Format, Block2 and Block1.
  */
-#define GCOAP_RESP_OPTIONS_BUF  (8)
+#define GCOAP_RESP_OPTIONS_BUF  (16)
 
 /**
  * @brief   Size of the buffer used to write options in an Observe notification
@@ -311,13 +388,6 @@ extern "C" {
  */
 #define GCOAP_SEND_LIMIT_NON    (-1)
 
-/**
- * @brief   Time in usec that the event loop waits for an incoming CoAP message
- */
-#ifndef GCOAP_RECV_TIMEOUT
-#define GCOAP_RECV_TIMEOUT      (1 * US_PER_SEC)
-#endif
-
 /**
  * @brief   Default time to wait for a non-confirmable response [in usec]
  *
@@ -336,10 +406,18 @@ extern "C" {
  * @brief   Identifies a request to interrupt listening for an incoming message
  *          on a sock
  *
- * Allows the event loop to process IPC messages.
+ * Allows the event loop to process IPC messages, like
+ * #GCOAP_MSG_TYPE_TIMEOUT.
  */
 #define GCOAP_MSG_TYPE_INTR     (0x1502)
 
+/**
+ * @brief   Notification for Observe registrations is due
+ *
+ * See gcoap_obs_notify().
+ */
+#define GCOAP_MSG_TYPE_OBS      (0x1503)
+
 /**
  * @brief   Maximum number of Observe clients; use 2 if not defined
  */
@@ -355,6 +433,28 @@ extern "C" {
 #define GCOAP_OBS_REGISTRATIONS_MAX     (2)
 #endif
 
+/**
+ * @brief   Number of hash buckets for Observe registrations; use 8 if not
+ *          defined
+ *
+ * Registrations are hashed by resource, so the observers of a resource are
+ * found without looking at the registrations for other resources. Must be a
+ * power of 2.
+ */
+#ifndef GCOAP_OBS_HASH_SIZE
+#define GCOAP_OBS_HASH_SIZE     (8)
+#endif
+
+/**
+ * @brief   Minimum time between notifications sent by gcoap_obs_notify(), in
+ *          microseconds; use 0 if not defined
+ *
+ * Changes notified within this time are coalesced into one notification.
+ */
+#ifndef GCOAP_OBS_MIN_INTERVAL
+#define GCOAP_OBS_MIN_INTERVAL  (0U)
+#endif
+
 /**
  * @name    States for the memo used to track Observe registrations
  * @{
@@ -414,6 +514,47 @@ extern "C" {
 #define GCOAP_STACK_SIZE (THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE)
 #endif
 
+/**
+ * @brief   Number of worker threads to run resource handlers
+ *
+ * With 0, the gcoap thread runs the handlers itself, one request after
+ * another. Otherwise, the gcoap thread passes each incoming request to the
+ * workers, so a slow handler does not hold up other requests.
+ */
+#ifndef GCOAP_WORKERS_NUMOF
+#define GCOAP_WORKERS_NUMOF     (0)
+#endif
+
+/**
+ * @brief   Stack size for each worker thread
+ */
+#ifndef GCOAP_WORKER_STACK_SIZE
+#define GCOAP_WORKER_STACK_SIZE (THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE)
+#endif
+
+/**
+ * @brief   Count of PDU buffers for requests passed to the worker threads;
+ *          must be a power of 2
+ *
+ * Limits the number of requests waiting for or being handled by a worker.
+ * While all buffers are in use, gcoap responds to a request with 5.03
+ * (Service Unavailable). Only used if #GCOAP_WORKERS_NUMOF is not 0.
+ */
+#ifndef GCOAP_PDU_BUFS_NUMOF
+#define GCOAP_PDU_BUFS_NUMOF    (4)
+#endif
+
+/**
+ * @brief   Number of responses kept by the response cache; use 0 if not
+ *          defined
+ *
+ * Each entry takes about #GCOAP_PDU_BUF_SIZE bytes. With 0, the response
+ * cache is not compiled in.
+ */
+#ifndef GCOAP_RESP_CACHE_SIZE
+#define GCOAP_RESP_CACHE_SIZE   (0)
+#endif
+
 /**
  * @brief   Count of PDU buffers available for resending confirmable messages
  */
@@ -429,6 +570,8 @@ typedef struct gcoap_listener {
                                      *   resources; must order alphabetically */
     size_t resources_len;           /**< Length of array */
     struct gcoap_listener *next;    /**< Next listener in list */
+    uint32_t max_age;               /**< Seconds to cache responses to GET
+                                     *   requests; 0 to not cache them */
 } gcoap_listener_t;
 
 /**
@@ -470,11 +613,15 @@ typedef struct {
 /**
  * @brief   Memo for Observe registration and notifications
  */
-typedef struct {
+typedef struct gcoap_observe_memo {
+    struct gcoap_observe_memo *next;    /**< Next memo in hash bucket or in
+                                             list of unused memos */
     sock_udp_ep_t *observer;            /**< Client endpoint; unused if null */
     coap_resource_t *resource;          /**< Entity being observed */
     uint8_t token[GCOAP_TOKENLEN_MAX];  /**< Client token for notifications */
     unsigned token_len;                 /**< Actual length of token attribute */
+    unsigned state;                     /**< State of this memo, a
+                                             GCOAP_OBS_MEMO... */
 } gcoap_observe_memo_t;
 
 /**
@@ -493,6 +640,9 @@ typedef struct {
                                              observe memos */
     gcoap_observe_memo_t observe_memos[GCOAP_OBS_REGISTRATIONS_MAX];
                                         /**< Observed resource registrations */
+    gcoap_observe_memo_t *obs_buckets[GCOAP_OBS_HASH_SIZE];
+                                        /**< Registrations by resource */
+    gcoap_observe_memo_t *obs_unused;   /**< Unused observe memos */
     uint8_t resend_bufs[GCOAP_RESEND_BUFS_MAX][GCOAP_PDU_BUF_SIZE];
                                         /**< Buffers for PDU for request resends;
                                              if first byte of an entry is zero,
@@ -517,6 +667,16 @@ kernel_pid_t gcoap_init(void);
  */
 void gcoap_register_listener(gcoap_listener_t *listener);
 
+/**
+ * @brief   Drops the cached responses for a resource
+ *
+ * Call when a resource changed, so the next request runs its handler again.
+ * Does nothing if #GCOAP_RESP_CACHE_SIZE is 0.
+ *
+ * @param[in] resource  Resource to drop responses for; NULL for all resources
+ */
+void gcoap_cache_invalidate(const coap_resource_t *resource);
+
 /**
  * @brief   Initializes a CoAP request PDU on a buffer.
  *
@@ -636,9 +796,11 @@ static inline ssize_t gcoap_response(coap_pkt_t *pdu, uint8_t *buf,
 
 /**
  * @brief   Initializes a CoAP Observe notification packet on a buffer, for the
- *          observer registered for a resource
+ *          observers registered for a resource
  *
- * First verifies that an observer has been registered for the resource.
+ * First verifies that an observer has been registered for the resource. The
+ * header uses the longest token of the observers, so gcoap_obs_send() can
+ * fit the token of each of them into it.
  *
  * @param[out] pdu      Notification metadata
  * @param[out] buf      Buffer containing the PDU
@@ -654,20 +816,35 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 
 /**
  * @brief   Sends a buffer containing a CoAP Observe notification to the
- *          observer registered for a resource
+ *          observers registered for a resource
  *
- * Assumes a single observer for a resource.
+ * The payload and options are sent unchanged to each observer, only the
+ * header is rewritten with the observer's token and a new message ID.
  *
- * @param[in] buf Buffer containing the PDU
- * @param[in] len Length of the buffer
- * @param[in] resource Resource to send
+ * @param[in,out] buf   Buffer containing the PDU, initialized with
+ *                      gcoap_obs_init(); the header is overwritten
+ * @param[in] len       Length of the buffer
+ * @param[in] resource  Resource to send
  *
- * @return  length of the packet
+ * @return  length of the packet sent to the last observer
  * @return  0 if cannot send
  */
-size_t gcoap_obs_send(const uint8_t *buf, size_t len,
+size_t gcoap_obs_send(uint8_t *buf, size_t len,
                       const coap_resource_t *resource);
 
+/**
+ * @brief   Notifies the observers of a resource that it changed
+ *
+ * The gcoap thread creates the notification with the handler of the
+ * resource and sends it to all observers, at most once per
+ * #GCOAP_OBS_MIN_INTERVAL. Must not be called from a resource handler.
+ *
+ * @param[in] resource  Resource that changed
+ *
+ * @return  number of observers to notify
+ */
+unsigned gcoap_obs_notify(const coap_resource_t *resource);
+
 /**
  * @brief   Provides important operational statistics
  *
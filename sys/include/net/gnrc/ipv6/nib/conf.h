@@ -240,6 +240,18 @@ extern "C" {
 #define GNRC_IPV6_NIB_OFFL_NUMOF            (8)
 #endif
 
+/**
+ * @brief   Number of destinations in the route cache
+ *
+ * The route cache remembers the forwarding table entry last chosen for a
+ * destination, so repeated route lookups for the same destinations skip the
+ * prefix search. It is flushed whenever an off-link entry is added or removed.
+ * Set to 0 to disable the route cache.
+ */
+#ifndef GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF
+#define GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF     (0)
+#endif
+
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C || defined(DOXYGEN)
 /**
  * @brief   Number of authoritative border router entries in NIB
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netapi_direct  Run-to-completion extension
+ * @ingroup     net_gnrc_netapi
+ * @brief       Passes packets between GNRC layers by direct function calls
+ *
+ * By default every GNRC layer handles its packets in its own thread, so a
+ * received packet is handed over by a message at every layer boundary. With
+ * the `gnrc_netapi_direct` module, the layers register a
+ * @ref net_gnrc_netapi_callbacks "callback" in @ref net_gnrc_netreg instead
+ * of their thread:
+ *
+ * - received packets run to completion in the thread of the network interface
+ *   that received them, up to the @ref net_gnrc_sock "sock" or application
+ *   the packet is delivered to,
+ * - packets are sent in the thread of the application down to the network
+ *   interface.
+ *
+ * The layer threads are kept for control-plane work, i.e. for
+ * @ref GNRC_NETAPI_MSG_TYPE_GET / @ref GNRC_NETAPI_MSG_TYPE_SET, the timers
+ * of the @ref net_gnrc_ipv6_nib "NIB" and sending 6LoWPAN fragments.
+ *
+ * @note    The processing of all layers now happens on the stacks of the
+ *          network interface threads and of the threads sending packets.
+ *          Increase the stack sizes passed to gnrc_netif_create() and the
+ *          stacks of the sending threads accordingly.
+ *
+ * To use, add the module `gnrc_netapi_direct` to the `USEMODULE` macro in
+ * your application's Makefile:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * USEMODULE += gnrc_netapi_direct
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The direct mode is enabled by default and can be switched at run-time with
+ * gnrc_netapi_direct_enable().
+ *
+ * @{
+ *
+ * @file
+ * @brief       Run-to-completion extension definitions
+ */
+#ifndef NET_GNRC_NETAPI_DIRECT_H
+#define NET_GNRC_NETAPI_DIRECT_H
+
+#include <stdbool.h>
+
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/nettype.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   A GNRC layer that can be called directly
+ */
+typedef struct gnrc_netapi_direct {
+    struct gnrc_netapi_direct *next;    /**< next layer in the list */
+    gnrc_nettype_t type;                /**< type the layer handles */
+    gnrc_netreg_entry_t thread;         /**< registry entry of the layer
+                                         *   thread */
+    gnrc_netreg_entry_t direct;         /**< registry entry of the handler */
+    gnrc_netreg_entry_cbd_t cbd;        /**< the handler */
+} gnrc_netapi_direct_t;
+
+/**
+ * @brief   Registers a layer for all packets of @p type
+ *
+ * Registers either the calling thread or @p handler in
+ * @ref net_gnrc_netreg, depending on the current mode. Replaces the
+ * gnrc_netreg_register() call of the layer thread.
+ *
+ * @pre The calling thread has a message queue
+ *
+ * @param[out] layer    The layer, must stay valid for the lifetime of the
+ *                      layer thread
+ * @param[in] type      The type of the packets the layer handles
+ * @param[in] handler   Handles @ref GNRC_NETAPI_MSG_TYPE_RCV and
+ *                      @ref GNRC_NETAPI_MSG_TYPE_SND in the calling thread.
+ *                      Must release the packet in any case.
+ */
+void gnrc_netapi_direct_register(gnrc_netapi_direct_t *layer,
+                                 gnrc_nettype_t type,
+                                 gnrc_netreg_entry_cb_t handler);
+
+/**
+ * @brief   Switches all layers between direct calls and their threads
+ *
+ * @note    Packets dispatched while the registrations are swapped are
+ *          dropped, so only call this while no packets are in flight.
+ *
+ * @param[in] enable    true, to call the layers directly,
+ *                      false, to pass packets to the layer threads
+ */
+void gnrc_netapi_direct_enable(bool enable);
+
+/**
+ * @brief   Checks if the layers are called directly
+ *
+ * @return  true, if the layers are called directly
+ * @return  false, if packets are passed to the layer threads
+ */
+bool gnrc_netapi_direct_enabled(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETAPI_DIRECT_H */
+/** @} */
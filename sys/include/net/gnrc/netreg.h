@@ -10,6 +10,16 @@
  * @defgroup    net_gnrc_netreg  Network protocol registry
  * @ingroup     net_gnrc
  * @brief       Registry to receive messages of a specified protocol type by GNRC.
+ *
+ * By default the registry keeps one list per @ref gnrc_nettype_t, so every
+ * lookup is linear in the number of entries registered for that type. With
+ * the `gnrc_netreg_hash` module each type is split into
+ * @ref GNRC_NETREG_HASH_BUCKETS buckets indexed by
+ * gnrc_netreg_entry_t::demux_ctx, and entries with the same demux context are
+ * kept adjacent in their bucket. This makes gnrc_netreg_lookup() independent
+ * of the number of registered entries (as long as the demux contexts spread
+ * over the buckets) and gnrc_netreg_getnext() constant-time. The API is the
+ * same for both variants.
  * @{
  *
  * @file
@@ -72,6 +82,15 @@ typedef enum {
 } gnrc_netreg_type_t;
 #endif
 
+/**
+ * @brief   Number of hash buckets per @ref gnrc_nettype_t
+ *
+ * @note    Only used with the `gnrc_netreg_hash` module. Must be a power of 2.
+ */
+#ifndef GNRC_NETREG_HASH_BUCKETS
+#define GNRC_NETREG_HASH_BUCKETS    (8U)
+#endif
+
 /**
  * @brief   Demux context value to get all packets of a certain type.
  *
@@ -304,6 +323,8 @@ static inline void gnrc_netreg_entry_init_cb(gnrc_netreg_entry_t *entry,
  *
  * @warning Call gnrc_netreg_unregister() *before* you leave the context you
  *          allocated @p entry in. Otherwise it might get overwritten.
+ * @warning Do not change gnrc_netreg_entry_t::demux_ctx of @p entry while it
+ *          is registered.
  *
  * @pre The calling thread must provide a message queue.
  *
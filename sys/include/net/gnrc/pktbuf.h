@@ -58,6 +58,45 @@ extern "C" {
 #define GNRC_PKTBUF_SIZE    (6144)
 #endif  /* GNRC_PKTBUF_SIZE */
 
+/**
+ * @name    Size classes of the `gnrc_pktbuf_slab` implementation
+ *
+ * @details `gnrc_pktbuf_slab` replaces the single arena of
+ *          `gnrc_pktbuf_static` with one pool of fixed size blocks per size
+ *          class: one for packet snips and three for data. Data is allocated
+ *          from the smallest class that fits and has a free block, so
+ *          allocation and release are constant-time and the buffer can not
+ *          fragment. @ref GNRC_PKTBUF_SIZE is not used by this implementation;
+ *          the largest possible allocation is @ref GNRC_PKTBUF_SLAB_LARGE_SIZE.
+ *
+ *          The defaults (about 6.5 KiB) fit 802.15.4 frames and 6LoWPAN
+ *          fragments into the medium class and leave two blocks for full
+ *          Ethernet frames or reassembled IPv6 packets.
+ * @{
+ */
+#ifndef GNRC_PKTBUF_SLAB_SNIP_NUMOF
+#define GNRC_PKTBUF_SLAB_SNIP_NUMOF     (32U)   /**< number of packet snips */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_SMALL_SIZE
+#define GNRC_PKTBUF_SLAB_SMALL_SIZE     (64U)   /**< block size of small class */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_SMALL_NUMOF
+#define GNRC_PKTBUF_SLAB_SMALL_NUMOF    (16U)   /**< blocks in small class */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_MEDIUM_SIZE
+#define GNRC_PKTBUF_SLAB_MEDIUM_SIZE    (128U)  /**< block size of medium class */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_MEDIUM_NUMOF
+#define GNRC_PKTBUF_SLAB_MEDIUM_NUMOF   (12U)   /**< blocks in medium class */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_LARGE_SIZE
+#define GNRC_PKTBUF_SLAB_LARGE_SIZE     (1536U) /**< block size of large class */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_LARGE_NUMOF
+#define GNRC_PKTBUF_SLAB_LARGE_NUMOF    (2U)    /**< blocks in large class */
+#endif
+/** @} */
+
 /**
  * @brief   Initializes packet buffer module.
  */
@@ -281,7 +320,9 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
  *
  * @note    Only available with DEVELHELP defined.
  *
- * @details Statistics include maximum number of reserved bytes.
+ * @details Statistics include maximum number of reserved bytes. With
+ *          `gnrc_pktbuf_slab` they include the number of used blocks, their
+ *          high-watermark and the number of failed allocations per size class.
  */
 void gnrc_pktbuf_stats(void);
 #endif
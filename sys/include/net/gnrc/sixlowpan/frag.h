@@ -14,6 +14,18 @@
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
+ *
+ * Datagrams in reassembly are held in the packet buffer. If a new datagram
+ * does not fit into `RBUF_MEM_MAX` bytes, the least recently used datagrams
+ * are evicted to make room for it.
+ *
+ * The number of datagrams in reassembly at the same time is still capped
+ * by `RBUF_SIZE` (default: 8), since the meta data of a datagram, including
+ * its fragment bitmaps, is allocated statically. Sizing this pool for the
+ * smallest fragmented datagrams would take several KiB of RAM on every node.
+ * Border routers that reassemble datagrams of many nodes at once should
+ * raise `RBUF_SIZE`. Datagrams evicted because either limit was reached are
+ * counted in gnrc_sixlowpan_frag_rbuf_stats_t::evicted.
  * @{
  *
  * @file
@@ -53,6 +65,22 @@ typedef struct {
                              *   payload datagram */
 } gnrc_sixlowpan_msg_frag_t;
 
+/**
+ * @brief   Statistics of the reassembly buffer
+ *
+ * All counters but gnrc_sixlowpan_frag_rbuf_stats_t::complete count
+ * datagrams that were dropped, by the reason they were dropped for.
+ */
+typedef struct {
+    uint32_t complete;      /**< datagrams reassembled */
+    uint32_t timeout;       /**< not completed within the reassembly timeout */
+    uint32_t evicted;       /**< evicted to make room for a newer datagram */
+    uint32_t overlap;       /**< fragments overlapped partially */
+    uint32_t too_big;       /**< a fragment exceeded the datagram size */
+    uint32_t nomem;         /**< no space left in the packet buffer */
+    uint32_t decode;        /**< the IPHC header could not be decoded */
+} gnrc_sixlowpan_frag_rbuf_stats_t;
+
 /**
  * @brief   Sends a packet fragmented.
  *
@@ -68,6 +96,13 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg);
  */
 void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Gets the statistics of the reassembly buffer
+ *
+ * @param[out] stats    The statistics
+ */
+void gnrc_sixlowpan_frag_rbuf_get_stats(gnrc_sixlowpan_frag_rbuf_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
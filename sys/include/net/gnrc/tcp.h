@@ -34,6 +34,21 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Timeout value for gnrc_tcp_accept(), to wait until a connection was established
+ */
+#define GNRC_TCP_NO_TIMEOUT (UINT32_MAX)
+
+/**
+ * @name Events of connections and listening queues, see gnrc_tcp_get_events()
+ * @{
+ */
+#define GNRC_TCP_EVENT_RECV   (0x01U)  /**< gnrc_tcp_recv() returns without waiting */
+#define GNRC_TCP_EVENT_SEND   (0x02U)  /**< Connection is established, data can be sent */
+#define GNRC_TCP_EVENT_CLOSED (0x04U)  /**< Connection is closed, e.g. reset by the peer */
+#define GNRC_TCP_EVENT_ACCEPT (0x08U)  /**< gnrc_tcp_accept() returns without waiting */
+/** @} */
+
 /**
  * @brief Initialize TCP
  *
@@ -74,7 +89,6 @@ void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb);
   *            -EAFNOSUPPORT if @p address_family is not supported.
   *            -EINVAL if @p address_family is not the same the address_family use by the TCB.
   *            -EISCONN if TCB is already in use.
-  *            -ENOMEM if the receive buffer for the TCB could not be allocated.
   *            -EADDRINUSE if @p local_port is already used by another connection.
   *            -ETIMEDOUT if the connection could not be opened.
   *            -ECONNREFUSED if the connection was resetted by the peer.
@@ -106,12 +120,80 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
  *            -EAFNOSUPPORT if local_addr != NULL and @p address_family is not supported.
  *            -EINVAL if @p address_family is not the same the address_family used in TCB.
  *            -EISCONN if TCB is already in use.
- *            -ENOMEM if the receive buffer for the TCB could not be allocated.
- *            Hint: Increase "GNRC_TCP_RCV_BUFFERS".
  */
 int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
                           const uint8_t *local_addr, const uint16_t local_port);
 
+/**
+ * @brief Listens for incomming connections with a queue of TCBs.
+ *
+ * @pre @p queue must not be NULL.
+ * @pre @p tcbs must not be NULL.
+ * @pre @p tcbs_len must not be zero.
+ * @pre if local_addr is not NULL, local_addr must be assigned to a network interface.
+ * @pre @p local_port must not be zero.
+ *
+ * @note Does not block. Incomming connection requests are handled by the TCP thread, each by
+ *       one of the listening TCBs of @p queue. Established connections are taken from
+ *       @p queue with gnrc_tcp_accept(). Once the connection of an accepted TCB was closed,
+ *       the TCB listens again. Connection requests, that arrive while no TCB of @p queue
+ *       listens, are dropped without reply, so the peer retries.
+ *
+ * @param[out]    queue            Listening queue to initialize.
+ * @param[in,out] tcbs             TCBs of the queue. The TCBs are initialized by this function.
+ * @param[in]     tcbs_len         Number of TCBs in @p tcbs.
+ * @param[in]     address_family   Address family of @p local_addr.
+ *                                 If local_addr == NULL, address_family is ignored.
+ * @param[in]     local_addr       If not NULL the connections are bound to @p local_addr.
+ *                                 If NULL a connection request to all local ip
+ *                                 addresses is valied.
+ * @param[in]     local_port       Port number to listen on.
+ *
+ * @returns   Zero on success.
+ *            -EAFNOSUPPORT if local_addr != NULL and @p address_family is not supported.
+ */
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, const size_t tcbs_len,
+                    const uint8_t address_family, const uint8_t *local_addr,
+                    const uint16_t local_port);
+
+/**
+ * @brief Accepts an established connection from a listening queue.
+ *
+ * @pre gnrc_tcp_listen() must have been successfully called on @p queue.
+ * @pre @p queue must not be NULL.
+ * @pre @p tcb must not be NULL.
+ *
+ * @note Function blocks if user_timeout_duration_us is not zero. Close the accepted
+ *       connection with gnrc_tcp_close() or gnrc_tcp_abort().
+ *
+ * @param[in,out] queue                      Listening queue.
+ * @param[out]    tcb                        TCB of the accepted connection.
+ * @param[in]     user_timeout_duration_us   Timeout for accept in microseconds.
+ *                                           If zero and no connection is established, the
+ *                                           function returns immediately. If
+ *                                           GNRC_TCP_NO_TIMEOUT, the function blocks until
+ *                                           a connection was established.
+ *
+ * @returns   Zero on success.
+ *            -EINVAL if @p queue is not listening.
+ *            -EAGAIN if user_timeout_duration_us is zero and no connection is established.
+ *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ */
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t user_timeout_duration_us);
+
+/**
+ * @brief Stops listening on a listening queue.
+ *
+ * @pre @p queue must not be NULL.
+ *
+ * @note Connections, that were not accepted yet, are aborted. Accepted connections are
+ *       not affected.
+ *
+ * @param[in,out] queue   Listening queue.
+ */
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue);
+
 /**
  * @brief Transmit data to connected peer.
  *
@@ -119,7 +201,9 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
  * @pre @p tcb must not be NULL.
  * @pre @p data must not be NULL.
  *
- * @note Blocks until up to @p len bytes were transmitted or an error occured.
+ * @note Blocks until up to @p len bytes were transmitted and acknowledged or an error occured.
+ *       Up to GNRC_TCP_SND_QUEUE_SIZE segments are in flight at once, limited by the
+ *       peers window and the congestion window.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -129,10 +213,14 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
  *                                           If zero, no timeout will be triggered.
  *
  * @returns   The number of successfully transmitted bytes.
+ *            The number of bytes the peer acknowledged, if the connection was aborted or
+ *            @p user_timeout_duration_us expired after some of the data was acknowledged.
+ *            Data, that was sent but not acknowledged yet, is not retransmitted then.
  *            -ENOTCONN if connection is not established.
  *            -ECONNRESET if connection was resetted by the peer.
- *            -ECONNABORTED if the connection was aborted.
- *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ *            -ECONNABORTED if the connection was aborted before any data was acknowledged.
+ *            -ETIMEDOUT if @p user_timeout_duration_us expired before any data was
+ *            acknowledged.
  */
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t user_timeout_duration_us);
@@ -158,6 +246,7 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
  *                                           @p user_timeout_duration_us microseconds passed.
  *
  * @returns   The number of bytes read into @p data.
+ *            Zero if the peer closed the connection and all data was read.
  *            -ENOTCONN if connection is not established.
  *            -EAGAIN if  user_timeout_duration_us is zero and no data is available.
  *            -ECONNRESET if connection was resetted by the peer.
@@ -187,6 +276,63 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb);
  */
 void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Sets a callback that is called on changes of a connection.
+ *
+ * The callback is called whenever a blocked gnrc_tcp_recv() or gnrc_tcp_send() would be
+ * woken up, e.g. on received data or when the connection was closed, so
+ * gnrc_tcp_get_events() may have changed. It is called from the context of the TCP thread
+ * or of the thread calling into @p tcb, so it must not block or call GNRC TCP functions.
+ *
+ * @pre @p tcb must not be NULL.
+ *
+ * @note The callback is removed when a connection accepted from a listening queue is
+ *       closed, since its TCB listens again.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     cb    The callback. May be NULL to remove the callback.
+ * @param[in]     arg   Argument for @p cb.
+ */
+void gnrc_tcp_set_cb(gnrc_tcp_tcb_t *tcb, gnrc_tcp_cb_t cb, void *arg);
+
+/**
+ * @brief Sets a callback that is called on changes of the connections of a listening queue,
+ *        that were not accepted yet.
+ *
+ * Like gnrc_tcp_set_cb(), but for connections, that can be taken by gnrc_tcp_accept().
+ *
+ * @pre @p queue must not be NULL.
+ * @pre gnrc_tcp_listen() must have been called for @p queue.
+ *
+ * @param[in,out] queue   Listening queue.
+ * @param[in]     cb      The callback. May be NULL to remove the callback.
+ * @param[in]     arg     Argument for @p cb.
+ */
+void gnrc_tcp_queue_set_cb(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_cb_t cb, void *arg);
+
+/**
+ * @brief Gets the events of a connection, that are pending.
+ *
+ * @pre @p tcb must not be NULL.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   GNRC_TCP_EVENT_RECV, GNRC_TCP_EVENT_SEND and GNRC_TCP_EVENT_CLOSED combined.
+ */
+unsigned gnrc_tcp_get_events(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Gets the events of a listening queue, that are pending.
+ *
+ * @pre @p queue must not be NULL.
+ *
+ * @param[in] queue   Listening queue.
+ *
+ * @returns   GNRC_TCP_EVENT_ACCEPT if a connection was established, that was not accepted
+ *            yet, zero otherwise.
+ */
+unsigned gnrc_tcp_queue_get_events(gnrc_tcp_tcb_queue_t *queue);
+
 /**
  * @brief Calculate and set checksum in TCP header.
  *
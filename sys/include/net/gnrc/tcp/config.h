@@ -68,17 +68,60 @@ extern "C" {
 #endif
 
 /**
- * @brief Number of preallocated receive buffers
+ * @brief Receive buffer size of a connection
+ *
+ * Received data is held in the packet buffer until it is read, this is the
+ * maximum number of unread bytes per connection.
  */
-#ifndef GNRC_TCP_RCV_BUFFERS
-#define GNRC_TCP_RCV_BUFFERS (1U)
+#ifndef GNRC_TCP_RCV_BUF_SIZE
+#define GNRC_TCP_RCV_BUF_SIZE (GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
 /**
- * @brief Default receive buffer size
+ * @brief Maximum number of received segments a connection holds
+ *
+ * This includes segments that arrived out of order and are held until the
+ * missing data was received. Further segments are dropped and have to be
+ * retransmitted by the peer.
+ *
+ * @note The advertised window only depends on GNRC_TCP_RCV_BUF_SIZE. While
+ *       this many segments are held unread, further segments are dropped
+ *       even if they are in order and the window is still open, e.g. if
+ *       the peer sends many small segments. Choose this value so that
+ *       GNRC_TCP_RCV_BUF_SIZE is filled by the expected segment sizes.
  */
-#ifndef GNRC_TCP_RCV_BUF_SIZE
-#define GNRC_TCP_RCV_BUF_SIZE (GNRC_TCP_DEFAULT_WINDOW)
+#ifndef GNRC_TCP_RCV_SEGS
+#define GNRC_TCP_RCV_SEGS (4U)
+#endif
+
+/**
+ * @brief Number of unacknowledged segments a connection keeps in flight
+ *
+ * Each segment stays in the packet buffer until it is acknowledged, so
+ * GNRC_PKTBUF_SIZE must hold this many MSS sized segments in addition to the
+ * packets of all other users.
+ */
+#ifndef GNRC_TCP_SND_QUEUE_SIZE
+#define GNRC_TCP_SND_QUEUE_SIZE (4U)
+#endif
+
+/**
+ * @brief Window scale shift count advertised to the peer (see RFC 7323)
+ *
+ * If not zero, the window scale option is sent in SYN segments. Scaling is
+ * used in both directions if the peer sends the option as well. It is only
+ * needed if GNRC_TCP_RCV_BUF_SIZE exceeds 64 KiB, or to allow the peer to
+ * announce a window larger than 64 KiB.
+ */
+#ifndef GNRC_TCP_WND_SCALE
+#define GNRC_TCP_WND_SCALE (0U)
+#endif
+
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit (see RFC 5681)
+ */
+#ifndef GNRC_TCP_DUPACK_THRESHOLD
+#define GNRC_TCP_DUPACK_THRESHOLD (3U)
 #endif
 
 /**
@@ -22,9 +22,9 @@
 #ifndef NET_GNRC_TCP_TCB_H
 #define NET_GNRC_TCP_TCB_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "kernel_types.h"
-#include "ringbuffer.h"
 #include "xtimer.h"
 #include "mutex.h"
 #include "msg.h"
@@ -45,6 +45,28 @@ extern "C" {
  */
 #define GNRC_TCP_TCB_MBOX_SIZE (8U)
 
+/**
+ * @brief Received segment, held by a TCB until its data was read
+ */
+typedef struct {
+    gnrc_pktsnip_t *pkt;   /**< Received packet, starting with the payload */
+    uint32_t seq;          /**< SeqNo. of the first unread byte */
+    uint16_t off;          /**< Offset of the first unread byte in the payload */
+    uint16_t len;          /**< Number of unread bytes */
+} gnrc_tcp_rcv_seg_t;
+
+/**
+ * @brief Listening queue of GNRC TCP, see gnrc_tcp_listen()
+ */
+struct _gnrc_tcp_tcb_queue;
+
+/**
+ * @brief Callback for changes of a connection or listening queue
+ *
+ * @param[in] arg   The argument given to gnrc_tcp_set_cb() or gnrc_tcp_queue_set_cb().
+ */
+typedef void (*gnrc_tcp_cb_t)(void *arg);
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
@@ -60,31 +82,60 @@ typedef struct _transmission_control_block {
     uint8_t status;        /**< A connections status flags */
     uint32_t snd_una;      /**< Send unacknowledged */
     uint32_t snd_nxt;      /**< Send next */
-    uint16_t snd_wnd;      /**< Send window */
+    uint32_t snd_wnd;      /**< Send window */
     uint32_t snd_wl1;      /**< SeqNo. from last window update */
     uint32_t snd_wl2;      /**< AckNo. from last window update */
     uint32_t rcv_nxt;      /**< Receive next */
-    uint16_t rcv_wnd;      /**< Receive window */
+    uint32_t rcv_wnd;      /**< Receive window */
+    uint8_t snd_wnd_shift; /**< Window scale shift count of the peer */
+    uint8_t rcv_wnd_shift; /**< Window scale shift count announced to the peer */
     uint32_t iss;          /**< Initial sequence sumber */
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
+    uint32_t cwnd;         /**< Congestion window */
+    uint32_t ssthresh;     /**< Slow start threshold */
+    uint32_t recover;      /**< Snd_nxt when loss recovery started (NewReno) */
+    uint8_t dupacks;       /**< Number of consecutive duplicate ACKs */
     uint32_t rtt_start;    /**< Timer value for rtt estimation */
+    uint32_t rtt_seq;      /**< SeqNo. that ends the segment used for rtt estimation */
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
     uint8_t retries;       /**< Number of retransmissions */
     xtimer_t tim_tout;     /**< Timer struct for timeouts */
     msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
+    gnrc_pktsnip_t *pkt_retransmit[GNRC_TCP_SND_QUEUE_SIZE]; /**< Retransmit queue, oldest first */
+    uint8_t pkt_retransmit_num;   /**< Number of packets in retransmit queue */
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
-    uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
-    ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
+    gnrc_tcp_rcv_seg_t rcv_buf[GNRC_TCP_RCV_SEGS];   /**< Received segments, by SeqNo. */
+    uint8_t rcv_buf_num;     /**< Number of segments in rcv_buf */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
+    gnrc_tcp_cb_t cb;        /**< Called on changes of the connection, see gnrc_tcp_set_cb() */
+    void *cb_arg;            /**< Argument for cb */
+    struct _gnrc_tcp_tcb_queue *queue;          /**< Listening queue, the TCB belongs to */
     struct _transmission_control_block *next;   /**< Pointer next TCB */
 } gnrc_tcp_tcb_t;
 
+/**
+ * @brief Listening queue of GNRC TCP.
+ *
+ * All TCBs of the queue listen on the same port. Each incoming connection
+ * request is handled by one of the listening TCBs, so a queue of n TCBs
+ * holds up to n connections that are being established or waiting to be
+ * accepted.
+ */
+typedef struct _gnrc_tcp_tcb_queue {
+    gnrc_tcp_tcb_t *tcbs;    /**< TCBs of the queue */
+    size_t tcbs_len;         /**< Number of TCBs in tcbs */
+    mutex_t lock;            /**< Mutex for function call synchronization */
+    msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
+    mbox_t mbox;             /**< Mbox, notified on established connections */
+    gnrc_tcp_cb_t cb;        /**< Called on established connections, see gnrc_tcp_queue_set_cb() */
+    void *cb_arg;            /**< Argument for cb */
+} gnrc_tcp_tcb_queue_t;
+
 #ifdef __cplusplus
 }
 #endif
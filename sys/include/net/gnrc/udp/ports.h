@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_udp_ports UDP port table
+ * @ingroup     net_gnrc_udp
+ * @brief       Table of the UDP ports GNRC has receivers for
+ *
+ * The port table keeps track of all UDP ports a receiver is registered for
+ * in @ref net_gnrc_netreg. It is shared by the port allocation of
+ * @ref net_gnrc_sock and the demultiplexing of @ref net_gnrc_udp:
+ *
+ * - The bound ports are looked up in the registry itself. Use the module
+ *   together with `gnrc_netreg_hash`, which hashes the registry by port, so
+ *   the lookup does not depend on the number of open socks.
+ * - The dynamic port range additionally has a bitmap with one bit per port,
+ *   so gnrc_udp_ports_alloc() finds a free ephemeral port without looking
+ *   at any other sock. The bitmap takes @ref GNRC_UDP_PORTS_DYN_NUM / 8
+ *   bytes of RAM, so reduce the range with @ref GNRC_UDP_PORTS_DYN_MIN on
+ *   memory-constrained devices.
+ * - Packets for ports without receiver are dropped by @ref net_gnrc_udp
+ *   before they are dispatched.
+ *
+ * The table is updated by gnrc_netreg_register() and
+ * gnrc_netreg_unregister(), so receivers do not need to be aware of it.
+ *
+ * @{
+ *
+ * @file
+ * @brief       UDP port table definitions
+ */
+#ifndef NET_GNRC_UDP_PORTS_H
+#define NET_GNRC_UDP_PORTS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "net/iana/portrange.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Lowest port of the dynamic port range
+ */
+#ifndef GNRC_UDP_PORTS_DYN_MIN
+#define GNRC_UDP_PORTS_DYN_MIN      (IANA_DYNAMIC_PORTRANGE_MIN)
+#endif
+
+/**
+ * @brief   Number of ports in the dynamic port range
+ *
+ * The range ends at @ref IANA_DYNAMIC_PORTRANGE_MAX.
+ */
+#define GNRC_UDP_PORTS_DYN_NUM      (IANA_DYNAMIC_PORTRANGE_MAX - \
+                                     GNRC_UDP_PORTS_DYN_MIN + 1)
+
+/**
+ * @brief   Offset between consecutive candidates for ephemeral ports
+ *
+ * Must be coprime to @ref GNRC_UDP_PORTS_DYN_NUM, see
+ * https://tools.ietf.org/html/rfc6056#section-3.3.3
+ */
+#ifndef GNRC_UDP_PORTS_DYN_OFF
+#define GNRC_UDP_PORTS_DYN_OFF      (17U)
+#endif
+
+/**
+ * @brief   Number of buckets to hash socks by their local port
+ *
+ * @note    Must be a power of 2
+ */
+#ifndef GNRC_UDP_PORTS_BUCKETS
+#define GNRC_UDP_PORTS_BUCKETS      (8U)
+#endif
+
+/**
+ * @brief   Occupancy statistics of the port table
+ */
+typedef struct {
+    uint16_t bound;             /**< ports with at least one receiver */
+    uint16_t dyn_bound;         /**< bound ports in the dynamic range */
+    uint32_t allocs;            /**< ephemeral ports allocated */
+    uint32_t alloc_fails;       /**< allocations failed due to a full range */
+    uint32_t demux_hits;        /**< packets for bound ports */
+    uint32_t demux_misses;      /**< packets dropped for unbound ports */
+} gnrc_udp_ports_stats_t;
+
+/**
+ * @brief   Bucket of @p port for hash tables keyed by port
+ *
+ * @param[in] port  A port in host byte order
+ *
+ * @return  a bucket index < @ref GNRC_UDP_PORTS_BUCKETS
+ */
+static inline unsigned gnrc_udp_ports_bucket(uint16_t port)
+{
+    return (port ^ (port >> 8)) & (GNRC_UDP_PORTS_BUCKETS - 1);
+}
+
+/**
+ * @brief   Clears the port table
+ *
+ * @note    Called by gnrc_netreg_init()
+ */
+void gnrc_udp_ports_init(void);
+
+/**
+ * @brief   Marks @p port as bound
+ *
+ * @note    Called by gnrc_netreg_register() after a receiver for @p port was
+ *          registered
+ *
+ * @param[in] port  A port in host byte order
+ */
+void gnrc_udp_ports_add(uint16_t port);
+
+/**
+ * @brief   Marks @p port as unbound if it has no receivers left
+ *
+ * @note    Called by gnrc_netreg_unregister() after a receiver for @p port
+ *          was unregistered
+ *
+ * @param[in] port  A port in host byte order
+ */
+void gnrc_udp_ports_remove(uint16_t port);
+
+/**
+ * @brief   Checks if @p port has a receiver
+ *
+ * @param[in] port  A port in host byte order
+ *
+ * @return  true, if @p port is bound
+ * @return  false, otherwise
+ */
+bool gnrc_udp_ports_used(uint16_t port);
+
+/**
+ * @brief   Checks if a received packet for @p port can be delivered and
+ *          counts it in the statistics
+ *
+ * @param[in] port  The destination port of the packet in host byte order
+ *
+ * @return  true, if @p port is bound
+ * @return  false, if the packet should be dropped
+ */
+bool gnrc_udp_ports_demux(uint16_t port);
+
+/**
+ * @brief   Finds an unbound port in the dynamic port range
+ *
+ * The candidates are picked as described in
+ * https://tools.ietf.org/html/rfc6056#section-3.3.3. If the candidate is
+ * bound, the next unbound port is taken from the bitmap.
+ *
+ * @note    The port is not bound by this function. Register a receiver for
+ *          it before the next call, or the same port may be returned again.
+ *
+ * @return  an unbound port in host byte order
+ * @return  0, if all ports of the dynamic range are bound
+ */
+uint16_t gnrc_udp_ports_alloc(void);
+
+/**
+ * @brief   Gets the occupancy statistics of the port table
+ *
+ * @param[out] stats    The statistics
+ */
+void gnrc_udp_ports_get_stats(gnrc_udp_ports_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_UDP_PORTS_H */
+/** @} */
@@ -51,15 +51,30 @@ extern "C" {
 #define NANOCOAP_QS_MAX         (64)
 /** @} */
 
+/**
+ * @brief   Maximum block size exponent used by coap_reply_block2()
+ *
+ * The block size is `2^(NANOCOAP_BLOCK_SZX_MAX + 4)`, so the default of 6
+ * allows for blocks of 1024 bytes, the maximum of RFC 7959. Lower it to keep
+ * responses within the link MTU.
+ */
+#ifndef NANOCOAP_BLOCK_SZX_MAX
+#define NANOCOAP_BLOCK_SZX_MAX  (6)
+#endif
+
 /**
  * @name    CoAP option numbers
  * @{
  */
 #define COAP_OPT_URI_HOST       (3)
+#define COAP_OPT_ETAG           (4)
 #define COAP_OPT_OBSERVE        (6)
 #define COAP_OPT_URI_PATH       (11)
 #define COAP_OPT_CONTENT_FORMAT (12)
+#define COAP_OPT_MAX_AGE        (14)
 #define COAP_OPT_URI_QUERY      (15)
+#define COAP_OPT_BLOCK2         (23)
+#define COAP_OPT_BLOCK1         (27)
 /** @} */
 
 /**
@@ -121,6 +136,7 @@ extern "C" {
 #define COAP_CODE_CONTENT      ((2 << 5) | 5)
 #define COAP_CODE_205          ((2 << 5) | 5)
 #define COAP_CODE_231          ((2 << 5) | 31)
+#define COAP_CODE_CONTINUE     ((2 << 5) | 31)
 /** @} */
 
 /**
@@ -136,6 +152,7 @@ extern "C" {
 #define COAP_CODE_404                        ((4 << 5) | 4)
 #define COAP_CODE_METHOD_NOT_ALLOWED         ((4 << 5) | 5)
 #define COAP_CODE_NOT_ACCEPTABLE             ((4 << 5) | 6)
+#define COAP_CODE_REQUEST_ENTITY_INCOMPLETE  ((4 << 5) | 8)
 #define COAP_CODE_PRECONDITION_FAILED        ((4 << 5) | 0xC)
 #define COAP_CODE_REQUEST_ENTITY_TOO_LARGE   ((4 << 5) | 0xD)
 #define COAP_CODE_UNSUPPORTED_CONTENT_FORMAT ((4 << 5) | 0xF)
@@ -228,8 +245,65 @@ typedef struct {
     unsigned payload_len;           /**< length of payload                  */
     uint16_t content_type;          /**< content type                       */
     uint32_t observe_value;         /**< observe value                      */
+    uint32_t block1;                /**< raw Block1 value, or UINT32_MAX    */
+    uint32_t block2;                /**< raw Block2 value, or UINT32_MAX    */
 } coap_pkt_t;
 
+/**
+ * @brief   Block1 or Block2 option (RFC 7959)
+ */
+typedef struct {
+    uint32_t num;                   /**< block number                       */
+    unsigned szx;                   /**< block size exponent, the size is
+                                         `2^(szx + 4)`                      */
+    bool more;                      /**< more blocks follow                 */
+} coap_block_t;
+
+/**
+ * @brief   Position while iterating over the options of a packet
+ */
+typedef struct {
+    uint8_t *pos;                   /**< start of the next option           */
+    uint16_t onum;                  /**< number of the current option       */
+    uint8_t *value;                 /**< value of the current option        */
+    size_t len;                     /**< length of @ref value               */
+} coap_optpos_t;
+
+/**
+ * @brief   Block2 producer type, used by coap_reply_block2()
+ *
+ * Writes the part of the representation starting at @p offset to @p buf.
+ *
+ * @param[in]   arg     argument passed to coap_reply_block2()
+ * @param[in]   offset  offset in the representation
+ * @param[out]  buf     buffer to write to
+ * @param[in]   len     size of @p buf
+ *
+ * @returns     number of bytes written, less than @p len only at the end of
+ *              the representation
+ * @returns     <0 on error
+ */
+typedef ssize_t (*coap_block_producer_t)(void *arg, size_t offset,
+                                         uint8_t *buf, size_t len);
+
+/**
+ * @brief   Block1 consumer type, used by coap_reply_block1()
+ *
+ * @param[in]   arg     argument passed to coap_reply_block1()
+ * @param[in]   offset  offset of @p data in the representation
+ * @param[in]   data    received block
+ * @param[in]   len     length of @p data
+ * @param[in]   more    true if more blocks follow
+ *
+ * @returns     0 on success
+ * @returns     -EINVAL if the block is out of sequence
+ * @returns     -ENOSPC if the representation is too large
+ * @returns     any other negative errno code on other errors
+ */
+typedef int (*coap_block_consumer_t)(void *arg, size_t offset,
+                                     const uint8_t *data, size_t len,
+                                     bool more);
+
 /**
  * @brief   Resource handler type
  */
@@ -247,6 +321,8 @@ typedef struct {
 
 /**
  * @brief   Global CoAP resource list
+ *
+ * Must be sorted by path, see coap_find_resource().
  */
 extern const coap_resource_t coap_resources[];
 
@@ -332,6 +408,72 @@ ssize_t coap_reply_simple(coap_pkt_t *pkt,
  */
 ssize_t coap_handle_req(coap_pkt_t *pkt, uint8_t *resp_buf, unsigned resp_buf_len);
 
+/**
+ * @brief   Find the resource for a path and method
+ *
+ * Uses a binary search, so @p resources must be sorted by path in the order
+ * of `strcmp()`. Resources with the same path but different methods may
+ * follow each other.
+ *
+ * @param[in]   resources       resources to search
+ * @param[in]   resources_numof number of entries in @p resources
+ * @param[in]   path            URI path to look for
+ * @param[in]   method_flag     method to look for, see coap_method2flag()
+ *
+ * @returns     the first resource matching @p path and @p method_flag
+ * @returns     NULL if there is none
+ */
+const coap_resource_t *coap_find_resource(const coap_resource_t *resources,
+                                          size_t resources_numof,
+                                          const char *path,
+                                          unsigned method_flag);
+
+/**
+ * @brief   Reply to a request with a block of a representation (RFC 7959)
+ *
+ * Calls @p producer for the block requested by the Block2 option of @p pkt,
+ * or for the first block if there is none, and writes the response with a
+ * Block2 option to @p buf. The block size is the smaller of the requested
+ * size, #NANOCOAP_BLOCK_SZX_MAX and the largest size that fits into @p buf,
+ * so the representation never needs to be held in RAM completely.
+ *
+ * @param[in]   pkt         request to reply to
+ * @param[in]   code        reply code (e.g., COAP_CODE_CONTENT)
+ * @param[out]  buf         buffer to write reply to
+ * @param[in]   len         size of @p buf
+ * @param[in]   ct          content type of the representation
+ * @param[in]   producer    producer of the representation
+ * @param[in]   arg         argument for @p producer
+ *
+ * @returns     size of reply packet on success
+ * @returns     <0 on error
+ */
+ssize_t coap_reply_block2(coap_pkt_t *pkt, unsigned code,
+                          uint8_t *buf, size_t len, unsigned ct,
+                          coap_block_producer_t producer, void *arg);
+
+/**
+ * @brief   Pass the block of a request to a consumer and reply (RFC 7959)
+ *
+ * Calls @p consumer for the payload of @p pkt at the offset given by its
+ * Block1 option, or for the complete payload if there is none. Replies with
+ * 2.31 (Continue) if more blocks follow and with 2.04 (Changed) otherwise,
+ * echoing the Block1 option. Errors of @p consumer are answered with 4.08
+ * (Request Entity Incomplete) for -EINVAL, 4.13 (Request Entity Too Large)
+ * for -ENOSPC and 5.00 (Internal Server Error) for anything else.
+ *
+ * @param[in]   pkt         request to handle
+ * @param[out]  buf         buffer to write reply to
+ * @param[in]   len         size of @p buf
+ * @param[in]   consumer    consumer of the representation
+ * @param[in]   arg         argument for @p consumer
+ *
+ * @returns     size of reply packet on success
+ * @returns     <0 on error
+ */
+ssize_t coap_reply_block1(coap_pkt_t *pkt, uint8_t *buf, size_t len,
+                          coap_block_consumer_t consumer, void *arg);
+
 /**
  * @brief   Builds a CoAP header
  *
@@ -392,6 +534,40 @@ size_t coap_put_option_ct(uint8_t *buf, uint16_t lastonum, uint16_t content_type
  */
 size_t coap_put_option_uri(uint8_t *buf, uint16_t lastonum, const char *uri, uint16_t optnum);
 
+/**
+ * @brief   Insert a Block1 or Block2 option into buffer
+ *
+ * @param[out]  buf         buffer to write to
+ * @param[in]   lastonum    number of previous option (for delta
+ *                          calculation), or 0 if first option
+ * @param[in]   onum        COAP_OPT_BLOCK1 or COAP_OPT_BLOCK2
+ * @param[in]   block       block to write
+ *
+ * @returns     amount of bytes written to @p buf
+ */
+size_t coap_put_option_block(uint8_t *buf, uint16_t lastonum, uint16_t onum,
+                             const coap_block_t *block);
+
+/**
+ * @brief   Start iterating over the options of a parsed packet
+ *
+ * @param[in]   pkt     parsed CoAP packet
+ * @param[out]  opt     iterator position
+ */
+void coap_opt_iter_init(coap_pkt_t *pkt, coap_optpos_t *opt);
+
+/**
+ * @brief   Get the next option of a parsed packet
+ *
+ * @param[in]     pkt   parsed CoAP packet
+ * @param[in,out] opt   iterator position, initialized with
+ *                      coap_opt_iter_init(); holds the option on success
+ *
+ * @returns     true if there is another option
+ * @returns     false at the end of the options
+ */
+bool coap_opt_iter_next(coap_pkt_t *pkt, coap_optpos_t *opt);
+
 /**
  * @brief   Get the CoAP version number
  *
@@ -591,6 +767,107 @@ static inline uint32_t coap_get_observe(coap_pkt_t *pkt)
     return pkt->observe_value;
 }
 
+/**
+ * @brief   Get the size of a block
+ *
+ * @param[in]   szx   block size exponent
+ *
+ * @returns     block size in bytes
+ */
+static inline size_t coap_szx2size(unsigned szx)
+{
+    return 1U << (szx + 4);
+}
+
+/**
+ * @brief   Get the raw value of a Block1 or Block2 option
+ *
+ * @param[in]   block   block to encode
+ *
+ * @returns     option value
+ */
+static inline uint32_t coap_block_value(const coap_block_t *block)
+{
+    return (block->num << 4) | (block->more << 3) | block->szx;
+}
+
+/**
+ * @brief   Decode the raw value of a Block1 or Block2 option
+ *
+ * @param[out]  block   decoded block
+ * @param[in]   value   option value
+ */
+static inline void coap_block_from_value(coap_block_t *block, uint32_t value)
+{
+    block->num = value >> 4;
+    block->more = (value >> 3) & 1;
+    block->szx = value & 0x7;
+}
+
+/**
+ * @brief   Get the Block1 option of a packet
+ *
+ * @param[in]   pkt     CoAP packet
+ * @param[out]  block   Block1 option, unchanged if there is none
+ *
+ * @returns     true if the packet has a Block1 option
+ * @returns     false if not
+ */
+static inline bool coap_get_block1(coap_pkt_t *pkt, coap_block_t *block)
+{
+    if (pkt->block1 == UINT32_MAX) {
+        return false;
+    }
+    coap_block_from_value(block, pkt->block1);
+    return true;
+}
+
+/**
+ * @brief   Get the Block2 option of a packet
+ *
+ * @param[in]   pkt     CoAP packet
+ * @param[out]  block   Block2 option, unchanged if there is none
+ *
+ * @returns     true if the packet has a Block2 option
+ * @returns     false if not
+ */
+static inline bool coap_get_block2(coap_pkt_t *pkt, coap_block_t *block)
+{
+    if (pkt->block2 == UINT32_MAX) {
+        return false;
+    }
+    coap_block_from_value(block, pkt->block2);
+    return true;
+}
+
+/**
+ * @brief   Set the Block1 option of a packet
+ *
+ * Used by gcoap to write the option, nanocoap functions write options
+ * directly.
+ *
+ * @param[out]  pkt     CoAP packet
+ * @param[in]   block   Block1 option, or NULL to remove it
+ */
+static inline void coap_set_block1(coap_pkt_t *pkt, const coap_block_t *block)
+{
+    pkt->block1 = block ? coap_block_value(block) : UINT32_MAX;
+}
+
+/**
+ * @brief   Set the Block2 option of a packet
+ *
+ * Used by gcoap to write the option, nanocoap functions write options
+ * directly.
+ *
+ * @param[out]  pkt     CoAP packet
+ * @param[in]   block   Block2 option, or NULL to remove it
+ */
+static inline void coap_set_block2(coap_pkt_t *pkt, const coap_block_t *block)
+{
+    pkt->block2 = block ? coap_block_value(block) : UINT32_MAX;
+}
+
 /**
  * @brief   Reference to the default .well-known/core handler defined by the
  *          application
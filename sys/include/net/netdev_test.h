@@ -118,6 +118,22 @@ typedef int (*netdev_test_send_cb_t)(netdev_t *dev, const iolist_t *iolist);
 typedef int (*netdev_test_recv_cb_t)(netdev_t *dev, char *buf, int len,
                                      void *info);
 
+/**
+ * @brief   Callback type to handle receive command with I/O vector list
+ *
+ * @param[in] dev       network device descriptor
+ * @param[in] iolist    buffers to write into or `NULL`
+ * @param[out] info     status information for the received packet. Might
+ *                      be of different type for different netdev devices.
+ *                      May be NULL if not needed or applicable
+ *
+ * @return <0 on error
+ * @return number of bytes read
+ */
+typedef int (*netdev_test_recv_iolist_cb_t)(netdev_t *dev,
+                                            const iolist_t *iolist,
+                                            void *info);
+
 /**
  * @brief   Callback type to handle device initialization
  *
@@ -184,6 +200,8 @@ typedef struct {
      */
     netdev_test_send_cb_t send_cb;                  /**< callback to handle send command */
     netdev_test_recv_cb_t recv_cb;                  /**< callback to handle receive command */
+    netdev_test_recv_iolist_cb_t recv_iolist_cb;    /**< callback to handle receive command
+                                                     *   with I/O vector list */
     netdev_test_init_cb_t init_cb;                  /**< callback to handle initialization events */
     netdev_test_isr_cb_t isr_cb;                    /**< callback to handle ISR events */
     netdev_test_get_cb_t get_cbs[NETOPT_NUMOF];     /**< callback to handle get command */
@@ -221,6 +239,23 @@ static inline void netdev_test_set_recv_cb(netdev_test_t *dev,
     mutex_unlock(&dev->mutex);
 }
 
+/**
+ * @brief   override receive callback for I/O vector lists
+ *
+ * @note    As long as this is not set (or set to NULL) the device reports
+ *          @ref netdev_driver_t::recv_iolist "recv_iolist()" as not supported.
+ *
+ * @param[in] dev               a @ref sys_netdev_test device
+ * @param[in] recv_iolist_cb    a receive callback for I/O vector lists
+ */
+static inline void netdev_test_set_recv_iolist_cb(netdev_test_t *dev,
+                                                  netdev_test_recv_iolist_cb_t recv_iolist_cb)
+{
+    mutex_lock(&dev->mutex);
+    dev->recv_iolist_cb = recv_iolist_cb;
+    mutex_unlock(&dev->mutex);
+}
+
 /**
  * @brief   override initialization callback
  *
@@ -51,6 +51,11 @@ typedef struct {
     uint32_t tx_bytes;          /**< sent bytes */
     uint32_t rx_count;          /**< received (data) packets */
     uint32_t rx_bytes;          /**< received bytes */
+    uint32_t rx_batches;        /**< interrupts that delivered at least one
+                                     packet; only counted by devices that
+                                     receive packets in batches */
+    uint32_t rx_batch_max;      /**< largest number of packets delivered by
+                                     a single interrupt */
 } netstats_t;
 
 #ifdef __cplusplus
@@ -114,6 +114,9 @@ extern "C" {
  * @{
  */
 #define SOCK_HAS_IPV6       /**< activate IPv6 support */
+#define SOCK_HAS_ASYNC      /**< activate receive notifications, see
+                             *   sock_udp_set_cb(), sock_ip_set_cb() and
+                             *   sock_tcp_set_cb() */
 /** @} */
 #endif
 
@@ -450,6 +450,34 @@ ssize_t sock_ip_recv(sock_ip_t *sock, void *data, size_t max_len,
 ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
                      uint8_t proto, const sock_ip_ep_t *remote);
 
+#if defined(SOCK_HAS_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Receive notification for a raw IPv4/IPv6 sock object
+ *
+ * @param[in] sock  The sock object a message was received for.
+ * @param[in] arg   The argument given to sock_ip_set_cb().
+ */
+typedef void (*sock_ip_cb_t)(sock_ip_t *sock, void *arg);
+
+/**
+ * @brief   Sets a callback that is called for every message received on a
+ *          sock object
+ *
+ * The callback is called after the message was queued for the sock, so it
+ * can be received with sock_ip_recv() without blocking. It is called from
+ * the context of the network stack, so it must not block.
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @note    Only available with `SOCK_HAS_ASYNC` defined.
+ *
+ * @param[in] sock  A raw IPv4/IPv6 sock object.
+ * @param[in] cb    The callback. May be `NULL` to remove the callback.
+ * @param[in] arg   Argument for @p cb.
+ */
+void sock_ip_set_cb(sock_ip_t *sock, sock_ip_cb_t cb, void *arg);
+#endif
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
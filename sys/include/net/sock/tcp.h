@@ -528,6 +528,93 @@ ssize_t sock_tcp_read(sock_tcp_t *sock, void *data, size_t max_len,
  */
 ssize_t sock_tcp_write(sock_tcp_t *sock, const void *data, size_t len);
 
+#if defined(SOCK_HAS_ASYNC) || defined(DOXYGEN)
+/**
+ * @name    Events of a TCP sock or queue, see sock_tcp_get_events()
+ * @{
+ */
+#define SOCK_TCP_EVENT_READ     (0x01U) /**< sock_tcp_read() does not block */
+#define SOCK_TCP_EVENT_WRITE    (0x02U) /**< connection is established, so it can
+                                         *   be written to */
+#define SOCK_TCP_EVENT_CLOSED   (0x04U) /**< connection is closed, e.g. reset by
+                                         *   the remote end point */
+#define SOCK_TCP_EVENT_ACCEPT   (0x08U) /**< sock_tcp_accept() does not block */
+/** @} */
+
+/**
+ * @brief   Notification for a TCP sock object or queue
+ *
+ * @param[in] arg   The argument given to sock_tcp_set_cb() or
+ *                  sock_tcp_queue_set_cb().
+ */
+typedef void (*sock_tcp_cb_t)(void *arg);
+
+/**
+ * @brief   Sets a callback that is called when the events of a sock object
+ *          may have changed
+ *
+ * The callback is called e.g. after data was received or the connection was
+ * closed, see sock_tcp_get_events(). It is called from the context of the
+ * network stack, so it must not block and should only notify the thread
+ * handling the sock.
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @note    Only available with `SOCK_HAS_ASYNC` defined.
+ *
+ * @param[in] sock  A TCP sock object.
+ * @param[in] cb    The callback. May be `NULL` to remove the callback.
+ * @param[in] arg   Argument for @p cb.
+ */
+void sock_tcp_set_cb(sock_tcp_t *sock, sock_tcp_cb_t cb, void *arg);
+
+/**
+ * @brief   Sets a callback that is called when a connection of a queue may
+ *          have become ready to be accepted
+ *
+ * Like sock_tcp_set_cb(), but for the connections sock_tcp_accept() takes
+ * from @p queue.
+ *
+ * @pre `(queue != NULL)`
+ *
+ * @note    Only available with `SOCK_HAS_ASYNC` defined.
+ *
+ * @param[in] queue A TCP listening queue, see sock_tcp_listen().
+ * @param[in] cb    The callback. May be `NULL` to remove the callback.
+ * @param[in] arg   Argument for @p cb.
+ */
+void sock_tcp_queue_set_cb(sock_tcp_queue_t *queue, sock_tcp_cb_t cb,
+                           void *arg);
+
+/**
+ * @brief   Gets the pending events of a sock object
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @note    Only available with `SOCK_HAS_ASYNC` defined.
+ *
+ * @param[in] sock  A TCP sock object.
+ *
+ * @return  @ref SOCK_TCP_EVENT_READ, @ref SOCK_TCP_EVENT_WRITE and
+ *          @ref SOCK_TCP_EVENT_CLOSED combined.
+ */
+unsigned sock_tcp_get_events(sock_tcp_t *sock);
+
+/**
+ * @brief   Gets the pending events of a listening queue
+ *
+ * @pre `(queue != NULL)`
+ *
+ * @note    Only available with `SOCK_HAS_ASYNC` defined.
+ *
+ * @param[in] queue A TCP listening queue, see sock_tcp_listen().
+ *
+ * @return  @ref SOCK_TCP_EVENT_ACCEPT, if a connection can be accepted.
+ * @return  0 otherwise.
+ */
+unsigned sock_tcp_queue_get_events(sock_tcp_queue_t *queue);
+#endif
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
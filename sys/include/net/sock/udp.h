@@ -273,6 +273,7 @@
 #include <stdlib.h>
 #include <sys/types.h>
 
+#include "iolist.h"
 #include "net/sock.h"
 
 #ifdef __cplusplus
@@ -401,6 +402,40 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep);
 ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                       uint32_t timeout, sock_udp_ep_t *remote);
 
+/**
+ * @brief   Receives a UDP message from a remote end point without copying it
+ *
+ * Lends the buffer of the network stack holding the received data to the
+ * caller, e.g. to parse a message in place. The data may be split into
+ * several chunks: call the function again with the same @p buf_ctx to get
+ * the next chunk, until it returns 0, which releases the buffer.
+ *
+ * @pre `(sock != NULL) && (data != NULL) && (buf_ctx != NULL)`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[out] data     Pointer to the received data within the buffer of
+ *                      the network stack. Set to `NULL` with return value 0.
+ * @param[in,out] buf_ctx   Buffer context of the network stack. Must point
+ *                      to a `NULL` pointer to receive a new message, and
+ *                      then identifies the message until its buffer is
+ *                      released.
+ * @param[in] timeout   Timeout for receive in microseconds, as for
+ *                      sock_udp_recv(). Only used for a new message.
+ * @param[out] remote   Remote end point of the received data. Only set for
+ *                      a new message.
+ *                      May be `NULL`, if it is not required by the application.
+ *
+ * @note    Function blocks if no packet is currently waiting and
+ *          `*buf_ctx == NULL`.
+ *
+ * @return  The number of bytes in the chunk at @p data.
+ * @return  0, if there is no further chunk. The buffer was released.
+ * @return  Any error of sock_udp_recv() but -ENOBUFS, if no new message
+ *          could be received.
+ */
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote);
+
 /**
  * @brief   Sends a UDP message to remote end point
  *
@@ -435,6 +470,121 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote);
 
+/**
+ * @brief   Sends a UDP message gathered from a list of buffers to remote end
+ *          point
+ *
+ * The buffers are written into a single message, e.g. a header and a
+ * payload held by the application in different places, without assembling
+ * them in an intermediate buffer first.
+ *
+ * @pre `((sock != NULL || remote != NULL))`
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`, as for
+ *                      sock_udp_send().
+ * @param[in] snips     List of buffers with the data to send. May be `NULL`
+ *                      to send an empty message.
+ * @param[in] remote    Remote end point for the sent data, as for
+ *                      sock_udp_send().
+ *
+ * @return  The number of bytes sent on success.
+ * @return  Any error of sock_udp_send().
+ */
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote);
+
+/**
+ * @brief   A UDP message for sock_udp_recv_batch() and sock_udp_send_batch()
+ */
+typedef struct {
+    void *data;                 /**< Message data */
+    size_t len;                 /**< Length of sock_udp_msg_t::data. For
+                                 *   sock_udp_recv_batch() the space available
+                                 *   at sock_udp_msg_t::data, which is set to
+                                 *   the number of bytes received. */
+    sock_udp_ep_t *remote;      /**< Remote end point of the message.
+                                 *   May be `NULL`, as the `remote` parameter
+                                 *   of sock_udp_recv() and sock_udp_send() */
+} sock_udp_msg_t;
+
+/**
+ * @brief   Receives multiple UDP messages from remote end points
+ *
+ * Waits like sock_udp_recv() for the first message, and then takes the
+ * messages already received by the sock without waiting, up to @p count.
+ * A burst of messages is thus received with one call and one wake-up of the
+ * calling thread.
+ *
+ * @pre `(sock != NULL) && (msgs != NULL) && (count > 0)`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[in,out] msgs  Buffers for the messages, see sock_udp_msg_t.
+ * @param[in] count     Number of elements in @p msgs.
+ * @param[in] timeout   Timeout for the first message in microseconds, as for
+ *                      sock_udp_recv().
+ *
+ * @note    If receiving a message fails after the first one, the function
+ *          returns the number of messages received before. The failed
+ *          message is dropped as in sock_udp_recv().
+ *
+ * @return  The number of messages received on success.
+ * @return  Any error of sock_udp_recv(), if the first message could not be
+ *          received.
+ */
+int sock_udp_recv_batch(sock_udp_t *sock, sock_udp_msg_t *msgs,
+                        unsigned count, uint32_t timeout);
+
+/**
+ * @brief   Sends multiple UDP messages to remote end points
+ *
+ * Sends the messages in order, and stops at the first one that can't be
+ * sent. Consecutive messages with the same sock_udp_msg_t::remote pointer
+ * may share the work of resolving their end points.
+ *
+ * @pre `((sock != NULL) || (remote of all msgs != NULL)) &&
+ *       (msgs != NULL) && (count > 0)`
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`, as for
+ *                      sock_udp_send().
+ * @param[in] msgs      The messages to send, see sock_udp_msg_t.
+ * @param[in] count     Number of elements in @p msgs.
+ *
+ * @return  The number of messages sent on success.
+ * @return  Any error of sock_udp_send(), if the first message could not be
+ *          sent.
+ */
+int sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                        unsigned count);
+
+#if defined(SOCK_HAS_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Receive notification for a UDP sock object
+ *
+ * @param[in] sock  The sock object a message was received for.
+ * @param[in] arg   The argument given to sock_udp_set_cb().
+ */
+typedef void (*sock_udp_cb_t)(sock_udp_t *sock, void *arg);
+
+/**
+ * @brief   Sets a callback that is called for every message received on a
+ *          sock object
+ *
+ * The callback is called after the message was queued for the sock, so it
+ * can be received with sock_udp_recv() without blocking. It is called from
+ * the context of the network stack, so it must not block and should only
+ * notify the thread handling the sock.
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @note    Only available with `SOCK_HAS_ASYNC` defined.
+ *
+ * @param[in] sock  A UDP sock object.
+ * @param[in] cb    The callback. May be `NULL` to remove the callback.
+ * @param[in] arg   Argument for @p cb.
+ */
+void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *arg);
+#endif
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
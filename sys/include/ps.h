@@ -32,6 +32,18 @@ extern "C" {
  */
 void ps(void);
 
+#if defined(MODULE_SCHEDPROF) || defined(DOXYGEN)
+/**
+ * @brief Print the profiling statistics of all active threads and of the
+ *        interrupts to stdout as comma separated values
+ *
+ * Each record is printed in one line, which starts with the record type
+ * (`thread` or `irq`). The line listing the fields of each record type
+ * starts with `#`. All times are in microseconds.
+ */
+void ps_prof(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_spscrb Single-producer single-consumer ringbuffer
+ * @ingroup     sys
+ * @brief       Lock-free ringbuffer for one producer and one consumer
+ *
+ * Like @ref sys_tsrb, this ringbuffer can be used without locking if there's
+ * only one producer and one consumer, e.g. an ISR and a thread. In addition,
+ * it
+ *
+ * - copies bulk data with `memcpy()` instead of byte by byte,
+ * - gives zero-copy access to the data and the free space of the buffer via
+ *   two contiguous segments (the second one is used when the region wraps
+ *   around the end of the buffer), see spscrb_read_peek() and
+ *   spscrb_write_peek(), and
+ * - uses C11 atomics for the read and write indices, so the data is
+ *   guaranteed to be visible to the consumer before the write index is.
+ *
+ * Functions changing the write position may only be called by the producer,
+ * functions changing the read position only by the consumer.
+ *
+ * @attention   Buffer size must be a power of two!
+ *
+ * @{
+ *
+ * @file
+ * @brief       Single-producer single-consumer ringbuffer definitions
+ */
+
+#ifndef SPSCRB_H
+#define SPSCRB_H
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+/* The stdatomic.h in GCC gives compilation errors with C++
+ * see: https://gcc.gnu.org/bugzilla/show_bug.cgi?id=60932
+ */
+#ifdef __cplusplus
+#include <atomic>
+/* Make the atomics available without namespace specifier */
+using std::atomic_uint;
+using std::atomic_init;
+using std::atomic_load_explicit;
+using std::memory_order_acquire;
+#else
+#include <stdatomic.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Single-producer single-consumer ringbuffer
+ */
+typedef struct {
+    uint8_t *buf;               /**< Buffer to operate on */
+    unsigned size;              /**< Size of buffer, must be power of 2 */
+    atomic_uint reads;          /**< Total number of bytes read */
+    atomic_uint writes;         /**< Total number of bytes written */
+} spscrb_t;
+
+/**
+ * @brief   Contiguous region of a ringbuffer
+ */
+typedef struct {
+    uint8_t *data;              /**< Start of the region */
+    unsigned len;               /**< Length of the region */
+} spscrb_seg_t;
+
+/**
+ * @brief   Static initializer
+ *
+ * @param[in] BUF   Buffer to use, the size is deduced with `sizeof (BUF)`
+ *                  and must be a power of 2
+ */
+#define SPSCRB_INIT(BUF) { (uint8_t *)(BUF), sizeof(BUF), \
+                           ATOMIC_VAR_INIT(0), ATOMIC_VAR_INIT(0) }
+
+/**
+ * @brief   Initialize a ringbuffer
+ *
+ * @param[out] rb       Ringbuffer to initialize
+ * @param[in] buffer    Buffer to use by the ringbuffer
+ * @param[in] bufsize   `sizeof (buffer)`, must be a power of 2
+ */
+static inline void spscrb_init(spscrb_t *rb, void *buffer, unsigned bufsize)
+{
+    assert((bufsize != 0) && ((bufsize & (bufsize - 1)) == 0));
+
+    rb->buf = (uint8_t *)buffer;
+    rb->size = bufsize;
+    atomic_init(&rb->reads, 0);
+    atomic_init(&rb->writes, 0);
+}
+
+/**
+ * @brief   Get number of bytes available for reading
+ *
+ * @param[in] rb    Ringbuffer to operate on
+ *
+ * @return  number of available bytes
+ */
+static inline unsigned spscrb_avail(spscrb_t *rb)
+{
+    return atomic_load_explicit(&rb->writes, memory_order_acquire) -
+           atomic_load_explicit(&rb->reads, memory_order_acquire);
+}
+
+/**
+ * @brief   Get free space in ringbuffer
+ *
+ * @param[in] rb    Ringbuffer to operate on
+ *
+ * @return  number of free bytes
+ */
+static inline unsigned spscrb_free(spscrb_t *rb)
+{
+    return rb->size - spscrb_avail(rb);
+}
+
+/**
+ * @brief   Test if the ringbuffer is empty
+ *
+ * @param[in] rb    Ringbuffer to operate on
+ *
+ * @return  0 if not empty
+ * @return  1 otherwise
+ */
+static inline int spscrb_empty(spscrb_t *rb)
+{
+    return (spscrb_avail(rb) == 0);
+}
+
+/**
+ * @brief   Test if the ringbuffer is full
+ *
+ * @param[in] rb    Ringbuffer to operate on
+ *
+ * @return  0 if not full
+ * @return  1 otherwise
+ */
+static inline int spscrb_full(spscrb_t *rb)
+{
+    return (spscrb_avail(rb) == rb->size);
+}
+
+/**
+ * @brief   Get a byte from the ringbuffer
+ *
+ * @param[in] rb    Ringbuffer to operate on
+ *
+ * @return  byte that has been read
+ * @return  -1 if no byte available
+ */
+int spscrb_get_one(spscrb_t *rb);
+
+/**
+ * @brief   Get bytes from the ringbuffer
+ *
+ * @param[in] rb    Ringbuffer to operate on
+ * @param[out] dst  Buffer to write to
+ * @param[in] n     Maximum number of bytes to write to @p dst
+ *
+ * @return  number of bytes written to @p dst
+ */
+unsigned spscrb_get(spscrb_t *rb, void *dst, unsigned n);
+
+/**
+ * @brief   Add a byte to the ringbuffer
+ *
+ * @param[in] rb    Ringbuffer to operate on
+ * @param[in] c     Byte to add
+ *
+ * @return  0 on success
+ * @return  -1 if no space available
+ */
+int spscrb_add_one(spscrb_t *rb, uint8_t c);
+
+/**
+ * @brief   Add bytes to the ringbuffer
+ *
+ * @param[in] rb    Ringbuffer to operate on
+ * @param[in] src   Buffer to read from
+ * @param[in] n     Maximum number of bytes to read from @p src
+ *
+ * @return  number of bytes read from @p src
+ */
+unsigned spscrb_add(spscrb_t *rb, const void *src, unsigned n);
+
+/**
+ * @brief   Get the data available for reading without copying it
+ *
+ * The data stays in the ringbuffer until it is released with
+ * spscrb_read_commit(). Only the consumer may call this function.
+ *
+ * @param[in] rb    Ringbuffer to operate on
+ * @param[out] seg  The available data. `seg[1]` continues `seg[0]` at the
+ *                  start of the buffer and is empty if the data doesn't
+ *                  wrap around.
+ *
+ * @return  number of available bytes
+ */
+unsigned spscrb_read_peek(spscrb_t *rb, spscrb_seg_t seg[2]);
+
+/**
+ * @brief   Release data that was read with spscrb_read_peek()
+ *
+ * @param[in] rb    Ringbuffer to operate on
+ * @param[in] n     Number of bytes to release, must not exceed the number
+ *                  returned by spscrb_read_peek()
+ */
+void spscrb_read_commit(spscrb_t *rb, unsigned n);
+
+/**
+ * @brief   Get the free space of the ringbuffer to write to it directly
+ *
+ * The written data becomes available for reading with
+ * spscrb_write_commit(). Only the producer may call this function.
+ *
+ * @param[in] rb    Ringbuffer to operate on
+ * @param[out] seg  The free space. `seg[1]` continues `seg[0]` at the start
+ *                  of the buffer and is empty if the space doesn't wrap
+ *                  around.
+ *
+ * @return  number of free bytes
+ */
+unsigned spscrb_write_peek(spscrb_t *rb, spscrb_seg_t seg[2]);
+
+/**
+ * @brief   Make data written to the space from spscrb_write_peek()
+ *          available for reading
+ *
+ * @param[in] rb    Ringbuffer to operate on
+ * @param[in] n     Number of bytes written, must not exceed the number
+ *                  returned by spscrb_write_peek()
+ */
+void spscrb_write_commit(spscrb_t *rb, unsigned n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPSCRB_H */
+/** @} */
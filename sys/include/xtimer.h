@@ -69,6 +69,15 @@ typedef void (*xtimer_callback_t)(void*);
  */
 typedef struct xtimer {
     struct xtimer *next;         /**< reference to next timer in timer lists */
+#if defined(MODULE_XTIMER_WHEEL) || DOXYGEN
+    struct xtimer *prev;         /**< reference to previous timer in timer
+                                      lists (only with `xtimer_wheel`) */
+#endif
+#if defined(MODULE_XTIMER_SLACK) || DOXYGEN
+    uint32_t slack;              /**< ticks the callback may be delayed to
+                                      share an interrupt with other timers
+                                      (only with `xtimer_slack`) */
+#endif
     uint32_t target;             /**< lower 32bit absolute target time */
     uint32_t long_target;        /**< upper 32bit absolute target time */
     xtimer_callback_t callback;  /**< callback function to call when timer
@@ -291,10 +300,70 @@ static inline void xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_
  */
 static inline void xtimer_set(xtimer_t *timer, uint32_t offset);
 
+/**
+ * @brief Set a timer to execute a callback that may be delayed
+ *
+ * Like xtimer_set(), but the callback may be executed up to @p slack
+ * microseconds late. xtimer uses this window to execute the callbacks of
+ * several timers in one timer interrupt: the low-level timer is set to the
+ * earliest point in time at which any timer runs out of slack, and all timers
+ * that expired until then are executed together.
+ *
+ * Without the `xtimer_slack` module, @p slack is ignored and the timer is
+ * set like with xtimer_set().
+ *
+ * @param[in] timer     the timer structure to use.
+ *                      Its xtimer_t::target and xtimer_t::long_target
+ *                      fields need to be initialized with 0 on first use
+ * @param[in] offset    time in microseconds from now specifying that timer's
+ *                      callback's earliest execution time
+ * @param[in] slack     time in microseconds the callback may be delayed
+ */
+static inline void xtimer_set_slack(xtimer_t *timer, uint32_t offset,
+                                    uint32_t slack);
+
+/**
+ * @brief Set a timer that sends a message and may be delayed
+ *
+ * Like xtimer_set_msg(), but the message may be sent up to @p slack
+ * microseconds late, see xtimer_set_slack().
+ *
+ * @param[in] timer         timer struct to work with.
+ *                          Its xtimer_t::target and xtimer_t::long_target
+ *                          fields need to be initialized with 0 on first use.
+ * @param[in] offset        microseconds from now
+ * @param[in] slack         microseconds the message may be delayed
+ * @param[in] msg           ptr to msg that will be sent
+ * @param[in] target_pid    pid the message will be sent to
+ */
+static inline void xtimer_set_msg_slack(xtimer_t *timer, uint32_t offset,
+                                        uint32_t slack, msg_t *msg,
+                                        kernel_pid_t target_pid);
+
+#if defined(MODULE_XTIMER_SLACK) || DOXYGEN
+/**
+ * @brief   Timer interrupt statistics of the `xtimer_slack` module
+ */
+typedef struct {
+    uint32_t wakeups;   /**< timer interrupts that executed callbacks */
+    uint32_t saved;     /**< callbacks executed in a timer interrupt
+                             together with another callback, i.e. the number
+                             of timer interrupts saved */
+} xtimer_slack_stats_t;
+
+/**
+ * @brief   Get the timer interrupt statistics
+ *
+ * @param[out] stats    the current statistics
+ */
+void xtimer_slack_stats(xtimer_slack_stats_t *stats);
+#endif
+
 /**
  * @brief remove a timer
  *
- * @note this function runs in O(n) with n being the number of active timers
+ * @note this function runs in O(n) with n being the number of active timers,
+ *       or in O(1) with the `xtimer_wheel` module
  *
  * @param[in] timer ptr to timer structure that will be removed
  */
@@ -520,6 +589,43 @@ void xtimer_set_timeout_flag(xtimer_t *t, uint32_t timeout);
 #define XTIMER_PERIODIC_RELATIVE (512)
 #endif
 
+#if defined(MODULE_XTIMER_WHEEL) || DOXYGEN
+/**
+ * @name    Timing wheel configuration
+ *
+ * With the `xtimer_wheel` module, timers that are not due within the next
+ * 2^XTIMER_WHEEL_SHIFT ticks are kept in a hierarchical timing wheel instead
+ * of a sorted list. Level `l` of the wheel has 2^XTIMER_WHEEL_BITS slots of
+ * 2^(XTIMER_WHEEL_SHIFT + l * XTIMER_WHEEL_BITS) ticks each.
+ * @{
+ */
+#ifndef XTIMER_WHEEL_SHIFT
+/**
+ * @brief   Width of a slot on the lowest level of the wheel, as power of 2
+ *          in ticks
+ */
+#define XTIMER_WHEEL_SHIFT  (10U)
+#endif
+
+#ifndef XTIMER_WHEEL_BITS
+/**
+ * @brief   Number of slots per level, as power of 2 (at most 5)
+ */
+#define XTIMER_WHEEL_BITS   (5U)
+#endif
+
+#ifndef XTIMER_WHEEL_LEVELS
+/**
+ * @brief   Number of levels of the wheel
+ *
+ * Timers beyond the range of the highest level are kept in an unsorted list
+ * until the wheel reaches them.
+ */
+#define XTIMER_WHEEL_LEVELS (6U)
+#endif
+/** @} */
+#endif /* MODULE_XTIMER_WHEEL */
+
 /*
  * Default xtimer configuration
  */
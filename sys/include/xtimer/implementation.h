@@ -65,6 +65,9 @@ uint64_t _xtimer_now64(void);
 int _xtimer_set_absolute(xtimer_t *timer, uint32_t target);
 void _xtimer_set(xtimer_t *timer, uint32_t offset);
 void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset);
+void _xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack);
+void _xtimer_set_msg_slack(xtimer_t *timer, uint32_t offset, uint32_t slack,
+                           msg_t *msg, kernel_pid_t target_pid);
 void _xtimer_periodic_wakeup(uint32_t *last_wakeup, uint32_t period);
 void _xtimer_set_msg(xtimer_t *timer, uint32_t offset, msg_t *msg, kernel_pid_t target_pid);
 void _xtimer_set_msg64(xtimer_t *timer, uint64_t offset, msg_t *msg, kernel_pid_t target_pid);
@@ -217,6 +220,31 @@ static inline void xtimer_set(xtimer_t *timer, uint32_t offset)
     _xtimer_set(timer, _xtimer_ticks_from_usec(offset));
 }
 
+static inline void xtimer_set_slack(xtimer_t *timer, uint32_t offset,
+                                    uint32_t slack)
+{
+#ifdef MODULE_XTIMER_SLACK
+    _xtimer_set_slack(timer, _xtimer_ticks_from_usec(offset),
+                      _xtimer_ticks_from_usec(slack));
+#else
+    (void)slack;
+    _xtimer_set(timer, _xtimer_ticks_from_usec(offset));
+#endif
+}
+
+static inline void xtimer_set_msg_slack(xtimer_t *timer, uint32_t offset,
+                                        uint32_t slack, msg_t *msg,
+                                        kernel_pid_t target_pid)
+{
+#ifdef MODULE_XTIMER_SLACK
+    _xtimer_set_msg_slack(timer, _xtimer_ticks_from_usec(offset),
+                          _xtimer_ticks_from_usec(slack), msg, target_pid);
+#else
+    (void)slack;
+    _xtimer_set_msg(timer, _xtimer_ticks_from_usec(offset), msg, target_pid);
+#endif
+}
+
 static inline int xtimer_msg_receive_timeout(msg_t *msg, uint32_t timeout)
 {
     return _xtimer_msg_receive_timeout(msg, _xtimer_ticks_from_usec(timeout));
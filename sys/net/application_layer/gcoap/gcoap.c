@@ -19,6 +19,7 @@
  */
 
 #include <errno.h>
+#include "hashes.h"
 #include "net/gcoap.h"
 #include "random.h"
 #include "thread.h"
@@ -26,6 +27,45 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+/* each open request has at most one timeout message queued, in addition to
+ * one GCOAP_MSG_TYPE_OBS message */
+#if GCOAP_MSG_QUEUE_SIZE <= GCOAP_REQ_WAITING_MAX
+#error "GCOAP_MSG_QUEUE_SIZE must be greater than GCOAP_REQ_WAITING_MAX"
+#endif
+
+#if (GCOAP_OBS_HASH_SIZE == 0) || \
+    ((GCOAP_OBS_HASH_SIZE & (GCOAP_OBS_HASH_SIZE - 1)) != 0)
+#error "GCOAP_OBS_HASH_SIZE must be a power of 2"
+#endif
+
+#if GCOAP_WORKERS_NUMOF
+#if (GCOAP_PDU_BUFS_NUMOF == 0) || \
+    ((GCOAP_PDU_BUFS_NUMOF & (GCOAP_PDU_BUFS_NUMOF - 1)) != 0)
+#error "GCOAP_PDU_BUFS_NUMOF must be a power of 2"
+#endif
+
+/* Request passed to a worker thread */
+typedef struct {
+    sock_udp_ep_t remote;               /* Remote endpoint */
+    size_t len;                         /* Length of buf */
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];    /* Request PDU, replaced by response */
+} _worker_req_t;
+#endif
+
+#if GCOAP_RESP_CACHE_SIZE
+/* Cached 2.05 response to a GET request */
+typedef struct {
+    const coap_resource_t *resource;    /* Requested resource; unused if NULL */
+    uint32_t block2;                    /* Block2 option of the request */
+    uint32_t stored;                    /* Time stored, in seconds */
+    uint32_t max_age;                   /* Lifetime in seconds */
+    uint32_t etag;                      /* Hash of options and payload */
+    size_t len;                         /* Length of pdu */
+    uint8_t pdu[GCOAP_PDU_BUF_SIZE];    /* Response without token, ETag and
+                                           Max-Age */
+} _cache_entry_t;
+#endif
+
 /* Internal functions */
 static void *_event_loop(void *arg);
 static void _listen(sock_udp_t *sock);
@@ -35,16 +75,41 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                                                          sock_udp_ep_t *remote);
 static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len);
 static void _expire_request(gcoap_request_memo_t *memo);
+static void _set_resp_timer(gcoap_request_memo_t *memo, uint32_t timeout);
+static void _resp_timer_cb(void *arg);
+static uint16_t _memo_msg_id(gcoap_request_memo_t *memo);
+#if GCOAP_WORKERS_NUMOF
+static int _queue_req(const uint8_t *buf, size_t len,
+                      const sock_udp_ep_t *remote);
+static void *_worker(void *arg);
+#endif
 static bool _endpoints_equal(const sock_udp_ep_t *ep1, const sock_udp_ep_t *ep2);
 static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *pdu,
                            const sock_udp_ep_t *remote);
 static void _find_resource(coap_pkt_t *pdu, coap_resource_t **resource_ptr,
                                             gcoap_listener_t **listener_ptr);
 static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote);
-static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
-                                                       coap_pkt_t *pdu);
+static void _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
+                           coap_pkt_t *pdu, const coap_resource_t *resource);
 static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
                                    const coap_resource_t *resource);
+static gcoap_observe_memo_t **_obs_bucket(const coap_resource_t *resource);
+static void _remove_obs_memo(gcoap_observe_memo_t *memo);
+static uint32_t _obs_value(void);
+static size_t _obs_send(uint8_t *buf, size_t len,
+                        const coap_resource_t *resource);
+static void _obs_timer_cb(void *arg);
+static void _notify_observers(void);
+static size_t _cache_lookup(coap_pkt_t *pdu, uint8_t *buf, size_t len);
+#if GCOAP_RESP_CACHE_SIZE
+static size_t _cache_store(const coap_resource_t *resource, uint32_t block2,
+                           uint32_t max_age, uint8_t *buf, size_t len,
+                           size_t pdu_len);
+static size_t _cache_reply(_cache_entry_t *entry, uint8_t *buf, size_t len,
+                           unsigned code);
+static uint32_t _cache_now(void);
+static uint32_t _cache_age(const _cache_entry_t *entry, uint32_t now);
+#endif
 
 /* Internal variables */
 const coap_resource_t _default_resources[] = {
@@ -54,7 +119,8 @@ const coap_resource_t _default_resources[] = {
 static gcoap_listener_t _default_listener = {
     (coap_resource_t *)&_default_resources[0],
     sizeof(_default_resources) / sizeof(_default_resources[0]),
-    NULL
+    NULL,
+    60      /* changes only when a listener is registered */
 };
 
 static gcoap_state_t _coap_state = {
@@ -65,6 +131,29 @@ static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static char _msg_stack[GCOAP_STACK_SIZE];
 static sock_udp_t _sock;
 
+/* Coalesces notifications requested with gcoap_obs_notify() */
+static xtimer_t _obs_timer = { .callback = _obs_timer_cb };
+static msg_t _obs_msg = { .type = GCOAP_MSG_TYPE_OBS };
+/* true while a GCOAP_MSG_TYPE_OBS message is due or queued */
+static bool _obs_due;
+static uint32_t _obs_last;
+
+#if GCOAP_WORKERS_NUMOF
+static char _worker_stacks[GCOAP_WORKERS_NUMOF][GCOAP_WORKER_STACK_SIZE];
+static _worker_req_t _worker_reqs[GCOAP_PDU_BUFS_NUMOF];
+/* Unused entries of _worker_reqs */
+static mbox_t _free_reqs;
+static msg_t _free_reqs_queue[GCOAP_PDU_BUFS_NUMOF];
+/* Requests waiting for a worker */
+static mbox_t _pending_reqs;
+static msg_t _pending_reqs_queue[GCOAP_PDU_BUFS_NUMOF];
+#endif
+
+#if GCOAP_RESP_CACHE_SIZE
+static _cache_entry_t _cache[GCOAP_RESP_CACHE_SIZE];
+/* Protects _cache; responses are stored by the worker threads, too */
+static mutex_t _cache_lock = MUTEX_INIT;
+#endif
 
 /* Event/Message loop for gcoap _pid thread. */
 static void *_event_loop(void *arg)
@@ -87,13 +176,26 @@ static void *_event_loop(void *arg)
     }
 
     while(1) {
-        res = msg_try_receive(&msg_rcvd);
+        /* Blocks until a message is received on the sock or a response timer
+         * interrupts it; see _resp_timer_cb(). */
+        _listen(&_sock);
 
-        if (res > 0) {
+        while (msg_try_receive(&msg_rcvd) > 0) {
             switch (msg_rcvd.type) {
             case GCOAP_MSG_TYPE_TIMEOUT: {
-                gcoap_request_memo_t *memo = (gcoap_request_memo_t *)msg_rcvd.content.ptr;
-
+                gcoap_request_memo_t *memo =
+                        &_coap_state.open_reqs[msg_rcvd.content.value >> 16];
+                bool expired;
+
+                /* The response may have been handled while the message was
+                 * queued, and the memo reused for another request. */
+                mutex_lock(&_coap_state.lock);
+                expired = (memo->state == GCOAP_MEMO_WAIT)
+                        && (_memo_msg_id(memo) == (msg_rcvd.content.value & 0xffff));
+                mutex_unlock(&_coap_state.lock);
+                if (!expired) {
+                    break;
+                }
                 /* no retries remaining */
                 if ((memo->send_limit == GCOAP_SEND_LIMIT_NON)
                         || (memo->send_limit == 0)) {
@@ -111,8 +213,7 @@ static void *_event_loop(void *arg)
                                                   memo->msg.data.pdu_len,
                                                   &memo->remote_ep);
                     if (bytes > 0) {
-                        xtimer_set_msg(&memo->response_timer, timeout,
-                                       &memo->timeout_msg, _pid);
+                        _set_resp_timer(memo, timeout);
                     }
                     else {
                         DEBUG("gcoap: sock resend failed: %d\n", (int)bytes);
@@ -121,17 +222,121 @@ static void *_event_loop(void *arg)
                 }
                 break;
             }
+            case GCOAP_MSG_TYPE_OBS:
+                _notify_observers();
+                break;
             default:
                 break;
             }
         }
+    }
 
-        _listen(&_sock);
+    return 0;
+}
+
+/*
+ * Starts the response timer for memo. The timeout message identifies the memo
+ * by its index, and the request by its message ID.
+ */
+static void _set_resp_timer(gcoap_request_memo_t *memo, uint32_t timeout)
+{
+    uint32_t idx = memo - &_coap_state.open_reqs[0];
+
+    memo->timeout_msg.type          = GCOAP_MSG_TYPE_TIMEOUT;
+    memo->timeout_msg.content.value = (idx << 16) | _memo_msg_id(memo);
+    memo->response_timer.callback = _resp_timer_cb;
+    memo->response_timer.arg      = memo;
+    xtimer_set(&memo->response_timer, timeout);
+}
+
+/*
+ * Response timer callback. Queues the timeout message for the gcoap thread,
+ * and then interrupts its wait for a message on the sock, so the timeout is
+ * handled without delay.
+ */
+static void _resp_timer_cb(void *arg)
+{
+    gcoap_request_memo_t *memo = arg;
+    msg_t mbox_msg = { .type = GCOAP_MSG_TYPE_INTR, .content = { .value = 0 } };
+
+    /* xtimer_set() runs the callback in thread context for short offsets, so
+     * use msg_try_send(), which works in both contexts */
+    if (msg_try_send(&memo->timeout_msg, _pid) != 1) {
+        DEBUG("gcoap: can't queue timeout msg\n");
     }
+    /* If the mbox is full, the gcoap thread is busy with the messages in it
+     * and handles the timeout afterwards. */
+    mbox_try_put(&_sock.reg.mbox, &mbox_msg);
+}
+
+/* Returns the message ID of the request memo is waiting for. */
+static uint16_t _memo_msg_id(gcoap_request_memo_t *memo)
+{
+    coap_hdr_t *hdr;
 
+    if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
+        hdr = (coap_hdr_t *)&memo->msg.hdr_buf[0];
+    }
+    else {
+        hdr = (coap_hdr_t *)memo->msg.data.pdu_buf;
+    }
+    return ntohs(hdr->id);
+}
+
+#if GCOAP_WORKERS_NUMOF
+/*
+ * Copies a request into a free buffer and queues it for the workers.
+ *
+ * return 0 on success, or -ENOMEM if all buffers are in use
+ */
+static int _queue_req(const uint8_t *buf, size_t len,
+                      const sock_udp_ep_t *remote)
+{
+    msg_t msg;
+
+    if (!mbox_try_get(&_free_reqs, &msg)) {
+        return -ENOMEM;
+    }
+    _worker_req_t *req = msg.content.ptr;
+    memcpy(req->buf, buf, len);
+    req->len = len;
+    memcpy(&req->remote, remote, sizeof(sock_udp_ep_t));
+    /* never blocks; the mbox has space for all requests */
+    mbox_put(&_pending_reqs, &msg);
     return 0;
 }
 
+/* Worker thread; runs the resource handlers for queued requests. */
+static void *_worker(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        msg_t msg;
+        coap_pkt_t pdu;
+
+        mbox_get(&_pending_reqs, &msg);
+        _worker_req_t *req = msg.content.ptr;
+
+        /* parsed successfully already by the gcoap thread */
+        coap_parse(&pdu, req->buf, req->len);
+        ssize_t pdu_len = (ssize_t)_handle_req(&pdu, req->buf, sizeof(req->buf),
+                                               &req->remote);
+        if (pdu_len > 0) {
+            ssize_t bytes = sock_udp_send(&_sock, req->buf, pdu_len,
+                                          &req->remote);
+            if (bytes <= 0) {
+                DEBUG("gcoap: send response failed: %d\n", (int)bytes);
+            }
+        }
+        /* never blocks; the mbox has space for all requests */
+        mbox_put(&_free_reqs, &msg);
+    }
+
+    return NULL;
+}
+#endif
+
 /* Listen for an incoming CoAP message. */
 static void _listen(sock_udp_t *sock)
 {
@@ -139,19 +344,17 @@ static void _listen(sock_udp_t *sock)
     uint8_t buf[GCOAP_PDU_BUF_SIZE];
     sock_udp_ep_t remote;
     gcoap_request_memo_t *memo = NULL;
-    uint8_t open_reqs = gcoap_op_state();
-
-    /* We expect a -EINTR response here when unlimited waiting (SOCK_NO_TIMEOUT)
-     * is interrupted when sending a message in gcoap_req_send2(). While a
-     * request is outstanding, sock_udp_recv() is called here with limited
-     * waiting so the request's timeout can be handled in a timely manner in
-     * _event_loop(). */
-    ssize_t res = sock_udp_recv(sock, buf, sizeof(buf),
-                                open_reqs > 0 ? GCOAP_RECV_TIMEOUT : SOCK_NO_TIMEOUT,
+
+    /* We expect an -EINVAL response here when waiting is interrupted by a
+     * GCOAP_MSG_TYPE_INTR message from a response timer. */
+    ssize_t res = sock_udp_recv(sock, buf, sizeof(buf), SOCK_NO_TIMEOUT,
                                 &remote);
+#if GCOAP_WORKERS_NUMOF
+    size_t msg_len = res;
+#endif
     if (res <= 0) {
 #if ENABLE_DEBUG
-        if (res < 0 && res != -ETIMEDOUT) {
+        if (res < 0 && res != -EINVAL) {
             DEBUG("gcoap: udp recv failure: %d\n", res);
         }
 #endif
@@ -176,7 +379,23 @@ static void _listen(sock_udp_t *sock)
     case COAP_CLASS_REQ:
         if (coap_get_type(&pdu) == COAP_TYPE_NON
                 || coap_get_type(&pdu) == COAP_TYPE_CON) {
-            size_t pdu_len = _handle_req(&pdu, buf, sizeof(buf), &remote);
+            /* a cached response doesn't need a worker */
+            size_t pdu_len = _cache_lookup(&pdu, buf, sizeof(buf));
+#if GCOAP_WORKERS_NUMOF
+            if (pdu_len == 0) {
+                if (_queue_req(buf, msg_len, &remote) == 0) {
+                    break;
+                }
+                /* all buffers in use; client may retry later */
+                DEBUG("gcoap: no buffer for request\n");
+                pdu_len = gcoap_response(&pdu, buf, sizeof(buf),
+                                         COAP_CODE_SERVICE_UNAVAILABLE);
+            }
+#else
+            if (pdu_len == 0) {
+                pdu_len = _handle_req(&pdu, buf, sizeof(buf), &remote);
+            }
+#endif
             if (pdu_len > 0) {
                 ssize_t bytes = sock_udp_send(sock, buf, pdu_len, &remote);
                 if (bytes <= 0) {
@@ -240,23 +459,29 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
     gcoap_listener_t *listener;
     sock_udp_ep_t *observer    = NULL;
     gcoap_observe_memo_t *memo = NULL;
-    gcoap_observe_memo_t *resource_memo = NULL;
 
     _find_resource(pdu, &resource, &listener);
     if (resource == NULL) {
         return gcoap_response(pdu, buf, len, COAP_CODE_PATH_NOT_FOUND);
     }
-    else {
-        /* used below to ensure a memo not already recorded for the resource */
-        _find_obs_memo_resource(&resource_memo, resource);
+#if GCOAP_RESP_CACHE_SIZE
+    /* read before the handler overwrites the request */
+    uint32_t max_age = listener->max_age;
+    uint32_t block2  = pdu->block2;
+    if ((coap_get_code_detail(pdu) != COAP_METHOD_GET) || coap_has_observe(pdu)) {
+        max_age = 0;
     }
+#endif
+
+    /* requests may be handled concurrently by worker threads */
+    mutex_lock(&_coap_state.lock);
 
     if (coap_get_observe(pdu) == COAP_OBS_REGISTER) {
-        int empty_slot = _find_obs_memo(&memo, remote, pdu);
+        _find_obs_memo(&memo, remote, pdu, resource);
         /* record observe memo */
         if (memo == NULL) {
-            if (empty_slot >= 0 && resource_memo == NULL) {
-
+            memo = _coap_state.obs_unused;
+            if (memo != NULL) {
                 int obs_slot = _find_observer(&observer, remote);
                 /* cache new observer */
                 if (observer == NULL) {
@@ -265,61 +490,310 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                         memcpy(observer, remote, sizeof(sock_udp_ep_t));
                     } else {
                         DEBUG("gcoap: can't register observer\n");
+                        memo = NULL;
                     }
                 }
-                if (observer != NULL) {
-                    memo = &_coap_state.observe_memos[empty_slot];
-                }
             }
-            if (memo == NULL) {
+            if (memo != NULL) {
+                gcoap_observe_memo_t **bucket = _obs_bucket(resource);
+
+                _coap_state.obs_unused = memo->next;
+                memo->next     = *bucket;
+                *bucket        = memo;
+                memo->observer = observer;
+            }
+            else {
                 coap_clear_observe(pdu);
                 DEBUG("gcoap: can't register observe memo\n");
             }
         }
         if (memo != NULL) {
-            memo->observer  = observer;
             memo->resource  = resource;
+            memo->state     = GCOAP_OBS_MEMO_IDLE;
             memo->token_len = coap_get_token_len(pdu);
             if (memo->token_len) {
                 memcpy(&memo->token[0], pdu->token, memo->token_len);
             }
             DEBUG("gcoap: Registered observer for: %s\n", memo->resource->path);
             /* generate initial notification value */
-            uint32_t now       = xtimer_now_usec();
-            pdu->observe_value = (now >> GCOAP_OBS_TICK_EXPONENT) & 0xFFFFFF;
+            pdu->observe_value = _obs_value();
         }
 
     } else if (coap_get_observe(pdu) == COAP_OBS_DEREGISTER) {
-        _find_obs_memo(&memo, remote, pdu);
+        _find_obs_memo(&memo, remote, pdu, resource);
         /* clear memo, and clear observer if no other memos */
         if (memo != NULL) {
             DEBUG("gcoap: Deregistering observer for: %s\n", memo->resource->path);
-            memo->observer = NULL;
-            memo           = NULL;
-            _find_obs_memo(&memo, remote, NULL);
-            if (memo == NULL) {
-                _find_observer(&observer, remote);
-                if (observer != NULL) {
-                    observer->family = AF_UNSPEC;
+            observer = memo->observer;
+            _remove_obs_memo(memo);
+            for (memo = &_coap_state.observe_memos[0];
+                 memo < &_coap_state.observe_memos[GCOAP_OBS_REGISTRATIONS_MAX];
+                 memo++) {
+                if (memo->observer == observer) {
+                    break;
                 }
             }
+            if (memo == &_coap_state.observe_memos[GCOAP_OBS_REGISTRATIONS_MAX]) {
+                observer->family = AF_UNSPEC;
+            }
         }
         coap_clear_observe(pdu);
 
     } else if (coap_has_observe(pdu)) {
         /* bogus request; don't respond */
+        mutex_unlock(&_coap_state.lock);
         DEBUG("gcoap: Observe value unexpected: %" PRIu32 "\n", coap_get_observe(pdu));
         return -1;
     }
+    mutex_unlock(&_coap_state.lock);
 
     ssize_t pdu_len = resource->handler(pdu, buf, len, resource->context);
     if (pdu_len < 0) {
         pdu_len = gcoap_response(pdu, buf, len,
                                  COAP_CODE_INTERNAL_SERVER_ERROR);
     }
+#if GCOAP_RESP_CACHE_SIZE
+    else if (max_age && pdu_len) {
+        pdu_len = _cache_store(resource, block2, max_age, buf, len, pdu_len);
+    }
+#endif
     return pdu_len;
 }
 
+/*
+ * Writes the cached response for a GET request, if any, replacing the request
+ * in buf.
+ *
+ * return length of response pdu, or 0 if not cached
+ */
+static size_t _cache_lookup(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+{
+#if GCOAP_RESP_CACHE_SIZE
+    coap_resource_t *resource;
+    gcoap_listener_t *listener;
+
+    if ((coap_get_code_detail(pdu) != COAP_METHOD_GET) || coap_has_observe(pdu)) {
+        return 0;
+    }
+    _find_resource(pdu, &resource, &listener);
+    if ((resource == NULL) || (listener->max_age == 0)) {
+        return 0;
+    }
+
+    size_t pdu_len = 0;
+    uint32_t now = _cache_now();
+
+    mutex_lock(&_cache_lock);
+    for (_cache_entry_t *entry = &_cache[0];
+         entry < &_cache[GCOAP_RESP_CACHE_SIZE]; entry++) {
+        if ((entry->resource != resource) || (entry->block2 != pdu->block2)
+                || (_cache_age(entry, now) == UINT32_MAX)) {
+            continue;
+        }
+        /* the client may revalidate its copy of the response */
+        unsigned code = COAP_CODE_CONTENT;
+        coap_optpos_t opt;
+        coap_opt_iter_init(pdu, &opt);
+        while (coap_opt_iter_next(pdu, &opt)) {
+            if ((opt.onum == COAP_OPT_ETAG) && (opt.len == sizeof(entry->etag))
+                    && (memcmp(opt.value, &entry->etag, opt.len) == 0)) {
+                code = COAP_CODE_VALID;
+                break;
+            }
+        }
+        pdu_len = _cache_reply(entry, buf, len, code);
+        DEBUG("gcoap: cached response for %s: %u\n", resource->path,
+              (unsigned)pdu_len);
+        break;
+    }
+    mutex_unlock(&_cache_lock);
+
+    return pdu_len;
+#else
+    (void)pdu;
+    (void)buf;
+    (void)len;
+    return 0;
+#endif
+}
+
+#if GCOAP_RESP_CACHE_SIZE
+/* Time in seconds for cache entries */
+static uint32_t _cache_now(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC);
+}
+
+/* Age of a cache entry in seconds; UINT32_MAX if unused or expired */
+static uint32_t _cache_age(const _cache_entry_t *entry, uint32_t now)
+{
+    uint32_t age = now - entry->stored;
+
+    if ((entry->resource == NULL) || (age >= entry->max_age)) {
+        return UINT32_MAX;
+    }
+    return age;
+}
+
+/*
+ * Stores a 2.05 response from a resource handler in the cache, and writes it
+ * again from there, so it includes ETag and Max-Age.
+ *
+ * return length of response pdu in buf
+ */
+static size_t _cache_store(const coap_resource_t *resource, uint32_t block2,
+                           uint32_t max_age, uint8_t *buf, size_t len,
+                           size_t pdu_len)
+{
+    coap_pkt_t resp;
+
+    if ((coap_parse(&resp, buf, pdu_len) < 0)
+            || (coap_get_code_raw(&resp) != COAP_CODE_CONTENT)) {
+        return pdu_len;
+    }
+
+    mutex_lock(&_cache_lock);
+    /* replace an entry for the same request, or else an unused, expired or
+     * the oldest one */
+    uint32_t now = _cache_now();
+    _cache_entry_t *entry = NULL;
+    for (_cache_entry_t *e = &_cache[0]; e < &_cache[GCOAP_RESP_CACHE_SIZE];
+         e++) {
+        if ((e->resource == resource) && (e->block2 == block2)) {
+            entry = e;
+            break;
+        }
+        if ((entry == NULL) || (_cache_age(e, now) > _cache_age(entry, now))) {
+            entry = e;
+        }
+    }
+
+    /* copy the response without token, ETag and Max-Age */
+    uint8_t *pos = entry->pdu + coap_build_hdr((coap_hdr_t *)entry->pdu,
+                                               coap_get_type(&resp), NULL, 0,
+                                               COAP_CODE_CONTENT, 0);
+    uint16_t lastonum = 0;
+    coap_optpos_t opt;
+    coap_opt_iter_init(&resp, &opt);
+    while (coap_opt_iter_next(&resp, &opt)) {
+        if (opt.onum == COAP_OPT_MAX_AGE) {
+            /* the handler knows best */
+            max_age = 0;
+            for (size_t i = 0; i < opt.len; i++) {
+                max_age = (max_age << 8) | opt.value[i];
+            }
+        }
+        else if (opt.onum != COAP_OPT_ETAG) {
+            pos += coap_put_option(pos, lastonum, opt.onum, opt.value, opt.len);
+            lastonum = opt.onum;
+        }
+    }
+    /* fits into entry->pdu; the header has no token, and the options don't
+     * grow without ETag and Max-Age */
+    if (resp.payload_len) {
+        *pos++ = GCOAP_PAYLOAD_MARKER;
+        memcpy(pos, resp.payload, resp.payload_len);
+        pos += resp.payload_len;
+    }
+    entry->len = pos - entry->pdu;
+    entry->etag = fnv_hash(entry->pdu + sizeof(coap_hdr_t),
+                           entry->len - sizeof(coap_hdr_t));
+    entry->resource = (max_age != 0) ? resource : NULL;
+    entry->block2 = block2;
+    entry->stored = now;
+    entry->max_age = max_age;
+
+    if (entry->resource) {
+        size_t cached_len = _cache_reply(entry, buf, len, COAP_CODE_CONTENT);
+        if (cached_len) {
+            pdu_len = cached_len;
+        }
+    }
+    mutex_unlock(&_cache_lock);
+
+    return pdu_len;
+}
+
+/*
+ * Writes a response from a cache entry into buf, which holds the request or
+ * the response from the handler. Keeps token and message ID of buf.
+ *
+ * Caller must hold _cache_lock.
+ *
+ * return length of response pdu, or 0 if it doesn't fit into buf
+ */
+static size_t _cache_reply(_cache_entry_t *entry, uint8_t *buf, size_t len,
+                           unsigned code)
+{
+    coap_pkt_t cached;
+    coap_hdr_t *hdr = (coap_hdr_t *)buf;
+    uint8_t *pos = hdr->data + (hdr->ver_t_tkl & 0xf);
+    uint32_t max_age = htonl(entry->max_age - (_cache_now() - entry->stored));
+    unsigned max_age_len = 4;
+
+    /* ETag and Max-Age add at most 5 bytes each */
+    if (((size_t)(pos - buf) + entry->len - sizeof(coap_hdr_t) + 10) > len) {
+        return 0;
+    }
+    /* parsed successfully already when stored */
+    coap_parse(&cached, entry->pdu, entry->len);
+
+    /* piggybacked response to a CON request */
+    if (((hdr->ver_t_tkl & 0x30) >> 4) != COAP_TYPE_NON) {
+        hdr->ver_t_tkl = (hdr->ver_t_tkl & ~0x30) | (COAP_TYPE_ACK << 4);
+    }
+    hdr->code = code;
+
+    while ((max_age_len > 0) && (((uint8_t *)&max_age)[4 - max_age_len] == 0)) {
+        max_age_len--;
+    }
+
+    /* insert ETag and Max-Age in order of option numbers */
+    uint16_t lastonum = 0;
+    coap_optpos_t opt;
+    coap_opt_iter_init(&cached, &opt);
+    bool more = coap_opt_iter_next(&cached, &opt);
+    while (lastonum < COAP_OPT_MAX_AGE) {
+        if (lastonum < COAP_OPT_ETAG) {
+            if (!more || (opt.onum > COAP_OPT_ETAG)) {
+                pos += coap_put_option(pos, lastonum, COAP_OPT_ETAG,
+                                       (uint8_t *)&entry->etag,
+                                       sizeof(entry->etag));
+                lastonum = COAP_OPT_ETAG;
+                continue;
+            }
+        }
+        else if (!more || (opt.onum > COAP_OPT_MAX_AGE)) {
+            pos += coap_put_option(pos, lastonum, COAP_OPT_MAX_AGE,
+                                   (uint8_t *)&max_age + (4 - max_age_len),
+                                   max_age_len);
+            lastonum = COAP_OPT_MAX_AGE;
+            continue;
+        }
+        /* 2.03 (Valid) updates only the options above */
+        if (code == COAP_CODE_CONTENT) {
+            pos += coap_put_option(pos, lastonum, opt.onum, opt.value, opt.len);
+            lastonum = opt.onum;
+        }
+        more = coap_opt_iter_next(&cached, &opt);
+    }
+    if (code == COAP_CODE_VALID) {
+        return pos - buf;
+    }
+    while (more) {
+        pos += coap_put_option(pos, lastonum, opt.onum, opt.value, opt.len);
+        lastonum = opt.onum;
+        more = coap_opt_iter_next(&cached, &opt);
+    }
+    if (cached.payload_len) {
+        *pos++ = GCOAP_PAYLOAD_MARKER;
+        memcpy(pos, cached.payload, cached.payload_len);
+        pos += cached.payload_len;
+    }
+    return pos - buf;
+}
+#endif
+
 /*
  * Searches listener registrations for the resource matching the path in a PDU.
  *
@@ -334,28 +808,15 @@ static void _find_resource(coap_pkt_t *pdu, coap_resource_t **resource_ptr,
     /* Find path for CoAP msg among listener resources and execute callback. */
     gcoap_listener_t *listener = _coap_state.listeners;
     while (listener) {
-        coap_resource_t *resource = listener->resources;
-        for (size_t i = 0; i < listener->resources_len; i++) {
-            if (i) {
-                resource++;
-            }
-            if (! (resource->methods & method_flag)) {
-                continue;
-            }
-
-            int res = strcmp((char *)&pdu->url[0], resource->path);
-            if (res > 0) {
-                continue;
-            }
-            else if (res < 0) {
-                /* resources expected in alphabetical order */
-                break;
-            }
-            else {
-                *resource_ptr = resource;
-                *listener_ptr = listener;
-                return;
-            }
+        /* resources expected in alphabetical order */
+        const coap_resource_t *resource = coap_find_resource(listener->resources,
+                                                             listener->resources_len,
+                                                             (char *)&pdu->url[0],
+                                                             method_flag);
+        if (resource) {
+            *resource_ptr = (coap_resource_t *)resource;
+            *listener_ptr = listener;
+            return;
         }
         listener = listener->next;
     }
@@ -520,10 +981,27 @@ static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len)
 
     /* Uri-query for requests */
     if (coap_get_code_class(pdu) == COAP_CLASS_REQ) {
-        bufpos += coap_put_option_uri(bufpos, last_optnum, (char *)pdu->qs,
-                                      COAP_OPT_URI_QUERY);
+        size_t qs_len = coap_put_option_uri(bufpos, last_optnum,
+                                            (char *)pdu->qs,
+                                            COAP_OPT_URI_QUERY);
+        if (qs_len) {
+            bufpos += qs_len;
+            last_optnum = COAP_OPT_URI_QUERY;
+        }
+    }
+
+    /* Block2 and Block1 for block-wise transfers */
+    coap_block_t block;
+    if (coap_get_block2(pdu, &block)) {
+        bufpos += coap_put_option_block(bufpos, last_optnum, COAP_OPT_BLOCK2,
+                                        &block);
+        last_optnum = COAP_OPT_BLOCK2;
+    }
+    if (coap_get_block1(pdu, &block)) {
+        bufpos += coap_put_option_block(bufpos, last_optnum, COAP_OPT_BLOCK1,
+                                        &block);
         /* uncomment when further options are added below ... */
-        /* last_optnum = COAP_OPT_URI_QUERY; */
+        /* last_optnum = COAP_OPT_BLOCK1; */
     }
 
     /* write payload marker */
@@ -582,48 +1060,34 @@ static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote)
  *
  * memo[out] -- Registered observe memo, or NULL if not found
  * remote[in] -- Endpoint for address to match
- * pdu[in] -- PDU for token to match, or NULL to match only on remote address
- *
- * return Index of empty slot, suitable for registering new memo; or -1 if no
- *        empty slots. Undefined if memo found.
+ * pdu[in] -- PDU for token to match
+ * resource[in] -- Observed resource to match
  */
-static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
-                                                       coap_pkt_t *pdu)
+static void _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
+                           coap_pkt_t *pdu, const coap_resource_t *resource)
 {
-    int empty_slot = -1;
-    *memo          = NULL;
+    *memo = NULL;
 
     sock_udp_ep_t *remote_observer = NULL;
     _find_observer(&remote_observer, remote);
+    if (remote_observer == NULL) {
+        return;
+    }
 
-    for (unsigned i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
-        if (_coap_state.observe_memos[i].observer == NULL) {
-            empty_slot = i;
-            continue;
-        }
-
-        if (_coap_state.observe_memos[i].observer == remote_observer) {
-            if (pdu == NULL) {
-                *memo = &_coap_state.observe_memos[i];
-                break;
-            }
-
-            if (_coap_state.observe_memos[i].token_len == coap_get_token_len(pdu)) {
-                unsigned cmplen = _coap_state.observe_memos[i].token_len;
-                if (cmplen &&
-                        memcmp(&_coap_state.observe_memos[i].token[0], &pdu->token[0],
-                                                                       cmplen) == 0) {
-                    *memo = &_coap_state.observe_memos[i];
-                    break;
-                }
-            }
+    unsigned cmplen = coap_get_token_len(pdu);
+    for (gcoap_observe_memo_t *m = *_obs_bucket(resource); m; m = m->next) {
+        if ((m->resource == resource) && (m->observer == remote_observer)
+                && (m->token_len == cmplen)
+                && (memcmp(&m->token[0], pdu->token, cmplen) == 0)) {
+            *memo = m;
+            break;
         }
     }
-    return empty_slot;
 }
 
 /*
- * Find registered observe memo for a resource.
+ * Find registered observe memo for a resource. If there are several, finds
+ * the one with the longest token.
  *
  * memo[out] -- Registered observe memo, or NULL if not found
  * resource[in] -- Resource to match
@@ -632,11 +1096,173 @@ static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
                                    const coap_resource_t *resource)
 {
     *memo = NULL;
-    for (int i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
-        if (_coap_state.observe_memos[i].observer != NULL
-                && _coap_state.observe_memos[i].resource == resource) {
-            *memo = &_coap_state.observe_memos[i];
-            break;
+    for (gcoap_observe_memo_t *m = *_obs_bucket(resource); m; m = m->next) {
+        if ((m->resource == resource)
+                && ((*memo == NULL) || (m->token_len > (*memo)->token_len))) {
+            *memo = m;
+        }
+    }
+}
+
+/* Hash bucket for the observe memos of a resource. */
+static gcoap_observe_memo_t **_obs_bucket(const coap_resource_t *resource)
+{
+    /* resources are mostly stored in arrays */
+    uintptr_t hash = (uintptr_t)resource / sizeof(coap_resource_t);
+    return &_coap_state.obs_buckets[hash & (GCOAP_OBS_HASH_SIZE - 1)];
+}
+
+/* Unlinks an observe memo from its hash bucket and marks it unused. */
+static void _remove_obs_memo(gcoap_observe_memo_t *memo)
+{
+    gcoap_observe_memo_t **prev = _obs_bucket(memo->resource);
+
+    while (*prev != memo) {
+        prev = &(*prev)->next;
+    }
+    *prev = memo->next;
+
+    memo->observer = NULL;
+    memo->state    = GCOAP_OBS_MEMO_UNUSED;
+    memo->next     = _coap_state.obs_unused;
+    _coap_state.obs_unused = memo;
+}
+
+/* Observe value for a new notification. */
+static uint32_t _obs_value(void)
+{
+    return (xtimer_now_usec() >> GCOAP_OBS_TICK_EXPONENT) & 0xFFFFFF;
+}
+
+/*
+ * Sends a notification to all observers of a resource. The notification
+ * header must hold the longest token of the observers. For shorter tokens,
+ * the header is rewritten so it ends at the same position, and the packet is
+ * sent from there, so the options and payload are never moved.
+ *
+ * Must be called with _coap_state.lock held.
+ *
+ * return length of the packet sent to the last observer, or 0 if not sent
+ */
+static size_t _obs_send(uint8_t *buf, size_t len,
+                        const coap_resource_t *resource)
+{
+    coap_hdr_t *hdr = (coap_hdr_t *)buf;
+    unsigned type   = (hdr->ver_t_tkl & 0x30) >> 4;
+    unsigned code   = hdr->code;
+    unsigned tkl    = hdr->ver_t_tkl & 0xf;
+    size_t sent     = 0;
+
+    for (gcoap_observe_memo_t *m = *_obs_bucket(resource); m; m = m->next) {
+        if (m->resource != resource) {
+            continue;
+        }
+        m->state = GCOAP_OBS_MEMO_IDLE;
+        if (m->token_len > tkl) {
+            DEBUG("gcoap: notification header too short for token\n");
+            continue;
+        }
+
+        unsigned shift = tkl - m->token_len;
+        uint16_t msgid = (uint16_t)atomic_fetch_add(&_coap_state.next_message_id, 1);
+        coap_build_hdr((coap_hdr_t *)(buf + shift), type, &m->token[0],
+                       m->token_len, code, msgid);
+
+        ssize_t bytes = sock_udp_send(&_sock, buf + shift, len - shift,
+                                      m->observer);
+        if (bytes > 0) {
+            sent = bytes;
+        }
+        else {
+            DEBUG("gcoap: sending notification failed: %d\n", (int)bytes);
+        }
+    }
+    return sent;
+}
+
+/*
+ * Observe timer callback. Queues the GCOAP_MSG_TYPE_OBS message for the
+ * gcoap thread, and interrupts its wait for a message on the sock.
+ */
+static void _obs_timer_cb(void *arg)
+{
+    msg_t mbox_msg = { .type = GCOAP_MSG_TYPE_INTR, .content = { .value = 0 } };
+    (void)arg;
+
+    /* xtimer_set() runs the callback in thread context for short offsets, so
+     * use msg_try_send(), which works in both contexts */
+    if (msg_try_send(&_obs_msg, _pid) != 1) {
+        DEBUG("gcoap: can't queue observe msg\n");
+    }
+    mbox_try_put(&_sock.reg.mbox, &mbox_msg);
+}
+
+/*
+ * Sends notifications for all resources with pending observe memos, see
+ * gcoap_obs_notify(). The resource handler creates the notification for the
+ * memo with the longest token.
+ *
+ * The pending resources are collected first, so the handlers run without
+ * _coap_state.lock held and may use the gcoap API themselves.
+ */
+static void _notify_observers(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    struct {
+        coap_resource_t *resource;
+        uint8_t token[GCOAP_TOKENLEN_MAX];
+        unsigned token_len;
+    } pending[GCOAP_OBS_REGISTRATIONS_MAX];
+    unsigned pending_numof = 0;
+
+    mutex_lock(&_coap_state.lock);
+    _obs_due  = false;
+    _obs_last = xtimer_now_usec();
+    for (unsigned i = 0; i < GCOAP_OBS_HASH_SIZE; i++) {
+        for (gcoap_observe_memo_t *m = _coap_state.obs_buckets[i]; m; m = m->next) {
+            if (m->state != GCOAP_OBS_MEMO_PENDING) {
+                continue;
+            }
+
+            coap_resource_t *resource = m->resource;
+            gcoap_observe_memo_t *memo;
+            _find_obs_memo_resource(&memo, resource);
+
+            pending[pending_numof].resource = resource;
+            memcpy(pending[pending_numof].token, memo->token, memo->token_len);
+            pending[pending_numof].token_len = memo->token_len;
+            pending_numof++;
+            /* the notification goes to all observers of the resource */
+            for (memo = m; memo; memo = memo->next) {
+                if (memo->resource == resource) {
+                    memo->state = GCOAP_OBS_MEMO_IDLE;
+                }
+            }
+        }
+    }
+    mutex_unlock(&_coap_state.lock);
+
+    for (unsigned i = 0; i < pending_numof; i++) {
+        coap_resource_t *resource = pending[i].resource;
+
+        /* handle it like a GET request for the observe registration */
+        uint16_t msgid = (uint16_t)atomic_fetch_add(&_coap_state.next_message_id, 1);
+        ssize_t len = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON,
+                                     &pending[i].token[0], pending[i].token_len,
+                                     COAP_METHOD_GET, msgid);
+        coap_parse(&pdu, buf, len);
+        strncpy((char *)pdu.url, resource->path, NANOCOAP_URL_MAX - 1);
+        pdu.observe_value = _obs_value();
+
+        len = resource->handler(&pdu, buf, sizeof(buf), resource->context);
+        if (len > 0) {
+            mutex_lock(&_coap_state.lock);
+            _obs_send(buf, len, resource);
+            mutex_unlock(&_coap_state.lock);
+        }
+        else {
+            DEBUG("gcoap: can't create notification for %s\n", resource->path);
         }
     }
 }
@@ -650,6 +1276,19 @@ kernel_pid_t gcoap_init(void)
     if (_pid != KERNEL_PID_UNDEF) {
         return -EEXIST;
     }
+#if GCOAP_WORKERS_NUMOF
+    mbox_init(&_free_reqs, _free_reqs_queue, GCOAP_PDU_BUFS_NUMOF);
+    mbox_init(&_pending_reqs, _pending_reqs_queue, GCOAP_PDU_BUFS_NUMOF);
+    for (unsigned i = 0; i < GCOAP_PDU_BUFS_NUMOF; i++) {
+        msg_t msg = { .content = { .ptr = (char *)&_worker_reqs[i] } };
+        mbox_put(&_free_reqs, &msg);
+    }
+    for (unsigned i = 0; i < GCOAP_WORKERS_NUMOF; i++) {
+        thread_create(_worker_stacks[i], sizeof(_worker_stacks[i]),
+                      THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                      _worker, NULL, "coap worker");
+    }
+#endif
     _pid = thread_create(_msg_stack, sizeof(_msg_stack), THREAD_PRIORITY_MAIN - 1,
                             THREAD_CREATE_STACKTEST, _event_loop, NULL, "coap");
 
@@ -658,6 +1297,12 @@ kernel_pid_t gcoap_init(void)
     memset(&_coap_state.open_reqs[0], 0, sizeof(_coap_state.open_reqs));
     memset(&_coap_state.observers[0], 0, sizeof(_coap_state.observers));
     memset(&_coap_state.observe_memos[0], 0, sizeof(_coap_state.observe_memos));
+    memset(&_coap_state.obs_buckets[0], 0, sizeof(_coap_state.obs_buckets));
+    _coap_state.obs_unused = NULL;
+    for (unsigned i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+        _coap_state.observe_memos[i].next = _coap_state.obs_unused;
+        _coap_state.obs_unused = &_coap_state.observe_memos[i];
+    }
     memset(&_coap_state.resend_bufs[0], 0, sizeof(_coap_state.resend_bufs));
     /* randomize initial value */
     atomic_init(&_coap_state.next_message_id, (unsigned)random_uint32());
@@ -675,6 +1320,23 @@ void gcoap_register_listener(gcoap_listener_t *listener)
 
     listener->next = NULL;
     _last->next = listener;
+    /* /.well-known/core lists the new resources */
+    gcoap_cache_invalidate(&_default_resources[0]);
+}
+
+void gcoap_cache_invalidate(const coap_resource_t *resource)
+{
+#if GCOAP_RESP_CACHE_SIZE
+    mutex_lock(&_cache_lock);
+    for (unsigned i = 0; i < GCOAP_RESP_CACHE_SIZE; i++) {
+        if ((resource == NULL) || (_cache[i].resource == resource)) {
+            _cache[i].resource = NULL;
+        }
+    }
+    mutex_unlock(&_cache_lock);
+#else
+    (void)resource;
+#endif
 }
 
 int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code,
@@ -711,6 +1373,8 @@ int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code,
          * length in the buffer. Allows us to reconstruct buffer length later. */
         pdu->payload_len  = len - (pdu->payload - buf);
         pdu->content_type = COAP_FORMAT_NONE;
+        coap_set_block1(pdu, NULL);
+        coap_set_block2(pdu, NULL);
 
         memcpy(&pdu->url[0], path, strlen(path));
         return 0;
@@ -815,27 +1479,8 @@ size_t gcoap_req_send2(const uint8_t *buf, size_t len,
     ssize_t res = sock_udp_send(&_sock, buf, len, remote);
 
     if ((res > 0) && (timeout > 0)) {     /* timeout may be zero for non-confirmable */
-        /* We assume gcoap_req_send2() is called on some thread other than
-         * gcoap's. First, put a message in the mbox for the sock udp object,
-         * which will interrupt listening on the gcoap thread. (When there are
-         * no outstanding requests, gcoap blocks indefinitely in _listen() at
-         * sock_udp_recv().) While the message sent here is outstanding, the
-         * sock_udp_recv() call will be set to a short timeout so the request
-         * timer below, also on the gcoap thread, is processed in a timely
-         * manner. */
-        msg_t mbox_msg;
-        mbox_msg.type          = GCOAP_MSG_TYPE_INTR;
-        mbox_msg.content.value = 0;
-        if (mbox_try_put(&_sock.reg.mbox, &mbox_msg)) {
-            /* start response wait timer on the gcoap thread */
-            memo->timeout_msg.type        = GCOAP_MSG_TYPE_TIMEOUT;
-            memo->timeout_msg.content.ptr = (char *)memo;
-            xtimer_set_msg(&memo->response_timer, timeout, &memo->timeout_msg, _pid);
-        }
-        else {
-            res = 0;
-            DEBUG("gcoap: can't wake up mbox; no timeout for msg\n");
-        }
+        /* start response wait timer for the gcoap thread */
+        _set_resp_timer(memo, timeout);
     }
     if (res <= 0) {
         if (msg_type == COAP_TYPE_CON) {
@@ -860,6 +1505,9 @@ int gcoap_resp_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code)
      * length in the buffer. Allows us to reconstruct buffer length later. */
     pdu->payload_len  = len - (pdu->payload - buf);
     pdu->content_type = COAP_FORMAT_NONE;
+    /* set by a handler for a block-wise transfer, if at all */
+    coap_set_block1(pdu, NULL);
+    coap_set_block2(pdu, NULL);
 
     return 0;
 }
@@ -869,8 +1517,13 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 {
     gcoap_observe_memo_t *memo = NULL;
 
+    /* the resource changed */
+    gcoap_cache_invalidate(resource);
+
+    mutex_lock(&_coap_state.lock);
     _find_obs_memo_resource(&memo, resource);
     if (memo == NULL) {
+        mutex_unlock(&_coap_state.lock);
         /* Unique return value to specify there is not an observer */
         return GCOAP_OBS_INIT_UNUSED;
     }
@@ -879,10 +1532,10 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
     uint16_t msgid = (uint16_t)atomic_fetch_add(&_coap_state.next_message_id, 1);
     ssize_t hdrlen = coap_build_hdr(pdu->hdr, COAP_TYPE_NON, &memo->token[0],
                                     memo->token_len, COAP_CODE_CONTENT, msgid);
+    mutex_unlock(&_coap_state.lock);
 
     if (hdrlen > 0) {
-        uint32_t now       = xtimer_now_usec();
-        pdu->observe_value = (now >> GCOAP_OBS_TICK_EXPONENT) & 0xFFFFFF;
+        pdu->observe_value = _obs_value();
 
         /* Reserve some space between the header and payload to write options later */
         pdu->payload       = buf + coap_get_total_hdr_len(pdu) + GCOAP_OBS_OPTIONS_BUF;
@@ -890,6 +1543,8 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
          * length in the buffer. Allows us to reconstruct buffer length later. */
         pdu->payload_len   = len - (pdu->payload - buf);
         pdu->content_type  = COAP_FORMAT_NONE;
+        coap_set_block1(pdu, NULL);
+        coap_set_block2(pdu, NULL);
 
         return GCOAP_OBS_INIT_OK;
     }
@@ -899,20 +1554,46 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
     }
 }
 
-size_t gcoap_obs_send(const uint8_t *buf, size_t len,
+size_t gcoap_obs_send(uint8_t *buf, size_t len,
                       const coap_resource_t *resource)
 {
-    gcoap_observe_memo_t *memo = NULL;
+    mutex_lock(&_coap_state.lock);
+    size_t sent = _obs_send(buf, len, resource);
+    mutex_unlock(&_coap_state.lock);
 
-    _find_obs_memo_resource(&memo, resource);
+    return sent;
+}
 
-    if (memo) {
-        ssize_t bytes = sock_udp_send(&_sock, buf, len, memo->observer);
-        return (size_t)((bytes > 0) ? bytes : 0);
+unsigned gcoap_obs_notify(const coap_resource_t *resource)
+{
+    unsigned count = 0;
+    uint32_t delay = 0;
+
+    gcoap_cache_invalidate(resource);
+
+    mutex_lock(&_coap_state.lock);
+    for (gcoap_observe_memo_t *m = *_obs_bucket(resource); m; m = m->next) {
+        if (m->resource == resource) {
+            m->state = GCOAP_OBS_MEMO_PENDING;
+            count++;
+        }
     }
-    else {
-        return 0;
+    /* coalesce with a notification that is already due */
+    if ((count == 0) || _obs_due) {
+        mutex_unlock(&_coap_state.lock);
+        return count;
+    }
+    _obs_due = true;
+#if GCOAP_OBS_MIN_INTERVAL
+    uint32_t elapsed = xtimer_now_usec() - _obs_last;
+    if (elapsed < GCOAP_OBS_MIN_INTERVAL) {
+        delay = GCOAP_OBS_MIN_INTERVAL - elapsed;
     }
+#endif
+    mutex_unlock(&_coap_state.lock);
+
+    xtimer_set(&_obs_timer, delay);
+    return count;
 }
 
 uint8_t gcoap_op_state(void)
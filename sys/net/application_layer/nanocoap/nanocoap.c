@@ -55,8 +55,12 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
     uint8_t *pkt_end = buf + len;
 
     memset(pkt->url, '\0', NANOCOAP_URL_MAX);
+    /* the options end here if there's no payload */
+    pkt->payload = pkt_end;
     pkt->payload_len = 0;
     pkt->observe_value = UINT32_MAX;
+    pkt->block1 = UINT32_MAX;
+    pkt->block2 = UINT32_MAX;
 
     /* token value (tkl bytes) */
     if (coap_get_token_len(pkt)) {
@@ -121,6 +125,24 @@ int coap_parse(coap_pkt_t *pkt, uint8_t *buf, size_t len)
                         return -EBADMSG;
                     }
                     break;
+                case COAP_OPT_BLOCK1:
+                case COAP_OPT_BLOCK2:
+                {
+                    uint32_t value = (option_len <= 3) ?
+                                     _decode_uint(pkt_pos, option_len) : 7;
+                    /* block size exponent 7 is reserved */
+                    if ((value & 0x7) == 7) {
+                        DEBUG("nanocoap: discarding packet with invalid block option.\n");
+                        return -EBADMSG;
+                    }
+                    if (option_nr == COAP_OPT_BLOCK1) {
+                        pkt->block1 = value;
+                    }
+                    else {
+                        pkt->block2 = value;
+                    }
+                    break;
+                }
                 default:
                     DEBUG("nanocoap: unhandled option nr=%i len=%i critical=%u\n", option_nr, option_len, option_nr & 1);
                     if (option_nr & 1) {
@@ -153,26 +175,51 @@ ssize_t coap_handle_req(coap_pkt_t *pkt, uint8_t *resp_buf, unsigned resp_buf_le
     }
 
     unsigned method_flag = coap_method2flag(coap_get_code_detail(pkt));
+    const coap_resource_t *resource = coap_find_resource(coap_resources,
+                                                         coap_resources_numof,
+                                                         (char *)pkt->url,
+                                                         method_flag);
 
-    for (unsigned i = 0; i < coap_resources_numof; i++) {
-        const coap_resource_t *resource = &coap_resources[i];
-        if (!(resource->methods & method_flag)) {
-            continue;
-        }
+    if (resource != NULL) {
+        return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
+    }
+
+    return coap_build_reply(pkt, COAP_CODE_404, resp_buf, resp_buf_len, 0);
+}
+
+const coap_resource_t *coap_find_resource(const coap_resource_t *resources,
+                                          size_t resources_numof,
+                                          const char *path,
+                                          unsigned method_flag)
+{
+    size_t lo = 0, hi = resources_numof;
+
+    while (lo < hi) {
+        size_t mid = lo + ((hi - lo) / 2);
+        int res = strcmp(path, resources[mid].path);
 
-        int res = strcmp((char *)pkt->url, resource->path);
         if (res > 0) {
-            continue;
+            lo = mid + 1;
         }
         else if (res < 0) {
-            break;
+            hi = mid;
         }
         else {
-            return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
+            /* resources for the same path may differ in their methods */
+            while ((mid > 0) && (strcmp(path, resources[mid - 1].path) == 0)) {
+                mid--;
+            }
+            for (; (mid < resources_numof) &&
+                   (strcmp(path, resources[mid].path) == 0); mid++) {
+                if (resources[mid].methods & method_flag) {
+                    return &resources[mid];
+                }
+            }
+            break;
         }
     }
 
-    return coap_build_reply(pkt, COAP_CODE_404, resp_buf, resp_buf_len, 0);
+    return NULL;
 }
 
 ssize_t coap_reply_simple(coap_pkt_t *pkt,
@@ -195,6 +242,102 @@ ssize_t coap_reply_simple(coap_pkt_t *pkt,
     return coap_build_reply(pkt, code, buf, len, bufpos - payload_start);
 }
 
+ssize_t coap_reply_block2(coap_pkt_t *pkt, unsigned code,
+                          uint8_t *buf, size_t len, unsigned ct,
+                          coap_block_producer_t producer, void *arg)
+{
+    coap_block_t block = { .num = 0, .szx = NANOCOAP_BLOCK_SZX_MAX };
+    size_t hdr_len = coap_get_total_hdr_len(pkt);
+    /* header, Content-Format, Block2 and payload marker */
+    size_t overhead = hdr_len + 3 + 4 + 1;
+    size_t offset;
+
+    coap_get_block2(pkt, &block);
+    offset = block.num * coap_szx2size(block.szx);
+    if (block.szx > NANOCOAP_BLOCK_SZX_MAX) {
+        block.szx = NANOCOAP_BLOCK_SZX_MAX;
+    }
+    /* one byte more than the block tells if the block is the last one */
+    while ((overhead + coap_szx2size(block.szx) + 1) > len) {
+        if (block.szx == 0) {
+            return -ENOSPC;
+        }
+        block.szx--;
+    }
+    /* a smaller block size than requested shifts the block number */
+    block.num = offset / coap_szx2size(block.szx);
+    block.more = false;
+
+    /* the length of the option doesn't depend on the more flag */
+    uint8_t *bufpos = buf + hdr_len;
+    bufpos += coap_put_option_ct(bufpos, 0, ct);
+    uint8_t *block_opt = bufpos;
+    bufpos += coap_put_option_block(bufpos, COAP_OPT_CONTENT_FORMAT,
+                                    COAP_OPT_BLOCK2, &block);
+    *bufpos++ = 0xff;
+
+    ssize_t payload_len = producer(arg, offset, bufpos,
+                                   coap_szx2size(block.szx) + 1);
+    if (payload_len < 0) {
+        return coap_build_reply(pkt, COAP_CODE_INTERNAL_SERVER_ERROR, buf,
+                                len, 0);
+    }
+    if ((size_t)payload_len > coap_szx2size(block.szx)) {
+        payload_len = coap_szx2size(block.szx);
+        block.more = true;
+        coap_put_option_block(block_opt, COAP_OPT_CONTENT_FORMAT,
+                              COAP_OPT_BLOCK2, &block);
+    }
+    else if (payload_len == 0) {
+        /* no payload marker for an empty payload */
+        bufpos--;
+    }
+    bufpos += payload_len;
+
+    return coap_build_reply(pkt, code, buf, len, bufpos - (buf + hdr_len));
+}
+
+ssize_t coap_reply_block1(coap_pkt_t *pkt, uint8_t *buf, size_t len,
+                          coap_block_consumer_t consumer, void *arg)
+{
+    coap_block_t block = { .num = 0, .szx = 0, .more = false };
+    bool has_block = coap_get_block1(pkt, &block);
+    size_t offset = block.num * coap_szx2size(block.szx);
+    unsigned code;
+
+    /* all but the last block have the announced size */
+    if (block.more && (pkt->payload_len != coap_szx2size(block.szx))) {
+        return coap_build_reply(pkt, COAP_CODE_BAD_REQUEST, buf, len, 0);
+    }
+
+    switch (consumer(arg, offset, pkt->payload, pkt->payload_len, block.more)) {
+        case 0:
+            code = block.more ? COAP_CODE_CONTINUE : COAP_CODE_CHANGED;
+            break;
+        case -EINVAL:
+            code = COAP_CODE_REQUEST_ENTITY_INCOMPLETE;
+            break;
+        case -ENOSPC:
+            code = COAP_CODE_REQUEST_ENTITY_TOO_LARGE;
+            break;
+        default:
+            code = COAP_CODE_INTERNAL_SERVER_ERROR;
+            break;
+    }
+
+    size_t hdr_len = coap_get_total_hdr_len(pkt);
+    size_t opt_len = 0;
+
+    if (has_block && (code != COAP_CODE_INTERNAL_SERVER_ERROR)) {
+        if ((hdr_len + 4) > len) {
+            return -ENOSPC;
+        }
+        opt_len = coap_put_option_block(buf + hdr_len, 0, COAP_OPT_BLOCK1,
+                                        &block);
+    }
+    return coap_build_reply(pkt, code, buf, len, opt_len);
+}
+
 ssize_t coap_build_reply(coap_pkt_t *pkt, unsigned code,
                          uint8_t *rbuf, unsigned rlen, unsigned payload_len)
 {
@@ -346,6 +489,47 @@ size_t coap_put_option_ct(uint8_t *buf, uint16_t lastonum, uint16_t content_type
     }
 }
 
+void coap_opt_iter_init(coap_pkt_t *pkt, coap_optpos_t *opt)
+{
+    opt->pos = pkt->hdr->data + coap_get_token_len(pkt);
+    opt->onum = 0;
+}
+
+bool coap_opt_iter_next(coap_pkt_t *pkt, coap_optpos_t *opt)
+{
+    /* coap_parse() validated the options */
+    if ((opt->pos >= pkt->payload) || (*opt->pos == 0xff)) {
+        return false;
+    }
+
+    uint8_t option_byte = *opt->pos++;
+    opt->onum += _decode_value(option_byte >> 4, &opt->pos, pkt->payload);
+    opt->len = _decode_value(option_byte & 0xf, &opt->pos, pkt->payload);
+    opt->value = opt->pos;
+    opt->pos += opt->len;
+    return true;
+}
+
+size_t coap_put_option_block(uint8_t *buf, uint16_t lastonum, uint16_t onum,
+                             const coap_block_t *block)
+{
+    assert(block->num < (1UL << 20));
+
+    uint32_t value = htonl(coap_block_value(block));
+    unsigned olen = 1;
+
+    /* always write at least one byte, so the more flag can be set later
+     * without changing the length of the option */
+    if (block->num >= (1U << 12)) {
+        olen = 3;
+    }
+    else if (block->num >= (1U << 4)) {
+        olen = 2;
+    }
+    return coap_put_option(buf, lastonum, onum,
+                           ((uint8_t *)&value) + (4 - olen), olen);
+}
+
 size_t coap_put_option_uri(uint8_t *buf, uint16_t lastonum, const char *uri, uint16_t optnum)
 {
     char separator = (optnum == COAP_OPT_URI_PATH) ? '/' : '&';
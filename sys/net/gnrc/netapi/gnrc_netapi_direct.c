@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_netapi_direct
+ * @{
+ *
+ * @file
+ * @brief       Run-to-completion extension implementation
+ * @}
+ */
+
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+
+#include "mutex.h"
+#include "sched.h"
+#include "net/gnrc/netapi/direct.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static gnrc_netapi_direct_t *_layers = NULL;
+static mutex_t _lock = MUTEX_INIT;
+static bool _enabled = true;
+
+void gnrc_netapi_direct_register(gnrc_netapi_direct_t *layer,
+                                 gnrc_nettype_t type,
+                                 gnrc_netreg_entry_cb_t handler)
+{
+    layer->type = type;
+    layer->cbd.cb = handler;
+    layer->cbd.ctx = NULL;
+    gnrc_netreg_entry_init_pid(&layer->thread, GNRC_NETREG_DEMUX_CTX_ALL,
+                               sched_active_pid);
+    gnrc_netreg_entry_init_cb(&layer->direct, GNRC_NETREG_DEMUX_CTX_ALL,
+                              &layer->cbd);
+    mutex_lock(&_lock);
+    layer->next = _layers;
+    _layers = layer;
+    gnrc_netreg_register(type, (_enabled) ? &layer->direct : &layer->thread);
+    mutex_unlock(&_lock);
+}
+
+void gnrc_netapi_direct_enable(bool enable)
+{
+    mutex_lock(&_lock);
+    if (enable != _enabled) {
+        DEBUG("netapi direct: %s direct calls\n",
+              (enable) ? "enabling" : "disabling");
+        for (gnrc_netapi_direct_t *layer = _layers; layer != NULL;
+             layer = layer->next) {
+            gnrc_netreg_unregister(layer->type, (enable) ? &layer->thread
+                                                         : &layer->direct);
+            gnrc_netreg_register(layer->type, (enable) ? &layer->direct
+                                                       : &layer->thread);
+        }
+        _enabled = enable;
+    }
+    mutex_unlock(&_lock);
+}
+
+bool gnrc_netapi_direct_enabled(void)
+{
+    return _enabled;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif  /* MODULE_GNRC_NETAPI_DIRECT */
@@ -16,6 +16,10 @@
  */
 
 #ifdef MODULE_NETDEV_ETH
+#include <errno.h>
+
+#include "iolist.h"
+#include "net/ethernet.h"
 #include "net/ethernet/hdr.h"
 #include "net/gnrc.h"
 #include "net/gnrc/netif/ethernet.h"
@@ -157,89 +161,148 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
     return res;
 }
 
-static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
+/* reads the Ethernet header into @p hdr and the payload directly into the
+ * packet buffer, so neither of them needs to be copied or marked afterwards */
+static int _recv_iolist(netdev_t *dev, int bytes_expected, ethernet_hdr_t *hdr,
+                        gnrc_pktsnip_t **pkt)
 {
-    netdev_t *dev = netif->dev;
-    int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
-    gnrc_pktsnip_t *pkt = NULL;
+    gnrc_pktsnip_t *payload;
+    int nread;
 
-    if (bytes_expected > 0) {
-        pkt = gnrc_pktbuf_add(NULL, NULL,
-                              bytes_expected,
+    if (bytes_expected <= (int)sizeof(ethernet_hdr_t)) {
+        DEBUG("gnrc_netif_ethernet: frame without payload.\n");
+        nread = dev->driver->recv_iolist(dev, NULL, NULL);
+        return (nread == -ENOTSUP) ? nread : -EIO;
+    }
+    payload = gnrc_pktbuf_add(NULL, NULL,
+                              bytes_expected - sizeof(ethernet_hdr_t),
                               GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
+        /* drop the packet (unless the device can not do it this way) */
+        nread = dev->driver->recv_iolist(dev, NULL, NULL);
+        return (nread == -ENOTSUP) ? nread : -ENOBUFS;
+    }
 
-        if (!pkt) {
-            DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
+    iolist_t payload_iol = { NULL, payload->data, payload->size };
+    iolist_t hdr_iol = { &payload_iol, hdr, sizeof(ethernet_hdr_t) };
 
-            /* drop the packet */
-            dev->driver->recv(dev, NULL, bytes_expected, NULL);
+    nread = dev->driver->recv_iolist(dev, &hdr_iol, NULL);
+    if (nread <= (int)sizeof(ethernet_hdr_t)) {
+        DEBUG("gnrc_netif_ethernet: read error or frame without payload.\n");
+        gnrc_pktbuf_release(payload);
+        return (nread < 0) ? nread : -EIO;
+    }
+    /* free the unused space */
+    gnrc_pktbuf_realloc_data(payload, nread - sizeof(ethernet_hdr_t));
+    *pkt = payload;
+    return nread;
+}
 
-            goto out;
-        }
+static int _recv_copy(netdev_t *dev, int bytes_expected, gnrc_pktsnip_t **pkt)
+{
+    if (bytes_expected <= 0) {
+        return -EIO;
+    }
+    *pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
+    if (*pkt == NULL) {
+        DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
 
-        int nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
-        if (nread <= 0) {
-            DEBUG("gnrc_netif_ethernet: read error.\n");
-            goto safe_out;
-        }
+        /* drop the packet */
+        dev->driver->recv(dev, NULL, bytes_expected, NULL);
 
-        if (nread < bytes_expected) {
-            /* we've got less than the expected packet size,
-             * so free the unused space.*/
+        return -ENOBUFS;
+    }
 
-            DEBUG("gnrc_netif_ethernet: reallocating.\n");
-            gnrc_pktbuf_realloc_data(pkt, nread);
-        }
+    int nread = dev->driver->recv(dev, (*pkt)->data, bytes_expected, NULL);
+    if (nread <= 0) {
+        DEBUG("gnrc_netif_ethernet: read error.\n");
+        gnrc_pktbuf_release(*pkt);
+        return -EIO;
+    }
 
-        /* mark ethernet header */
-        gnrc_pktsnip_t *eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF);
-        if (!eth_hdr) {
-            DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
-            goto safe_out;
-        }
+    if (nread < bytes_expected) {
+        /* we've got less than the expected packet size,
+         * so free the unused space.*/
 
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)eth_hdr->data;
+        DEBUG("gnrc_netif_ethernet: reallocating.\n");
+        gnrc_pktbuf_realloc_data(*pkt, nread);
+    }
 
-#ifdef MODULE_L2FILTER
-        if (!l2filter_pass(dev->filter, hdr->src, ETHERNET_ADDR_LEN)) {
-            DEBUG("gnrc_netif_ethernet: incoming packet filtered by l2filter\n");
-            goto safe_out;
+    /* mark ethernet header */
+    if (gnrc_pktbuf_mark(*pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF) == NULL) {
+        DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
+        gnrc_pktbuf_release(*pkt);
+        return -ENOBUFS;
+    }
+    return nread;
+}
+
+static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
+{
+    netdev_t *dev = netif->dev;
+    ethernet_hdr_t hdr_buf;
+    ethernet_hdr_t *hdr = &hdr_buf;
+    gnrc_pktsnip_t *pkt = NULL, *eth_hdr = NULL;
+    /* drivers that cannot tell the frame size report the maximum size */
+    int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
+    int nread = -ENOTSUP;
+
+    if (dev->driver->recv_iolist != NULL) {
+        nread = _recv_iolist(dev, bytes_expected, hdr, &pkt);
+    }
+    if (nread == -ENOTSUP) {
+        /* the frame was not consumed, so its size is still valid */
+        nread = _recv_copy(dev, bytes_expected, &pkt);
+        if (nread > 0) {
+            eth_hdr = pkt->next;
+            hdr = (ethernet_hdr_t *)eth_hdr->data;
         }
+    }
+    if (nread <= 0) {
+        return NULL;
+    }
+
+#ifdef MODULE_L2FILTER
+    if (!l2filter_pass(dev->filter, hdr->src, ETHERNET_ADDR_LEN)) {
+        DEBUG("gnrc_netif_ethernet: incoming packet filtered by l2filter\n");
+        goto safe_out;
+    }
 #endif
 
-        /* set payload type from ethertype */
-        pkt->type = gnrc_nettype_from_ethertype(byteorder_ntohs(hdr->type));
+    /* set payload type from ethertype */
+    pkt->type = gnrc_nettype_from_ethertype(byteorder_ntohs(hdr->type));
 
-        /* create netif header */
-        gnrc_pktsnip_t *netif_hdr;
-        netif_hdr = gnrc_pktbuf_add(NULL, NULL,
-                                    sizeof(gnrc_netif_hdr_t) + (2 * ETHERNET_ADDR_LEN),
-                                    GNRC_NETTYPE_NETIF);
+    /* create netif header */
+    gnrc_pktsnip_t *netif_hdr;
+    netif_hdr = gnrc_pktbuf_add(NULL, NULL,
+                                sizeof(gnrc_netif_hdr_t) + (2 * ETHERNET_ADDR_LEN),
+                                GNRC_NETTYPE_NETIF);
 
-        if (netif_hdr == NULL) {
-            DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
-            pkt = eth_hdr;
-            goto safe_out;
-        }
+    if (netif_hdr == NULL) {
+        DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
+        goto safe_out;
+    }
 
-        gnrc_netif_hdr_init(netif_hdr->data, ETHERNET_ADDR_LEN, ETHERNET_ADDR_LEN);
-        gnrc_netif_hdr_set_src_addr(netif_hdr->data, hdr->src, ETHERNET_ADDR_LEN);
-        gnrc_netif_hdr_set_dst_addr(netif_hdr->data, hdr->dst, ETHERNET_ADDR_LEN);
-        ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid = thread_getpid();
+    gnrc_netif_hdr_init(netif_hdr->data, ETHERNET_ADDR_LEN, ETHERNET_ADDR_LEN);
+    gnrc_netif_hdr_set_src_addr(netif_hdr->data, hdr->src, ETHERNET_ADDR_LEN);
+    gnrc_netif_hdr_set_dst_addr(netif_hdr->data, hdr->dst, ETHERNET_ADDR_LEN);
+    ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid = thread_getpid();
 
-        DEBUG("gnrc_netif_ethernet: received packet from %02x:%02x:%02x:%02x:%02x:%02x "
-              "of length %d\n",
-              hdr->src[0], hdr->src[1], hdr->src[2], hdr->src[3], hdr->src[4],
-              hdr->src[5], nread);
+    DEBUG("gnrc_netif_ethernet: received packet from %02x:%02x:%02x:%02x:%02x:%02x "
+          "of length %d\n",
+          hdr->src[0], hdr->src[1], hdr->src[2], hdr->src[3], hdr->src[4],
+          hdr->src[5], nread);
 #if defined(MODULE_OD) && ENABLE_DEBUG
-        od_hex_dump(hdr, nread, OD_WIDTH_DEFAULT);
+    od_hex_dump(hdr, sizeof(ethernet_hdr_t), OD_WIDTH_DEFAULT);
+    od_hex_dump(pkt->data, pkt->size, OD_WIDTH_DEFAULT);
 #endif
 
+    if (eth_hdr != NULL) {
         gnrc_pktbuf_remove_snip(pkt, eth_hdr);
-        LL_APPEND(pkt, netif_hdr);
     }
+    LL_APPEND(pkt, netif_hdr);
 
-out:
     return pkt;
 
 safe_out:
@@ -24,16 +24,44 @@
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/udp.h"
 #include "net/gnrc/tcp.h"
+#ifdef MODULE_GNRC_UDP_PORTS
+#include "net/gnrc/udp/ports.h"
+#endif
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
+#ifdef MODULE_GNRC_NETREG_HASH
+#if (GNRC_NETREG_HASH_BUCKETS & (GNRC_NETREG_HASH_BUCKETS - 1)) != 0
+#error "GNRC_NETREG_HASH_BUCKETS must be a power of 2"
+#endif
+
+/* The registry as hash table by gnrc_nettype_t and demux context */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][GNRC_NETREG_HASH_BUCKETS];
+
+static inline unsigned _bucket(uint32_t demux_ctx)
+{
+    /* fold upper bits in so both port numbers (lower 16 bit) and
+     * GNRC_NETREG_DEMUX_CTX_ALL (upper 16 bit) spread over the buckets */
+    demux_ctx ^= (demux_ctx >> 16);
+    demux_ctx ^= (demux_ctx >> 8);
+    return demux_ctx & (GNRC_NETREG_HASH_BUCKETS - 1);
+}
+
+#define _HEAD(type, demux_ctx)  (netreg[type][_bucket(demux_ctx)])
+#else
 /* The registry as lookup table by gnrc_nettype_t */
 static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
 
+#define _HEAD(type, demux_ctx)  (netreg[type])
+#endif
+
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
+#ifdef MODULE_GNRC_UDP_PORTS
+    gnrc_udp_ports_init();
+#endif
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -51,7 +79,28 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
+#ifdef MODULE_GNRC_NETREG_HASH
+    /* insert in front of the entries with the same demux context (or at the
+     * head of the bucket) so gnrc_netreg_getnext() only needs to look at the
+     * immediate successor */
+    gnrc_netreg_entry_t **ptr = &_HEAD(type, entry->demux_ctx);
+
+    while ((*ptr != NULL) && ((*ptr)->demux_ctx != entry->demux_ctx)) {
+        ptr = &(*ptr)->next;
+    }
+    if (*ptr == NULL) {
+        ptr = &_HEAD(type, entry->demux_ctx);
+    }
+    entry->next = *ptr;
+    *ptr = entry;
+#else
     LL_PREPEND(netreg[type], entry);
+#endif
+#ifdef MODULE_GNRC_UDP_PORTS
+    if ((type == GNRC_NETTYPE_UDP) && (entry->demux_ctx <= UINT16_MAX)) {
+        gnrc_udp_ports_add(entry->demux_ctx);
+    }
+#endif
 
     return 0;
 }
@@ -62,54 +111,65 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+#ifdef MODULE_GNRC_UDP_PORTS
+    gnrc_netreg_entry_t **ptr = &_HEAD(type, entry->demux_ctx);
+
+    while ((*ptr != NULL) && (*ptr != entry)) {
+        ptr = &(*ptr)->next;
+    }
+    if (*ptr == NULL) {
+        /* entry was not registered, so the port table is unaffected */
+        return;
+    }
+    *ptr = entry->next;
+    if ((type == GNRC_NETTYPE_UDP) && (entry->demux_ctx <= UINT16_MAX)) {
+        gnrc_udp_ports_remove(entry->demux_ctx);
+    }
+#else
+    LL_DELETE(_HEAD(type, entry->demux_ctx), entry);
+#endif
 }
 
-/**
- * @brief   Searches the next entry in the registry that matches given
- *          parameters, start lookup from beginning or given entry.
- *
- * @param[in] from      A registry entry to lookup from or NULL to start fresh
- * @param[in] type      Type of the protocol.
- * @param[in] demux_ctx The demultiplexing context for the registered thread.
- *                      See gnrc_netreg_entry_t::demux_ctx.
- *
- * @return  The first entry fitting the given parameters on success
- * @return  NULL if no entry can be found.
- */
-static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *from,
-                                           gnrc_nettype_t type,
-                                           uint32_t demux_ctx)
+gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
 {
     gnrc_netreg_entry_t *res = NULL;
 
-    if (from || !_INVALID_TYPE(type)) {
-        gnrc_netreg_entry_t *head = (from) ? from->next : netreg[type];
-        LL_SEARCH_SCALAR(head, res, demux_ctx, demux_ctx);
+    if (!_INVALID_TYPE(type)) {
+        LL_SEARCH_SCALAR(_HEAD(type, demux_ctx), res, demux_ctx, demux_ctx);
     }
 
     return res;
 }
 
-gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
-{
-    return _netreg_lookup(NULL, type, demux_ctx);
-}
-
 int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
 {
     int num = 0;
-    gnrc_netreg_entry_t *entry = NULL;
+    gnrc_netreg_entry_t *entry = gnrc_netreg_lookup(type, demux_ctx);
 
-    while((entry = _netreg_lookup(entry, type, demux_ctx)) != NULL) {
+    while (entry != NULL) {
         num++;
+        entry = gnrc_netreg_getnext(entry);
     }
     return num;
 }
 
 gnrc_netreg_entry_t *gnrc_netreg_getnext(gnrc_netreg_entry_t *entry)
 {
-    return (entry ? _netreg_lookup(entry, 0, entry->demux_ctx) : NULL);
+    gnrc_netreg_entry_t *res = NULL;
+
+    if (entry != NULL) {
+#ifdef MODULE_GNRC_NETREG_HASH
+        /* entries with the same demux context are adjacent in a bucket */
+        if ((entry->next != NULL) &&
+            (entry->next->demux_ctx == entry->demux_ctx)) {
+            res = entry->next;
+        }
+#else
+        LL_SEARCH_SCALAR(entry->next, res, demux_ctx, entry->demux_ctx);
+#endif
+    }
+
+    return res;
 }
 
 int gnrc_netreg_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
@@ -33,6 +33,9 @@
 #include "net/gnrc/ipv6/blacklist.h"
 
 #include "net/gnrc/ipv6.h"
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+#include "net/gnrc/netapi/direct.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -53,6 +56,11 @@ static char _stack[GNRC_IPV6_STACK_SIZE];
  */
 static fib_entry_t _fib_entries[GNRC_IPV6_FIB_TABLE_SIZE];
 
+/**
+ * @brief buffer to store the prefix trie nodes indexing the forwarding table
+ */
+static fib_trie_node_t _fib_trie_nodes[FIB_TRIE_NODES_NUMOF(GNRC_IPV6_FIB_TABLE_SIZE)];
+
 /**
  * @brief the IPv6 forwarding table
  */
@@ -63,6 +71,10 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 kernel_pid_t gnrc_ipv6_pid = KERNEL_PID_UNDEF;
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static gnrc_netapi_direct_t _layer;
+#endif
+
 /* handles GNRC_NETAPI_MSG_TYPE_RCV commands */
 static void _receive(gnrc_pktsnip_t *pkt);
 /* Sends packet over the appropriate interface(s).
@@ -71,6 +83,10 @@ static void _receive(gnrc_pktsnip_t *pkt);
 static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr);
 /* Main event loop for IPv6 */
 static void *_event_loop(void *args);
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+/* handles packets in the thread that dispatched them */
+static void _direct(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx);
+#endif
 
 /* Handles encapsulated IPv6 packets: http://tools.ietf.org/html/rfc2473 */
 static void _decapsulate(gnrc_pktsnip_t *pkt);
@@ -85,6 +101,7 @@ kernel_pid_t gnrc_ipv6_init(void)
 
 #ifdef MODULE_FIB
     gnrc_ipv6_fib_table.data.entries = _fib_entries;
+    gnrc_ipv6_fib_table.trie_nodes = _fib_trie_nodes;
     gnrc_ipv6_fib_table.table_type = FIB_TABLE_TYPE_SH;
     gnrc_ipv6_fib_table.size = GNRC_IPV6_FIB_TABLE_SIZE;
     fib_init(&gnrc_ipv6_fib_table);
@@ -248,14 +265,20 @@ static void _dispatch_next_header(gnrc_pktsnip_t *current, gnrc_pktsnip_t *pkt,
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
+#ifndef MODULE_GNRC_NETAPI_DIRECT
     gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
+#endif
 
     (void)args;
     msg_init_queue(msg_q, GNRC_IPV6_MSG_QUEUE_SIZE);
 
     /* register interest in all IPv6 packets */
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    gnrc_netapi_direct_register(&_layer, GNRC_NETTYPE_IPV6, _direct);
+#else
     gnrc_netreg_register(GNRC_NETTYPE_IPV6, &me_reg);
+#endif
 
     /* preinitialize ACK */
     reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
@@ -309,6 +332,24 @@ static void *_event_loop(void *args)
     return NULL;
 }
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static void _direct(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    switch (cmd) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            _receive(pkt);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            _send(pkt, true);
+            break;
+        default:
+            gnrc_pktbuf_release(pkt);
+            break;
+    }
+}
+#endif
+
 static void _send_to_iface(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 {
     assert(netif != NULL);
@@ -646,6 +687,12 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
 
             DEBUG("ipv6: packet is addressed to myself => loopback\n");
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+            if (gnrc_netapi_direct_enabled()) {
+                _receive(rcv_pkt);
+                return;
+            }
+#endif
             if (gnrc_netapi_receive(gnrc_ipv6_pid, rcv_pkt) < 1) {
                 DEBUG("ipv6: unable to deliver packet\n");
                 gnrc_pktbuf_release(rcv_pkt);
@@ -36,12 +36,30 @@ static clist_node_t _next_removable = { NULL };
 
 static _nib_onl_entry_t _nodes[GNRC_IPV6_NIB_NUMOF];
 static _nib_offl_entry_t _dsts[GNRC_IPV6_NIB_OFFL_NUMOF];
+/* prefix index of _dsts: hash buckets over (prefix, prefix length), the set
+ * of prefix lengths in use and the number of entries per prefix length */
+static _nib_offl_entry_t *_dst_buckets[GNRC_IPV6_NIB_OFFL_NUMOF];
+static BITFIELD(_dst_pfx_lens, IPV6_ADDR_BIT_LEN + 1);
+#if GNRC_IPV6_NIB_OFFL_NUMOF > UINT8_MAX
+#error "GNRC_IPV6_NIB_OFFL_NUMOF too large for the prefix length counters"
+#endif
+static uint8_t _dst_pfx_len_numof[IPV6_ADDR_BIT_LEN + 1];
 static _nib_dr_entry_t _def_routers[GNRC_IPV6_NIB_DEFAULT_ROUTER_NUMOF];
 
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
 static _nib_abr_entry_t _abrs[GNRC_IPV6_NIB_ABR_NUMOF];
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
 
+#if GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF
+typedef struct {
+    ipv6_addr_t dst;            /**< destination */
+    _nib_offl_entry_t *offl;    /**< best match for dst (may be NULL) */
+    bool valid;                 /**< entry is in use */
+} _route_cache_entry_t;
+
+static _route_cache_entry_t _route_cache[GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF];
+#endif  /* GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF */
+
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 mutex_t _nib_mutex = MUTEX_INIT;
@@ -50,6 +68,7 @@ evtimer_msg_t _nib_evtimer;
 static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node);
 static inline bool _node_unreachable(_nib_onl_entry_t *node);
+static inline void _route_cache_flush(void);
 
 void _nib_init(void)
 {
@@ -59,6 +78,10 @@ void _nib_init(void)
     memset(_nodes, 0, sizeof(_nodes));
     memset(_def_routers, 0, sizeof(_def_routers));
     memset(_dsts, 0, sizeof(_dsts));
+    memset(_dst_buckets, 0, sizeof(_dst_buckets));
+    memset(_dst_pfx_lens, 0, sizeof(_dst_pfx_lens));
+    memset(_dst_pfx_len_numof, 0, sizeof(_dst_pfx_len_numof));
+    _route_cache_flush();
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
@@ -437,6 +460,68 @@ void _nib_drl_ft_get(const _nib_dr_entry_t *drl, gnrc_ipv6_nib_ft_t *fte)
     fte->iface = _nib_onl_get_if(drl->next_hop);
 }
 
+static inline void _route_cache_flush(void)
+{
+#if GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF
+    memset(_route_cache, 0, sizeof(_route_cache));
+#endif  /* GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF */
+}
+
+static uint32_t _pfx_hash(const ipv6_addr_t *pfx, unsigned pfx_len)
+{
+    unsigned bytes = pfx_len / 8;
+    uint32_t hash = pfx_len;
+
+    for (unsigned i = 0; i < bytes; i++) {
+        hash = (hash * 33) ^ pfx->u8[i];
+    }
+    if (pfx_len % 8) {
+        /* only the bits covered by the prefix are significant */
+        hash = (hash * 33) ^ (pfx->u8[bytes] & (0xff << (8 - (pfx_len % 8))));
+    }
+    return hash;
+}
+
+static inline unsigned _dst_bucket(const ipv6_addr_t *pfx, unsigned pfx_len)
+{
+    return _pfx_hash(pfx, pfx_len) % GNRC_IPV6_NIB_OFFL_NUMOF;
+}
+
+static void _dst_index_add(_nib_offl_entry_t *dst)
+{
+    _nib_offl_entry_t **ptr = &_dst_buckets[_dst_bucket(&dst->pfx,
+                                                        dst->pfx_len)];
+
+    /* append, so entries allocated first are found first */
+    while (*ptr != NULL) {
+        ptr = &(*ptr)->next;
+    }
+    dst->next = NULL;
+    *ptr = dst;
+    _dst_pfx_len_numof[dst->pfx_len]++;
+    bf_set(_dst_pfx_lens, dst->pfx_len);
+    _route_cache_flush();
+}
+
+static void _dst_index_remove(_nib_offl_entry_t *dst)
+{
+    _nib_offl_entry_t **ptr = &_dst_buckets[_dst_bucket(&dst->pfx,
+                                                        dst->pfx_len)];
+
+    while ((*ptr != NULL) && (*ptr != dst)) {
+        ptr = &(*ptr)->next;
+    }
+    if (*ptr != NULL) {
+        *ptr = dst->next;
+        assert(_dst_pfx_len_numof[dst->pfx_len] > 0);
+        if (--_dst_pfx_len_numof[dst->pfx_len] == 0) {
+            bf_unset(_dst_pfx_lens, dst->pfx_len);
+        }
+    }
+    dst->next = NULL;
+    _route_cache_flush();
+}
+
 _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
                                    const ipv6_addr_t *pfx, unsigned pfx_len)
 {
@@ -484,6 +569,7 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+        _dst_index_add(dst);
     }
     return dst;
 }
@@ -515,6 +601,7 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+        _dst_index_remove(dst);
         memset(dst, 0, sizeof(_nib_offl_entry_t));
     }
 }
@@ -538,32 +625,66 @@ bool _nib_offl_is_entry(const _nib_offl_entry_t *entry)
     return (entry >= _dsts) && _in_dsts(entry);
 }
 
+static _nib_offl_entry_t *_nib_offl_get_pfx_match(const ipv6_addr_t *dst,
+                                                  unsigned pfx_len)
+{
+    _nib_offl_entry_t *res = NULL;
+
+    for (_nib_offl_entry_t *entry = _dst_buckets[_dst_bucket(dst, pfx_len)];
+         entry != NULL; entry = entry->next) {
+        /* prefer the entry allocated first for equal prefixes */
+        if ((entry->mode != _EMPTY) && (entry->pfx_len == pfx_len) &&
+            (ipv6_addr_match_prefix(&entry->pfx, dst) >= pfx_len) &&
+            ((res == NULL) || (entry < res))) {
+            res = entry;
+        }
+    }
+    return res;
+}
+
 static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 {
     _nib_offl_entry_t *res = NULL;
-    uint8_t best_match = 0;
 
     DEBUG("nib: get match for destination %s from NIB\n",
           ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
-    for (_nib_offl_entry_t *entry = _dsts; _in_dsts(entry); entry++) {
-        if (entry->mode != _EMPTY) {
-            uint8_t match = ipv6_addr_match_prefix(&entry->pfx, dst);
-
-            DEBUG("nib: %s/%u => ",
-                  ipv6_addr_to_str(addr_str, &entry->pfx, sizeof(addr_str)),
-                  entry->pfx_len);
-            DEBUG("%s%%%u matches with %u bits\n",
-                  (entry->mode == _PL) ? "(nil)" :
-                  ipv6_addr_to_str(addr_str, &entry->next_hop->ipv6,
-                                   sizeof(addr_str)),
-                  _nib_onl_get_if(entry->next_hop), match);
-            if ((match > best_match) && (match >= entry->pfx_len)) {
-                DEBUG("nib: best match (%u bits)\n", match);
-                res = entry;
-                best_match = match;
-            }
+#if GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF
+    _route_cache_entry_t *cached = &_route_cache[
+            _pfx_hash(dst, IPV6_ADDR_BIT_LEN) % GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF
+        ];
+
+    if (cached->valid && ipv6_addr_equal(&cached->dst, dst)) {
+        DEBUG("nib: using cached route %p\n", (void *)cached->offl);
+        return cached->offl;
+    }
+#endif  /* GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF */
+    /* probe the prefix lengths in use from the longest to the shortest */
+    for (int pfx_len = IPV6_ADDR_BIT_LEN; (pfx_len > 0) && (res == NULL);
+         pfx_len--) {
+        if (_dst_pfx_lens[pfx_len / 8] == 0) {
+            /* skip to the last prefix length of the previous byte */
+            pfx_len &= ~0x7;
+            continue;
+        }
+        if (bf_isset(_dst_pfx_lens, pfx_len)) {
+            res = _nib_offl_get_pfx_match(dst, pfx_len);
         }
     }
+    if (res != NULL) {
+        DEBUG("nib: best match %s/%u => ",
+              ipv6_addr_to_str(addr_str, &res->pfx, sizeof(addr_str)),
+              res->pfx_len);
+        DEBUG("%s%%%u\n",
+              (res->mode == _PL) ? "(nil)" :
+              ipv6_addr_to_str(addr_str, &res->next_hop->ipv6,
+                               sizeof(addr_str)),
+              _nib_onl_get_if(res->next_hop));
+    }
+#if GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF
+    memcpy(&cached->dst, dst, sizeof(cached->dst));
+    cached->offl = res;
+    cached->valid = true;
+#endif  /* GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF */
     return res;
 }
 
@@ -193,7 +193,11 @@ typedef struct {
 /**
  * @brief   Off-link NIB entry
  */
-typedef struct {
+typedef struct _nib_offl_entry {
+    /**
+     * @brief   next entry in the same bucket of the prefix index
+     */
+    struct _nib_offl_entry *next;
     _nib_onl_entry_t *next_hop; /**< next hop to destination */
     ipv6_addr_t pfx;            /**< prefix to the destination */
     /**
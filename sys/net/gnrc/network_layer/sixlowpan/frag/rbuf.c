@@ -14,6 +14,7 @@
 
 #include <inttypes.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "rbuf.h"
 #include "net/ipv6.h"
@@ -29,37 +30,42 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-/* estimated fragment payload size to determinate RBUF_INT_SIZE, default to
- * MAC payload size - fragment header. */
-#ifndef GNRC_SIXLOWPAN_FRAG_SIZE
-/* assuming 64-bit source/destination address, source PAN ID omitted */
-#define GNRC_SIXLOWPAN_FRAG_SIZE (104 - 5)
+#if (RBUF_BUCKETS & (RBUF_BUCKETS - 1)) != 0
+#error "RBUF_BUCKETS must be a power of 2"
 #endif
 
-#ifndef RBUF_INT_SIZE
-/* same as ((int) ceil((double) N / D)) */
-#define DIV_CEIL(N, D) (((N) + (D) - 1) / (D))
-#define RBUF_INT_SIZE (DIV_CEIL(IPV6_MIN_MTU, GNRC_SIXLOWPAN_FRAG_SIZE) * RBUF_SIZE)
-#endif
-
-static rbuf_int_t rbuf_int[RBUF_INT_SIZE];
-
 static rbuf_t rbuf[RBUF_SIZE];
 
+/* entries by the hash of their datagram */
+static rbuf_t *_buckets[RBUF_BUCKETS];
+/* entries that were in use before, chained by rbuf_t::next */
+static rbuf_t *_free = NULL;
+/* number of entries that were ever in use */
+static unsigned _used = 0;
+/* entries from the most to the least recently used */
+static rbuf_t *_lru_head = NULL, *_lru_tail = NULL;
+/* bytes of the packet buffer held by the entries */
+static size_t _mem = 0;
+static gnrc_sixlowpan_frag_rbuf_stats_t _stats;
+
 static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
 
 /* ------------------------------------
  * internal function definitions
  * ------------------------------------*/
-/* checks whether start and end overlaps, but not identical to, given interval i */
-static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end);
-/* gets a free entry from interval buffer */
-static rbuf_int_t *_rbuf_int_get_free(void);
+/* gets the hash bucket of a datagram */
+static unsigned _bucket(const uint8_t *src, size_t src_len,
+                        const uint8_t *dst, size_t dst_len,
+                        size_t size, uint16_t tag);
 /* remove entry from reassembly buffer */
 static void _rbuf_rem(rbuf_t *entry);
-/* update interval buffer of entry */
-static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size);
-/* checks timeouts and removes entries if necessary (oldest if full) */
+/* remove entry from reassembly buffer and release its packet */
+static void _rbuf_drop(rbuf_t *entry, uint32_t *reason);
+/* counts the units of a fragment that were already received */
+static unsigned _rbuf_received(rbuf_t *entry, unsigned first, unsigned last);
+/* checks if a fragment with all units received is a received fragment */
+static bool _rbuf_is_dup(rbuf_t *entry, unsigned first, unsigned last);
+/* removes timed out entries */
 static void _rbuf_gc(void);
 /* gets an entry identified by its tupel */
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
@@ -75,8 +81,8 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     unsigned int data_offset = 0;
     size_t original_size = frag_size;
     sixlowpan_frag_t *frag = pkt->data;
-    rbuf_int_t *ptr;
     uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t);
+    unsigned first, last, received;
 
     _rbuf_gc();
     entry = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
@@ -89,8 +95,6 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         return;
     }
 
-    ptr = entry->ints;
-
     /* dispatches in the first fragment are ignored */
     if (offset == 0) {
         if (data[0] == SIXLOWPAN_UNCOMP) {
@@ -100,12 +104,11 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC
         else if (sixlowpan_iphc_is(data)) {
             size_t iphc_len, nh_len = 0;
-            iphc_len = gnrc_sixlowpan_iphc_decode(&entry->pkt, pkt, entry->pkt->size,
+            iphc_len = gnrc_sixlowpan_iphc_decode(&entry->pkt, pkt, entry->size,
                                                   sizeof(sixlowpan_frag_t), &nh_len);
             if (iphc_len == 0) {
                 DEBUG("6lo rfrag: could not decode IPHC dispatch\n");
-                gnrc_pktbuf_release(entry->pkt);
-                _rbuf_rem(entry);
+                _rbuf_drop(entry, &_stats.decode);
                 return;
             }
             data += iphc_len;       /* take remaining data as data */
@@ -121,48 +124,60 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         data++; /* FRAGN header is one byte longer (offset) */
     }
 
-    if ((offset + frag_size) > entry->pkt->size) {
+    if ((offset + frag_size) > entry->size) {
         DEBUG("6lo rfrag: fragment too big for resulting datagram, discarding datagram\n");
-        gnrc_pktbuf_release(entry->pkt);
-        _rbuf_rem(entry);
+        _rbuf_drop(entry, &_stats.too_big);
+        return;
+    }
+    if (frag_size == 0) {
         return;
     }
 
+    first = offset / RBUF_UNIT;
+    last = (offset + frag_size - 1) / RBUF_UNIT;
+    received = _rbuf_received(entry, first, last);
+
     /* If the fragment overlaps another fragment and differs in either the size
      * or the offset of the overlapped fragment, discards the datagram
-     * https://tools.ietf.org/html/rfc4944#section-5.3 */
-    while (ptr != NULL) {
-        if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
-            DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
-            gnrc_pktbuf_release(entry->pkt);
-            _rbuf_rem(entry);
-
-            /* "A fresh reassembly may be commenced with the most recently
-             * received link fragment"
-             * https://tools.ietf.org/html/rfc4944#section-5.3 */
-            rbuf_add(netif_hdr, pkt, original_size, offset);
-
-            return;
-        }
+     * https://tools.ietf.org/html/rfc4944#section-5.3
+     * Since all but the last fragment are multiples of RBUF_UNIT, only a
+     * fragment with the same first and last unit as a received one is a
+     * duplicate. */
+    if ((received > 0) &&
+        ((received <= (last - first)) || !_rbuf_is_dup(entry, first, last))) {
+        DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
+        _rbuf_drop(entry, &_stats.overlap);
+
+        /* "A fresh reassembly may be commenced with the most recently
+         * received link fragment"
+         * https://tools.ietf.org/html/rfc4944#section-5.3 */
+        rbuf_add(netif_hdr, pkt, original_size, offset);
 
-        ptr = ptr->next;
+        return;
     }
 
-    if (_rbuf_update_ints(entry, offset, frag_size)) {
-        DEBUG("6lo rbuf: add fragment data\n");
+    if (received == 0) {
+        DEBUG("6lo rfrag: add units (%u, %u) to entry (%s, ", first, last,
+              gnrc_netif_addr_to_str(entry->src, entry->src_len, l2addr_str));
+        DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(entry->dst, entry->dst_len,
+                                                      l2addr_str),
+              (unsigned)entry->size, entry->tag);
+        for (unsigned i = first; i <= last; i++) {
+            bf_set(entry->received, i);
+        }
+        bf_set(entry->starts, first);
         entry->cur_size += (uint16_t)frag_size;
         memcpy(((uint8_t *)entry->pkt->data) + offset + data_offset, data,
                frag_size - data_offset);
     }
 
-    if (entry->cur_size == entry->pkt->size) {
+    if (entry->cur_size == entry->size) {
         gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(entry->src, entry->src_len,
                                                      entry->dst, entry->dst_len);
 
         if (netif == NULL) {
             DEBUG("6lo rbuf: error allocating netif header\n");
-            gnrc_pktbuf_release(entry->pkt);
-            _rbuf_rem(entry);
+            _rbuf_drop(entry, &_stats.nomem);
             return;
         }
 
@@ -171,96 +186,134 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
          * info of the previous fragments is discarded.
          */
         gnrc_netif_hdr_t *new_netif_hdr = netif->data;
+        gnrc_pktsnip_t *datagram = entry->pkt;
+
         new_netif_hdr->if_pid = netif_hdr->if_pid;
         new_netif_hdr->flags = netif_hdr->flags;
         new_netif_hdr->lqi = netif_hdr->lqi;
         new_netif_hdr->rssi = netif_hdr->rssi;
-        LL_APPEND(entry->pkt, netif);
-        gnrc_sixlowpan_dispatch_recv(entry->pkt, NULL, 0);
+        LL_APPEND(datagram, netif);
         _rbuf_rem(entry);
+        _stats.complete++;
+        gnrc_sixlowpan_dispatch_recv(datagram, NULL, 0);
     }
 }
 
-static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end)
+void gnrc_sixlowpan_frag_rbuf_get_stats(gnrc_sixlowpan_frag_rbuf_stats_t *stats)
 {
-    /* start and ends are both inclusive, so using <= for both */
-    return ((i->start <= end) && (start <= i->end)) && /* overlaps */
-        ((start != i->start) || (end != i->end)); /* not identical */
+    memcpy(stats, &_stats, sizeof(_stats));
 }
 
-static rbuf_int_t *_rbuf_int_get_free(void)
+static unsigned _bucket(const uint8_t *src, size_t src_len,
+                        const uint8_t *dst, size_t dst_len,
+                        size_t size, uint16_t tag)
 {
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
-        }
+    uint32_t hash = ((uint32_t)size << 16) | tag;
+
+    for (unsigned i = 0; i < src_len; i++) {
+        hash = (hash * 31) + src[i];
     }
+    for (unsigned i = 0; i < dst_len; i++) {
+        hash = (hash * 31) + dst[i];
+    }
+    return (hash ^ (hash >> 8) ^ (hash >> 16)) & (RBUF_BUCKETS - 1);
+}
 
-    return NULL;
+static void _lru_rem(rbuf_t *entry)
+{
+    if (entry->lru_prev != NULL) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    }
+    else {
+        _lru_head = entry->lru_next;
+    }
+    if (entry->lru_next != NULL) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    }
+    else {
+        _lru_tail = entry->lru_prev;
+    }
+}
+
+static void _lru_push(rbuf_t *entry)
+{
+    entry->lru_prev = NULL;
+    entry->lru_next = _lru_head;
+    if (_lru_head != NULL) {
+        _lru_head->lru_prev = entry;
+    }
+    else {
+        _lru_tail = entry;
+    }
+    _lru_head = entry;
 }
 
 static void _rbuf_rem(rbuf_t *entry)
 {
-    while (entry->ints != NULL) {
-        rbuf_int_t *next = entry->ints->next;
+    rbuf_t **ptr = &_buckets[_bucket(entry->src, entry->src_len,
+                                     entry->dst, entry->dst_len,
+                                     entry->size, entry->tag)];
 
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
-        entry->ints = next;
+    while (*ptr != entry) {
+        ptr = &(*ptr)->next;
     }
-
+    *ptr = entry->next;
+    _lru_rem(entry);
+    _mem -= entry->size;
     entry->pkt = NULL;
+    entry->next = _free;
+    _free = entry;
 }
 
-static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
+static void _rbuf_drop(rbuf_t *entry, uint32_t *reason)
 {
-    rbuf_int_t *new;
-    uint16_t end = (uint16_t)(offset + frag_size - 1);
+    gnrc_pktbuf_release(entry->pkt);
+    _rbuf_rem(entry);
+    (*reason)++;
+}
 
-    new = _rbuf_int_get_free();
+static unsigned _rbuf_received(rbuf_t *entry, unsigned first, unsigned last)
+{
+    unsigned res = 0;
 
-    if (new == NULL) {
-        DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
-        return false;
+    for (unsigned i = first; i <= last; i++) {
+        if (bf_isset(entry->received, i)) {
+            res++;
+        }
     }
+    return res;
+}
 
-    new->start = offset;
-    new->end = end;
-
-    DEBUG("6lo rfrag: add interval (%" PRIu16 ", %" PRIu16 ") to entry (%s, ",
-          new->start, new->end, gnrc_netif_addr_to_str(entry->src,
-                                                       entry->src_len,
-                                                       l2addr_str));
-    DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(entry->dst, entry->dst_len,
-                                                  l2addr_str),
-          (unsigned)entry->pkt->size, entry->tag);
-
-    LL_PREPEND(entry->ints, new);
-
-    return true;
+static bool _rbuf_is_dup(rbuf_t *entry, unsigned first, unsigned last)
+{
+    if (!bf_isset(entry->starts, first)) {
+        return false;
+    }
+    for (unsigned i = first + 1; i <= last; i++) {
+        if (bf_isset(entry->starts, i)) {
+            return false;
+        }
+    }
+    /* the received fragment must end with last as well */
+    return ((last + 1) >= RBUF_UNITS) || !bf_isset(entry->received, last + 1) ||
+           bf_isset(entry->starts, last + 1);
 }
 
 static void _rbuf_gc(void)
 {
     uint32_t now_usec = xtimer_now_usec();
-    unsigned int i;
-
-    for (i = 0; i < RBUF_SIZE; i++) {
-        /* since pkt occupies pktbuf, aggressivly collect garbage */
-        if ((rbuf[i].pkt != NULL) &&
-              ((now_usec - rbuf[i].arrival) > RBUF_TIMEOUT)) {
-            DEBUG("6lo rfrag: entry (%s, ",
-                  gnrc_netif_addr_to_str(rbuf[i].src, rbuf[i].src_len,
-                                         l2addr_str));
-            DEBUG("%s, %u, %u) timed out\n",
-                  gnrc_netif_addr_to_str(rbuf[i].dst, rbuf[i].dst_len,
-                                         l2addr_str),
-                  (unsigned)rbuf[i].pkt->size, rbuf[i].tag);
-
-            gnrc_pktbuf_release(rbuf[i].pkt);
-            _rbuf_rem(&(rbuf[i]));
-        }
+
+    /* the least recently used entry is the one with the oldest arrival */
+    while ((_lru_tail != NULL) &&
+           ((now_usec - _lru_tail->arrival) > RBUF_TIMEOUT)) {
+        DEBUG("6lo rfrag: entry (%s, ",
+              gnrc_netif_addr_to_str(_lru_tail->src, _lru_tail->src_len,
+                                     l2addr_str));
+        DEBUG("%s, %u, %u) timed out\n",
+              gnrc_netif_addr_to_str(_lru_tail->dst, _lru_tail->dst_len,
+                                     l2addr_str),
+              (unsigned)_lru_tail->size, _lru_tail->tag);
+        _rbuf_drop(_lru_tail, &_stats.timeout);
     }
 }
 
@@ -268,55 +321,64 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
                          size_t size, uint16_t tag)
 {
-    rbuf_t *res = NULL, *oldest = NULL;
+    rbuf_t *res;
+    unsigned bucket = _bucket(src, src_len, dst, dst_len, size, tag);
     uint32_t now_usec = xtimer_now_usec();
 
-    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].pkt->size == size) &&
-            (rbuf[i].tag == tag) && (rbuf[i].src_len == src_len) &&
-            (rbuf[i].dst_len == dst_len) &&
-            (memcmp(rbuf[i].src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(rbuf[i].src, rbuf[i].src_len,
-                                         l2addr_str));
+    /* check first if entry already available */
+    for (res = _buckets[bucket]; res != NULL; res = res->next) {
+        if ((res->size == size) && (res->tag == tag) &&
+            (res->src_len == src_len) && (res->dst_len == dst_len) &&
+            (memcmp(res->src, src, src_len) == 0) &&
+            (memcmp(res->dst, dst, dst_len) == 0)) {
+            DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
+                  gnrc_netif_addr_to_str(res->src, res->src_len, l2addr_str));
             DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(rbuf[i].dst, rbuf[i].dst_len,
-                                         l2addr_str),
-                  (unsigned)rbuf[i].pkt->size, rbuf[i].tag);
-            rbuf[i].arrival = now_usec;
-            return &(rbuf[i]);
-        }
-
-        /* if there is a free spot: remember it */
-        if ((res == NULL) && (rbuf[i].pkt == NULL)) {
-            res = &(rbuf[i]);
-        }
-
-        /* remember oldest slot */
-        /* note that xtimer_now will overflow in ~1.2 hours */
-        if ((oldest == NULL) || (oldest->arrival - rbuf[i].arrival < UINT32_MAX / 2)) {
-            oldest = &(rbuf[i]);
+                  gnrc_netif_addr_to_str(res->dst, res->dst_len, l2addr_str),
+                  (unsigned)res->size, res->tag);
+            res->arrival = now_usec;
+            _lru_rem(res);
+            _lru_push(res);
+            return res;
         }
     }
 
-    /* entry not in buffer and no empty spot found */
-    if (res == NULL) {
-        assert(oldest != NULL);
-        assert(oldest->pkt != NULL); /* if oldest->pkt == NULL, res must not be NULL */
-        DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
-        gnrc_pktbuf_release(oldest->pkt);
-        _rbuf_rem(oldest);
-        res = oldest;
+    if (size > RBUF_MEM_MAX) {
+        DEBUG("6lo rfrag: datagram exceeds reassembly buffer memory\n");
+        _stats.nomem++;
+        return NULL;
+    }
+    /* make room for the new datagram by evicting the least recently used
+     * entries */
+    while ((_lru_tail != NULL) &&
+           (((_mem + size) > RBUF_MEM_MAX) ||
+            ((_free == NULL) && (_used == RBUF_SIZE)))) {
+        DEBUG("6lo rfrag: reassembly buffer full, remove least recently "
+              "used entry\n");
+        _rbuf_drop(_lru_tail, &_stats.evicted);
+    }
+    if (_free != NULL) {
+        res = _free;
+        _free = res->next;
+    }
+    else {
+        res = &rbuf[_used++];
     }
 
     /* now we have an empty spot */
 
-    res->pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_IPV6);
-    if (res->pkt == NULL) {
-        DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
-        return NULL;
+    while ((res->pkt = gnrc_pktbuf_add(NULL, NULL, size,
+                                       GNRC_NETTYPE_IPV6)) == NULL) {
+        if (_lru_tail == NULL) {
+            DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
+            res->next = _free;
+            _free = res;
+            _stats.nomem++;
+            return NULL;
+        }
+        /* the packet buffer is shared with the rest of the stack, so it can
+         * run out before RBUF_MEM_MAX is reached */
+        _rbuf_drop(_lru_tail, &_stats.evicted);
     }
 
     *((uint64_t *)res->pkt->data) = 0;  /* clean first few bytes for later
@@ -327,13 +389,20 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     res->src_len = src_len;
     res->dst_len = dst_len;
     res->tag = tag;
+    res->size = size;
     res->cur_size = 0;
+    memset(res->received, 0, sizeof(res->received));
+    memset(res->starts, 0, sizeof(res->starts));
+    res->next = _buckets[bucket];
+    _buckets[bucket] = res;
+    _lru_push(res);
+    _mem += size;
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(res->src, res->src_len, l2addr_str));
     DEBUG("%s, %u, %u) created\n",
-          gnrc_netif_addr_to_str(res->dst, res->dst_len, l2addr_str), (unsigned)res->pkt->size,
-          res->tag);
+          gnrc_netif_addr_to_str(res->dst, res->dst_len, l2addr_str),
+          (unsigned)res->size, res->tag);
 
     return res;
 }
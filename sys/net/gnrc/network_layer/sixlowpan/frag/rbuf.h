@@ -21,8 +21,12 @@
 
 #include <inttypes.h>
 
+#include "bitfield.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/pkt.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/ipv6.h"
+#include "net/sixlowpan.h"
 
 #include "net/gnrc/sixlowpan/frag.h"
 #ifdef __cplusplus
@@ -31,26 +35,63 @@ extern "C" {
 #endif
 
 #define RBUF_L2ADDR_MAX_LEN (8U)               /**< maximum length for link-layer addresses */
-#define RBUF_SIZE           (4U)               /**< size of the reassembly buffer */
-#define RBUF_TIMEOUT        (3U * US_PER_SEC) /**< timeout for reassembly in microseconds */
 
 /**
- * @brief   Fragment intervals to identify limits of fragments.
+ * @brief   Number of entries in the reassembly buffer
+ *
+ * Bounds the number of datagrams in reassembly at the same time. An entry
+ * only holds the meta data of a datagram, the datagram itself is held in the
+ * packet buffer, bounded by @ref RBUF_MEM_MAX.
+ *
+ * @note    The entries are allocated statically, so unlike the datagrams
+ *          they are not bounded by memory. If all are in use, the least
+ *          recently used datagram is evicted even if @ref RBUF_MEM_MAX is
+ *          not reached yet.
+ */
+#ifndef RBUF_SIZE
+#define RBUF_SIZE           (8U)
+#endif
+
+/**
+ * @brief   Number of hash buckets to look up entries by their datagram
+ *
+ * @note    Must be a power of 2
+ */
+#ifndef RBUF_BUCKETS
+#define RBUF_BUCKETS        (8U)
+#endif
+
+/**
+ * @brief   Maximum number of bytes of the packet buffer all datagrams in
+ *          reassembly may take
  *
- * @note    Fragments MUST NOT overlap and overlapping fragments are to be
- *          discarded
+ * If a new datagram does not fit, the least recently used datagrams are
+ * evicted. Datagrams larger than this are not reassembled at all, so by
+ * default the whole packet buffer may be used.
+ */
+#ifndef RBUF_MEM_MAX
+#if GNRC_PKTBUF_SIZE > 0
+#define RBUF_MEM_MAX        (GNRC_PKTBUF_SIZE)
+#else
+#define RBUF_MEM_MAX        (RBUF_SIZE * IPV6_MIN_MTU)
+#endif
+#endif
+
+#define RBUF_TIMEOUT        (3U * US_PER_SEC) /**< timeout for reassembly in microseconds */
+
+/**
+ * @brief   Granularity of fragment offsets in bytes
  *
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
- *
- * @internal
  */
-typedef struct rbuf_int {
-    struct rbuf_int *next;  /**< next element in interval list */
-    uint16_t start;         /**< start byte of interval */
-    uint16_t end;           /**< end byte of interval */
-} rbuf_int_t;
+#define RBUF_UNIT           (8U)
+
+/**
+ * @brief   Number of units of the largest possible datagram
+ */
+#define RBUF_UNITS          ((SIXLOWPAN_FRAG_MAX_LEN + RBUF_UNIT - 1) / RBUF_UNIT)
 
 /**
  * @brief   An entry in the 6LoWPAN reassembly buffer.
@@ -59,7 +100,7 @@ typedef struct rbuf_int {
  *
  * 1. the source address,
  * 2. the destination address,
- * 3. the datagram size (gnrc_pktsnip_t::size of rbuf_t::pkt), and
+ * 3. the datagram size (rbuf_t::size), and
  * 4. the datagram tag
  *
  * to identify all fragments that belong to the given datagram.
@@ -70,8 +111,11 @@ typedef struct rbuf_int {
  *
  * @internal
  */
-typedef struct {
-    rbuf_int_t *ints;                   /**< intervals of the fragment */
+typedef struct rbuf {
+    struct rbuf *next;                  /**< next entry in the same hash bucket
+                                         *   or in the list of free entries */
+    struct rbuf *lru_prev;              /**< more recently used entry */
+    struct rbuf *lru_next;              /**< less recently used entry */
     gnrc_pktsnip_t *pkt;                /**< the reassembled packet in packet buffer */
     uint32_t arrival;                   /**< time in microseconds of arrival of
                                          *   last received fragment */
@@ -80,7 +124,12 @@ typedef struct {
     uint8_t src_len;                    /**< length of source address */
     uint8_t dst_len;                    /**< length of destination address */
     uint16_t tag;                       /**< the datagram's tag */
+    uint16_t size;                      /**< the datagram's size */
     uint16_t cur_size;                  /**< the datagram's current size */
+    BITFIELD(received, RBUF_UNITS);     /**< units of @ref RBUF_UNIT bytes
+                                         *   received */
+    BITFIELD(starts, RBUF_UNITS);       /**< first units of the fragments
+                                         *   received */
 } rbuf_t;
 
 /**
@@ -12,7 +12,9 @@
  * @file
  */
 
+#include "irq.h"
 #include "kernel_types.h"
+#include "mutex.h"
 #include "net/gnrc.h"
 #include "thread.h"
 #include "utlist.h"
@@ -22,6 +24,9 @@
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/gnrc/sixlowpan/iphc.h"
 #include "net/gnrc/netif.h"
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+#include "net/gnrc/netapi/direct.h"
+#endif
 #include "net/sixlowpan.h"
 
 #define ENABLE_DEBUG    (0)
@@ -38,6 +43,14 @@ static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static gnrc_sixlowpan_msg_frag_t fragment_msg = {KERNEL_PID_UNDEF, NULL, 0, 0};
 #endif
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static gnrc_netapi_direct_t _layer;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+/* the reassembly buffer is shared by the threads of all interfaces */
+static mutex_t _rbuf_lock = MUTEX_INIT;
+#endif
+#endif
+
 #if ENABLE_DEBUG
 static char _stack[GNRC_SIXLOWPAN_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
@@ -164,7 +177,13 @@ static void _receive(gnrc_pktsnip_t *pkt)
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG
     else if (sixlowpan_frag_is((sixlowpan_frag_t *)dispatch)) {
         DEBUG("6lo: received 6LoWPAN fragment\n");
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+        mutex_lock(&_rbuf_lock);
+        gnrc_sixlowpan_frag_handle_pkt(pkt);
+        mutex_unlock(&_rbuf_lock);
+#else
         gnrc_sixlowpan_frag_handle_pkt(pkt);
+#endif
         return;
     }
 #endif
@@ -305,18 +324,23 @@ static void _send(gnrc_pktsnip_t *pkt)
         return;
     }
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG
-    else if (fragment_msg.pkt != NULL) {
-        DEBUG("6lo: Fragmentation already ongoing. Dropping packet\n");
-        gnrc_pktbuf_release(pkt2);
-        return;
-    }
     else if (datagram_size <= SIXLOWPAN_FRAG_MAX_LEN) {
         DEBUG("6lo: Send fragmented (%u > %" PRIu8 ")\n",
               (unsigned int)datagram_size, iface->sixlo.max_frag_size);
         msg_t msg;
+        /* _send() may be called by any thread with gnrc_netapi_direct, so
+         * claim the fragmentation buffer atomically */
+        unsigned state = irq_disable();
 
-        fragment_msg.pid = hdr->if_pid;
+        if (fragment_msg.pkt != NULL) {
+            irq_restore(state);
+            DEBUG("6lo: Fragmentation already ongoing. Dropping packet\n");
+            gnrc_pktbuf_release(pkt2);
+            return;
+        }
         fragment_msg.pkt = pkt2;
+        irq_restore(state);
+        fragment_msg.pid = hdr->if_pid;
         fragment_msg.datagram_size = datagram_size;
         /* Sending the first fragment has an offset==0 */
         fragment_msg.offset = 0;
@@ -324,8 +348,12 @@ static void _send(gnrc_pktsnip_t *pkt)
         /* set the outgoing message's fields */
         msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
         msg.content.ptr = &fragment_msg;
-        /* send message to self */
-        msg_send_to_self(&msg);
+        /* fragments are always sent by the 6LoWPAN thread */
+        if (msg_try_send(&msg, _pid) < 1) {
+            DEBUG("6lo: unable to start fragmentation\n");
+            fragment_msg.pkt = NULL;
+            gnrc_pktbuf_release(pkt2);
+        }
     }
     else {
         DEBUG("6lo: packet too big (%u > %" PRIu16 ")\n",
@@ -340,17 +368,41 @@ static void _send(gnrc_pktsnip_t *pkt)
 #endif
 }
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static void _direct(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    switch (cmd) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            _receive(pkt);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            _send(pkt);
+            break;
+        default:
+            gnrc_pktbuf_release(pkt);
+            break;
+    }
+}
+#endif
+
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_SIXLOWPAN_MSG_QUEUE_SIZE];
+#ifndef MODULE_GNRC_NETAPI_DIRECT
     gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
+#endif
 
     (void)args;
     msg_init_queue(msg_q, GNRC_SIXLOWPAN_MSG_QUEUE_SIZE);
 
     /* register interest in all 6LoWPAN packets */
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    gnrc_netapi_direct_register(&_layer, GNRC_NETTYPE_SIXLOWPAN, _direct);
+#else
     gnrc_netreg_register(GNRC_NETTYPE_SIXLOWPAN, &me_reg);
+#endif
 
     /* preinitialize ACK */
     reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
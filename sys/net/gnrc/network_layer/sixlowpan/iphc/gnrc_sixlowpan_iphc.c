@@ -22,6 +22,7 @@
 #include "net/ieee802154.h"
 #include "net/ipv6/hdr.h"
 #include "net/gnrc.h"
+#include "net/gnrc/netif/internal.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "net/sixlowpan.h"
 #include "utlist.h"
@@ -727,9 +728,16 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
                                    netif_hdr->src_l2addr_len);
             }
             else {
-                /* but take from driver otherwise */
-                gnrc_netapi_get(netif_hdr->if_pid, NETOPT_IPV6_IID, 0, &iid,
-                                sizeof(eui64_t));
+                /* but take from interface otherwise. Don't ask the interface
+                 * thread for it, with gnrc_netapi_direct this may already run
+                 * in that thread, e.g. for replies to received packets */
+                gnrc_netif_t *netif = gnrc_netif_get_by_pid(netif_hdr->if_pid);
+
+                if (netif != NULL) {
+                    gnrc_netif_acquire(netif);
+                    gnrc_netif_ipv6_get_iid(netif, &iid);
+                    gnrc_netif_release(netif);
+                }
             }
 
             if ((ipv6_hdr->src.u64[1].u64 == iid.uint64.u64) ||
@@ -0,0 +1,594 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Packet buffer implementation based on fixed size classes
+ *
+ * Every size class is a static array of equally sized blocks with its own
+ * free list, so allocation and release never have to walk over holes. Packet
+ * snips are taken from a dedicated class, data is taken from the smallest
+ * payload class that fits and has a free block. Since gnrc_pktbuf_mark()
+ * splits the data of one snip into two snips, every block carries a reference
+ * counter and is only returned to its free list when the last snip pointing
+ * into it is released.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#include "mutex.h"
+#include "utlist.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _ALIGNMENT_MASK     (sizeof(void *) - 1)
+#define _ALIGN(size)        (((size) + _ALIGNMENT_MASK) & ~(_ALIGNMENT_MASK))
+
+#define _SNIP_SIZE          _ALIGN(sizeof(gnrc_pktsnip_t))
+#define _SMALL_SIZE         _ALIGN(GNRC_PKTBUF_SLAB_SMALL_SIZE)
+#define _MEDIUM_SIZE        _ALIGN(GNRC_PKTBUF_SLAB_MEDIUM_SIZE)
+#define _LARGE_SIZE         _ALIGN(GNRC_PKTBUF_SLAB_LARGE_SIZE)
+
+#if (GNRC_PKTBUF_SLAB_SMALL_SIZE > GNRC_PKTBUF_SLAB_MEDIUM_SIZE) || \
+    (GNRC_PKTBUF_SLAB_MEDIUM_SIZE > GNRC_PKTBUF_SLAB_LARGE_SIZE)
+#error "gnrc_pktbuf_slab: size classes must be in ascending order"
+#endif
+
+/**
+ * @brief   Index of the snip class in _slabs
+ */
+#define _SNIP_SLAB          (0U)
+
+/**
+ * @brief   Index of the first payload class in _slabs
+ */
+#define _PAYLOAD_SLAB       (1U)
+
+typedef struct _free_block {
+    struct _free_block *next;
+} _free_block_t;
+
+typedef struct {
+    uint8_t *pool;          /**< first block of the class */
+    uint8_t *refs;          /**< number of snips referencing each block */
+    _free_block_t *free;    /**< free list of the class */
+    uint16_t size;          /**< size of a block */
+    uint16_t numof;         /**< number of blocks */
+    uint16_t used;          /**< number of blocks currently in use */
+#ifdef DEVELHELP
+    uint16_t max_used;      /**< high-watermark of used blocks */
+    uint16_t fails;         /**< number of failed allocations */
+#endif
+} _slab_t;
+
+static mutex_t _mutex = MUTEX_INIT;
+
+/* pools are declared as void * arrays to get pointer alignment */
+static void *_snip_pool[(GNRC_PKTBUF_SLAB_SNIP_NUMOF * _SNIP_SIZE) /
+                        sizeof(void *)];
+static void *_small_pool[(GNRC_PKTBUF_SLAB_SMALL_NUMOF * _SMALL_SIZE) /
+                         sizeof(void *)];
+static void *_medium_pool[(GNRC_PKTBUF_SLAB_MEDIUM_NUMOF * _MEDIUM_SIZE) /
+                          sizeof(void *)];
+static void *_large_pool[(GNRC_PKTBUF_SLAB_LARGE_NUMOF * _LARGE_SIZE) /
+                         sizeof(void *)];
+static uint8_t _snip_refs[GNRC_PKTBUF_SLAB_SNIP_NUMOF];
+static uint8_t _small_refs[GNRC_PKTBUF_SLAB_SMALL_NUMOF];
+static uint8_t _medium_refs[GNRC_PKTBUF_SLAB_MEDIUM_NUMOF];
+static uint8_t _large_refs[GNRC_PKTBUF_SLAB_LARGE_NUMOF];
+
+#define _SLAB_INIT(pool_, refs_, size_, numof_) \
+    { .pool = (uint8_t *)(pool_), .refs = (refs_), .size = (size_), \
+      .numof = (numof_) }
+
+static _slab_t _slabs[] = {
+    _SLAB_INIT(_snip_pool, _snip_refs, _SNIP_SIZE, GNRC_PKTBUF_SLAB_SNIP_NUMOF),
+    _SLAB_INIT(_small_pool, _small_refs, _SMALL_SIZE, GNRC_PKTBUF_SLAB_SMALL_NUMOF),
+    _SLAB_INIT(_medium_pool, _medium_refs, _MEDIUM_SIZE, GNRC_PKTBUF_SLAB_MEDIUM_NUMOF),
+    _SLAB_INIT(_large_pool, _large_refs, _LARGE_SIZE, GNRC_PKTBUF_SLAB_LARGE_NUMOF),
+};
+
+#define _SLABS_NUMOF        (sizeof(_slabs) / sizeof(_slabs[0]))
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void _data_release(void *data);
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+/* finds the size class @p ptr belongs to and the index of its block */
+static _slab_t *_slab_of(const void *ptr, unsigned *idx)
+{
+    for (unsigned i = 0; i < _SLABS_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+        /* wraps around for ptr < slab->pool */
+        uintptr_t offset = (uintptr_t)ptr - (uintptr_t)slab->pool;
+
+        if (offset < ((uintptr_t)slab->size * slab->numof)) {
+            *idx = offset / slab->size;
+            return slab;
+        }
+    }
+    return NULL;
+}
+
+static inline uint8_t *_block(const _slab_t *slab, unsigned idx)
+{
+    return slab->pool + ((size_t)idx * slab->size);
+}
+
+/* smallest payload class that fits @p size, regardless of its free blocks */
+static _slab_t *_fit(size_t size)
+{
+    for (unsigned i = _PAYLOAD_SLAB; i < _SLABS_NUMOF; i++) {
+        if (size <= _slabs[i].size) {
+            return &_slabs[i];
+        }
+    }
+    return NULL;
+}
+
+static void *_slab_alloc(_slab_t *slab)
+{
+    _free_block_t *block = slab->free;
+    unsigned idx;
+
+    if (block == NULL) {
+        return NULL;
+    }
+    slab->free = block->next;
+    idx = ((uint8_t *)block - slab->pool) / slab->size;
+    assert(slab->refs[idx] == 0);
+    slab->refs[idx] = 1;
+    slab->used++;
+#ifdef DEVELHELP
+    if (slab->used > slab->max_used) {
+        slab->max_used = slab->used;
+    }
+#endif
+    return block;
+}
+
+static void _slab_free(_slab_t *slab, unsigned idx)
+{
+    _free_block_t *block = (_free_block_t *)_block(slab, idx);
+
+    assert(slab->used > 0);
+    block->next = slab->free;
+    slab->free = block;
+    slab->used--;
+}
+
+/* takes a block of the best fitting payload class, falls back to bigger
+ * classes when that one is exhausted */
+static void *_data_alloc(size_t size)
+{
+    _slab_t *slab = _fit(size);
+
+    if (slab == NULL) {
+        DEBUG("pktbuf: size (%u) exceeds largest size class (%u)\n",
+              (unsigned)size, (unsigned)_LARGE_SIZE);
+        return NULL;
+    }
+    for (_slab_t *tmp = slab; tmp < &_slabs[_SLABS_NUMOF]; tmp++) {
+        void *data = _slab_alloc(tmp);
+
+        if (data != NULL) {
+            return data;
+        }
+    }
+#ifdef DEVELHELP
+    slab->fails++;
+#endif
+    DEBUG("pktbuf: no block left for size %u\n", (unsigned)size);
+    return NULL;
+}
+
+static void _data_release(void *data)
+{
+    unsigned idx;
+    _slab_t *slab;
+
+    if ((data == NULL) || ((slab = _slab_of(data, &idx)) == NULL)) {
+        return;
+    }
+    assert(slab->refs[idx] > 0);
+    if (--slab->refs[idx] == 0) {
+        _slab_free(slab, idx);
+    }
+}
+
+static gnrc_pktsnip_t *_snip_alloc(void)
+{
+    gnrc_pktsnip_t *pkt = _slab_alloc(&_slabs[_SNIP_SLAB]);
+
+#ifdef DEVELHELP
+    if (pkt == NULL) {
+        _slabs[_SNIP_SLAB].fails++;
+    }
+#endif
+    return pkt;
+}
+
+static inline void _snip_free(gnrc_pktsnip_t *pkt)
+{
+    _slab_t *slab = &_slabs[_SNIP_SLAB];
+    unsigned idx = ((uint8_t *)pkt - slab->pool) / slab->size;
+
+    slab->refs[idx] = 0;
+    _slab_free(slab, idx);
+}
+
+void gnrc_pktbuf_init(void)
+{
+    mutex_lock(&_mutex);
+    for (unsigned i = 0; i < _SLABS_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+
+        slab->free = NULL;
+        /* build free list back to front so blocks are handed out in order */
+        for (unsigned j = slab->numof; j > 0; j--) {
+            _free_block_t *block = (_free_block_t *)_block(slab, j - 1);
+
+            block->next = slab->free;
+            slab->free = block;
+        }
+        memset(slab->refs, 0, slab->numof);
+        slab->used = 0;
+#ifdef DEVELHELP
+        slab->max_used = 0;
+        slab->fails = 0;
+#endif
+    }
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > _LARGE_SIZE) {
+        DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SLAB_LARGE_SIZE (%u)\n",
+              (unsigned)size, (unsigned)_LARGE_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _snip_alloc();
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    _set_pktsnip(marked_snip, pkt->next, pkt->data, size, type);
+    if (pkt->size == size) {
+        pkt->data = NULL;
+    }
+    else {
+        unsigned idx;
+        _slab_t *slab = _slab_of(pkt->data, &idx);
+
+        /* both snips now point into the same block */
+        if (slab != NULL) {
+            assert(slab->refs[idx] < UINT8_MAX);
+            slab->refs[idx]++;
+        }
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    pkt->size -= size;
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    unsigned idx = 0;
+    _slab_t *slab = NULL;
+    void *new_data;
+
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) &&
+            (_slab_of(pkt->data, &idx) != NULL)));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        _data_release(pkt->data);
+        pkt->data = NULL;
+        pkt->size = 0;
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    if (pkt->data != NULL) {
+        slab = _slab_of(pkt->data, &idx);
+    }
+    if (slab != NULL) {
+        size_t end = ((uint8_t *)pkt->data - _block(slab, idx)) + size;
+
+        if (size < pkt->size) {
+            _slab_t *best = _fit(size);
+
+            /* keep shrunk data in place unless it is the only user of a block
+             * and a smaller class has room (e.g. after a receive buffer
+             * of maximum frame size was cut to the actual frame length) */
+            if ((slab->refs[idx] > 1) || (best >= slab) || (best->free == NULL)) {
+                pkt->size = size;
+                mutex_unlock(&_mutex);
+                return 0;
+            }
+        }
+        else if ((slab->refs[idx] == 1) && (end <= slab->size)) {
+            /* grow within block */
+            pkt->size = size;
+            mutex_unlock(&_mutex);
+            return 0;
+        }
+    }
+    new_data = _data_alloc(size);
+    if (new_data == NULL) {
+        DEBUG("pktbuf: error allocating new data section\n");
+        mutex_unlock(&_mutex);
+        return ENOMEM;
+    }
+    if (pkt->data != NULL) {            /* if old data exist */
+        memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
+    }
+    _data_release(pkt->data);
+    pkt->data = new_data;
+    pkt->size = size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(pkt->users > 0);
+        tmp = pkt->next;
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            _data_release(pkt->data);
+            _snip_free(pkt);
+        }
+        else {
+            pkt->users--;
+        }
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        pkt = tmp;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    _release_error_locked(pkt, err);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if ((pkt == NULL) || (pkt->size == 0)) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    static const char *names[] = { "snip", "small", "medium", "large" };
+
+    mutex_lock(&_mutex);
+    printf("packet buffer: slab allocator (%u bytes)\n",
+           (unsigned)(sizeof(_snip_pool) + sizeof(_small_pool) +
+                      sizeof(_medium_pool) + sizeof(_large_pool)));
+    printf("%8s %6s %6s %6s %6s %6s\n", "class", "size", "numof", "used",
+           "max", "fails");
+    for (unsigned i = 0; i < _SLABS_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+
+        printf("%8s %6u %6u %6u %6u %6u\n", names[i], slab->size, slab->numof,
+               slab->used, slab->max_used, slab->fails);
+    }
+    mutex_unlock(&_mutex);
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    for (unsigned i = 0; i < _SLABS_NUMOF; i++) {
+        if (_slabs[i].used > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    /* Invariants of this implementation (per size class):
+     *  - every free block is the start of a block in the pool
+     *  - free blocks are not referenced by any snip
+     *  - number of free blocks + used == numof
+     */
+    for (unsigned i = 0; i < _SLABS_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+        unsigned free_numof = 0;
+
+        for (_free_block_t *ptr = slab->free; ptr != NULL; ptr = ptr->next) {
+            uintptr_t offset = (uintptr_t)ptr - (uintptr_t)slab->pool;
+
+            if ((offset >= ((uintptr_t)slab->size * slab->numof)) ||
+                ((offset % slab->size) != 0) ||
+                (slab->refs[offset / slab->size] != 0) ||
+                (++free_numof > slab->numof)) {
+                return false;
+            }
+        }
+        if ((free_numof + slab->used) != slab->numof) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _snip_alloc();
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _data_alloc(size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _snip_free(pkt);
+            return NULL;
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    if ((data != NULL) && (size > 0)) {
+        memcpy(_data, data, size);
+    }
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t type)
+{
+    mutex_lock(&_mutex);
+
+    bool is_shared = pkt->users > 1;
+    size_t size = gnrc_pkt_len_upto(pkt, type);
+
+    DEBUG("ipv6_ext: duplicating %d octets\n", (int) size);
+
+    gnrc_pktsnip_t *tmp;
+    gnrc_pktsnip_t *target = gnrc_pktsnip_search_type(pkt, type);
+    gnrc_pktsnip_t *next = (target == NULL) ? NULL : target->next;
+    gnrc_pktsnip_t *new = _create_snip(next, NULL, size, type);
+
+    if (new == NULL) {
+        mutex_unlock(&_mutex);
+
+        return NULL;
+    }
+
+    /* copy payloads */
+    for (tmp = pkt; tmp != NULL; tmp = tmp->next) {
+        uint8_t *dest = ((uint8_t *)new->data) + (size - tmp->size);
+
+        memcpy(dest, tmp->data, tmp->size);
+
+        size -= tmp->size;
+
+        if (tmp->type == type) {
+            break;
+        }
+    }
+
+    /* decrements reference counters */
+
+    if (target != NULL) {
+        target->next = NULL;
+    }
+
+    _release_error_locked(pkt, GNRC_NETERR_SUCCESS);
+
+    if (is_shared && (target != NULL)) {
+        target->next = next;
+    }
+
+    mutex_unlock(&_mutex);
+
+    return new;
+}
+
+/** @} */
@@ -26,6 +26,9 @@
 #include "sock_types.h"
 #include "gnrc_sock_internal.h"
 
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
 #ifdef MODULE_XTIMER
 #define _TIMEOUT_MAGIC      (0xF38A0B63U)
 #define _TIMEOUT_MSG_TYPE   (0x8474)
@@ -43,10 +46,35 @@ static void _callback_put(void *arg)
 }
 #endif
 
+#ifdef SOCK_HAS_ASYNC
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    msg_t msg = { .type = cmd, .content = { .ptr = pkt } };
+    gnrc_sock_reg_t *reg = ctx;
+
+    if (mbox_try_put(&reg->mbox, &msg) < 1) {
+        DEBUG("gnrc_sock: dropped message to %p (was full)\n", (void *)reg);
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if (reg->async_cb.generic != NULL) {
+        reg->async_cb.generic(reg, reg->async_cb_arg);
+    }
+}
+#endif
+
 void gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_ctx)
 {
     mbox_init(&reg->mbox, reg->mbox_queue, SOCK_MBOX_SIZE);
+#ifdef SOCK_HAS_ASYNC
+    /* queue in the mbox from a callback, so the sock can be notified after
+     * the packet is available */
+    reg->netreg_cb.cb = _netapi_cb;
+    reg->netreg_cb.ctx = reg;
+    gnrc_netreg_entry_init_cb(&reg->entry, demux_ctx, &reg->netreg_cb);
+#else
     gnrc_netreg_entry_init_mbox(&reg->entry, demux_ctx, &reg->mbox);
+#endif
     gnrc_netreg_register(type, &reg->entry);
 }
 
@@ -31,6 +31,10 @@
 #include "net/gnrc/netreg.h"
 #include "net/sock/ip.h"
 #include "net/sock/udp.h"
+#ifdef MODULE_GNRC_SOCK_TCP
+#include "net/gnrc/tcp/tcb.h"
+#include "net/sock/tcp.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -51,6 +55,26 @@ typedef struct gnrc_sock_reg {
     gnrc_netreg_entry_t entry;          /**< @ref net_gnrc_netreg entry for mbox */
     mbox_t mbox;                        /**< @ref core_mbox target for the sock */
     msg_t mbox_queue[SOCK_MBOX_SIZE];   /**< queue for gnrc_sock_reg_t::mbox */
+#if defined(SOCK_HAS_ASYNC) || defined(DOXYGEN)
+    /**
+     * @brief   Callback for gnrc_sock_reg_t::entry, queues received packets
+     *          in gnrc_sock_reg_t::mbox and calls gnrc_sock_reg_t::async_cb
+     */
+    gnrc_netreg_entry_cbd_t netreg_cb;
+    /**
+     * @brief   Receive notification of the sock
+     */
+    union {
+        /**
+         * @brief   Called by the implementation, gnrc_sock_reg_t is the first
+         *          member of every sock type
+         */
+        void (*generic)(struct gnrc_sock_reg *reg, void *arg);
+        sock_ip_cb_t ip;                /**< for a raw IP sock */
+        sock_udp_cb_t udp;              /**< for a UDP sock */
+    } async_cb;
+    void *async_cb_arg;                 /**< argument for gnrc_sock_reg_t::async_cb */
+#endif
 } gnrc_sock_reg_t;
 
 /**
@@ -75,6 +99,28 @@ struct sock_udp {
     uint16_t flags;                     /**< option flags */
 };
 
+#if defined(MODULE_GNRC_SOCK_TCP) || defined(DOXYGEN)
+/**
+ * @brief   TCP sock type
+ * @internal
+ *
+ * @note    Consists only of the TCB, so the `queue_array` of
+ *          sock_tcp_listen() is used as the TCBs of the listening queue.
+ */
+struct sock_tcp {
+    gnrc_tcp_tcb_t tcb;                 /**< TCB of the connection */
+};
+
+/**
+ * @brief   TCP queue type
+ * @internal
+ */
+struct sock_tcp_queue {
+    gnrc_tcp_tcb_queue_t queue;         /**< listening queue of the TCBs */
+    sock_tcp_ep_t local;                /**< local end-point */
+};
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -53,6 +53,9 @@ int sock_ip_create(sock_ip_t *sock, const sock_ip_ep_t *local,
         }
         gnrc_ep_set(&sock->remote, remote, sizeof(sock_ip_ep_t));
     }
+#ifdef SOCK_HAS_ASYNC
+    sock->reg.async_cb.generic = NULL;
+#endif
     gnrc_sock_create(&sock->reg, GNRC_NETTYPE_IPV6,
                      proto);
     sock->flags = flags;
@@ -196,4 +199,14 @@ ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
     return res;
 }
 
+#ifdef SOCK_HAS_ASYNC
+void sock_ip_set_cb(sock_ip_t *sock, sock_ip_cb_t cb, void *arg)
+{
+    assert(sock != NULL);
+    /* the stack may call the callback any time, so set its argument first */
+    sock->reg.async_cb_arg = arg;
+    sock->reg.async_cb.ip = cb;
+}
+#endif
+
 /** @} */
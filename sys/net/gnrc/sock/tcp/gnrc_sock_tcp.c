@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       GNRC implementation of @ref net_sock_tcp
+ *
+ * The socks of a listening queue are the TCBs of a @ref net_gnrc_tcp
+ * listening queue, so incoming connections are handled by the TCP thread
+ * while the user is busy with previously accepted ones.
+ *
+ * @note    The sock_tcp_ep_t::netif of end points is not considered, since
+ *          @ref net_gnrc_tcp does not bind connections to an interface.
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "net/af.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/tcp.h"
+#include "net/sock/tcp.h"
+
+/**
+ * @brief   Fills an end point from the address and port of a TCB
+ */
+static void _tcb_to_ep(const uint8_t *addr, uint16_t port, sock_tcp_ep_t *ep)
+{
+    ep->family = AF_INET6;
+    memcpy(&ep->addr.ipv6, addr, sizeof(ipv6_addr_t));
+    ep->netif = SOCK_ADDR_ANY_NETIF;
+    ep->port = port;
+}
+
+int sock_tcp_connect(sock_tcp_t *sock, const sock_tcp_ep_t *remote,
+                     uint16_t local_port, uint16_t flags)
+{
+    assert((sock != NULL) && (remote != NULL) && (remote->port != 0));
+    (void)flags;
+    if (remote->family != AF_INET6) {
+        return -EAFNOSUPPORT;
+    }
+    if (ipv6_addr_is_unspecified((const ipv6_addr_t *)&remote->addr.ipv6) ||
+        ipv6_addr_is_multicast((const ipv6_addr_t *)&remote->addr.ipv6)) {
+        return -EINVAL;
+    }
+    gnrc_tcp_tcb_init(&sock->tcb);
+    return gnrc_tcp_open_active(&sock->tcb, AF_INET6, remote->addr.ipv6,
+                                remote->port, local_port);
+}
+
+int sock_tcp_listen(sock_tcp_queue_t *queue, const sock_tcp_ep_t *local,
+                    sock_tcp_t *queue_array, unsigned queue_len,
+                    uint16_t flags)
+{
+    const uint8_t *local_addr = NULL;
+
+    assert((queue != NULL) && (local != NULL) && (local->port != 0));
+    assert((queue_array != NULL) && (queue_len != 0));
+    (void)flags;
+    if (local->family != AF_INET6) {
+        return -EAFNOSUPPORT;
+    }
+    if (!ipv6_addr_is_unspecified((const ipv6_addr_t *)&local->addr.ipv6)) {
+        local_addr = local->addr.ipv6;
+    }
+    memcpy(&queue->local, local, sizeof(sock_tcp_ep_t));
+    /* a sock consists only of its TCB, so queue_array is an array of TCBs */
+    return gnrc_tcp_listen(&queue->queue, &queue_array[0].tcb, queue_len,
+                           AF_INET6, local_addr, local->port);
+}
+
+void sock_tcp_disconnect(sock_tcp_t *sock)
+{
+    assert(sock != NULL);
+    gnrc_tcp_close(&sock->tcb);
+}
+
+void sock_tcp_stop_listen(sock_tcp_queue_t *queue)
+{
+    assert(queue != NULL);
+    gnrc_tcp_stop_listen(&queue->queue);
+    queue->local.family = AF_UNSPEC;
+}
+
+int sock_tcp_get_local(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    assert((sock != NULL) && (ep != NULL));
+    if (sock->tcb.local_port == 0) {
+        return -EADDRNOTAVAIL;
+    }
+    _tcb_to_ep(sock->tcb.local_addr, sock->tcb.local_port, ep);
+    return 0;
+}
+
+int sock_tcp_get_remote(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    assert((sock != NULL) && (ep != NULL));
+    if (sock->tcb.peer_port == 0) {
+        return -ENOTCONN;
+    }
+    _tcb_to_ep(sock->tcb.peer_addr, sock->tcb.peer_port, ep);
+    return 0;
+}
+
+int sock_tcp_queue_get_local(sock_tcp_queue_t *queue, sock_tcp_ep_t *ep)
+{
+    assert((queue != NULL) && (ep != NULL));
+    if (queue->local.family == AF_UNSPEC) {
+        return -EADDRNOTAVAIL;
+    }
+    memcpy(ep, &queue->local, sizeof(sock_tcp_ep_t));
+    return 0;
+}
+
+int sock_tcp_accept(sock_tcp_queue_t *queue, sock_tcp_t **sock,
+                    uint32_t timeout)
+{
+    gnrc_tcp_tcb_t *tcb;
+    int res;
+
+    assert((queue != NULL) && (sock != NULL));
+    /* SOCK_NO_TIMEOUT and GNRC_TCP_NO_TIMEOUT are both UINT32_MAX */
+    if ((res = gnrc_tcp_accept(&queue->queue, &tcb, timeout)) == 0) {
+        *sock = container_of(tcb, sock_tcp_t, tcb);
+    }
+    return res;
+}
+
+ssize_t sock_tcp_read(sock_tcp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout)
+{
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    do {
+        res = gnrc_tcp_recv(&sock->tcb, data, max_len, timeout);
+        /* gnrc_tcp_recv() has no infinite timeout, so wait again */
+    } while ((res == -ETIMEDOUT) && (timeout == SOCK_NO_TIMEOUT));
+    return res;
+}
+
+ssize_t sock_tcp_write(sock_tcp_t *sock, const void *data, size_t len)
+{
+    assert(sock != NULL);
+    assert((len == 0) || (data != NULL));
+    if (len == 0) {
+        return 0;
+    }
+    return gnrc_tcp_send(&sock->tcb, data, len, 0);
+}
+
+#ifdef SOCK_HAS_ASYNC
+void sock_tcp_set_cb(sock_tcp_t *sock, sock_tcp_cb_t cb, void *arg)
+{
+    assert(sock != NULL);
+    gnrc_tcp_set_cb(&sock->tcb, cb, arg);
+}
+
+void sock_tcp_queue_set_cb(sock_tcp_queue_t *queue, sock_tcp_cb_t cb,
+                           void *arg)
+{
+    assert(queue != NULL);
+    gnrc_tcp_queue_set_cb(&queue->queue, cb, arg);
+}
+
+unsigned sock_tcp_get_events(sock_tcp_t *sock)
+{
+    unsigned tcp_events, events = 0;
+
+    assert(sock != NULL);
+    tcp_events = gnrc_tcp_get_events(&sock->tcb);
+    if (tcp_events & GNRC_TCP_EVENT_RECV) {
+        events |= SOCK_TCP_EVENT_READ;
+    }
+    if (tcp_events & GNRC_TCP_EVENT_SEND) {
+        events |= SOCK_TCP_EVENT_WRITE;
+    }
+    if (tcp_events & GNRC_TCP_EVENT_CLOSED) {
+        events |= SOCK_TCP_EVENT_CLOSED;
+    }
+    return events;
+}
+
+unsigned sock_tcp_queue_get_events(sock_tcp_queue_t *queue)
+{
+    assert(queue != NULL);
+    if (gnrc_tcp_queue_get_events(&queue->queue) & GNRC_TCP_EVENT_ACCEPT) {
+        return SOCK_TCP_EVENT_ACCEPT;
+    }
+    return 0;
+}
+#endif
+
+/** @} */
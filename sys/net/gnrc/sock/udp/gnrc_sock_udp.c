@@ -22,13 +22,26 @@
 #include "net/protnum.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/udp.h"
+#ifdef MODULE_GNRC_UDP_PORTS
+#include "net/gnrc/udp/ports.h"
+#endif
 #include "net/sock/udp.h"
 #include "net/udp.h"
 
 #include "gnrc_sock_internal.h"
 
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
+#ifdef MODULE_GNRC_UDP_PORTS
+/* socks hashed by local port, so only socks with the same port need to be
+ * compared on bind */
+static sock_udp_t *_udp_socks[GNRC_UDP_PORTS_BUCKETS];
+
+#define _SOCKS(port)    (_udp_socks[gnrc_udp_ports_bucket(port)])
+#else
 static sock_udp_t *_udp_socks = NULL;
+
+#define _SOCKS(port)    (_udp_socks)
+#endif
 #endif
 
 static uint16_t _dyn_port_next = 0;
@@ -38,7 +51,9 @@ static uint16_t _dyn_port_next = 0;
  */
 static bool _dyn_port_used(uint16_t port)
 {
-#ifdef MODULE_GNRC_SOCK_CHECK_REUSE
+#ifdef MODULE_GNRC_UDP_PORTS
+    return gnrc_udp_ports_used(port);
+#elif defined(MODULE_GNRC_SOCK_CHECK_REUSE)
     for (sock_udp_t *ptr = _udp_socks; ptr != NULL;
          ptr = (sock_udp_t *)ptr->reg.next) {
         bool spec_addr = false;
@@ -56,10 +71,11 @@ static bool _dyn_port_used(uint16_t port)
             return true;
         }
     }
+    return false;
 #else
     (void) port;
-#endif /* MODULE_GNRC_SOCK_CHECK_REUSE */
     return false;
+#endif /* MODULE_GNRC_SOCK_CHECK_REUSE */
 }
 
 /**
@@ -69,6 +85,13 @@ static bool _dyn_port_used(uint16_t port)
  */
 static uint16_t _get_dyn_port(sock_udp_t *sock)
 {
+#ifdef MODULE_GNRC_UDP_PORTS
+    if ((sock != NULL) && !(sock->flags & SOCK_FLAGS_REUSE_EP)) {
+        /* picks the candidates the same way, but skips bound ports in the
+         * port table's bitmap instead of trying them one by one */
+        return gnrc_udp_ports_alloc();
+    }
+#endif
     unsigned count = GNRC_SOCK_DYN_PORTRANGE_NUM;
     do {
         uint16_t port = GNRC_SOCK_DYN_PORTRANGE_MIN +
@@ -99,7 +122,7 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
     if (local != NULL) {
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
         if (!(flags & SOCK_FLAGS_REUSE_EP)) {
-            for (sock_udp_t *ptr = _udp_socks; ptr != NULL;
+            for (sock_udp_t *ptr = _SOCKS(local->port); ptr != NULL;
                  ptr = (sock_udp_t *)ptr->reg.next) {
                 if (memcmp(&ptr->local, local, sizeof(sock_udp_ep_t)) == 0) {
                     return -EADDRINUSE;
@@ -107,8 +130,8 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
             }
         }
         /* prepend to current socks */
-        sock->reg.next = (gnrc_sock_reg_t *)_udp_socks;
-        _udp_socks = sock;
+        sock->reg.next = (gnrc_sock_reg_t *)_SOCKS(local->port);
+        _SOCKS(local->port) = sock;
 #endif
         if (gnrc_af_not_supported(local->family)) {
             return -EAFNOSUPPORT;
@@ -126,6 +149,9 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
         gnrc_ep_set((sock_ip_ep_t *)&sock->remote,
                     (sock_ip_ep_t *)remote, sizeof(sock_udp_ep_t));
     }
+#ifdef SOCK_HAS_ASYNC
+    sock->reg.async_cb.generic = NULL;
+#endif
     if (local != NULL) {
         /* listen only with local given */
         gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, local->port);
@@ -139,9 +165,10 @@ void sock_udp_close(sock_udp_t *sock)
     assert(sock != NULL);
     gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &sock->reg.entry);
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
-    if (_udp_socks != NULL) {
-        gnrc_sock_reg_t *head = (gnrc_sock_reg_t *)_udp_socks;
+    if (_SOCKS(sock->local.port) != NULL) {
+        gnrc_sock_reg_t *head = (gnrc_sock_reg_t *)_SOCKS(sock->local.port);
         LL_DELETE(head, (gnrc_sock_reg_t *)sock);
+        _SOCKS(sock->local.port) = (sock_udp_t *)head;
     }
 #endif
 }
@@ -166,15 +193,19 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *remote)
     return 0;
 }
 
-ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
-                      uint32_t timeout, sock_udp_ep_t *remote)
+/**
+ * @brief   Receives a packet for a sock and checks its remote end point
+ *
+ * @return  size of the payload in @p pkt_out, which the caller must release
+ */
+static ssize_t _recv(sock_udp_t *sock, gnrc_pktsnip_t **pkt_out,
+                     uint32_t timeout, sock_udp_ep_t *remote)
 {
     gnrc_pktsnip_t *pkt, *udp;
     udp_hdr_t *hdr;
     sock_ip_ep_t tmp;
     int res;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
     if (sock->local.family == AF_UNSPEC) {
         return -EADDRNOTAVAIL;
     }
@@ -183,10 +214,6 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     if (res < 0) {
         return res;
     }
-    if (pkt->size > max_len) {
-        gnrc_pktbuf_release(pkt);
-        return -ENOBUFS;
-    }
     udp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
     assert(udp);
     hdr = udp->data;
@@ -205,23 +232,78 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
         gnrc_pktbuf_release(pkt);
         return -EPROTO;
     }
-    memcpy(data, pkt->data, pkt->size);
+    *pkt_out = pkt;
+    return (ssize_t)pkt->size;
+}
+
+ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout, sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *pkt;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    res = _recv(sock, &pkt, timeout, remote);
+    if (res < 0) {
+        return res;
+    }
+    if ((size_t)res > max_len) {
+        gnrc_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
+    memcpy(data, pkt->data, res);
     gnrc_pktbuf_release(pkt);
-    return (int)pkt->size;
+    return res;
+}
+
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *pkt;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    if (*buf_ctx != NULL) {
+        /* the payload is a single snip, so the packet ends here */
+        gnrc_pktbuf_release(*buf_ctx);
+        *buf_ctx = NULL;
+        *data = NULL;
+        return 0;
+    }
+    res = _recv(sock, &pkt, timeout, remote);
+    if (res < 0) {
+        return res;
+    }
+    if (res == 0) {
+        gnrc_pktbuf_release(pkt);
+        *data = NULL;
+        return 0;
+    }
+    *data = pkt->data;
+    *buf_ctx = pkt;
+    return res;
 }
 
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote)
 {
-    int res;
-    gnrc_pktsnip_t *payload, *pkt;
-    uint16_t src_port = 0, dst_port;
-    sock_ip_ep_t local;
-    sock_udp_ep_t remote_cpy;
-    sock_ip_ep_t *rem;
+    const iolist_t snip = { NULL, (void *)data, len };
 
-    assert((sock != NULL) || (remote != NULL));
     assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+    return sock_udp_sendv(sock, &snip, remote);
+}
+
+/**
+ * @brief   Resolves the end points of a datagram, and binds @p sock
+ *          implicitly if it is unbound
+ *
+ * @return  0 on success, the errors of sock_udp_send() otherwise
+ */
+static int _send_ep(sock_udp_t *sock, const sock_udp_ep_t *remote,
+                    sock_ip_ep_t *local, sock_udp_ep_t *rem,
+                    uint16_t *src_port)
+{
+    assert((sock != NULL) || (remote != NULL));
 
     if (remote != NULL) {
         if (remote->port == 0) {
@@ -248,8 +330,8 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
      * cppcheck is being weird here anyways) */
     if ((sock == NULL) || (sock->local.family == AF_UNSPEC)) {
         /* no sock or sock currently unbound */
-        memset(&local, 0, sizeof(local));
-        if ((src_port = _get_dyn_port(sock)) == GNRC_SOCK_DYN_PORTRANGE_ERR) {
+        memset(local, 0, sizeof(*local));
+        if ((*src_port = _get_dyn_port(sock)) == GNRC_SOCK_DYN_PORTRANGE_ERR) {
             return -EINVAL;
         }
         /* cppcheck-suppress nullPointer
@@ -257,57 +339,152 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
          * well, see above) */
         if (sock != NULL) {
             /* bind sock object implicitly */
-            sock->local.port = src_port;
+            sock->local.port = *src_port;
             if (remote == NULL) {
                 sock->local.family = sock->remote.family;
             }
             else {
                 sock->local.family = remote->family;
             }
-            gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, src_port);
+            gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, *src_port);
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
             /* prepend to current socks */
-            sock->reg.next = (gnrc_sock_reg_t *)_udp_socks;
-            _udp_socks = sock;
+            sock->reg.next = (gnrc_sock_reg_t *)_SOCKS(*src_port);
+            _SOCKS(*src_port) = sock;
 #endif /* MODULE_GNRC_SOCK_CHECK_REUSE */
         }
     }
     else {
-        src_port = sock->local.port;
-        memcpy(&local, &sock->local, sizeof(local));
+        *src_port = sock->local.port;
+        memcpy(local, &sock->local, sizeof(*local));
     }
     /* sock can't be NULL at this point */
     if (remote == NULL) {
-        rem = (sock_ip_ep_t *)&sock->remote;
-        dst_port = sock->remote.port;
+        memcpy(rem, &sock->remote, sizeof(*rem));
     }
     else {
-        rem = (sock_ip_ep_t *)&remote_cpy;
-        gnrc_ep_set(rem, (sock_ip_ep_t *)remote, sizeof(sock_udp_ep_t));
-        dst_port = remote->port;
+        gnrc_ep_set((sock_ip_ep_t *)rem, (sock_ip_ep_t *)remote,
+                    sizeof(sock_udp_ep_t));
     }
     /* check for matching address families in local and remote */
-    if (local.family == AF_UNSPEC) {
-        local.family = rem->family;
+    if (local->family == AF_UNSPEC) {
+        local->family = rem->family;
     }
-    else if (local.family != rem->family) {
+    else if (local->family != rem->family) {
         return -EINVAL;
     }
-    /* generate payload and header snips */
-    payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
+    return 0;
+}
+
+/**
+ * @brief   Sends a datagram to the end points resolved by _send_ep()
+ */
+static ssize_t _send(const iolist_t *snips, sock_ip_ep_t *local,
+                     const sock_udp_ep_t *rem, uint16_t src_port)
+{
+    gnrc_pktsnip_t *payload, *pkt;
+    int res;
+
+    /* generate payload and header snips; the stack sends the packet after
+     * this function returns, so the data is copied */
+    payload = gnrc_pktbuf_add(NULL, NULL, iolist_size(snips),
+                              GNRC_NETTYPE_UNDEF);
     if (payload == NULL) {
         return -ENOMEM;
     }
-    pkt = gnrc_udp_hdr_build(payload, src_port, dst_port);
+    uint8_t *pos = payload->data;
+    for (const iolist_t *snip = snips; snip != NULL; snip = snip->iol_next) {
+        if (snip->iol_len > 0) {
+            memcpy(pos, snip->iol_base, snip->iol_len);
+            pos += snip->iol_len;
+        }
+    }
+    pkt = gnrc_udp_hdr_build(payload, src_port, rem->port);
     if (pkt == NULL) {
         gnrc_pktbuf_release(payload);
         return -ENOMEM;
     }
-    res = gnrc_sock_send(pkt, &local, rem, PROTNUM_UDP);
+    res = gnrc_sock_send(pkt, local, (const sock_ip_ep_t *)rem, PROTNUM_UDP);
     if (res > 0) {
         res -= sizeof(udp_hdr_t);
     }
     return res;
 }
 
+ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                       const sock_udp_ep_t *remote)
+{
+    sock_ip_ep_t local;
+    sock_udp_ep_t rem;
+    uint16_t src_port = 0;
+    int res;
+
+    if ((res = _send_ep(sock, remote, &local, &rem, &src_port)) < 0) {
+        return res;
+    }
+    return _send(snips, &local, &rem, src_port);
+}
+
+int sock_udp_recv_batch(sock_udp_t *sock, sock_udp_msg_t *msgs,
+                        unsigned count, uint32_t timeout)
+{
+    assert((sock != NULL) && (msgs != NULL) && (count > 0));
+    for (unsigned i = 0; i < count; i++) {
+        gnrc_pktsnip_t *pkt;
+        /* only the first message sets a timer and blocks, the others are
+         * taken from the mbox with mbox_try_get() by gnrc_sock_recv() */
+        ssize_t res = _recv(sock, &pkt, (i == 0) ? timeout : 0,
+                            msgs[i].remote);
+
+        if ((res >= 0) && ((size_t)res > msgs[i].len)) {
+            gnrc_pktbuf_release(pkt);
+            res = -ENOBUFS;
+        }
+        if (res < 0) {
+            return (i == 0) ? (int)res : (int)i;
+        }
+        memcpy(msgs[i].data, pkt->data, res);
+        gnrc_pktbuf_release(pkt);
+        msgs[i].len = (size_t)res;
+    }
+    return (int)count;
+}
+
+int sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                        unsigned count)
+{
+    sock_ip_ep_t local;
+    sock_udp_ep_t rem;
+    uint16_t src_port = 0;
+
+    assert((msgs != NULL) && (count > 0));
+    for (unsigned i = 0; i < count; i++) {
+        const iolist_t snip = { NULL, msgs[i].data, msgs[i].len };
+        ssize_t res = 0;
+
+        assert((msgs[i].len == 0) || (msgs[i].data != NULL));
+        /* the end points are only resolved again if the remote changes */
+        if ((i == 0) || (msgs[i].remote != msgs[i - 1].remote)) {
+            res = _send_ep(sock, msgs[i].remote, &local, &rem, &src_port);
+        }
+        if (res == 0) {
+            res = _send(&snip, &local, &rem, src_port);
+        }
+        if (res < 0) {
+            return (i == 0) ? (int)res : (int)i;
+        }
+    }
+    return (int)count;
+}
+
+#ifdef SOCK_HAS_ASYNC
+void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb, void *arg)
+{
+    assert(sock != NULL);
+    /* the stack may call the callback any time, so set its argument first */
+    sock->reg.async_cb_arg = arg;
+    sock->reg.async_cb.udp = cb;
+}
+#endif
+
 /** @} */
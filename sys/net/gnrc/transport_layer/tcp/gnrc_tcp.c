@@ -18,6 +18,7 @@
  */
 
 #include <errno.h>
+#include <stdbool.h>
 #include <utlist.h>
 #include "net/af.h"
 #include "net/gnrc/tcp.h"
@@ -25,8 +26,8 @@
 #include "internal/fsm.h"
 #include "internal/pkt.h"
 #include "internal/option.h"
-#include "internal/eventloop.h"
 #include "internal/rcvbuf.h"
+#include "internal/eventloop.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
@@ -95,6 +96,80 @@ static void _setup_timeout(xtimer_t *timer, const uint32_t duration, const xtime
     xtimer_set(timer, duration);
 }
 
+/**
+ * @brief Prepares a TCB for a passive open.
+ *
+ * @param[in,out] tcb          TCB holding the connection information.
+ * @param[in]     local_addr   Local address to bind on, NULL to accept any local address.
+ * @param[in]     local_port   Local port to bind on.
+ */
+static void _setup_passive(gnrc_tcp_tcb_t *tcb, const uint8_t *local_addr, uint16_t local_port)
+{
+    /* Mark connection as passive opend */
+    tcb->status |= STATUS_PASSIVE;
+    if (local_addr == NULL) {
+        tcb->status |= STATUS_ALLOW_ANY_ADDR;
+    }
+#ifdef MODULE_GNRC_IPV6
+    /* If local address is specified: Copy it into TCB */
+    else if (tcb->address_family == AF_INET6) {
+            memcpy(tcb->local_addr, local_addr, sizeof(ipv6_addr_t));
+    }
+#endif
+    /* Set port number to listen on */
+    tcb->local_port = local_port;
+}
+
+/**
+ * @brief Lets a TCB of a listening queue listen again, after its connection was closed.
+ *
+ * @note Must be called with tcb->function_lock locked and tcb in state CLOSED.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _requeue(gnrc_tcp_tcb_t *tcb)
+{
+    bool listen;
+
+    mutex_lock(&(tcb->fsm_lock));
+    listen = (tcb->queue != NULL);
+    tcb->status &= ~STATUS_ACCEPTED;
+    if (listen) {
+        /* The callback belongs to the user of the closed connection */
+        tcb->cb = NULL;
+    }
+    mutex_unlock(&(tcb->fsm_lock));
+
+    if (listen) {
+        _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+    }
+}
+
+/**
+ * @brief Takes an established connection, that was not accepted yet, from a listening queue.
+ *
+ * @param[in,out] queue   Listening queue.
+ *
+ * @returns   TCB of the connection on success.
+ *            NULL if there is no established connection.
+ */
+static gnrc_tcp_tcb_t *_queue_get_established(gnrc_tcp_tcb_queue_t *queue)
+{
+    for (size_t i = 0; i < queue->tcbs_len; i++) {
+        gnrc_tcp_tcb_t *tcb = &(queue->tcbs[i]);
+
+        mutex_lock(&(tcb->fsm_lock));
+        if (!(tcb->status & STATUS_ACCEPTED) &&
+            (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_CLOSE_WAIT)) {
+            tcb->status |= STATUS_ACCEPTED;
+            mutex_unlock(&(tcb->fsm_lock));
+            return tcb;
+        }
+        mutex_unlock(&(tcb->fsm_lock));
+    }
+    return NULL;
+}
+
 /**
  * @brief   Establishes a new TCP connection
  *
@@ -107,7 +182,6 @@ static void _setup_timeout(xtimer_t *timer, const uint32_t duration, const xtime
  *
  * @returns   Zero on success.
  *            -EISCONN if TCB is already connected.
- *            -ENOMEM if the receive buffer for the TCB could not be allocated.
  *            -EADDRINUSE if @p local_port is already in use.
  *            -ETIMEDOUT if the connection opening timed out.
  *            -ECONNREFUSED if the connection was resetted by the peer.
@@ -138,19 +212,7 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, const uint8_t *target_addr, uint1
 
     /* Setup passive connection */
     if (passive) {
-        /* Mark connection as passive opend */
-        tcb->status |= STATUS_PASSIVE;
-        if (local_addr == NULL) {
-            tcb->status |= STATUS_ALLOW_ANY_ADDR;
-        }
-#ifdef MODULE_GNRC_IPV6
-        /* If local address is specified: Copy it into TCB */
-        else if (tcb->address_family == AF_INET6) {
-                memcpy(tcb->local_addr, local_addr, sizeof(ipv6_addr_t));
-        }
-#endif
-        /* Set port number to listen on */
-        tcb->local_port = local_port;
+        _setup_passive(tcb, local_addr, local_port);
     }
     /* Setup active connection */
     else {
@@ -171,10 +233,7 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, const uint8_t *target_addr, uint1
 
     /* Call FSM with event: CALL_OPEN */
     ret = _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
-    if (ret == -ENOMEM) {
-        DEBUG("gnrc_tcp.c : gnrc_tcp_connect() : Out of receive buffers.\n");
-    }
-    else if(ret == -EADDRINUSE) {
+    if (ret == -EADDRINUSE) {
         DEBUG("gnrc_tcp.c : gnrc_tcp_connect() : local_port is already in use.\n");
     }
 
@@ -221,7 +280,6 @@ int gnrc_tcp_init(void)
 
     /* Initialize TCB list */
     _list_tcb_head = NULL;
-    _rcvbuf_init();
 
     /* Start TCP processing thread */
     return thread_create(_stack, sizeof(_stack), TCP_EVENTLOOP_PRIO,
@@ -294,6 +352,121 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
     return _gnrc_tcp_open(tcb, NULL, 0, local_addr, local_port, 1);
 }
 
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, const size_t tcbs_len,
+                    const uint8_t address_family, const uint8_t *local_addr,
+                    const uint16_t local_port)
+{
+    assert(queue != NULL);
+    assert(tcbs != NULL);
+    assert(tcbs_len > 0);
+    assert(local_port != PORT_UNSPEC);
+
+    /* Check AF-Family support if local address was supplied */
+    if (local_addr != NULL) {
+#ifdef MODULE_GNRC_IPV6
+        if (address_family != AF_INET6) {
+            return -EAFNOSUPPORT;
+        }
+#else
+        return -EAFNOSUPPORT;
+#endif
+    }
+
+    mutex_init(&(queue->lock));
+    mbox_init(&(queue->mbox), queue->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
+    queue->cb = NULL;
+
+    /* Let all TCBs of the queue listen on local_port */
+    mutex_lock(&(queue->lock));
+    queue->tcbs = tcbs;
+    queue->tcbs_len = tcbs_len;
+    for (size_t i = 0; i < tcbs_len; i++) {
+        gnrc_tcp_tcb_init(&(tcbs[i]));
+        tcbs[i].queue = queue;
+        _setup_passive(&(tcbs[i]), local_addr, local_port);
+        _fsm(&(tcbs[i]), FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+    }
+    mutex_unlock(&(queue->lock));
+    return 0;
+}
+
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t timeout_duration_us)
+{
+    assert(queue != NULL);
+    assert(tcb != NULL);
+
+    msg_t msg;
+    xtimer_t user_timeout;
+    cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(queue->mbox)};
+    bool user_timeout_set = false;
+    int ret = 0;
+
+    /* Lock the queue for this function call */
+    mutex_lock(&(queue->lock));
+
+    /* Check if the queue is listening */
+    if (queue->tcbs == NULL) {
+        mutex_unlock(&(queue->lock));
+        return -EINVAL;
+    }
+
+    /* 'Flush' mbox, established connections are looked up in the queue anyways */
+    while (mbox_try_get(&(queue->mbox), &msg) != 0) {
+    }
+
+    /* Setup user specified timeout */
+    if (timeout_duration_us > 0 && timeout_duration_us != GNRC_TCP_NO_TIMEOUT) {
+        _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
+        user_timeout_set = true;
+    }
+
+    /* Wait until a connection was established */
+    while ((*tcb = _queue_get_established(queue)) == NULL) {
+        if (timeout_duration_us == 0) {
+            ret = -EAGAIN;
+            break;
+        }
+        mbox_get(&(queue->mbox), &msg);
+        if (msg.type == MSG_TYPE_USER_SPEC_TIMEOUT) {
+            DEBUG("gnrc_tcp.c : gnrc_tcp_accept() : USER_SPEC_TIMEOUT\n");
+            ret = -ETIMEDOUT;
+            break;
+        }
+    }
+
+    /* Cleanup */
+    if (user_timeout_set) {
+        xtimer_remove(&user_timeout);
+    }
+    mutex_unlock(&(queue->lock));
+    return ret;
+}
+
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue)
+{
+    assert(queue != NULL);
+
+    /* Lock the queue for this function call */
+    mutex_lock(&(queue->lock));
+    for (size_t i = 0; i < queue->tcbs_len; i++) {
+        gnrc_tcp_tcb_t *tcb = &(queue->tcbs[i]);
+        bool accepted;
+
+        /* Detach TCB from the queue, accepted connections are closed by their user */
+        mutex_lock(&(tcb->fsm_lock));
+        accepted = (tcb->status & STATUS_ACCEPTED);
+        tcb->queue = NULL;
+        mutex_unlock(&(tcb->fsm_lock));
+        if (!accepted) {
+            gnrc_tcp_abort(tcb);
+        }
+    }
+    queue->tcbs = NULL;
+    queue->tcbs_len = 0;
+    mutex_unlock(&(queue->lock));
+}
+
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t timeout_duration_us)
 {
@@ -309,6 +482,9 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     cb_arg_t probe_timeout_arg = {MSG_TYPE_PROBE_TIMEOUT, &(tcb->mbox)};
     uint32_t probe_timeout_duration_us = 0;
     ssize_t ret = 0;
+    size_t sent = 0;
+    size_t acked;
+    uint32_t snd_una_start;
     bool probing_mode = false;
 
     /* Lock the TCB for this function call */
@@ -319,6 +495,7 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         mutex_unlock(&(tcb->function_lock));
         return -ENOTCONN;
     }
+    snd_una_start = tcb->snd_una;
 
     /* Mark TCB as waiting for incomming messages */
     tcb->status |= STATUS_WAIT_FOR_MSG;
@@ -336,8 +513,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until everything was sent and acked */
+    while (ret == 0 && (sent < len || tcb->pkt_retransmit_num > 0)) {
         /* Check if the connections state is closed. If so, a reset was received */
         if (tcb->state == FSM_STATE_CLOSED) {
             ret = -ECONNRESET;
@@ -356,9 +533,9 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                            &probe_timeout_arg);
         }
 
-        /* Try to send data in case there nothing has been sent and we are not probing */
-        if (ret == 0 && !probing_mode) {
-            ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+        /* Try to send the remaining data, as long as we are not probing */
+        if (sent < len && !probing_mode) {
+            sent += _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (uint8_t *) data + sent, len - sent);
         }
 
         /* Wait for responses */
@@ -415,6 +592,23 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     xtimer_remove(&connection_timeout);
     xtimer_remove(&user_timeout);
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
+
+    if (ret == 0) {
+        ret = (ssize_t) sent;
+    }
+    else if (ret == -ETIMEDOUT || ret == -ECONNABORTED) {
+        /* The peer received the acknowledged data, so report it instead of the timeout */
+        mutex_lock(&(tcb->fsm_lock));
+        acked = tcb->snd_una - snd_una_start;
+        mutex_unlock(&(tcb->fsm_lock));
+        /* Acknowledged data beyond sent was dropped by an earlier call on its timeout */
+        if (acked > sent) {
+            acked = sent;
+        }
+        if (acked > 0) {
+            ret = (ssize_t) acked;
+        }
+    }
     mutex_unlock(&(tcb->function_lock));
     return ret;
 }
@@ -445,7 +639,7 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
     /* If this call is non-blocking (timeout_duration_us == 0): Try to read data and return */
     if (timeout_duration_us == 0) {
         ret = _fsm(tcb, FSM_EVENT_CALL_RECV, NULL, data, max_len);
-        if (ret == 0) {
+        if (ret == 0 && tcb->state != FSM_STATE_CLOSE_WAIT) {
             ret = -EAGAIN;
         }
         mutex_unlock(&(tcb->function_lock));
@@ -477,6 +671,11 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
         /* Try to read available data */
         ret = _fsm(tcb, FSM_EVENT_CALL_RECV, NULL, data, max_len);
 
+        /* If the peer closed the connection and all data was read: Return zero */
+        if (ret == 0 && tcb->state == FSM_STATE_CLOSE_WAIT) {
+            break;
+        }
+
         /* If there was no data: Wait for next packet or until the timeout fires */
         if (ret <= 0) {
             mbox_get(&(tcb->mbox), &msg);
@@ -522,8 +721,15 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     /* Lock the TCB for this function call */
     mutex_lock(&(tcb->function_lock));
 
+    /* Return if the TCB listens as part of a listening queue */
+    if ((tcb->queue != NULL) && !(tcb->status & STATUS_ACCEPTED)) {
+        mutex_unlock(&(tcb->function_lock));
+        return;
+    }
+
     /* Return if connection is closed */
     if (tcb->state == FSM_STATE_CLOSED) {
+        _requeue(tcb);
         mutex_unlock(&(tcb->function_lock));
         return;
     }
@@ -563,6 +769,7 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     /* Cleanup */
     xtimer_remove(&connection_timeout);
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
+    _requeue(tcb);
     mutex_unlock(&(tcb->function_lock));
 }
 
@@ -576,9 +783,89 @@ void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
         /* Call FSM ABORT event */
         _fsm(tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
     }
+    _requeue(tcb);
     mutex_unlock(&(tcb->function_lock));
 }
 
+void gnrc_tcp_set_cb(gnrc_tcp_tcb_t *tcb, gnrc_tcp_cb_t cb, void *arg)
+{
+    assert(tcb != NULL);
+
+    mutex_lock(&(tcb->fsm_lock));
+    tcb->cb = cb;
+    tcb->cb_arg = arg;
+    mutex_unlock(&(tcb->fsm_lock));
+}
+
+void gnrc_tcp_queue_set_cb(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_cb_t cb, void *arg)
+{
+    assert(queue != NULL);
+
+    /* The TCBs call the callback with their fsm_lock held, so take all of them. Unlike
+     * queue->lock, they are not held by a waiting gnrc_tcp_accept(). */
+    for (size_t i = 0; i < queue->tcbs_len; i++) {
+        mutex_lock(&(queue->tcbs[i].fsm_lock));
+    }
+    queue->cb = cb;
+    queue->cb_arg = arg;
+    for (size_t i = 0; i < queue->tcbs_len; i++) {
+        mutex_unlock(&(queue->tcbs[i].fsm_lock));
+    }
+}
+
+unsigned gnrc_tcp_get_events(gnrc_tcp_tcb_t *tcb)
+{
+    assert(tcb != NULL);
+
+    unsigned events = 0;
+
+    mutex_lock(&(tcb->fsm_lock));
+    switch (tcb->state) {
+        case FSM_STATE_ESTABLISHED:
+            events |= GNRC_TCP_EVENT_SEND;
+            /* Falls through. */
+        case FSM_STATE_FIN_WAIT_1:
+        case FSM_STATE_FIN_WAIT_2:
+            if (_rcvbuf_get_avail(tcb) > 0) {
+                events |= GNRC_TCP_EVENT_RECV;
+            }
+            break;
+        case FSM_STATE_CLOSE_WAIT:
+            /* gnrc_tcp_recv() returns zero once all data was read */
+            events |= GNRC_TCP_EVENT_RECV | GNRC_TCP_EVENT_SEND;
+            break;
+        case FSM_STATE_CLOSED:
+            /* gnrc_tcp_recv() fails without waiting */
+            events |= GNRC_TCP_EVENT_RECV | GNRC_TCP_EVENT_CLOSED;
+            break;
+        default:
+            break;
+    }
+    mutex_unlock(&(tcb->fsm_lock));
+    return events;
+}
+
+unsigned gnrc_tcp_queue_get_events(gnrc_tcp_tcb_queue_t *queue)
+{
+    assert(queue != NULL);
+
+    unsigned events = 0;
+
+    /* queue->lock is held by a waiting gnrc_tcp_accept(), the TCBs of a queue only
+     * change in gnrc_tcp_listen() and gnrc_tcp_stop_listen() */
+    for (size_t i = 0; i < queue->tcbs_len; i++) {
+        gnrc_tcp_tcb_t *tcb = &(queue->tcbs[i]);
+
+        mutex_lock(&(tcb->fsm_lock));
+        if (!(tcb->status & STATUS_ACCEPTED) &&
+            (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_CLOSE_WAIT)) {
+            events |= GNRC_TCP_EVENT_ACCEPT;
+        }
+        mutex_unlock(&(tcb->fsm_lock));
+    }
+    return events;
+}
+
 int gnrc_tcp_calc_csum(const gnrc_pktsnip_t *hdr, const gnrc_pktsnip_t *pseudo_hdr)
 {
     uint16_t csum;
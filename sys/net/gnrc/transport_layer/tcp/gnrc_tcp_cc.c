@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/cc.h
+ *
+ * Lost segments are retransmitted from the retransmit queue, there is no
+ * go-back-N after a retransmission timeout. Instead, the timeout starts loss
+ * recovery like a fast retransmit does, so every partial ACK retransmits the
+ * next unacknowledged segment.
+ *
+ * @}
+ */
+#include "net/gnrc/pktbuf.h"
+#include "internal/common.h"
+#include "internal/pkt.h"
+#include "internal/cc.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief Largest window that can be announced with window scaling.
+ */
+#define CWND_MAX ((uint32_t) UINT16_MAX << 14)
+
+/**
+ * @brief Calculates the minimum of two unsigned numbers.
+ */
+static inline uint32_t _min(const uint32_t x, const uint32_t y)
+{
+    return (x < y) ? x : y;
+}
+
+/**
+ * @brief Calculates the maximum of two unsigned numbers.
+ */
+static inline uint32_t _max(const uint32_t x, const uint32_t y)
+{
+    return (x > y) ? x : y;
+}
+
+/**
+ * @brief Calculates the amount of outstanding data.
+ */
+static inline uint32_t _flight_size(const gnrc_tcp_tcb_t *tcb)
+{
+    return tcb->snd_nxt - tcb->snd_una;
+}
+
+/**
+ * @brief Resends the oldest unacknowledged segment, without touching the
+ *        retransmission timer.
+ */
+static void _retransmit_first(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->pkt_retransmit_num > 0) {
+        DEBUG("gnrc_tcp_cc.c : _retransmit_first() : snd_una=%"PRIu32"\n", tcb->snd_una);
+        /* Every send attempt consumes a user */
+        gnrc_pktbuf_hold(tcb->pkt_retransmit[0], 1);
+        _pkt_send(tcb, tcb->pkt_retransmit[0], 0, true);
+    }
+}
+
+/**
+ * @brief Calculates the slow start threshold after a loss (see RFC 5681, eq. 4).
+ */
+static inline uint32_t _loss_ssthresh(const gnrc_tcp_tcb_t *tcb)
+{
+    return _max(_flight_size(tcb) / 2, 2 * _cc_get_smss(tcb));
+}
+
+uint16_t _cc_get_smss(const gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->mss == 0 || tcb->mss > GNRC_TCP_MSS) {
+        return GNRC_TCP_MSS;
+    }
+    return tcb->mss;
+}
+
+void _cc_init(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _cc_get_smss(tcb);
+
+    /* Initial window, see RFC 5681 section 3.1 */
+    if (smss > 2190) {
+        tcb->cwnd = 2 * smss;
+    }
+    else if (smss > 1095) {
+        tcb->cwnd = 3 * smss;
+    }
+    else {
+        tcb->cwnd = 4 * smss;
+    }
+    tcb->ssthresh = CWND_MAX;
+    tcb->recover = tcb->snd_una;
+    tcb->dupacks = 0;
+    tcb->status &= ~STATUS_RECOVERY;
+}
+
+void _cc_ack(gnrc_tcp_tcb_t *tcb, const uint32_t acked)
+{
+    uint32_t smss = _cc_get_smss(tcb);
+
+    tcb->dupacks = 0;
+    if (tcb->status & STATUS_RECOVERY) {
+        if (LEQ_32_BIT(tcb->recover, tcb->snd_una)) {
+            /* Full acknowledgment: deflate the window, leave recovery */
+            tcb->cwnd = _min(tcb->ssthresh, _max(_flight_size(tcb), smss) + smss);
+            tcb->status &= ~STATUS_RECOVERY;
+            DEBUG("gnrc_tcp_cc.c : _cc_ack() : recovery done, cwnd=%"PRIu32"\n", tcb->cwnd);
+        }
+        else {
+            /* Partial acknowledgment: the next segment was lost as well */
+            _retransmit_first(tcb);
+            tcb->cwnd = (tcb->cwnd > acked) ? (tcb->cwnd - acked) : 0;
+            if (acked >= smss) {
+                tcb->cwnd += smss;
+            }
+            tcb->cwnd = _max(tcb->cwnd, smss);
+        }
+        return;
+    }
+
+    /* Slow start grows by at most one SMSS per ACK, congestion avoidance by
+     * about one SMSS per round trip */
+    if (tcb->cwnd < tcb->ssthresh) {
+        tcb->cwnd += _min(acked, smss);
+    }
+    else {
+        tcb->cwnd += _max(1, (smss * smss) / tcb->cwnd);
+    }
+    tcb->cwnd = _min(tcb->cwnd, CWND_MAX);
+}
+
+void _cc_dupack(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = _cc_get_smss(tcb);
+
+    if (tcb->status & STATUS_RECOVERY) {
+        /* Every duplicate ACK signals a segment that left the network */
+        tcb->cwnd = _min(tcb->cwnd + smss, CWND_MAX);
+        tcb->status |= STATUS_NOTIFY_USER;
+        return;
+    }
+
+    tcb->dupacks += 1;
+    /* Don't reduce the window twice for losses of the same window */
+    if (tcb->dupacks == GNRC_TCP_DUPACK_THRESHOLD && LEQ_32_BIT(tcb->recover, tcb->snd_una)) {
+        tcb->ssthresh = _loss_ssthresh(tcb);
+        tcb->recover = tcb->snd_nxt;
+        tcb->cwnd = tcb->ssthresh + GNRC_TCP_DUPACK_THRESHOLD * smss;
+        tcb->status |= STATUS_RECOVERY;
+        DEBUG("gnrc_tcp_cc.c : _cc_dupack() : fast retransmit, ssthresh=%"PRIu32"\n",
+              tcb->ssthresh);
+        _retransmit_first(tcb);
+    }
+}
+
+void _cc_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    /* Only the first timeout of a segment reduces ssthresh (see RFC 5681, eq. 4) */
+    if (tcb->retries == 0) {
+        tcb->ssthresh = _loss_ssthresh(tcb);
+    }
+    tcb->cwnd = _cc_get_smss(tcb);
+    tcb->recover = tcb->snd_nxt;
+    tcb->dupacks = 0;
+    tcb->status |= STATUS_RECOVERY;
+    DEBUG("gnrc_tcp_cc.c : _cc_timeout() : ssthresh=%"PRIu32"\n", tcb->ssthresh);
+}
+
+uint32_t _cc_get_usable_window(const gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t wnd = _min(tcb->snd_wnd, tcb->cwnd);
+    uint32_t flight = _flight_size(tcb);
+
+    return (wnd > flight) ? (wnd - flight) : 0;
+}
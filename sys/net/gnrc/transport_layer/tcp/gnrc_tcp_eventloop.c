@@ -77,6 +77,7 @@ static int _send(gnrc_pktsnip_t *pkt)
  *            -ENOMSG if paket couldn't be marked.
  *            -EINVAL if checksum was invalid.
  *            -ENOTCONN if no TCB is interested in @p pkt.
+ *            -ENOBUFS if @p pkt is a SYN for a listening queue without listening TCB.
  */
 static int _receive(gnrc_pktsnip_t *pkt)
 {
@@ -86,9 +87,11 @@ static int _receive(gnrc_pktsnip_t *pkt)
     uint16_t dst = 0;
     uint8_t hdr_size = 0;
     uint8_t syn = 0;
+    uint8_t queued = 0;
     gnrc_pktsnip_t *ip = NULL;
     gnrc_pktsnip_t *reset = NULL;
     gnrc_tcp_tcb_t *tcb = NULL;
+    gnrc_tcp_tcb_t *listen = NULL;
     tcp_hdr_t *hdr;
 
     /* Get write access to the TCP header */
@@ -153,32 +156,38 @@ static int _receive(gnrc_pktsnip_t *pkt)
         return -EINVAL;
     }
 
-    /* Find TCB to for this packet */
+    /* Find TCB to for this packet. Segments of established connections, including
+     * retransmitted SYNs, go to the connection. Other SYNs go to a listening TCB. */
     mutex_lock(&_list_tcb_lock);
     tcb = _list_tcb_head;
     while (tcb) {
 #ifdef MODULE_GNRC_IPV6
         /* Check if current TCB is fitting for the incomming packet */
         if (ip->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6) {
-            /* If SYN is set, a connection is listening on that port ... */
             ipv6_addr_t *tmp_addr = NULL;
-            if (syn && tcb->local_port == dst && tcb->state == FSM_STATE_LISTEN) {
-                /* ... and local addr is unspec or pre configured */
-                tmp_addr = &((ipv6_hdr_t *)ip->data)->dst;
-                if (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, (ipv6_addr_t *) tmp_addr) ||
-                    ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
-                    break;
+            if (tcb->state == FSM_STATE_LISTEN) {
+                /* If SYN is set, a connection is listening on that port ... */
+                if (syn && tcb->local_port == dst && listen == NULL) {
+                    /* ... and local addr is unspec or pre configured */
+                    tmp_addr = &((ipv6_hdr_t *)ip->data)->dst;
+                    if (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, tmp_addr) ||
+                        ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
+                        listen = tcb;
+                    }
                 }
             }
-
-            /* If SYN is not set and the ports match ... */
-            if (!syn && tcb->local_port == dst && tcb->peer_port == src) {
+            /* If the ports match ... */
+            else if (tcb->local_port == dst && tcb->peer_port == src) {
                 /* .. and the IPv6 addresses match */
                 tmp_addr = &((ipv6_hdr_t * )ip->data)->src;
-                if (ipv6_addr_equal((ipv6_addr_t *) tcb->peer_addr, (ipv6_addr_t *) tmp_addr)) {
+                if (ipv6_addr_equal((ipv6_addr_t *) tcb->peer_addr, tmp_addr)) {
                     break;
                 }
             }
+            /* Remember if a listening queue is busy on that port */
+            if (syn && tcb->local_port == dst && tcb->queue != NULL) {
+                queued = 1;
+            }
         }
 #else
         /* Supress compiler warnings if TCP is build without network layer */
@@ -188,8 +197,18 @@ static int _receive(gnrc_pktsnip_t *pkt)
 #endif
         tcb = tcb->next;
     }
+    if (tcb == NULL) {
+        tcb = listen;
+    }
     mutex_unlock(&_list_tcb_lock);
 
+    /* All TCBs of a listening queue are in use: Drop SYN silently, the peer retries */
+    if (tcb == NULL && queued) {
+        DEBUG("gnrc_tcp_eventloop.c : _receive() : Listening queue is full\n");
+        gnrc_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
+
     /* Call FSM with event RCVD_PKT if a fitting TCB was found */
     if (tcb != NULL) {
         _fsm(tcb, FSM_EVENT_RCVD_PKT, pkt, NULL, 0);
@@ -23,6 +23,7 @@
 #include "internal/pkt.h"
 #include "internal/option.h"
 #include "internal/rcvbuf.h"
+#include "internal/cc.h"
 #include "internal/fsm.h"
 
 #ifdef MODULE_GNRC_IPV6
@@ -80,14 +81,33 @@ static uint16_t _get_random_local_port(void)
  */
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->pkt_retransmit != NULL) {
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
+    if (tcb->pkt_retransmit_num > 0) {
+        for (unsigned i = 0; i < tcb->pkt_retransmit_num; i++) {
+            gnrc_pktbuf_release(tcb->pkt_retransmit[i]);
+        }
         xtimer_remove(&(tcb->tim_tout));
-        tcb->pkt_retransmit = NULL;
+        tcb->pkt_retransmit_num = 0;
     }
     return 0;
 }
 
+/**
+ * @brief Enables window scaling if both peers sent the window scale option.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _set_wnd_scale(gnrc_tcp_tcb_t *tcb)
+{
+    if ((GNRC_TCP_WND_SCALE > 0) && (tcb->status & STATUS_WND_SCALE)) {
+        tcb->rcv_wnd_shift = GNRC_TCP_WND_SCALE;
+    }
+    else {
+        tcb->status &= ~STATUS_WND_SCALE;
+        tcb->snd_wnd_shift = 0;
+        tcb->rcv_wnd_shift = 0;
+    }
+}
+
 /**
  * @brief Restarts timewait timer.
  *
@@ -123,13 +143,19 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             /* Clear retransmit queue */
             _clear_retransmit(tcb);
 
+            /* Connection of a listening queue, that was not accepted yet: Listen again */
+            if ((tcb->queue != NULL) && !(tcb->status & STATUS_ACCEPTED)) {
+                xtimer_remove(&(tcb->tim_tout));
+                return _transition_to(tcb, FSM_STATE_LISTEN);
+            }
+
             /* Remove connection from active connections */
             mutex_lock(&_list_tcb_lock);
             LL_DELETE(_list_tcb_head, tcb);
             mutex_unlock(&_list_tcb_lock);
 
-            /* Free potencially allocated receive buffer */
-            _rcvbuf_release_buffer(tcb);
+            /* Release received data */
+            _rcvbuf_clear(tcb);
             tcb->status |= STATUS_NOTIFY_USER;
             break;
 
@@ -145,10 +171,11 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
 #endif
             tcb->peer_port = PORT_UNSPEC;
 
-            /* Allocate receive buffer */
-            if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
-                return -ENOMEM;
-            }
+            /* Release data received from the previous peer, reset receive window */
+            _rcvbuf_clear(tcb);
+            tcb->rcv_wnd = GNRC_TCP_DEFAULT_WINDOW;
+            tcb->snd_wnd_shift = 0;
+            tcb->rcv_wnd_shift = 0;
 
             /* Add connection to active connections (if not already active) */
             mutex_lock(&_list_tcb_lock);
@@ -160,11 +187,6 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             break;
 
         case FSM_STATE_SYN_SENT:
-            /* Allocate rceveive buffer */
-            if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
-                return -ENOMEM;
-            }
-
             /* Add connection to active connections (if not already active) */
             mutex_lock(&_list_tcb_lock);
             LL_SEARCH(_list_tcb_head, iter, tcb, TCB_EQUAL);
@@ -172,10 +194,9 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             if (iter == NULL) {
                 /* Check if port number was specified */
                 if (tcb->local_port != PORT_UNSPEC) {
-                    /* Check if given port number is use: return error and release buffer */
+                    /* Check if given port number is use: return error */
                     if (_is_local_port_in_use(tcb->local_port)) {
                         mutex_unlock(&_list_tcb_lock);
-                        _rcvbuf_release_buffer(tcb);
                         return -EADDRINUSE;
                     }
                 }
@@ -189,6 +210,11 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             break;
 
         case FSM_STATE_ESTABLISHED:
+            /* Start in slow start */
+            _cc_init(tcb);
+            tcb->status |= STATUS_NOTIFY_USER;
+            break;
+
         case FSM_STATE_CLOSE_WAIT:
             tcb->status |= STATUS_NOTIFY_USER;
             break;
@@ -210,7 +236,6 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
  * @param[in,out] tcb   TCB holding the connection information.
  *
  * @returns   Zero on success.
- *            -ENOMEM if receive buffer could not be allocated.
  *            -EADDRINUSE if given local port number is already in use.
  */
 static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
@@ -219,13 +244,12 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
 
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_open()\n");
     tcb->rcv_wnd = GNRC_TCP_DEFAULT_WINDOW;
+    tcb->snd_wnd_shift = 0;
+    tcb->rcv_wnd_shift = 0;
 
     if (tcb->status & STATUS_PASSIVE) {
         /* Passive open, T: CLOSED -> LISTEN */
-        if (_transition_to(tcb, FSM_STATE_LISTEN) == -ENOMEM) {
-            _transition_to(tcb, FSM_STATE_CLOSED);
-            return -ENOMEM;
-        }
+        _transition_to(tcb, FSM_STATE_LISTEN);
     }
     else {
         /* Active Open, set TCB values, send SYN, T: CLOSED -> SYN_SENT */
@@ -263,24 +287,35 @@ static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_send()\n");
 
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    size_t sent = 0;
+    size_t smss = _cc_get_smss(tcb);
 
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
+    /* Send segments as long as the window is open and the retransmit queue has space */
+    while (sent < len && tcb->pkt_retransmit_num < GNRC_TCP_SND_QUEUE_SIZE) {
         /* Calculate segment size */
-        payload = (payload < GNRC_TCP_MSS) ? payload : GNRC_TCP_MSS;
-        payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        size_t payload = _cc_get_usable_window(tcb);
+        payload = (payload < smss) ? payload : smss;
+        payload = (payload < (len - sent)) ? payload : (len - sent);
+
+        /* Avoid the silly window syndrome: Send less than a full segment */
+        /* only if it is the last one or nothing is in flight (see RFC 1122, 4.2.3.4) */
+        if (payload == 0 || (payload < smss && payload < (len - sent) &&
+                             tcb->snd_nxt != tcb->snd_una)) {
+            break;
+        }
 
-        /* Calculate payload size for this segment */
+        /* Build segment, stop if the packet buffer is full */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt,
+                       (uint8_t *) buf + sent, payload) < 0) {
+            break;
+        }
         _pkt_setup_retransmit(tcb, out_pkt, false);
         _pkt_send(tcb, out_pkt, seq_con, false);
-        return payload;
+        sent += payload;
     }
-    return 0;
+    return sent;
 }
 
 /**
@@ -296,16 +331,16 @@ static int _fsm_call_recv(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_recv()\n");
 
-    if (ringbuffer_empty(&tcb->rcv_buf)) {
+    if (_rcvbuf_get_avail(tcb) == 0) {
         return 0;
     }
 
     /* Read data into 'buf' up to 'len' bytes from receive buffer */
-    size_t rcvd = ringbuffer_get(&(tcb->rcv_buf), buf, len);
+    size_t rcvd = _rcvbuf_get(tcb, buf, len);
 
     /* If receive buffer can store more than GNRC_TCP_MSS: open window to available buffer size */
-    if (ringbuffer_get_free(&tcb->rcv_buf) >= GNRC_TCP_MSS) {
-        tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+    if (_rcvbuf_get_free(tcb) >= GNRC_TCP_MSS) {
+        tcb->rcv_wnd = _rcvbuf_get_free(tcb);
 
         /* Send ACK to anounce window update */
         gnrc_pktsnip_t *out_pkt = NULL;
@@ -386,7 +421,6 @@ static int _fsm_call_abort(gnrc_tcp_tcb_t *tcb)
  * @param[in]     in_pkt   Incomming packet.
  *
  * @returns   Zero on success.
- *            -ENOMEM if receive buffer could not be allocated.
  */
 static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
 {
@@ -417,6 +451,11 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
     seg_ack = byteorder_ntohl(tcp_hdr->ack_num);
     seg_wnd = byteorder_ntohs(tcp_hdr->window);
 
+    /* The window field of SYN segments is never scaled */
+    if (!(ctl & MSK_SYN)) {
+        seg_wnd <<= tcb->snd_wnd_shift;
+    }
+
     /* Extract network layer header */
 #ifdef MODULE_GNRC_IPV6
     LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_IPV6);
@@ -488,6 +527,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             tcb->snd_una = tcb->iss;
             tcb->snd_nxt = tcb->iss;
             tcb->snd_wnd = seg_wnd;
+            _set_wnd_scale(tcb);
 
             /* Send SYN+ACK: seq_no = iss, ack_no = rcv_nxt, T: LISTEN -> SYN_RCVD */
             _pkt_build(tcb, &out_pkt, &seq_con, MSK_SYN_ACK, tcb->iss, tcb->rcv_nxt, NULL, 0);
@@ -523,6 +563,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
         if (ctl & MSK_SYN) {
             tcb->rcv_nxt = seg_seq + 1;
             tcb->irs = seg_seq;
+            _set_wnd_scale(tcb);
             if (ctl & MSK_ACK) {
                 tcb->snd_una = seg_ack;
                 _pkt_acknowledge(tcb, seg_ack);
@@ -573,10 +614,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
         if (ctl & MSK_RST) {
             /* .. and state is SYN_RCVD and the connection is passive: SYN_RCVD -> LISTEN */
             if (tcb->state == FSM_STATE_SYN_RCVD && (tcb->status & STATUS_PASSIVE)) {
-                if (_transition_to(tcb, FSM_STATE_LISTEN) == -ENOMEM) {
-                    _transition_to(tcb, FSM_STATE_CLOSED);
-                    return -ENOMEM;
-                }
+                _transition_to(tcb, FSM_STATE_LISTEN);
             }
             else {
                 _transition_to(tcb, FSM_STATE_CLOSED);
@@ -614,8 +652,16 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    uint32_t acked = seg_ack - tcb->snd_una;
                     tcb->snd_una = seg_ack;
                     _pkt_acknowledge(tcb, seg_ack);
+                    _cc_ack(tcb, acked);
+                }
+                /* Duplicate ACK, while data is outstanding (see RFC 5681) */
+                else if (seg_ack == tcb->snd_una && pay_len == 0 &&
+                         !(ctl & (MSK_SYN | MSK_FIN)) && seg_wnd == tcb->snd_wnd &&
+                         tcb->pkt_retransmit_num > 0) {
+                    _cc_dupack(tcb);
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -639,25 +685,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Additional processing */
                 /* Check additionaly if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_num == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_num == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_num == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_num == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         return 0;
                     }
@@ -675,29 +721,27 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Search for begin of payload */
                 LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_UNDEF);
 
-                /* Accept only data that is expected, to be received */
-                if (tcb->rcv_nxt == seg_seq) {
-                    /* Copy contents into receive buffer */
-                    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
-                        tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
-                        snp = snp->next;
-                    }
-                    /* Shrink receive window */
-                    tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+                /* Hold payload in receive buffer, segments received out of order
+                 * are kept until the gap before them is filled */
+                if (_rcvbuf_add(tcb, snp, seg_seq, pay_len) > 0) {
                     /* Notify owner because new data is available */
                     tcb->status |= STATUS_NOTIFY_USER;
                 }
-                /* Send ACK, if FIN processing sends ACK already */
+                /* Shrink receive window */
+                tcb->rcv_wnd = _rcvbuf_get_free(tcb);
+
+                /* Send ACK, if FIN processing sends ACK already. For segments received
+                 * out of order, this is a duplicate ACK for the sender. */
                 /* NOTE: this is the place to add payload piggybagging in the future */
-                if (!(ctl & MSK_FIN)) {
+                if (!(ctl & MSK_FIN) || LSS_32_BIT(tcb->rcv_nxt, seg_seq + pay_len)) {
                     _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
                                NULL, 0);
                     _pkt_send(tcb, out_pkt, seq_con, false);
                 }
             }
         }
-        /* 7) Check FIN */
-        if (ctl & MSK_FIN) {
+        /* 7) Check FIN, if all data before it was received */
+        if ((ctl & MSK_FIN) && !LSS_32_BIT(tcb->rcv_nxt, seg_seq + pay_len)) {
             if (tcb->state == FSM_STATE_CLOSED || tcb->state == FSM_STATE_LISTEN ||
                 tcb->state == FSM_STATE_SYN_SENT) {
                 return 0;
@@ -711,7 +755,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->pkt_retransmit_num == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -753,9 +797,11 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
-    if (tcb->pkt_retransmit != NULL) {
-        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    if (tcb->pkt_retransmit_num > 0) {
+        /* Resend the oldest unacknowledged packet */
+        _cc_timeout(tcb);
+        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit[0], true);
+        _pkt_send(tcb, tcb->pkt_retransmit[0], 0, true);
     }
     else {
         DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Retransmit queue is empty\n");
@@ -821,7 +867,6 @@ static int _fsm_clear_retransmit(gnrc_tcp_tcb_t *tcb)
  * @param[in]     len     Number of bytes to send or receive in @p buf.
  *
  * @returns   Zero on success.
- *           -ENOMEM if receive buffer could not be allocated.
  *           -EADDRINUSE if given local port number in @p tcb is already in use.
  *           -EOPNOTSUPP if event is not implemented.
  */
@@ -884,6 +929,23 @@ int _fsm(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip_t *in_pkt, void *b
         msg.type = MSG_TYPE_NOTIFY_USER;
         mbox_try_put(&(tcb->mbox), &msg);
     }
+    /* Notify listening queue if a connection, that was not accepted yet, changed */
+    if ((tcb->status & STATUS_NOTIFY_USER) && (tcb->queue != NULL) &&
+        !(tcb->status & STATUS_ACCEPTED)) {
+        msg_t msg;
+        msg.type = MSG_TYPE_NOTIFY_USER;
+        mbox_try_put(&(tcb->queue->mbox), &msg);
+    }
+    /* Call the callbacks on the same changes */
+    if (tcb->status & STATUS_NOTIFY_USER) {
+        if (tcb->cb != NULL) {
+            tcb->cb(tcb->cb_arg);
+        }
+        if ((tcb->queue != NULL) && !(tcb->status & STATUS_ACCEPTED) &&
+            (tcb->queue->cb != NULL)) {
+            tcb->queue->cb(tcb->queue->cb_arg);
+        }
+    }
     /* Unlock FSM */
     mutex_unlock(&(tcb->fsm_lock));
     return result;
@@ -16,7 +16,9 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  * @}
  */
+#include <stdbool.h>
 #include "internal/common.h"
+#include "internal/fsm.h"
 #include "internal/option.h"
 
 #define ENABLE_DEBUG (0)
@@ -24,8 +26,18 @@
 
 int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
 {
+    uint16_t ctl = byteorder_ntohs(hdr->off_ctl);
+
+    /* The window scale option is only valid in SYN segments during connection setup */
+    bool parse_ws = (ctl & MSK_SYN) &&
+                    (tcb->state == FSM_STATE_LISTEN || tcb->state == FSM_STATE_SYN_SENT);
+    if (parse_ws) {
+        tcb->status &= ~STATUS_WND_SCALE;
+        tcb->snd_wnd_shift = 0;
+    }
+
     /* Extract offset value. Return if no options are set */
-    uint8_t offset = GET_OFFSET(byteorder_ntohs(hdr->off_ctl));
+    uint8_t offset = GET_OFFSET(ctl);
     if (offset <= TCP_HDR_OFFSET_MIN) {
         return 0;
     }
@@ -60,6 +72,20 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                       tcb->mss);
                 break;
 
+            case TCP_OPTION_KIND_WS:
+                if (option->length != TCP_OPTION_LENGTH_WS) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid WS Option length.\n");
+                    return -1;
+                }
+                if (parse_ws) {
+                    /* Shift counts above 14 must be treated as 14 (see RFC 7323) */
+                    tcb->snd_wnd_shift = (option->value[0] < 14) ? option->value[0] : 14;
+                    tcb->status |= STATUS_WND_SCALE;
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : WS option found. "
+                          "Shift=%"PRIu8"\n", tcb->snd_wnd_shift);
+                }
+                break;
+
             default:
                 DEBUG("gnrc_tcp_option.c : _option_parse() : Unknown option found.\
                       KIND=%"PRIu8", LENGTH=%"PRIu8"\n", option->kind, option->length);
@@ -16,86 +16,176 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
 #include <errno.h>
+#include <string.h>
+#include "net/gnrc/pktbuf.h"
+#include "internal/common.h"
 #include "internal/rcvbuf.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
 /**
- * @brief Internal struct holding receive buffers.
- */
-rcvbuf_t _static_buf;
-
-/**
- * @brief Initializes all receive buffers.
+ * @brief Copies payload of a received packet.
+ *
+ * @param[in]  pkt   Received packet, starting with the payload.
+ * @param[in]  off   Offset into the payload.
+ * @param[out] buf   Buffer to copy the payload into.
+ * @param[in]  len   Number of bytes to copy.
  */
-void _rcvbuf_init(void)
+static void _copy_payload(const gnrc_pktsnip_t *pkt, size_t off, uint8_t *buf, size_t len)
 {
-    DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_init() : entry\n");
-    mutex_init(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        _static_buf.entries[i].used = 0;
+    while (pkt && pkt->type == GNRC_NETTYPE_UNDEF && len > 0) {
+        if (off < pkt->size) {
+            size_t n = ((pkt->size - off) < len) ? (pkt->size - off) : len;
+            memcpy(buf, (uint8_t *) pkt->data + off, n);
+            buf += n;
+            len -= n;
+            off = 0;
+        }
+        else {
+            off -= pkt->size;
+        }
+        pkt = pkt->next;
     }
 }
 
 /**
- * @brief Allocate receive buffer.
+ * @brief Removes a segment from the receive buffer.
  *
- * @returns   Not NULL if a receive buffer was allocated.
- *            NULL if allocation failed.
+ * @param[in,out] tcb   TCB holding the receive buffer.
+ * @param[in]     pos   Index of the segment to remove.
  */
-static void* _rcvbuf_alloc(void)
+static void _remove(gnrc_tcp_tcb_t *tcb, const unsigned pos)
 {
-    void *result = NULL;
-    DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_alloc() : Entry\n");
-    mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if (_static_buf.entries[i].used == 0) {
-            _static_buf.entries[i].used = 1;
-            result = (void *)(_static_buf.entries[i].buffer);
-            break;
+    gnrc_pktbuf_release(tcb->rcv_buf[pos].pkt);
+    tcb->rcv_buf_num--;
+    memmove(&tcb->rcv_buf[pos], &tcb->rcv_buf[pos + 1],
+            (tcb->rcv_buf_num - pos) * sizeof(tcb->rcv_buf[0]));
+}
+
+int _rcvbuf_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const uint32_t seq_num,
+                const uint32_t pay_len)
+{
+    uint32_t seq = seq_num;
+    uint32_t len = pay_len;
+    uint32_t off = 0;
+    uint32_t r_edge = tcb->rcv_nxt + tcb->rcv_wnd;
+    uint32_t rcv_nxt = tcb->rcv_nxt;
+    unsigned pos = tcb->rcv_buf_num;
+
+    /* Cut off data that was received before */
+    if (LSS_32_BIT(seq, tcb->rcv_nxt)) {
+        off = tcb->rcv_nxt - seq;
+        if (off >= len) {
+            return 0;
+        }
+        seq += off;
+        len -= off;
+    }
+    /* Cut off data beyond the receive window */
+    if (LSS_32_BIT(r_edge, seq + len)) {
+        if (!LSS_32_BIT(seq, r_edge)) {
+            return 0;
+        }
+        len = r_edge - seq;
+    }
+
+    /* Find the position in the buffer, segments are ordered by sequence number */
+    while (pos > 0 && LSS_32_BIT(seq, tcb->rcv_buf[pos - 1].seq)) {
+        pos--;
+    }
+    /* Cut off data that is held by the previous segment */
+    if (pos > 0) {
+        gnrc_tcp_rcv_seg_t *prev = &tcb->rcv_buf[pos - 1];
+        uint32_t prev_end = prev->seq + prev->len;
+
+        if (LSS_32_BIT(seq, prev_end)) {
+            uint32_t cut = prev_end - seq;
+            if (cut >= len) {
+                return 0;
+            }
+            seq += cut;
+            off += cut;
+            len -= cut;
+        }
+    }
+    /* Cut off data that is held by the next segment */
+    if (pos < tcb->rcv_buf_num && LSS_32_BIT(tcb->rcv_buf[pos].seq, seq + len)) {
+        len = tcb->rcv_buf[pos].seq - seq;
+    }
+
+    /* If the buffer is full, make room by dropping the segment with the highest
+     * sequence number, unless it is the new one. This way the segment that fills
+     * a gap is never dropped in favor of segments received out of order. */
+    if (tcb->rcv_buf_num >= GNRC_TCP_RCV_SEGS) {
+        if (pos == tcb->rcv_buf_num ||
+            LSS_32_BIT(tcb->rcv_buf[tcb->rcv_buf_num - 1].seq, tcb->rcv_nxt)) {
+            DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_add() : Receive buffer is full\n");
+            return -ENOMEM;
         }
+        _remove(tcb, tcb->rcv_buf_num - 1);
+    }
+
+    /* Insert segment, hold the packet until its data was read */
+    memmove(&tcb->rcv_buf[pos + 1], &tcb->rcv_buf[pos],
+            (tcb->rcv_buf_num - pos) * sizeof(tcb->rcv_buf[0]));
+    tcb->rcv_buf[pos].pkt = pkt;
+    tcb->rcv_buf[pos].seq = seq;
+    tcb->rcv_buf[pos].off = off;
+    tcb->rcv_buf[pos].len = len;
+    tcb->rcv_buf_num++;
+    gnrc_pktbuf_hold(pkt, 1);
+
+    /* Advance rcv_nxt over all segments without gap */
+    while (pos < tcb->rcv_buf_num && tcb->rcv_buf[pos].seq == tcb->rcv_nxt) {
+        tcb->rcv_nxt += tcb->rcv_buf[pos].len;
+        pos++;
     }
-    mutex_unlock(&(_static_buf.lock));
-    return result;
+    return tcb->rcv_nxt - rcv_nxt;
 }
 
-/**
- * @brief Release allocated receive buffer.
- *
- * @param[in] buf   Pointer to buffer that should be released.
- */
-static void _rcvbuf_free(void * const buf)
+size_t _rcvbuf_get(gnrc_tcp_tcb_t *tcb, void *buf, const size_t len)
 {
-    DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_free() : Entry\n");
-    mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if ((_static_buf.entries[i].used == 1) && (buf == _static_buf.entries[i].buffer)) {
-            _static_buf.entries[i].used = 0;
+    size_t rcvd = 0;
+
+    while (rcvd < len && tcb->rcv_buf_num > 0 && LSS_32_BIT(tcb->rcv_buf[0].seq, tcb->rcv_nxt)) {
+        gnrc_tcp_rcv_seg_t *seg = &tcb->rcv_buf[0];
+        size_t n = ((len - rcvd) < seg->len) ? (len - rcvd) : seg->len;
+
+        _copy_payload(seg->pkt, seg->off, (uint8_t *) buf + rcvd, n);
+        rcvd += n;
+        seg->seq += n;
+        seg->off += n;
+        seg->len -= n;
+        if (seg->len == 0) {
+            _remove(tcb, 0);
         }
     }
-    mutex_unlock(&(_static_buf.lock));
+    return rcvd;
 }
 
-int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
+size_t _rcvbuf_get_avail(const gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->rcv_buf_raw == NULL) {
-        tcb->rcv_buf_raw = _rcvbuf_alloc();
-        if (tcb->rcv_buf_raw == NULL) {
-            DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_get_buffer() : Can't allocate rcv_buf_raw\n");
-            return -ENOMEM;
-        }
-        else {
-            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, GNRC_TCP_RCV_BUF_SIZE);
+    size_t avail = 0;
+
+    for (unsigned i = 0; i < tcb->rcv_buf_num; i++) {
+        if (!LSS_32_BIT(tcb->rcv_buf[i].seq, tcb->rcv_nxt)) {
+            break;
         }
+        avail += tcb->rcv_buf[i].len;
     }
-    return 0;
+    return avail;
+}
+
+size_t _rcvbuf_get_free(const gnrc_tcp_tcb_t *tcb)
+{
+    return GNRC_TCP_RCV_BUF_SIZE - _rcvbuf_get_avail(tcb);
 }
 
-void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
+void _rcvbuf_clear(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->rcv_buf_raw != NULL) {
-        _rcvbuf_free(tcb->rcv_buf_raw);
-        tcb->rcv_buf_raw = NULL;
+    for (unsigned i = 0; i < tcb->rcv_buf_num; i++) {
+        gnrc_pktbuf_release(tcb->rcv_buf[i].pkt);
     }
+    tcb->rcv_buf_num = 0;
 }
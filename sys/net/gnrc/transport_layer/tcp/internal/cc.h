@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tcp TCP
+ * @ingroup     net_gnrc
+ * @brief       RIOT's TCP implementation for the GNRC network stack.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Congestion control (NewReno, see RFC 5681 and RFC 6582).
+ */
+
+#ifndef CC_H
+#define CC_H
+
+#include <stdint.h>
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Calculates the sender maximum segment size of a connection.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   The size of the largest segment that may be sent to the peer.
+ */
+uint16_t _cc_get_smss(const gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Sets the initial congestion window and slow start threshold.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_init(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Updates the congestion window after an ACK acknowledged new data.
+ *
+ * @note Must be called after snd_una was advanced and the acknowledged
+ *       packets were removed from the retransmit queue.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     acked   Number of newly acknowledged bytes.
+ */
+void _cc_ack(gnrc_tcp_tcb_t *tcb, const uint32_t acked);
+
+/**
+ * @brief Handles a duplicate ACK, starts fast retransmit if required.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_dupack(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Reduces the congestion window after a retransmission timeout.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_timeout(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Calculates the number of bytes that may be sent right now.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Free space in the smaller of send window and congestion window.
+ */
+uint32_t _cc_get_usable_window(const gnrc_tcp_tcb_t *tcb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CC_H */
+/** @} */
@@ -44,6 +44,20 @@ static inline uint32_t _option_build_mss(uint16_t mss)
             ((uint32_t) TCP_OPTION_LENGTH_MSS << 16) | mss);
 }
 
+/**
+ * @brief Helper function to build the window scale option, preceded by a NOP option.
+ *
+ * @param[in] shift   Window scale shift count that should be set.
+ *
+ * @returns   NOP and window scale option value.
+ */
+static inline uint32_t _option_build_ws(uint8_t shift)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_WS << 16) |
+            ((uint32_t) TCP_OPTION_LENGTH_WS << 8) | shift);
+}
+
 /**
  * @brief Helper function to build the combined option and control flag field.
  *
@@ -14,7 +14,11 @@
  * @{
  *
  * @file
- * @brief       Functions for allocating and freeing the receive buffer.
+ * @brief       Functions for holding received data until it is read.
+ *
+ * Received segments are held in the packet buffer, so no memory is reserved
+ * for connections that don't receive. Segments that arrive out of order are
+ * held as well, until the missing data arrives.
  *
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
@@ -23,7 +27,8 @@
 #define RCVBUF_H
 
 #include <stdint.h>
-#include "mutex.h"
+#include <stddef.h>
+#include "net/gnrc/pkt.h"
 #include "net/gnrc/tcp/config.h"
 #include "net/gnrc/tcp/tcb.h"
 
@@ -32,42 +37,56 @@ extern "C" {
 #endif
 
 /**
- * @brief Receive buffer entry.
+ * @brief Adds the payload of a received segment to the receive buffer.
+ *
+ * @note Advances rcv_nxt of @p tcb over the data that became readable.
+ *
+ * @param[in,out] tcb       TCB holding the receive buffer.
+ * @param[in]     pkt       Received packet, starting with the payload.
+ * @param[in]     seq_num   Sequence number of the segment.
+ * @param[in]     pay_len   Payload length of the segment.
+ *
+ * @returns   Number of bytes that became readable.
+ *            -ENOMEM if the segment was dropped, because too many segments are held.
  */
-typedef struct rcvbuf_entry {
-    uint8_t used;                          /**< Flag: Is buffer in use? */
-    uint8_t buffer[GNRC_TCP_RCV_BUF_SIZE]; /**< Receive buffer storage */
-} rcvbuf_entry_t;
+int _rcvbuf_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const uint32_t seq_num,
+                const uint32_t pay_len);
 
 /**
- * @brief   Stuct holding receive buffers.
+ * @brief Reads data from the receive buffer.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer.
+ * @param[out]    buf   Buffer to store the data into.
+ * @param[in]     len   Maximum number of bytes to read.
+ *
+ * @returns   Number of bytes read.
  */
-typedef struct rcvbuf {
-    mutex_t lock;                                 /**< Lock for allocation synchronization */
-    rcvbuf_entry_t entries[GNRC_TCP_RCV_BUFFERS]; /**< Maintained receive buffers */
-} rcvbuf_t;
+size_t _rcvbuf_get(gnrc_tcp_tcb_t *tcb, void *buf, const size_t len);
 
 /**
- * @brief   Initializes global receive buffer.
+ * @brief Calculates the number of readable bytes in the receive buffer.
+ *
+ * @param[in] tcb   TCB holding the receive buffer.
+ *
+ * @returns   Number of bytes that can be read.
  */
-void _rcvbuf_init(void);
+size_t _rcvbuf_get_avail(const gnrc_tcp_tcb_t *tcb);
 
 /**
- * @brief Allocate receive buffer and assign it to TCB.
+ * @brief Calculates the free space in the receive buffer.
  *
- * @param[in,out] tcb   TCB that aquires receive buffer.
+ * @param[in] tcb   TCB holding the receive buffer.
  *
- * @returns   Zero  on success.
- *            -ENOMEM if all receive buffers are currently used.
+ * @returns   GNRC_TCP_RCV_BUF_SIZE minus the number of readable bytes.
  */
-int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
+size_t _rcvbuf_get_free(const gnrc_tcp_tcb_t *tcb);
 
 /**
- * @brief Release allocated receive buffer.
+ * @brief Releases all segments held in the receive buffer.
  *
- * @param[in,out] tcb   TCB holding the receive buffer that should be released.
+ * @param[in,out] tcb   TCB holding the receive buffer.
  */
-void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb);
+void _rcvbuf_clear(gnrc_tcp_tcb_t *tcb);
 
 #ifdef __cplusplus
 }
@@ -26,7 +26,13 @@
 #include "utlist.h"
 #include "net/ipv6/hdr.h"
 #include "net/gnrc/udp.h"
+#ifdef MODULE_GNRC_UDP_PORTS
+#include "net/gnrc/udp/ports.h"
+#endif
 #include "net/gnrc.h"
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+#include "net/gnrc/netapi/direct.h"
+#endif
 #include "net/inet_csum.h"
 
 
@@ -47,6 +53,13 @@ static char _stack[GNRC_UDP_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 static char _stack[GNRC_UDP_STACK_SIZE];
 #endif
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+/**
+ * @brief   Registration of UDP for direct calls
+ */
+static gnrc_netapi_direct_t _layer;
+#endif
+
 /**
  * @brief   Calculate the UDP checksum dependent on the network protocol
  *
@@ -154,6 +167,14 @@ static void _receive(gnrc_pktsnip_t *pkt)
     /* get port (netreg demux context) */
     port = (uint32_t)byteorder_ntohs(hdr->dst_port);
 
+#ifdef MODULE_GNRC_UDP_PORTS
+    if (!gnrc_udp_ports_demux(port)) {
+        DEBUG("udp: port %u is not bound, dropping packet\n", (unsigned)port);
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+#endif
+
     /* send payload to receivers */
     if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UDP, port, pkt)) {
         DEBUG("udp: unable to forward packet as no one is interested in it\n");
@@ -217,20 +238,44 @@ static void _send(gnrc_pktsnip_t *pkt)
     }
 }
 
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+static void _direct(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    switch (cmd) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            _receive(pkt);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            _send(pkt);
+            break;
+        default:
+            gnrc_pktbuf_release(pkt);
+            break;
+    }
+}
+#endif
+
 static void *_event_loop(void *arg)
 {
     (void)arg;
     msg_t msg, reply;
     msg_t msg_queue[GNRC_UDP_MSG_QUEUE_SIZE];
+#ifndef MODULE_GNRC_NETAPI_DIRECT
     gnrc_netreg_entry_t netreg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
+#endif
     /* preset reply message */
     reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
     reply.content.value = (uint32_t)-ENOTSUP;
     /* initialize message queue */
     msg_init_queue(msg_queue, GNRC_UDP_MSG_QUEUE_SIZE);
     /* register UPD at netreg */
+#ifdef MODULE_GNRC_NETAPI_DIRECT
+    gnrc_netapi_direct_register(&_layer, GNRC_NETTYPE_UDP, _direct);
+#else
     gnrc_netreg_register(GNRC_NETTYPE_UDP, &netreg);
+#endif
 
     /* dispatch NETAPI messages */
     while (1) {
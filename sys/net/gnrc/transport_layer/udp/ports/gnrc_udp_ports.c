@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_udp_ports
+ * @{
+ *
+ * @file
+ * @brief       UDP port table implementation
+ * @}
+ */
+
+#include <string.h>
+
+#include "bitarithm.h"
+#include "bitfield.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/udp/ports.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if (GNRC_UDP_PORTS_BUCKETS & (GNRC_UDP_PORTS_BUCKETS - 1)) != 0
+#error "GNRC_UDP_PORTS_BUCKETS must be a power of 2"
+#endif
+
+#define _DYN_BYTES      ((GNRC_UDP_PORTS_DYN_NUM + 7) / 8)
+
+/* bit i is set if GNRC_UDP_PORTS_DYN_MIN + i is bound */
+static BITFIELD(_dyn_bound, GNRC_UDP_PORTS_DYN_NUM);
+static uint16_t _dyn_next = 0;
+static gnrc_udp_ports_stats_t _stats;
+
+static inline bool _is_dyn(uint16_t port)
+{
+    return (port >= GNRC_UDP_PORTS_DYN_MIN);
+}
+
+void gnrc_udp_ports_init(void)
+{
+    memset(_dyn_bound, 0, sizeof(_dyn_bound));
+    /* the bits past the end of the range are never free */
+    for (unsigned i = GNRC_UDP_PORTS_DYN_NUM; i < (_DYN_BYTES * 8); i++) {
+        bf_set(_dyn_bound, i);
+    }
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+void gnrc_udp_ports_add(uint16_t port)
+{
+    if (gnrc_netreg_num(GNRC_NETTYPE_UDP, port) != 1) {
+        /* port was already bound */
+        return;
+    }
+    DEBUG("udp ports: bound port %u\n", (unsigned)port);
+    _stats.bound++;
+    if (_is_dyn(port)) {
+        bf_set(_dyn_bound, port - GNRC_UDP_PORTS_DYN_MIN);
+        _stats.dyn_bound++;
+    }
+}
+
+void gnrc_udp_ports_remove(uint16_t port)
+{
+    if (gnrc_netreg_lookup(GNRC_NETTYPE_UDP, port) != NULL) {
+        /* port still has receivers */
+        return;
+    }
+    DEBUG("udp ports: unbound port %u\n", (unsigned)port);
+    _stats.bound--;
+    if (_is_dyn(port)) {
+        bf_unset(_dyn_bound, port - GNRC_UDP_PORTS_DYN_MIN);
+        _stats.dyn_bound--;
+    }
+}
+
+bool gnrc_udp_ports_used(uint16_t port)
+{
+    if (_is_dyn(port)) {
+        return bf_isset(_dyn_bound, port - GNRC_UDP_PORTS_DYN_MIN);
+    }
+    return (gnrc_netreg_lookup(GNRC_NETTYPE_UDP, port) != NULL);
+}
+
+bool gnrc_udp_ports_demux(uint16_t port)
+{
+    if (gnrc_udp_ports_used(port)) {
+        _stats.demux_hits++;
+        return true;
+    }
+    _stats.demux_misses++;
+    return false;
+}
+
+uint16_t gnrc_udp_ports_alloc(void)
+{
+    unsigned idx = (_dyn_next * GNRC_UDP_PORTS_DYN_OFF) % GNRC_UDP_PORTS_DYN_NUM;
+
+    _dyn_next++;
+    if (!bf_isset(_dyn_bound, idx)) {
+        _stats.allocs++;
+        return GNRC_UDP_PORTS_DYN_MIN + idx;
+    }
+    if (_stats.dyn_bound >= GNRC_UDP_PORTS_DYN_NUM) {
+        DEBUG("udp ports: dynamic port range exhausted\n");
+        _stats.alloc_fails++;
+        return 0;
+    }
+    /* candidate is bound: take the next unbound port after it. The first
+     * byte is looked at twice, once for the ports after the candidate and
+     * after wrapping around for the ports before it. */
+    for (unsigned i = 0; i <= _DYN_BYTES; i++) {
+        unsigned byte = ((idx / 8) + i) % _DYN_BYTES;
+        unsigned free = ~_dyn_bound[byte] & 0xff;
+
+        if (i == 0) {
+            free &= (0xff << (idx % 8));
+        }
+        if (free != 0) {
+            _stats.allocs++;
+            return GNRC_UDP_PORTS_DYN_MIN + (byte * 8) + bitarithm_lsb(free);
+        }
+    }
+    /* unreachable as long as _stats.dyn_bound is consistent */
+    _stats.alloc_fails++;
+    return 0;
+}
+
+void gnrc_udp_ports_get_stats(gnrc_udp_ports_stats_t *stats)
+{
+    memcpy(stats, &_stats, sizeof(_stats));
+}
@@ -24,6 +24,7 @@ void netdev_test_reset(netdev_test_t *dev)
     mutex_lock(&dev->mutex);
     dev->send_cb = NULL;
     dev->recv_cb = NULL;
+    dev->recv_iolist_cb = NULL;
     dev->init_cb = NULL;
     dev->isr_cb = NULL;
     memset(dev->get_cbs, 0, sizeof(dev->get_cbs));
@@ -61,6 +62,23 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     return res;
 }
 
+static int _recv_iolist(netdev_t *netdev, const iolist_t *iolist, void *info)
+{
+    netdev_test_t *dev = (netdev_test_t *)netdev;
+    int res = -ENOTSUP;     /* fall back to _recv() by default */
+
+    mutex_lock(&dev->mutex);
+    if (dev->recv_iolist_cb != NULL) {
+        /* could fire context change and call _recv_iolist so we need to unlock */
+        mutex_unlock(&dev->mutex);
+        res = dev->recv_iolist_cb(netdev, iolist, info);
+    }
+    else {
+        mutex_unlock(&dev->mutex);
+    }
+    return res;
+}
+
 static int _init(netdev_t *netdev)
 {
     netdev_test_t *dev = (netdev_test_t *)netdev;
@@ -121,6 +139,7 @@ static const netdev_driver_t _driver = {
     .isr    = _isr,
     .get    = _get,
     .set    = _set,
+    .recv_iolist = _recv_iolist,
 };
 
 void netdev_test_setup(netdev_test_t *dev, void *state)
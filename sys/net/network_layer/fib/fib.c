@@ -24,9 +24,12 @@
 #include <string.h>
 #include <inttypes.h>
 #include <errno.h>
+#include <assert.h>
 #include "thread.h"
 #include "mutex.h"
 #include "msg.h"
+#include "evtimer.h"
+#include "kernel_defines.h"
 #include "xtimer.h"
 #include "timex.h"
 #include "utlist.h"
@@ -65,9 +68,387 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * US_PER_MS);
 }
 
+/**
+ * @brief expiry timer callback, called in interrupt context.
+ *        It only marks the entry, the entry is removed the next time it is
+ *        encountered while holding the table mutex.
+ *
+ * @param[in] event     the expiry event of the entry
+ */
+static void fib_expire_cb(evtimer_event_t *event)
+{
+    fib_entry_t *entry = container_of(event, fib_entry_t, expiry);
+
+    entry->expired = 1;
+}
+
+/**
+ * @brief sets the lifetime of an entry and (re)schedules its expiry
+ *
+ * @param[in] table     the FIB table the entry belongs to
+ * @param[in] entry     the entry
+ * @param[in] lifetime  the lifetime in ms
+ */
+static void fib_set_lifetime(fib_table_t *table, fib_entry_t *entry,
+                             uint32_t lifetime)
+{
+    if ((entry->lifetime != 0) && (entry->lifetime != FIB_LIFETIME_NO_EXPIRE)) {
+        evtimer_del(&table->expiry, &entry->expiry);
+    }
+
+    entry->expired = 0;
+
+    if (lifetime != (uint32_t)FIB_LIFETIME_NO_EXPIRE) {
+        fib_lifetime_to_absolute(lifetime, &entry->lifetime);
+        entry->expiry.offset = lifetime;
+        evtimer_add(&table->expiry, &entry->expiry);
+    }
+    else {
+        entry->lifetime = FIB_LIFETIME_NO_EXPIRE;
+    }
+}
+
+/**
+ * @brief returns the bit at position pos of the given address
+ */
+static inline unsigned fib_addr_bit(const uint8_t *addr, unsigned pos)
+{
+    return (addr[pos >> 3] >> (7 - (pos & 0x7))) & 0x1;
+}
+
+/**
+ * @brief returns the number of leading bits a and b have in common,
+ *        but at most max
+ */
+static unsigned fib_common_bits(const uint8_t *a, const uint8_t *b,
+                                unsigned max)
+{
+    unsigned i = 0;
+
+    while (((i + 8) <= max) && (a[i >> 3] == b[i >> 3])) {
+        i += 8;
+    }
+    while ((i < max) && (fib_addr_bit(a, i) == fib_addr_bit(b, i))) {
+        i++;
+    }
+
+    return i;
+}
+
+/**
+ * @brief returns the number of significant prefix bits of an entry
+ *
+ * The all zero address is the default route and has no significant bits,
+ * entries without a net prefix length are host routes.
+ */
+static uint16_t fib_entry_prefix_len(fib_entry_t *entry)
+{
+    size_t bits = entry->global->address_size << 3;
+    bool is_all_zeros_addr = true;
+
+    for (size_t i = 0; i < entry->global->address_size; ++i) {
+        if (entry->global->address[i] != 0) {
+            is_all_zeros_addr = false;
+            break;
+        }
+    }
+
+    if (is_all_zeros_addr) {
+        return 0;
+    }
+
+    if (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK) {
+        /* we shift the most upper flag byte back to get the number of prefix bits */
+        size_t prefix_len = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                            >> FIB_FLAG_NET_PREFIX_SHIFT;
+        if (prefix_len < bits) {
+            return prefix_len;
+        }
+    }
+
+    return bits;
+}
+
+/**
+ * @brief resets the prefix trie of a table and puts all nodes on the free list
+ *
+ * @param[in] table     the FIB table
+ */
+static void fib_trie_reset(fib_table_t *table)
+{
+    table->trie_root = NULL;
+    table->trie_free = NULL;
+
+    if (table->table_type != FIB_TABLE_TYPE_SH) {
+        return;
+    }
+
+    for (size_t i = 0; i < FIB_TRIE_NODES_NUMOF(table->size); ++i) {
+        table->trie_nodes[i].child[0] = table->trie_free;
+        table->trie_nodes[i].child[1] = NULL;
+        table->trie_nodes[i].entry = NULL;
+        table->trie_free = &table->trie_nodes[i];
+    }
+}
+
+static fib_trie_node_t *fib_trie_node_alloc(fib_table_t *table)
+{
+    fib_trie_node_t *node = table->trie_free;
+
+    if (node != NULL) {
+        table->trie_free = node->child[0];
+        node->child[0] = NULL;
+        node->child[1] = NULL;
+        node->entry = NULL;
+    }
+
+    return node;
+}
+
+static void fib_trie_node_free(fib_table_t *table, fib_trie_node_t *node)
+{
+    node->entry = NULL;
+    node->child[1] = NULL;
+    node->child[0] = table->trie_free;
+    table->trie_free = node;
+}
+
+/**
+ * @brief returns the address of any entry below the given node.
+ *        Its first node->len bits are the prefix represented by the node.
+ */
+static uint8_t *fib_trie_node_key(fib_trie_node_t *node)
+{
+    /* branching nodes always have two children */
+    while (node->entry == NULL) {
+        node = node->child[0];
+    }
+
+    return node->entry->global->address;
+}
+
+/**
+ * @brief releases the addresses and the expiry timer of an entry
+ *        without touching the prefix trie
+ *
+ * @param[in] table     the FIB table the entry belongs to
+ * @param[in] entry     the entry to be released
+ */
+static void fib_release(fib_table_t *table, fib_entry_t *entry)
+{
+    if ((entry->lifetime != 0) && (entry->lifetime != FIB_LIFETIME_NO_EXPIRE)) {
+        evtimer_del(&table->expiry, &entry->expiry);
+    }
+
+    if (entry->global != NULL) {
+        universal_address_rem(entry->global);
+    }
+
+    if (entry->next_hop) {
+        universal_address_rem(entry->next_hop);
+    }
+
+    entry->global = NULL;
+    entry->global_flags = 0;
+    entry->next_hop = NULL;
+    entry->next_hop_flags = 0;
+
+    entry->iface_id = KERNEL_PID_UNDEF;
+    entry->lifetime = 0;
+    entry->expired = 0;
+}
+
+/**
+ * @brief inserts an entry into the prefix trie.
+ *        An entry for a prefix that is already stored is appended to the
+ *        entries of that prefix, so the entry added first is preferred.
+ *
+ * @param[in] table     the FIB table
+ * @param[in] entry     the entry to be inserted, its global address must be set
+ *
+ * @return 0 on success
+ *         -ENOMEM if no trie node is left
+ */
+static int fib_trie_insert(fib_table_t *table, fib_entry_t *entry)
+{
+    uint8_t *key = entry->global->address;
+    uint16_t len = fib_entry_prefix_len(entry);
+    fib_trie_node_t **slot = &table->trie_root;
+    fib_trie_node_t *node = fib_trie_node_alloc(table);
+
+    if (node == NULL) {
+        return -ENOMEM;
+    }
+
+    entry->next = NULL;
+    node->entry = entry;
+    node->len = len;
+
+    while (*slot != NULL) {
+        fib_trie_node_t *cur = *slot;
+        uint8_t *cur_key = fib_trie_node_key(cur);
+        unsigned common = fib_common_bits(key, cur_key,
+                                          (len < cur->len) ? len : cur->len);
+
+        if (common < cur->len) {
+            if (common == len) {
+                /* the new prefix covers the current subtrie */
+                node->child[fib_addr_bit(cur_key, len)] = cur;
+                *slot = node;
+                return 0;
+            }
+
+            /* the prefixes diverge, so we need a branching node */
+            fib_trie_node_t *branch = fib_trie_node_alloc(table);
+
+            if (branch == NULL) {
+                fib_trie_node_free(table, node);
+                return -ENOMEM;
+            }
+
+            branch->len = common;
+            branch->child[fib_addr_bit(key, common)] = node;
+            branch->child[fib_addr_bit(cur_key, common)] = cur;
+            *slot = branch;
+            return 0;
+        }
+
+        if (cur->len == len) {
+            /* we already have a node for this prefix */
+            fib_entry_t **tail = &cur->entry;
+
+            fib_trie_node_free(table, node);
+
+            while (*tail != NULL) {
+                tail = &(*tail)->next;
+            }
+
+            *tail = entry;
+            return 0;
+        }
+
+        slot = &cur->child[fib_addr_bit(key, cur->len)];
+    }
+
+    *slot = node;
+    return 0;
+}
+
+/**
+ * @brief checks if an entry is stored at the given trie node
+ */
+static bool fib_trie_node_has_entry(fib_trie_node_t *node, fib_entry_t *entry)
+{
+    for (fib_entry_t *cur = node->entry; cur != NULL; cur = cur->next) {
+        if (cur == entry) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief removes an entry from the prefix trie
+ *
+ * @param[in] table     the FIB table
+ * @param[in] entry     the entry to be removed
+ */
+static void fib_trie_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    uint8_t *key = entry->global->address;
+    size_t key_bits = entry->global->address_size << 3;
+    fib_trie_node_t **parent_slot = NULL;
+    fib_trie_node_t **slot = &table->trie_root;
+
+    while ((*slot != NULL) && !fib_trie_node_has_entry(*slot, entry)) {
+        if ((*slot)->len >= key_bits) {
+            return;
+        }
+        parent_slot = slot;
+        slot = &(*slot)->child[fib_addr_bit(key, (*slot)->len)];
+    }
+
+    fib_trie_node_t *node = *slot;
+
+    if (node == NULL) {
+        return;
+    }
+
+    fib_entry_t **prev = &node->entry;
+
+    while (*prev != entry) {
+        prev = &(*prev)->next;
+    }
+
+    *prev = entry->next;
+    entry->next = NULL;
+
+    if (node->entry != NULL) {
+        /* other entries for this prefix are left */
+        return;
+    }
+
+    if ((node->child[0] != NULL) && (node->child[1] != NULL)) {
+        /* keep it as branching node */
+        return;
+    }
+
+    *slot = (node->child[0] != NULL) ? node->child[0] : node->child[1];
+    fib_trie_node_free(table, node);
+
+    if ((*slot == NULL) && (parent_slot != NULL)) {
+        fib_trie_node_t *parent = *parent_slot;
+
+        if (parent->entry == NULL) {
+            /* a branching node with a single child is not needed anymore */
+            *parent_slot = (parent->child[0] != NULL) ? parent->child[0]
+                                                      : parent->child[1];
+            fib_trie_node_free(table, parent);
+        }
+    }
+}
+
+/**
+ * @brief removes the given entry
+ *
+ * @param[in] table the FIB table the entry belongs to
+ * @param[in] entry the entry to be removed
+ *
+ * @return 0 on success
+ */
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    if (entry->global != NULL) {
+        fib_trie_remove(table, entry);
+    }
+
+    fib_release(table, entry);
+
+    return 0;
+}
+
+/**
+ * @brief removes all entries of the table whose lifetime expired
+ *
+ * @param[in] table the FIB table
+ */
+static void fib_remove_expired(fib_table_t *table)
+{
+    for (size_t i = 0; i < table->size; ++i) {
+        if ((table->data.entries[i].global != NULL)
+            && table->data.entries[i].expired) {
+            fib_remove(table, &table->data.entries[i]);
+        }
+    }
+}
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
+ * The lookup descends the prefix trie along the bits of dst, so its cost only
+ * depends on the address size and not on the number of entries.
+ *
  * @param[in] table                the FIB table to search in
  * @param[in] dst                  the destination address
  * @param[in] dst_size             the destination address size
@@ -81,13 +462,9 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
  */
 static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                           fib_entry_t **entry_arr, size_t *entry_arr_size) {
-    uint64_t now = xtimer_now_usec64();
-
-    size_t count = 0;
-    size_t prefix_size = 0;
-    size_t match_size = dst_size << 3;
-    int ret = -EHOSTUNREACH;
-    bool is_all_zeros_addr = true;
+    size_t dst_bits = dst_size << 3;
+    fib_trie_node_t *node = table->trie_root;
+    fib_entry_t *best = NULL;
 
 #if ENABLE_DEBUG
     DEBUG("[fib_find_entry] dst =");
@@ -97,101 +474,74 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     DEBUG("\n");
 #endif
 
-    for (size_t i = 0; i < dst_size; ++i) {
-        if (dst[i] != 0) {
-            is_all_zeros_addr = false;
-            break;
-        }
-    }
+    while (node != NULL) {
+        fib_entry_t *entry = node->entry;
 
-    for (size_t i = 0; i < table->size; ++i) {
+        while ((entry != NULL) && !entry->expired) {
+            entry = entry->next;
+        }
 
-        /* autoinvalidate if the entry lifetime is not set to not expire */
-        if (table->data.entries[i].lifetime != FIB_LIFETIME_NO_EXPIRE) {
+        if (entry != NULL) {
+            /* drop the expired entry and start over, since the removal
+             * reshapes the trie */
+            fib_remove(table, entry);
+            node = table->trie_root;
+            best = NULL;
+            continue;
+        }
 
-            /* check if the lifetime expired */
-            if (table->data.entries[i].lifetime < now) {
-                /* remove this entry if its lifetime expired */
-                table->data.entries[i].lifetime = 0;
-                table->data.entries[i].global_flags = 0;
-                table->data.entries[i].next_hop_flags = 0;
-                table->data.entries[i].iface_id = KERNEL_PID_UNDEF;
+        entry = node->entry;
 
-                if (table->data.entries[i].global != NULL) {
-                    universal_address_rem(table->data.entries[i].global);
-                    table->data.entries[i].global = NULL;
-                }
+        if ((entry != NULL) && (entry->global->address_size == dst_size)) {
+            if (fib_common_bits(entry->global->address, dst, node->len) < node->len) {
+                /* all entries below share this prefix, so none of them fits */
+                break;
+            }
 
-                if (table->data.entries[i].next_hop != NULL) {
-                    universal_address_rem(table->data.entries[i].next_hop);
-                    table->data.entries[i].next_hop = NULL;
+            /* all entries of this node share the prefix, but differ in the
+             * remaining bits of their address */
+            for (; entry != NULL; entry = entry->next) {
+                if (memcmp(entry->global->address, dst, dst_size) == 0) {
+                    entry_arr[0] = entry;
+                    *entry_arr_size = 1;
+                    /* we will not find a better one so we return */
+                    return 1;
                 }
             }
-        }
 
-        if ((prefix_size < (dst_size<<3)) && (table->data.entries[i].global != NULL)) {
+            /* we could find a better one so we move on */
+            best = node->entry;
+        }
 
-            int ret_comp = universal_address_compare(table->data.entries[i].global, dst, &match_size);
-            /* If we found an exact match */
-            if ((ret_comp == UNIVERSAL_ADDRESS_EQUAL)
-                || (is_all_zeros_addr && (ret_comp == UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS))) {
-                entry_arr[0] = &(table->data.entries[i]);
-                *entry_arr_size = 1;
-                /* we will not find a better one so we return */
-                return 1;
-            }
-            else {
-                /* we try to find the most fitting prefix */
-                if (ret_comp == UNIVERSAL_ADDRESS_MATCHING_PREFIX) {
-                    if (table->data.entries[i].global_flags & FIB_FLAG_NET_PREFIX_MASK) {
-                        /* we shift the most upper flag byte back to get the number of prefix bits */
-                        size_t global_prefix_len = (table->data.entries[i].global_flags
-                                                    & FIB_FLAG_NET_PREFIX_MASK) >> FIB_FLAG_NET_PREFIX_SHIFT;
-
-                        if ((match_size >= global_prefix_len) &&
-                            ((prefix_size == 0) || (match_size > prefix_size))) {
-                            entry_arr[0] = &(table->data.entries[i]);
-                            /* we could find a better one so we move on */
-                            ret = 0;
-
-                            prefix_size = match_size;
-                            count = 1;
-                        }
-                    }
-                 }
-                 else if (ret_comp == UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS) {
-                    /* we found the default gateway entry, e.g. ::/0 for IPv6
-                     * and we keep it only if there is no better one
-                     */
-                    if (prefix_size == 0) {
-                        entry_arr[0] = &(table->data.entries[i]);
-                        /* we could find a better one so we move on */
-                        ret = 0;
-                        count = 1;
-                    }
-                }
-                match_size = dst_size<<3;
-            }
+        if (node->len >= dst_bits) {
+            break;
         }
+
+        node = node->child[fib_addr_bit(dst, node->len)];
+    }
+
+    if (best == NULL) {
+        *entry_arr_size = 0;
+        return -EHOSTUNREACH;
     }
 
 #if ENABLE_DEBUG
-    if (count > 0) {
-        DEBUG("[fib_find_entry] found prefix on interface %d:", entry_arr[0]->iface_id);
-        for (size_t i = 0; i < entry_arr[0]->global->address_size; i++) {
-            DEBUG(" %02x", entry_arr[0]->global->address[i]);
-        }
-        DEBUG("\n");
+    DEBUG("[fib_find_entry] found prefix on interface %d:", best->iface_id);
+    for (size_t i = 0; i < best->global->address_size; i++) {
+        DEBUG(" %02x", best->global->address[i]);
     }
+    DEBUG("\n");
 #endif
 
-    *entry_arr_size = count;
-    return ret;
+    entry_arr[0] = best;
+    *entry_arr_size = 1;
+    return 0;
 }
 
 /**
  * @brief updates the next hop the lifetime and the interface id for a given entry
  *
+ * @param[in] table          the FIB table the entry belongs to
  * @param[in] entry          the entry to be updated
  * @param[in] next_hop       the next hop address to be updated
  * @param[in] next_hop_size  the next hop address size
@@ -201,9 +551,9 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
  * @return 0 if the entry has been updated
  *         -ENOMEM if the entry cannot be updated due to insufficient RAM
  */
-static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
-                         size_t next_hop_size, uint32_t next_hop_flags,
-                         uint32_t lifetime)
+static int fib_upd_entry(fib_table_t *table, fib_entry_t *entry,
+                         uint8_t *next_hop, size_t next_hop_size,
+                         uint32_t next_hop_flags, uint32_t lifetime)
 {
     universal_address_container_t *container = universal_address_add(next_hop, next_hop_size);
 
@@ -215,12 +565,7 @@ static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
     entry->next_hop = container;
     entry->next_hop_flags = next_hop_flags;
 
-    if (lifetime != (uint32_t)FIB_LIFETIME_NO_EXPIRE) {
-        fib_lifetime_to_absolute(lifetime, &entry->lifetime);
-    }
-    else {
-        entry->lifetime = FIB_LIFETIME_NO_EXPIRE;
-    }
+    fib_set_lifetime(table, entry, lifetime);
 
     return 0;
 }
@@ -246,60 +591,49 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                             uint8_t *next_hop, size_t next_hop_size, uint32_t
                             next_hop_flags, uint32_t lifetime)
 {
-    for (size_t i = 0; i < table->size; ++i) {
-        if (table->data.entries[i].lifetime == 0) {
+    fib_entry_t *entry = NULL;
 
-            table->data.entries[i].global = universal_address_add(dst, dst_size);
-
-            if (table->data.entries[i].global != NULL) {
-                table->data.entries[i].global_flags = dst_flags;
-                table->data.entries[i].next_hop = universal_address_add(next_hop, next_hop_size);
-                table->data.entries[i].next_hop_flags = next_hop_flags;
+    for (int retry = 0; (entry == NULL) && (retry < 2); ++retry) {
+        if (retry > 0) {
+            /* make room by dropping entries that expired in the meantime */
+            fib_remove_expired(table);
+        }
+        for (size_t i = 0; i < table->size; ++i) {
+            if (table->data.entries[i].lifetime == 0) {
+                entry = &table->data.entries[i];
+                break;
             }
+        }
+    }
 
-            if (table->data.entries[i].next_hop != NULL) {
-                /* everything worked fine */
-                table->data.entries[i].iface_id = iface_id;
+    if (entry == NULL) {
+        return -ENOMEM;
+    }
 
-                if (lifetime != (uint32_t) FIB_LIFETIME_NO_EXPIRE) {
-                    fib_lifetime_to_absolute(lifetime, &table->data.entries[i].lifetime);
-                }
-                else {
-                    table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
-                }
+    entry->global = universal_address_add(dst, dst_size);
 
-                return 0;
-            }
-        }
+    if (entry->global == NULL) {
+        return -ENOMEM;
     }
 
-    return -ENOMEM;
-}
+    entry->next_hop = universal_address_add(next_hop, next_hop_size);
 
-/**
- * @brief removes the given entry
- *
- * @param[in] entry the entry to be removed
- *
- * @return 0 on success
- */
-static int fib_remove(fib_entry_t *entry)
-{
-    if (entry->global != NULL) {
-        universal_address_rem(entry->global);
+    if (entry->next_hop == NULL) {
+        fib_release(table, entry);
+        return -ENOMEM;
     }
 
-    if (entry->next_hop) {
-        universal_address_rem(entry->next_hop);
-    }
+    entry->global_flags = dst_flags;
+    entry->next_hop_flags = next_hop_flags;
 
-    entry->global = NULL;
-    entry->global_flags = 0;
-    entry->next_hop = NULL;
-    entry->next_hop_flags = 0;
+    if (fib_trie_insert(table, entry) != 0) {
+        fib_release(table, entry);
+        return -ENOMEM;
+    }
 
-    entry->iface_id = KERNEL_PID_UNDEF;
-    entry->lifetime = 0;
+    /* everything worked fine */
+    entry->iface_id = iface_id;
+    fib_set_lifetime(table, entry, lifetime);
 
     return 0;
 }
@@ -403,7 +737,7 @@ int fib_add_entry(fib_table_t *table,
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         ret = fib_create_entry(table, iface_id, dst, dst_size, dst_flags,
@@ -433,7 +767,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     if (fib_find_entry(table, dst, dst_size, &(entry[0]), &count) == 1) {
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -457,7 +791,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -477,7 +811,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -547,6 +881,8 @@ int fib_get_destination_set(fib_table_t *table, uint8_t *prefix,
     int ret = -EHOSTUNREACH;
     size_t found_entries = 0;
 
+    fib_remove_expired(table);
+
     for (size_t i = 0; i < table->size; ++i) {
         if ((table->data.entries[i].global != NULL) &&
             (universal_address_compare_prefix(table->data.entries[i].global, prefix, prefix_size<<3) >= UNIVERSAL_ADDRESS_EQUAL)) {
@@ -595,8 +931,11 @@ void fib_init(fib_table_t *table)
                sizeof(fib_sr_entry_t) * table->data.source_routes->entry_pool_size);
     }
     else {
+        assert(table->trie_nodes != NULL);
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
+    evtimer_init(&table->expiry, fib_expire_cb);
+    fib_trie_reset(table);
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
 }
@@ -620,8 +959,15 @@ void fib_deinit(fib_table_t *table)
                sizeof(fib_sr_entry_t) * table->data.source_routes->entry_pool_size);
     }
     else {
+        for (size_t i = 0; i < table->size; ++i) {
+            fib_entry_t *entry = &table->data.entries[i];
+            if ((entry->lifetime != 0) && (entry->lifetime != FIB_LIFETIME_NO_EXPIRE)) {
+                evtimer_del(&table->expiry, &entry->expiry);
+            }
+        }
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
+    fib_trie_reset(table);
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
 }
@@ -657,6 +1003,10 @@ int fib_get_num_used_entries(fib_table_t *table)
     mutex_lock(&(table->mtx_access));
     size_t used_entries = 0;
 
+    if (table->table_type == FIB_TABLE_TYPE_SH) {
+        fib_remove_expired(table);
+    }
+
     for (size_t i = 0; i < table->size; ++i) {
         used_entries += (size_t)(table->data.entries[i].global != NULL);
     }
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_sock_udp
+ * @{
+ *
+ * @file
+ * @brief       Generic implementation of sock_udp_recv_batch() and
+ *              sock_udp_send_batch()
+ *
+ * For stacks without a batch path of their own: the messages are received
+ * and sent one by one with sock_udp_recv() and sock_udp_send().
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "net/sock/udp.h"
+
+int sock_udp_recv_batch(sock_udp_t *sock, sock_udp_msg_t *msgs,
+                        unsigned count, uint32_t timeout)
+{
+    assert((msgs != NULL) && (count > 0));
+    for (unsigned i = 0; i < count; i++) {
+        /* only wait for the first message */
+        ssize_t res = sock_udp_recv(sock, msgs[i].data, msgs[i].len,
+                                    (i == 0) ? timeout : 0, msgs[i].remote);
+        if (res < 0) {
+            return (i == 0) ? (int)res : (int)i;
+        }
+        msgs[i].len = (size_t)res;
+    }
+    return (int)count;
+}
+
+int sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                        unsigned count)
+{
+    assert((msgs != NULL) && (count > 0));
+    for (unsigned i = 0; i < count; i++) {
+        ssize_t res = sock_udp_send(sock, msgs[i].data, msgs[i].len,
+                                    msgs[i].remote);
+        if (res < 0) {
+            return (i == 0) ? (int)res : (int)i;
+        }
+    }
+    return (int)count;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  posix_sockets
+ * @{
+ */
+
+/**
+ * @file
+ * @brief   Input/output multiplexing
+ * @see     <a href="http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/poll.h.html">
+ *              The Open Group Base Specifications Issue 7, <poll.h>
+ *          </a>
+ */
+
+/* If building on native we need to use the system header for the types */
+#ifdef CPU_NATIVE
+#pragma GCC system_header
+/* without the GCC pragma above #include_next will trigger a pedantic error */
+#include_next <poll.h>
+#else
+#ifndef POLL_H
+#define POLL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Event flags
+ * @brief   Flags for pollfd::events and pollfd::revents
+ * @{
+ */
+#define POLLIN      (0x0001)    /**< Data other than high-priority data may be read */
+#define POLLPRI     (0x0002)    /**< High-priority data may be read */
+#define POLLOUT     (0x0004)    /**< Normal data may be written */
+#define POLLERR     (0x0008)    /**< An error has occurred (revents only) */
+#define POLLHUP     (0x0010)    /**< Device has been disconnected (revents only) */
+#define POLLNVAL    (0x0020)    /**< Invalid fd member (revents only) */
+#define POLLRDNORM  POLLIN      /**< Normal data may be read */
+#define POLLWRNORM  POLLOUT     /**< Equivalent to POLLOUT */
+/** @} */
+
+/**
+ * @brief   Type for the number of file descriptors
+ */
+typedef unsigned int nfds_t;
+
+/**
+ * @brief   File descriptor to poll
+ */
+struct pollfd {
+    int fd;         /**< The file descriptor, ignored if negative */
+    short events;   /**< The requested events */
+    short revents;  /**< The events that occurred */
+};
+
+/**
+ * @brief   Waits for events on a set of file descriptors
+ *
+ * @see <a href="http://pubs.opengroup.org/onlinepubs/9699919799/functions/poll.html">
+ *          The Open Group Base Specification Issue 7, poll
+ *      </a>
+ *
+ * @note    Only sockets can be polled, and only with `SOCK_HAS_ASYNC` defined.
+ *          TCP sockets report POLLIN for readable data, the end of the stream
+ *          or a connection to accept, POLLOUT while connected and POLLHUP
+ *          once closed. Several threads may poll the same socket.
+ *
+ * @param[in,out] fds   The file descriptors and the events to wait for.
+ * @param[in] nfds      Number of elements in @p fds.
+ * @param[in] timeout   Timeout in milliseconds, -1 to wait indefinitely.
+ *
+ * @return  The number of elements of @p fds with non-zero pollfd::revents.
+ * @return  0, if the call timed out.
+ * @return  -1 on error, errno is set to indicate the error.
+ */
+int poll(struct pollfd fds[], nfds_t nfds, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POLL_H */
+#endif /* CPU_NATIVE */
+/** @} */
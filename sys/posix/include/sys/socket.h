@@ -117,6 +117,14 @@ extern "C" {
 #define SO_TYPE         (15)    /**< Socket type. */
 /** @} */
 
+/**
+ * @name    Message flags
+ * @brief   Flags for recv() and recvfrom()
+ * @{
+ */
+#define MSG_DONTWAIT    (0x0040)    /**< Do not block if no message is available. */
+/** @} */
+
 typedef unsigned short sa_family_t;   /**< address family type */
 
 /**
@@ -332,8 +340,8 @@ int listen(int socket, int backlog);
  *                          stored.
  * @param[in] length        Specifies the length in bytes of the buffer pointed
  *                          to by the buffer argument.
- * @param[in] flags         Specifies the type of message reception. Support
- *                          for values other than 0 is not implemented yet.
+ * @param[in] flags         Specifies the type of message reception. Only
+ *                          @ref MSG_DONTWAIT is supported.
  * @param[out] address      A null pointer, or points to a sockaddr structure
  *                          in which the sending address is to be stored. The
  *                          length and format of the address depend on the
@@ -369,8 +377,8 @@ ssize_t recvfrom(int socket, void *__restrict buffer, size_t length, int flags,
  * @param[out] buffer   Points to a buffer where the message should be stored.
  * @param[in] length    Specifies the length in bytes of the buffer pointed to
  *                      by the buffer argument.
- * @param[in] flags     Specifies the type of message reception. Support for
- *                      values other than 0 is not implemented yet.
+ * @param[in] flags     Specifies the type of message reception. Only
+ *                      @ref MSG_DONTWAIT is supported.
  *
  * @return  Upon successful completion, recv() shall return the length of the
  *          message in bytes. If no messages are available to be received and
@@ -19,6 +19,8 @@
 #include <assert.h>
 #include <arpa/inet.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <stdbool.h>
 #include <string.h>
 
@@ -36,10 +38,21 @@
 #include "net/sock/udp.h"
 #include "net/sock/tcp.h"
 
+#ifdef SOCK_HAS_ASYNC
+#include <stdatomic.h>
+
+#include "thread.h"
+#include "thread_flags.h"
+#include "xtimer.h"
+#endif
+
 /* enough to create sockets both with socket() and accept() */
 #define _ACTUAL_SOCKET_POOL_SIZE   (SOCKET_POOL_SIZE + \
                                     (SOCKET_POOL_SIZE * SOCKET_TCP_QUEUE_SIZE))
 #define SOCKET_BLKSIZE             (512)
+/* thread flag poll() waits for, set by the receive notifications of the
+ * sockets polled */
+#define SOCKET_POLL_FLAG           (1U << 13)
 
 /**
  * @brief   Unitfied connection type.
@@ -70,8 +83,14 @@ typedef struct {
     int type;
     int protocol;
     bool bound;
+    bool nonblock;              /* O_NONBLOCK is set */
 #ifdef POSIX_SETSOCKOPT
     uint32_t recv_timeout;
+#endif
+#ifdef SOCK_HAS_ASYNC
+    atomic_uint rx_pending;     /* messages received, but not read yet */
+    /* threads waiting for the socket in poll(), by PID */
+    BITFIELD(pollers, KERNEL_PID_LAST + 1);
 #endif
     socket_sock_t *sock;
 #ifdef MODULE_SOCK_TCP
@@ -82,6 +101,8 @@ typedef struct {
 } socket_t;
 
 static socket_t _socket_pool[_ACTUAL_SOCKET_POOL_SIZE];
+/* sockets by file descriptor */
+static socket_t *_fd_sockets[VFS_MAX_OPEN_FILES];
 static socket_sock_t _sock_pool[SOCKET_POOL_SIZE];
 #ifdef MODULE_SOCK_TCP
 static sock_tcp_t _tcp_sock_pool[SOCKET_POOL_SIZE][SOCKET_TCP_QUEUE_SIZE];
@@ -121,14 +142,80 @@ static socket_sock_t *_get_free_sock(void)
 
 static socket_t *_get_socket(int fd)
 {
-    for (int i = 0; i < _ACTUAL_SOCKET_POOL_SIZE; i++) {
-        if (_socket_pool[i].fd == fd) {
-            return &_socket_pool[i];
+    if ((fd < 0) || (fd >= VFS_MAX_OPEN_FILES)) {
+        return NULL;
+    }
+    return _fd_sockets[fd];
+}
+
+static void _socket_init(socket_t *s, int fd)
+{
+    s->fd = fd;
+    s->nonblock = false;
+#ifdef SOCK_HAS_ASYNC
+    atomic_init(&s->rx_pending, 0);
+    memset(s->pollers, 0, sizeof(s->pollers));
+#endif
+    _fd_sockets[fd] = s;
+}
+
+#ifdef SOCK_HAS_ASYNC
+static void _poll_wake(socket_t *s)
+{
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        if (bf_isset(s->pollers, pid)) {
+            thread_t *thread = (thread_t *)thread_get(pid);
+
+            /* the polling thread may have exited without leaving poll() */
+            if (thread != NULL) {
+                thread_flags_set(thread, SOCKET_POLL_FLAG);
+            }
         }
     }
-    return NULL;
 }
 
+static void _sock_event(socket_t *s)
+{
+    atomic_fetch_add(&s->rx_pending, 1);
+    _poll_wake(s);
+}
+
+#ifdef MODULE_SOCK_IP
+static void _ip_cb(sock_ip_t *sock, void *arg)
+{
+    (void)sock;
+    _sock_event(arg);
+}
+#endif
+
+#ifdef MODULE_SOCK_UDP
+static void _udp_cb(sock_udp_t *sock, void *arg)
+{
+    (void)sock;
+    _sock_event(arg);
+}
+#endif
+
+#ifdef MODULE_SOCK_TCP
+static void _tcp_cb(void *arg)
+{
+    /* the readiness of TCP socks is queried in _poll_events() */
+    _poll_wake(arg);
+}
+#endif
+
+static void _rx_done(socket_t *s)
+{
+    unsigned pending = atomic_load(&s->rx_pending);
+
+    /* a message is counted only after it was queued, so it may have been
+     * read before it was counted */
+    while ((pending > 0) &&
+           !atomic_compare_exchange_weak(&s->rx_pending, &pending,
+                                         pending - 1)) {}
+}
+#endif
+
 static int _get_sock_idx(socket_sock_t *sock)
 {
     if ((sock < &_sock_pool[0]) || (sock > &_sock_pool[SOCKET_POOL_SIZE - 1])) {
@@ -267,9 +354,15 @@ static int socket_close(vfs_file_t *filp)
 #ifdef MODULE_SOCK_TCP
             case SOCK_STREAM:
                 if (s->queue_array == NULL) {
+#ifdef SOCK_HAS_ASYNC
+                    sock_tcp_set_cb(&s->sock->tcp.sock, NULL, NULL);
+#endif
                     sock_tcp_disconnect(&s->sock->tcp.sock);
                 }
                 else {
+#ifdef SOCK_HAS_ASYNC
+                    sock_tcp_queue_set_cb(&s->sock->tcp.queue, NULL, NULL);
+#endif
                     sock_tcp_stop_listen(&s->sock->tcp.queue);
                 }
                 break;
@@ -283,6 +376,7 @@ static int socket_close(vfs_file_t *filp)
             bf_unset(_sock_pool_used, idx);
         }
     }
+    _fd_sockets[s->fd] = NULL;
     mutex_unlock(&_socket_pool_mutex);
     s->sock = NULL;
     s->domain = AF_UNSPEC;
@@ -316,9 +410,24 @@ static inline ssize_t socket_write(vfs_file_t *filp, const void *buf, size_t n)
     return socket_sendto(filp->private_data.ptr, buf, n, 0, NULL, 0);
 }
 
+static int socket_fcntl(vfs_file_t *filp, int cmd, int arg)
+{
+    socket_t *s = filp->private_data.ptr;
+
+    switch (cmd) {
+        case F_SETFL:
+            /* only O_NONBLOCK can be changed */
+            s->nonblock = (arg & O_NONBLOCK);
+            filp->flags = (filp->flags & ~O_NONBLOCK) | (arg & O_NONBLOCK);
+            return 0;
+        default:
+            return -EINVAL;
+    }
+}
+
 static const vfs_file_ops_t socket_ops = {
     .close = socket_close,
-    .fcntl = NULL,          /* TODO: provide when needed */
+    .fcntl = socket_fcntl,
     .fstat = socket_fstat,
     .lseek = socket_lseek,
     .read = socket_read,
@@ -351,7 +460,8 @@ int socket(int domain, int type, int protocol)
                 break;
             }
             else {
-                s->fd = res = fd;
+                _socket_init(s, fd);
+                res = fd;
             }
             s->domain = domain;
             s->type = type;
@@ -406,9 +516,9 @@ int accept(int socket, struct sockaddr *restrict address,
     }
 
 #ifdef POSIX_SETSOCKOPT
-    const uint32_t recv_timeout = s->recv_timeout;
+    const uint32_t recv_timeout = (s->nonblock) ? 0 : s->recv_timeout;
 #else
-    const uint32_t recv_timeout = SOCK_NO_TIMEOUT;
+    const uint32_t recv_timeout = (s->nonblock) ? 0 : SOCK_NO_TIMEOUT;
 #endif
 
     switch (s->type) {
@@ -450,15 +560,22 @@ int accept(int socket, struct sockaddr *restrict address,
                     break;
                 }
                 else {
-                    new_s->fd = res = fd;
+                    _socket_init(new_s, fd);
+                    res = fd;
                 }
                 new_s->domain = s->domain;
                 new_s->type = s->type;
                 new_s->protocol = s->protocol;
                 new_s->bound = true;
+                /* the accepted sock is part of the queue array of s, so
+                 * it is not taken from the sock pool */
+                new_s->sock = (socket_sock_t *)sock;
                 new_s->queue_array = NULL;
                 new_s->queue_array_len = 0;
-                memset(&s->local, 0, sizeof(sock_tcp_ep_t));
+                memset(&new_s->local, 0, sizeof(sock_tcp_ep_t));
+#ifdef SOCK_HAS_ASYNC
+                sock_tcp_set_cb(sock, _tcp_cb, new_s);
+#endif
             }
             break;
         default:
@@ -590,6 +707,27 @@ static int _bind_connect(socket_t *s, const struct sockaddr *address,
         mutex_unlock(&_socket_pool_mutex);
         return -1;
     }
+#ifdef SOCK_HAS_ASYNC
+    switch (s->type) {
+#ifdef MODULE_SOCK_IP
+        case SOCK_RAW:
+            sock_ip_set_cb(&sock->raw, _ip_cb, s);
+            break;
+#endif
+#ifdef MODULE_SOCK_UDP
+        case SOCK_DGRAM:
+            sock_udp_set_cb(&sock->udp, _udp_cb, s);
+            break;
+#endif
+#ifdef MODULE_SOCK_TCP
+        case SOCK_STREAM:
+            sock_tcp_set_cb(&sock->tcp.sock, _tcp_cb, s);
+            break;
+#endif
+        default:
+            break;
+    }
+#endif
     s->sock = sock;
     return 0;
 }
@@ -789,6 +927,9 @@ int listen(int socket, int backlog)
             break;
     }
     if (res == 0) {
+#ifdef SOCK_HAS_ASYNC
+        sock_tcp_queue_set_cb(&sock->tcp.queue, _tcp_cb, s);
+#endif
         s->sock = sock;
     }
     else {
@@ -815,7 +956,6 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
     int res = 0;
     struct _sock_tl_ep ep = { .port = 0 };
 
-    (void)flags;
     if (s == NULL) {
         return -ENOTSOCK;
     }
@@ -832,11 +972,14 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
     }
 
 #ifdef POSIX_SETSOCKOPT
-    const uint32_t recv_timeout = s->recv_timeout;
+    uint32_t recv_timeout = s->recv_timeout;
 #else
-    const uint32_t recv_timeout = SOCK_NO_TIMEOUT;
+    uint32_t recv_timeout = SOCK_NO_TIMEOUT;
 #endif
 
+    if (s->nonblock || (flags & MSG_DONTWAIT)) {
+        recv_timeout = 0;
+    }
     switch (s->type) {
 #ifdef MODULE_SOCK_IP
         case SOCK_RAW:
@@ -863,6 +1006,12 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
             res = -EOPNOTSUPP;
             break;
     }
+#ifdef SOCK_HAS_ASYNC
+    if ((s->type != SOCK_STREAM) && (res != -ETIMEDOUT)) {
+        /* every other result consumed a message or found none */
+        _rx_done(s);
+    }
+#endif
     if ((res >= 0) && (address != NULL) && (address_len != NULL)) {
         switch (s->type) {
 #ifdef MODULE_SOCK_TCP
@@ -1046,6 +1195,125 @@ int setsockopt(int socket, int level, int option_name, const void *option_value,
 #endif
 }
 
+#ifdef SOCK_HAS_ASYNC
+static short _poll_events(socket_t *s, short events)
+{
+    short revents = 0;
+
+    switch (s->type) {
+        case SOCK_DGRAM:
+        case SOCK_RAW:
+            if ((events & POLLIN) && (atomic_load(&s->rx_pending) > 0)) {
+                revents |= POLLIN;
+            }
+            /* sending datagrams never blocks */
+            revents |= (events & POLLOUT);
+            break;
+#ifdef MODULE_SOCK_TCP
+        case SOCK_STREAM:
+            if (s->sock == NULL) {
+                /* neither connected nor listening */
+                revents |= POLLHUP;
+            }
+            else if (s->queue_array != NULL) {
+                if ((events & POLLIN) &&
+                    (sock_tcp_queue_get_events(&s->sock->tcp.queue) &
+                     SOCK_TCP_EVENT_ACCEPT)) {
+                    revents |= POLLIN;
+                }
+            }
+            else {
+                unsigned tcp_events = sock_tcp_get_events(&s->sock->tcp.sock);
+
+                if ((events & POLLIN) && (tcp_events & SOCK_TCP_EVENT_READ)) {
+                    revents |= POLLIN;
+                }
+                if ((events & POLLOUT) && (tcp_events & SOCK_TCP_EVENT_WRITE)) {
+                    revents |= POLLOUT;
+                }
+                if (tcp_events & SOCK_TCP_EVENT_CLOSED) {
+                    revents |= POLLHUP;
+                }
+            }
+            break;
+#endif
+        default:
+            revents = POLLNVAL;
+            break;
+    }
+    return revents;
+}
+
+static int _poll_check(struct pollfd fds[], nfds_t nfds, kernel_pid_t poller)
+{
+    int ready = 0;
+
+    mutex_lock(&_socket_pool_mutex);
+    for (nfds_t i = 0; i < nfds; i++) {
+        socket_t *s;
+
+        fds[i].revents = 0;
+        if (fds[i].fd < 0) {
+            continue;
+        }
+        if ((s = _get_socket(fds[i].fd)) == NULL) {
+            fds[i].revents = POLLNVAL;
+        }
+        else {
+            /* register before checking, so events after the check wake the
+             * poller */
+            bf_set(s->pollers, poller);
+            fds[i].revents = _poll_events(s, fds[i].events);
+        }
+        if (fds[i].revents != 0) {
+            ready++;
+        }
+    }
+    mutex_unlock(&_socket_pool_mutex);
+    return ready;
+}
+#endif
+
+int poll(struct pollfd fds[], nfds_t nfds, int timeout)
+{
+#ifdef SOCK_HAS_ASYNC
+    xtimer_t timer;
+    int ready;
+
+    thread_flags_clear(SOCKET_POLL_FLAG | THREAD_FLAG_TIMEOUT);
+    if (timeout > 0) {
+        xtimer_set_timeout_flag(&timer, (uint32_t)timeout * US_PER_MS);
+    }
+    while ((ready = _poll_check(fds, nfds, sched_active_pid)) == 0) {
+        if ((timeout == 0) ||
+            (thread_flags_wait_any(SOCKET_POLL_FLAG | THREAD_FLAG_TIMEOUT) &
+             THREAD_FLAG_TIMEOUT)) {
+            break;
+        }
+    }
+    if (timeout > 0) {
+        xtimer_remove(&timer);
+    }
+    /* unregister from the sockets again */
+    mutex_lock(&_socket_pool_mutex);
+    for (nfds_t i = 0; i < nfds; i++) {
+        socket_t *s = _get_socket(fds[i].fd);
+
+        if (s != NULL) {
+            bf_unset(s->pollers, sched_active_pid);
+        }
+    }
+    mutex_unlock(&_socket_pool_mutex);
+    return ready;
+#else
+    (void)fds;
+    (void)nfds;
+    (void)timeout;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
 /**
  * @}
  */
@@ -26,6 +26,10 @@
 #include "xtimer.h"
 #endif
 
+#ifdef MODULE_SCHEDPROF
+#include <inttypes.h>
+#endif
+
 #ifdef MODULE_TLSF
 #include "tlsf.h"
 #endif
@@ -45,6 +49,28 @@ static const char *state_names[] = {
     [STATUS_MBOX_BLOCKED] = "bl mbox",
 };
 
+#ifdef MODULE_SCHEDPROF
+static uint32_t _usec(uint32_t ticks)
+{
+    return xtimer_usec_from_ticks(xtimer_ticks(ticks));
+}
+
+static uint32_t _latency_avg(const schedstat *stat)
+{
+    return (stat->wakeups) ? _usec(stat->latency_ticks / stat->wakeups) : 0;
+}
+
+static unsigned _msg_queue_size(const thread_t *p)
+{
+#ifdef MODULE_CORE_MSG
+    return (p->msg_array) ? (p->msg_queue.mask + 1) : 0;
+#else
+    (void)p;
+    return 0;
+#endif
+}
+#endif
+
 /**
  * @brief Prints a list of running threads including stack usage to stdout.
  */
@@ -65,6 +91,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
            "| runtime  | switches"
+#endif
+#ifdef MODULE_SCHEDPROF
+           " | lat max    avg | irqoff max | msgq"
 #endif
            "\n",
 #ifdef DEVELHELP
@@ -124,6 +153,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    " | %2d.%03d%% |  %8u"
+#endif
+#ifdef MODULE_SCHEDPROF
+                   " | %7" PRIu32 " %6" PRIu32 " | %10" PRIu32 " | %4u"
 #endif
                    "\n",
                    p->pid,
@@ -136,6 +168,12 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    , runtime_major, runtime_minor, switches
+#endif
+#ifdef MODULE_SCHEDPROF
+                   , _usec(sched_pidlist[i].latency_max),
+                   _latency_avg(&sched_pidlist[i]),
+                   _usec(sched_pidlist[i].irq_off_max),
+                   sched_pidlist[i].msg_queue_max
 #endif
                   );
         }
@@ -150,3 +188,40 @@ void ps(void)
 #   endif
 #endif
 }
+
+#ifdef MODULE_SCHEDPROF
+void ps_prof(void)
+{
+    puts("#thread,pid,name,runtime_us,switches,wakeups,lat_max_us,lat_avg_us,"
+         "irq_off_us,irq_off_max_us,msgq_max,msgq_size");
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        thread_t *p = (thread_t *)sched_threads[i];
+        const schedstat *stat = &sched_pidlist[i];
+
+        if (p == NULL) {
+            continue;
+        }
+        printf("thread,%" PRIkernel_pid ",%s,%" PRIu64 ",%u,%u,%" PRIu32
+               ",%" PRIu32 ",%" PRIu64 ",%" PRIu32 ",%u,%u\n",
+               p->pid,
+#ifdef DEVELHELP
+               p->name,
+#else
+               "-",
+#endif
+               xtimer_usec_from_ticks64(xtimer_ticks64(stat->runtime_ticks)),
+               stat->schedules, stat->wakeups, _usec(stat->latency_max),
+               _latency_avg(stat),
+               xtimer_usec_from_ticks64(xtimer_ticks64(stat->irq_off_ticks)),
+               _usec(stat->irq_off_max), stat->msg_queue_max,
+               _msg_queue_size(p));
+    }
+    puts("#irq,isr_count,isr_us,isr_max_us,irq_off_us,irq_off_max_us");
+    printf("irq,%u,%" PRIu64 ",%" PRIu32 ",%" PRIu64 ",%" PRIu32 "\n",
+           schedprof_irq.isr_count,
+           xtimer_usec_from_ticks64(xtimer_ticks64(schedprof_irq.isr_ticks)),
+           _usec(schedprof_irq.isr_max),
+           xtimer_usec_from_ticks64(xtimer_ticks64(schedprof_irq.irq_off_ticks)),
+           _usec(schedprof_irq.irq_off_max));
+}
+#endif
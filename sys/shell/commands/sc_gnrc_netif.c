@@ -132,6 +132,12 @@ static int _netif_stats(kernel_pid_t iface, unsigned module, bool reset)
                (unsigned) stats->tx_bytes,
                (unsigned) stats->tx_success,
                (unsigned) stats->tx_failed);
+        if (stats->rx_batches > 0) {
+            printf("            RX batches %u (avg. %u, max. %u packets)\n",
+                   (unsigned) stats->rx_batches,
+                   (unsigned) (stats->rx_count / stats->rx_batches),
+                   (unsigned) stats->rx_batch_max);
+        }
         res = 0;
     }
     return res;
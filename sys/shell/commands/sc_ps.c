@@ -20,6 +20,13 @@
 
 #include "ps.h"
 
+#ifdef MODULE_SCHEDPROF
+#include <stdio.h>
+#include <string.h>
+
+#include "sched.h"
+#endif
+
 int _ps_handler(int argc, char **argv)
 {
     (void) argc;
@@ -29,3 +36,21 @@ int _ps_handler(int argc, char **argv)
 
     return 0;
 }
+
+#ifdef MODULE_SCHEDPROF
+int _schedprof_handler(int argc, char **argv)
+{
+    if ((argc == 2) && (strcmp(argv[1], "reset") == 0)) {
+        schedprof_reset();
+    }
+    else if (argc == 1) {
+        ps_prof();
+    }
+    else {
+        printf("usage: %s [reset]\n", argv[0]);
+        return 1;
+    }
+
+    return 0;
+}
+#endif
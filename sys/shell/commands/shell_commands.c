@@ -35,6 +35,9 @@ extern int _heap_handler(int argc, char **argv);
 
 #ifdef MODULE_PS
 extern int _ps_handler(int argc, char **argv);
+#ifdef MODULE_SCHEDPROF
+extern int _schedprof_handler(int argc, char **argv);
+#endif
 #endif
 
 #ifdef MODULE_SHT11
@@ -148,6 +151,9 @@ const shell_command_t _shell_command_list[] = {
 #endif
 #ifdef MODULE_PS
     {"ps", "Prints information about running threads.", _ps_handler},
+#ifdef MODULE_SCHEDPROF
+    {"schedprof", "Prints or resets profiling statistics as CSV", _schedprof_handler},
+#endif
 #endif
 #ifdef MODULE_SHT11
     {"temp", "Prints measured temperature.", _get_temperature_handler},
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_spscrb
+ * @{
+ *
+ * @file
+ * @brief       Single-producer single-consumer ringbuffer implementation
+ *
+ * The producer owns `writes`, the consumer owns `reads`. Each side loads its
+ * own index relaxed and the other one with acquire semantics, and publishes
+ * its index with release semantics after it accessed the buffer, so neither
+ * side sees the index before the data (or free space) it refers to.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "spscrb.h"
+
+/**
+ * @brief   Split the region of @p len bytes at @p pos into the part up to
+ *          the end of the buffer and the part wrapping around
+ */
+static unsigned _segs(spscrb_t *rb, unsigned pos, unsigned len,
+                      spscrb_seg_t seg[2])
+{
+    unsigned offset = pos & (rb->size - 1);
+    unsigned till_end = rb->size - offset;
+
+    seg[0].data = rb->buf + offset;
+    seg[0].len = (len < till_end) ? len : till_end;
+    seg[1].data = rb->buf;
+    seg[1].len = len - seg[0].len;
+    return len;
+}
+
+unsigned spscrb_read_peek(spscrb_t *rb, spscrb_seg_t seg[2])
+{
+    unsigned reads = atomic_load_explicit(&rb->reads, memory_order_relaxed);
+    unsigned writes = atomic_load_explicit(&rb->writes, memory_order_acquire);
+
+    return _segs(rb, reads, writes - reads, seg);
+}
+
+void spscrb_read_commit(spscrb_t *rb, unsigned n)
+{
+    unsigned reads = atomic_load_explicit(&rb->reads, memory_order_relaxed);
+
+    assert(n <= spscrb_avail(rb));
+    atomic_store_explicit(&rb->reads, reads + n, memory_order_release);
+}
+
+unsigned spscrb_write_peek(spscrb_t *rb, spscrb_seg_t seg[2])
+{
+    unsigned writes = atomic_load_explicit(&rb->writes, memory_order_relaxed);
+    unsigned reads = atomic_load_explicit(&rb->reads, memory_order_acquire);
+
+    return _segs(rb, writes, rb->size - (writes - reads), seg);
+}
+
+void spscrb_write_commit(spscrb_t *rb, unsigned n)
+{
+    unsigned writes = atomic_load_explicit(&rb->writes, memory_order_relaxed);
+
+    assert(n <= spscrb_free(rb));
+    atomic_store_explicit(&rb->writes, writes + n, memory_order_release);
+}
+
+int spscrb_get_one(spscrb_t *rb)
+{
+    unsigned reads = atomic_load_explicit(&rb->reads, memory_order_relaxed);
+    int c;
+
+    if (atomic_load_explicit(&rb->writes, memory_order_acquire) == reads) {
+        return -1;
+    }
+    c = rb->buf[reads & (rb->size - 1)];
+    atomic_store_explicit(&rb->reads, reads + 1, memory_order_release);
+    return c;
+}
+
+unsigned spscrb_get(spscrb_t *rb, void *dst, unsigned n)
+{
+    spscrb_seg_t seg[2];
+    unsigned avail = spscrb_read_peek(rb, seg);
+
+    if (n > avail) {
+        n = avail;
+    }
+    if (n <= seg[0].len) {
+        memcpy(dst, seg[0].data, n);
+    }
+    else {
+        memcpy(dst, seg[0].data, seg[0].len);
+        memcpy((uint8_t *)dst + seg[0].len, seg[1].data, n - seg[0].len);
+    }
+    spscrb_read_commit(rb, n);
+    return n;
+}
+
+int spscrb_add_one(spscrb_t *rb, uint8_t c)
+{
+    unsigned writes = atomic_load_explicit(&rb->writes, memory_order_relaxed);
+
+    if ((writes - atomic_load_explicit(&rb->reads, memory_order_acquire)) ==
+        rb->size) {
+        return -1;
+    }
+    rb->buf[writes & (rb->size - 1)] = c;
+    atomic_store_explicit(&rb->writes, writes + 1, memory_order_release);
+    return 0;
+}
+
+unsigned spscrb_add(spscrb_t *rb, const void *src, unsigned n)
+{
+    spscrb_seg_t seg[2];
+    unsigned space = spscrb_write_peek(rb, seg);
+
+    if (n > space) {
+        n = space;
+    }
+    if (n <= seg[0].len) {
+        memcpy(seg[0].data, src, n);
+    }
+    else {
+        memcpy(seg[0].data, src, seg[0].len);
+        memcpy(seg[1].data, (const uint8_t *)src + seg[0].len, n - seg[0].len);
+    }
+    spscrb_write_commit(rb, n);
+    return n;
+}
@@ -161,6 +161,15 @@ void _xtimer_set_msg64(xtimer_t *timer, uint64_t offset, msg_t *msg, kernel_pid_
     _xtimer_set64(timer, offset, offset >> 32);
 }
 
+#ifdef MODULE_XTIMER_SLACK
+void _xtimer_set_msg_slack(xtimer_t *timer, uint32_t offset, uint32_t slack,
+                           msg_t *msg, kernel_pid_t target_pid)
+{
+    _setup_msg(timer, msg, target_pid);
+    _xtimer_set_slack(timer, offset, slack);
+}
+#endif
+
 static void _callback_wakeup(void* arg)
 {
     thread_wakeup((kernel_pid_t)((intptr_t)arg));
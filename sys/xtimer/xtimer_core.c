@@ -41,11 +41,18 @@ static xtimer_t *timer_list_head = NULL;
 static xtimer_t *overflow_list_head = NULL;
 static xtimer_t *long_list_head = NULL;
 
+#ifdef MODULE_XTIMER_SLACK
+static xtimer_slack_stats_t _slack_stats;
+#endif
+
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer);
 static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer);
 static void _shoot(xtimer_t *timer);
 static void _remove(xtimer_t *timer);
 static inline void _lltimer_set(uint32_t target);
+static uint32_t _next_target(void);
+static void _set(xtimer_t *timer, uint32_t offset);
+static int _set_absolute(xtimer_t *timer, uint32_t target);
 static uint32_t _time_left(uint32_t target, uint32_t reference);
 
 static void _timer_callback(void);
@@ -58,6 +65,25 @@ static inline int _is_set(xtimer_t *timer)
     return (timer->target || timer->long_target);
 }
 
+static inline uint32_t _slack(xtimer_t *timer)
+{
+#ifdef MODULE_XTIMER_SLACK
+    return timer->slack;
+#else
+    (void)timer;
+    return 0;
+#endif
+}
+
+static inline void _clear_slack(xtimer_t *timer)
+{
+#ifdef MODULE_XTIMER_SLACK
+    timer->slack = 0;
+#else
+    (void)timer;
+#endif
+}
+
 static inline void xtimer_spin_until(uint32_t target) {
 #if XTIMER_MASK
     target = _xtimer_lltimer_mask(target);
@@ -111,6 +137,7 @@ void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
         if (_is_set(timer)) {
             _remove(timer);
         }
+        _clear_slack(timer);
 
         _xtimer_now_internal(&timer->target, &timer->long_target);
         timer->target += offset;
@@ -127,6 +154,27 @@ void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
 }
 
 void _xtimer_set(xtimer_t *timer, uint32_t offset)
+{
+    _clear_slack(timer);
+    _set(timer, offset);
+}
+
+#ifdef MODULE_XTIMER_SLACK
+void _xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack)
+{
+    timer->slack = slack;
+    _set(timer, offset);
+}
+
+void xtimer_slack_stats(xtimer_slack_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    *stats = _slack_stats;
+    irq_restore(state);
+}
+#endif
+
+static void _set(xtimer_t *timer, uint32_t offset)
 {
     DEBUG("timer_set(): offset=%" PRIu32 " now=%" PRIu32 " (%" PRIu32 ")\n",
           offset, xtimer_now().ticks32, _xtimer_lltimer_now());
@@ -143,7 +191,7 @@ void _xtimer_set(xtimer_t *timer, uint32_t offset)
     }
     else {
         uint32_t target = _xtimer_now() + offset;
-        _xtimer_set_absolute(timer, target);
+        _set_absolute(timer, target);
     }
 }
 
@@ -169,6 +217,12 @@ static inline void _lltimer_set(uint32_t target)
 }
 
 int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+{
+    _clear_slack(timer);
+    return _set_absolute(timer, target);
+}
+
+static int _set_absolute(xtimer_t *timer, uint32_t target)
 {
     uint32_t now = _xtimer_now();
     int res = 0;
@@ -207,9 +261,13 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
             DEBUG("timer_set_absolute(): timer will expire in this timer period.\n");
             _add_timer_to_list(&timer_list_head, timer);
 
-            if (timer_list_head == timer) {
-                DEBUG("timer_set_absolute(): timer is new list head. updating lltimer.\n");
-                _lltimer_set(target - XTIMER_OVERHEAD);
+            /* with slack, a timer that is not the new list head may still
+             * have to fire before the timers in front of it run out of
+             * slack */
+            uint32_t next = _next_target();
+            if ((timer_list_head == timer) || (target <= next)) {
+                DEBUG("timer_set_absolute(): timer changes next target. updating lltimer.\n");
+                _lltimer_set(next - XTIMER_OVERHEAD);
             }
         }
     }
@@ -261,7 +319,7 @@ static void _remove(xtimer_t *timer)
         timer_list_head = timer->next;
         if (timer_list_head) {
             /* schedule callback on next timer target time */
-            next = timer_list_head->target - XTIMER_OVERHEAD;
+            next = _next_target() - XTIMER_OVERHEAD;
         }
         else {
             next = _xtimer_lltimer_mask(0xFFFFFFFF);
@@ -302,6 +360,35 @@ static uint32_t _time_left(uint32_t target, uint32_t reference)
     }
 }
 
+/**
+ * @brief get the time at which the next timers of the current period need
+ *        to be fired
+ *
+ * This is the earliest target plus slack among the timers that already
+ * expired by then, so all of these timers fire in a single interrupt.
+ * Without slack, this is the target of the list head.
+ */
+static uint32_t _next_target(void)
+{
+    uint32_t next = 0;
+
+    for (xtimer_t *timer = timer_list_head;
+         timer && ((timer == timer_list_head) || (timer->target <= next));
+         timer = timer->next) {
+        /* the timer needs to fire before the end of the current period */
+        uint32_t latest = timer->target | _xtimer_lltimer_mask(0xFFFFFFFF);
+        uint32_t slack = _slack(timer);
+
+        if (slack > (latest - timer->target)) {
+            slack = latest - timer->target;
+        }
+        if ((timer == timer_list_head) || ((timer->target + slack) < next)) {
+            next = timer->target + slack;
+        }
+    }
+    return next;
+}
+
 static inline int _this_high_period(uint32_t target) {
 #if XTIMER_MASK
     return (target & XTIMER_MASK) == _xtimer_high_cnt;
@@ -432,6 +519,7 @@ static void _timer_callback(void)
 {
     uint32_t next_target;
     uint32_t reference;
+    unsigned fired = 0;
 
     _in_handler = 1;
 
@@ -480,6 +568,7 @@ overflow:
 
         /* fire timer */
         _shoot(timer);
+        fired++;
     }
 
     /* possibly executing all callbacks took enough
@@ -496,7 +585,7 @@ overflow:
 
     if (timer_list_head) {
         /* schedule callback on next timer target time */
-        next_target = timer_list_head->target - XTIMER_OVERHEAD;
+        next_target = _next_target() - XTIMER_OVERHEAD;
 
         /* make sure we're not setting a time in the past */
         if (next_target < (_xtimer_lltimer_now() + XTIMER_ISR_BACKOFF)) {
@@ -527,6 +616,15 @@ overflow:
         }
     }
 
+#ifdef MODULE_XTIMER_SLACK
+    if (fired) {
+        _slack_stats.wakeups++;
+        _slack_stats.saved += fired - 1;
+    }
+#else
+    (void)fired;
+#endif
+
     _in_handler = 0;
 
     /* set low level timer */
@@ -0,0 +1,599 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ * @ingroup xtimer
+ * @{
+ * @file
+ * @brief xtimer core functionality based on a hierarchical timing wheel
+ *
+ * Drop-in replacement for xtimer_core.c, selected with the `xtimer_wheel`
+ * module.
+ *
+ * Only timers due within the current lowest-level slot are kept in a sorted
+ * list, from which they fire with full precision. All other timers are
+ * hashed by their 64-bit target into a slot of the wheel, see
+ * @ref XTIMER_WHEEL_SHIFT. A timer is put on the lowest level on which its
+ * target and the current wheel time lie in the same slot of the next higher
+ * level. Per level, a bitmap marks the non-empty slots, so setting and
+ * removing a timer is O(1) and finding the next slot that needs attention
+ * is O(XTIMER_WHEEL_LEVELS). When the wheel time reaches a non-empty slot,
+ * its timers are moved down one or more levels, so every timer is moved at
+ * most XTIMER_WHEEL_LEVELS times before it fires.
+ * @}
+ */
+
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+#include "board.h"
+#include "periph/timer.h"
+#include "periph_conf.h"
+
+#include "bitarithm.h"
+#include "xtimer.h"
+#include "irq.h"
+
+/* WARNING! enabling this will have side effects and can lead to timer underflows. */
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#if (XTIMER_WHEEL_BITS > 5)
+#error "XTIMER_WHEEL_BITS must not exceed 5"
+#endif
+#if ((XTIMER_WHEEL_SHIFT + XTIMER_WHEEL_LEVELS * XTIMER_WHEEL_BITS) > 63)
+#error "xtimer_wheel: wheel exceeds 64-bit time range"
+#endif
+
+#define SLOTS_NUMOF     (1U << XTIMER_WHEEL_BITS)
+#define SLOT_MASK       (SLOTS_NUMOF - 1)
+#define SLOT_TICKS      (1ULL << XTIMER_WHEEL_SHIFT)
+
+/* lowest bit of the slot index of level l in a target */
+#define LEVEL_SHIFT(l)  (XTIMER_WHEEL_SHIFT + ((l) * XTIMER_WHEEL_BITS))
+/* lowest bit above the slot index of level l in a target */
+#define BLOCK_SHIFT(l)  (LEVEL_SHIFT(l) + XTIMER_WHEEL_BITS)
+
+/* pseudo levels for timers outside the wheel */
+#define LEVEL_FAR       (XTIMER_WHEEL_LEVELS)
+#define LEVEL_NEAR      (XTIMER_WHEEL_LEVELS + 1)
+
+#define NO_DEADLINE     (UINT64_MAX)
+
+static volatile int _in_handler = 0;
+
+static volatile uint32_t _long_cnt = 0;
+#if XTIMER_MASK
+volatile uint32_t _xtimer_high_cnt = 0;
+#endif
+
+/* timers due before the end of the current lowest-level slot, sorted */
+static xtimer_t *_near_list_head = NULL;
+/* timers beyond the range of the highest level, unsorted */
+static xtimer_t *_far_list_head = NULL;
+static xtimer_t *_slots[XTIMER_WHEEL_LEVELS][SLOTS_NUMOF];
+static uint32_t _slots_used[XTIMER_WHEEL_LEVELS];
+/* start of the current lowest-level slot */
+static uint64_t _wheel_time = 0;
+
+/* deadline the low-level timer is currently set to */
+static uint64_t _armed = NO_DEADLINE;
+static int _armed_period_end = 0;
+/* low-level timer value last seen by the handler */
+static uint32_t _ll_ref = 0;
+
+#ifdef MODULE_XTIMER_SLACK
+static xtimer_slack_stats_t _slack_stats;
+#endif
+
+static void _set_offset(xtimer_t *timer, uint32_t offset);
+static int _set_absolute(xtimer_t *timer, uint32_t target);
+static void _timer_callback(void);
+static void _periph_timer_callback(void *arg, int chan);
+
+static inline int _is_set(xtimer_t *timer)
+{
+    return (timer->target || timer->long_target);
+}
+
+static inline void _clear_slack(xtimer_t *timer)
+{
+#ifdef MODULE_XTIMER_SLACK
+    timer->slack = 0;
+#else
+    (void)timer;
+#endif
+}
+
+static inline uint64_t _target64(const xtimer_t *timer)
+{
+    return ((uint64_t)timer->long_target << 32) | timer->target;
+}
+
+static inline unsigned _lsb(uint32_t v)
+{
+#if (UINT_MAX < UINT32_MAX)
+    if ((v & 0xffff) == 0) {
+        return 16 + bitarithm_lsb((unsigned)(v >> 16));
+    }
+    return bitarithm_lsb((unsigned)(v & 0xffff));
+#else
+    return bitarithm_lsb(v);
+#endif
+}
+
+static inline void xtimer_spin_until(uint32_t target) {
+#if XTIMER_MASK
+    target = _xtimer_lltimer_mask(target);
+#endif
+    while (_xtimer_lltimer_now() > target);
+    while (_xtimer_lltimer_now() < target);
+}
+
+/**
+ * @brief   find the list a timer with the given target belongs to
+ */
+static xtimer_t **_list(uint64_t target, unsigned *level, unsigned *slot)
+{
+    if (target < (_wheel_time + SLOT_TICKS)) {
+        *level = LEVEL_NEAR;
+        return &_near_list_head;
+    }
+    for (unsigned l = 0; l < XTIMER_WHEEL_LEVELS; l++) {
+        if ((target >> BLOCK_SHIFT(l)) == (_wheel_time >> BLOCK_SHIFT(l))) {
+            *level = l;
+            *slot = (target >> LEVEL_SHIFT(l)) & SLOT_MASK;
+            return &_slots[l][*slot];
+        }
+    }
+    *level = LEVEL_FAR;
+    return &_far_list_head;
+}
+
+static void _insert(xtimer_t *timer)
+{
+    uint64_t target = _target64(timer);
+    unsigned level, slot = 0;
+    xtimer_t **list_head = _list(target, &level, &slot);
+
+    timer->prev = NULL;
+    if (level == LEVEL_NEAR) {
+        while (*list_head && (_target64(*list_head) <= target)) {
+            timer->prev = *list_head;
+            list_head = &((*list_head)->next);
+        }
+    }
+    else if (level != LEVEL_FAR) {
+        _slots_used[level] |= ((uint32_t)1 << slot);
+    }
+    timer->next = *list_head;
+    if (timer->next) {
+        timer->next->prev = timer;
+    }
+    *list_head = timer;
+}
+
+static void _remove(xtimer_t *timer)
+{
+    if (timer->prev) {
+        timer->prev->next = timer->next;
+    }
+    else {
+        unsigned level, slot = 0;
+        xtimer_t **list_head = _list(_target64(timer), &level, &slot);
+
+        *list_head = timer->next;
+        if (!timer->next && (level < LEVEL_FAR)) {
+            _slots_used[level] &= ~((uint32_t)1 << slot);
+        }
+    }
+    if (timer->next) {
+        timer->next->prev = timer->prev;
+    }
+    /* make sure timer is recognized as not being set */
+    timer->target = 0;
+    timer->long_target = 0;
+}
+
+/**
+ * @brief   get the time at which the wheel needs to be advanced next
+ *
+ * All non-empty slots of a level lie after the slot of the wheel time, and
+ * all slots of a level lie before the next slot of the level above, so the
+ * next non-empty slot of the lowest non-empty level is due first.
+ */
+static uint64_t _next_slot(unsigned *level)
+{
+    for (unsigned l = 0; l < XTIMER_WHEEL_LEVELS; l++) {
+        if (_slots_used[l]) {
+            uint64_t block = _wheel_time & ~((1ULL << BLOCK_SHIFT(l)) - 1);
+
+            *level = l;
+            return block | ((uint64_t)_lsb(_slots_used[l]) << LEVEL_SHIFT(l));
+        }
+    }
+    if (_far_list_head) {
+        *level = LEVEL_FAR;
+        return (_wheel_time | ((1ULL << BLOCK_SHIFT(LEVEL_FAR - 1)) - 1)) + 1;
+    }
+    return NO_DEADLINE;
+}
+
+/**
+ * @brief   advance the wheel to @p now, moving the timers of all slots that
+ *          were reached down the wheel
+ */
+static void _advance(uint64_t now)
+{
+    uint64_t next;
+    unsigned level = 0;
+
+    while ((next = _next_slot(&level)) <= now) {
+        xtimer_t *timer;
+
+        _wheel_time = next;
+        if (level == LEVEL_FAR) {
+            timer = _far_list_head;
+            _far_list_head = NULL;
+        }
+        else {
+            unsigned slot = (next >> LEVEL_SHIFT(level)) & SLOT_MASK;
+
+            timer = _slots[level][slot];
+            _slots[level][slot] = NULL;
+            _slots_used[level] &= ~((uint32_t)1 << slot);
+        }
+        while (timer) {
+            xtimer_t *next_timer = timer->next;
+
+            _insert(timer);
+            timer = next_timer;
+        }
+    }
+    /* no non-empty slot was skipped, so the wheel can jump ahead */
+    now &= ~(SLOT_TICKS - 1);
+    if (now > _wheel_time) {
+        _wheel_time = now;
+    }
+}
+
+static uint64_t _deadline(void)
+{
+    unsigned level;
+    uint64_t deadline = _next_slot(&level);
+
+    if (_near_list_head) {
+        uint64_t target = _target64(_near_list_head);
+#ifdef MODULE_XTIMER_SLACK
+        /* fire all timers that expired before the first one of them runs
+         * out of slack in one interrupt */
+        uint64_t next = target + _near_list_head->slack;
+
+        for (xtimer_t *timer = _near_list_head->next;
+             timer && (_target64(timer) <= next); timer = timer->next) {
+            if ((_target64(timer) + timer->slack) < next) {
+                next = _target64(timer) + timer->slack;
+            }
+        }
+        target = next;
+#endif
+        target -= XTIMER_OVERHEAD;
+        if (target < deadline) {
+            deadline = target;
+        }
+    }
+    return deadline;
+}
+
+/**
+ * @brief   set the low-level timer to @p deadline, or to the end of the
+ *          current low-level timer period if that is earlier
+ */
+static void _lltimer_set(uint64_t deadline, uint64_t now)
+{
+    uint32_t period_mask = _xtimer_lltimer_mask(0xFFFFFFFF);
+    uint64_t period_end = (now & ~((uint64_t)period_mask)) | period_mask;
+
+    /* the handler needs to run once per period to keep track of time, and
+     * must not be due so close to the end that it misses the overflow */
+    _armed_period_end = (deadline >= (period_end - XTIMER_ISR_BACKOFF));
+    if (_armed_period_end) {
+        deadline = period_end;
+    }
+    _armed = deadline;
+    DEBUG("_lltimer_set(): setting %" PRIu32 "\n",
+          _xtimer_lltimer_mask((uint32_t)deadline));
+    timer_set_absolute(XTIMER_DEV, XTIMER_CHAN,
+                       _xtimer_lltimer_mask((uint32_t)deadline));
+}
+
+void xtimer_init(void)
+{
+    /* initialize low-level timer */
+    timer_init(XTIMER_DEV, XTIMER_HZ, _periph_timer_callback, NULL);
+
+    /* register initial overflow tick */
+    _lltimer_set(NO_DEADLINE, 0);
+}
+
+static void _xtimer_now_internal(uint32_t *short_term, uint32_t *long_term)
+{
+    uint32_t before, after, long_value;
+
+    /* loop to cope with possible overflow of _xtimer_now() */
+    do {
+        before = _xtimer_now();
+        long_value = _long_cnt;
+        after = _xtimer_now();
+
+    } while(before > after);
+
+    *short_term = after;
+    *long_term = long_value;
+}
+
+uint64_t _xtimer_now64(void)
+{
+    uint32_t short_term, long_term;
+    _xtimer_now_internal(&short_term, &long_term);
+
+    return ((uint64_t)long_term<<32) + short_term;
+}
+
+/**
+ * @brief   (re-)schedule @p timer at the absolute time @p target
+ *
+ * Must be called with interrupts disabled.
+ */
+static void _set(xtimer_t *timer, uint64_t target)
+{
+    uint64_t now = 0;
+
+    if (_is_set(timer)) {
+        _remove(timer);
+    }
+    timer->target = (uint32_t)target;
+    timer->long_target = (uint32_t)(target >> 32);
+
+    if (!_in_handler) {
+        /* the handler advances the wheel before it returns */
+        now = _xtimer_now64();
+        _advance(now);
+    }
+    _insert(timer);
+    if (!_in_handler) {
+        uint64_t deadline = _deadline();
+
+        if (deadline < _armed) {
+            /* a slot that needs to be advanced, or a timer's target minus
+             * the overhead, may be too close to set the low-level timer to */
+            if (deadline < (now + XTIMER_ISR_BACKOFF)) {
+                deadline = now + XTIMER_ISR_BACKOFF;
+            }
+            if (deadline < _armed) {
+                _lltimer_set(deadline, now);
+            }
+        }
+    }
+}
+
+void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
+{
+    DEBUG(" _xtimer_set64() offset=%" PRIu32 " long_offset=%" PRIu32 "\n", offset, long_offset);
+    if (!long_offset) {
+        /* timer fits into the short timer */
+        _xtimer_set(timer, (uint32_t) offset);
+    }
+    else {
+        int state = irq_disable();
+
+        _clear_slack(timer);
+        _set(timer, _xtimer_now64() + (((uint64_t)long_offset << 32) | offset));
+        irq_restore(state);
+        DEBUG("xtimer_set64(): added longterm timer (long_target=%" PRIu32 " target=%" PRIu32 ")\n",
+                timer->long_target, timer->target);
+    }
+}
+
+void _xtimer_set(xtimer_t *timer, uint32_t offset)
+{
+    _clear_slack(timer);
+    _set_offset(timer, offset);
+}
+
+#ifdef MODULE_XTIMER_SLACK
+void _xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack)
+{
+    timer->slack = slack;
+    _set_offset(timer, offset);
+}
+
+void xtimer_slack_stats(xtimer_slack_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    *stats = _slack_stats;
+    irq_restore(state);
+}
+#endif
+
+static void _set_offset(xtimer_t *timer, uint32_t offset)
+{
+    DEBUG("timer_set(): offset=%" PRIu32 " now=%" PRIu32 " (%" PRIu32 ")\n",
+          offset, xtimer_now().ticks32, _xtimer_lltimer_now());
+    if (!timer->callback) {
+        DEBUG("timer_set(): timer has no callback.\n");
+        return;
+    }
+
+    xtimer_remove(timer);
+
+    if (offset < XTIMER_BACKOFF) {
+        _xtimer_spin(offset);
+        timer->callback(timer->arg);
+    }
+    else {
+        uint32_t target = _xtimer_now() + offset;
+        _set_absolute(timer, target);
+    }
+}
+
+static void _periph_timer_callback(void *arg, int chan)
+{
+    (void)arg;
+    (void)chan;
+    _timer_callback();
+}
+
+int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+{
+    _clear_slack(timer);
+    return _set_absolute(timer, target);
+}
+
+static int _set_absolute(xtimer_t *timer, uint32_t target)
+{
+    uint32_t now = _xtimer_now();
+    uint32_t long_target;
+
+    DEBUG("timer_set_absolute(): now=%" PRIu32 " target=%" PRIu32 "\n", now, target);
+
+    if ((target >= now) && ((target - XTIMER_BACKOFF) < now)) {
+        /* backoff */
+        xtimer_spin_until(target + XTIMER_BACKOFF);
+        timer->callback(timer->arg);
+        return 0;
+    }
+
+    unsigned state = irq_disable();
+
+    long_target = _long_cnt;
+    if (target < now) {
+        long_target++;
+    }
+    _set(timer, ((uint64_t)long_target << 32) | target);
+    irq_restore(state);
+
+    return 0;
+}
+
+void xtimer_remove(xtimer_t *timer)
+{
+    int state = irq_disable();
+    if (_is_set(timer)) {
+        _remove(timer);
+    }
+    irq_restore(state);
+}
+
+/**
+ * @brief handle low-level timer overflow, advance to next short timer period
+ */
+static void _next_period(void)
+{
+#if XTIMER_MASK
+    /* advance <32bit mask register */
+    _xtimer_high_cnt += ~XTIMER_MASK + 1;
+    if (_xtimer_high_cnt == 0) {
+        /* high_cnt overflowed, so advance >32bit counter */
+        _long_cnt++;
+    }
+#else
+    /* advance >32bit counter */
+    _long_cnt++;
+#endif
+}
+
+/**
+ * @brief   get the current time from within the handler, taking care of
+ *          low-level timer overflows that happen while handling timers
+ */
+static uint64_t _handler_now(void)
+{
+    uint32_t now = _xtimer_lltimer_now();
+
+    if (now < _ll_ref) {
+        DEBUG("_timer_callback: overflowed while executing callbacks.\n");
+        _next_period();
+    }
+    _ll_ref = now;
+#if XTIMER_MASK
+    now |= _xtimer_high_cnt;
+#endif
+    return ((uint64_t)_long_cnt << 32) | now;
+}
+
+/**
+ * @brief main xtimer callback function
+ */
+static void _timer_callback(void)
+{
+    uint64_t now, deadline;
+    unsigned fired = 0;
+
+    _in_handler = 1;
+
+    if (_armed_period_end) {
+        DEBUG("_timer_callback(): tick\n");
+        /* make sure the timer counter also arrived
+         * in the next timer period */
+        while (_xtimer_lltimer_now() == _xtimer_lltimer_mask(0xFFFFFFFF)) {}
+        _next_period();
+        _ll_ref = 0;
+        _armed_period_end = 0;
+    }
+
+    while (1) {
+        now = _handler_now();
+        _advance(now + XTIMER_ISR_BACKOFF);
+
+        /* check if next timer is close to expiring */
+        if (_near_list_head &&
+            (_target64(_near_list_head) <= (now + XTIMER_ISR_BACKOFF))) {
+            xtimer_t *timer = _near_list_head;
+            uint64_t target = _target64(timer);
+
+            /* make sure we don't fire too early */
+            if (target > now) {
+                _xtimer_spin((uint32_t)(target - now));
+                /* catch an overflow while spinning before the callback
+                 * reads the time */
+                _handler_now();
+            }
+            _remove(timer);
+            timer->callback(timer->arg);
+            fired++;
+            continue;
+        }
+
+        /* make sure we're not setting a time in the past */
+        deadline = _deadline();
+        if (deadline < (now + XTIMER_ISR_BACKOFF)) {
+            continue;
+        }
+
+        /* check if the end of this period is very soon */
+        if ((now | _xtimer_lltimer_mask(0xFFFFFFFF)) < (now + XTIMER_ISR_BACKOFF)) {
+            /* spin until next period, _handler_now() then advances */
+            while (_xtimer_lltimer_now() >= _ll_ref) {}
+            continue;
+        }
+        break;
+    }
+
+#ifdef MODULE_XTIMER_SLACK
+    if (fired) {
+        _slack_stats.wakeups++;
+        _slack_stats.saved += fired - 1;
+    }
+#else
+    (void)fired;
+#endif
+
+    _in_handler = 0;
+
+    /* set low level timer */
+    _lltimer_set(deadline, now);
+}
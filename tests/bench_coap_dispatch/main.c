@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the cost of finding the resource for a CoAP request
+ *              over the number of resources
+ *
+ * Compares coap_find_resource() with the linear search previously used by
+ * nanocoap and gcoap. The lookups are spread over all existing paths, with a
+ * method only allowed by the second of two resources for each path.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "net/nanocoap.h"
+#include "xtimer.h"
+
+#define RESOURCES_MAX       (256U)
+#define LOOKUPS_NUMOF       (1024U)
+#define PATH_LEN            (16U)
+
+static const unsigned _resources_numof[] = { 8, 32, 128, 256 };
+
+/* nanocoap requires the application to provide these */
+const coap_resource_t coap_resources[] = {
+    COAP_WELL_KNOWN_CORE_DEFAULT_HANDLER,
+};
+const unsigned coap_resources_numof = sizeof(coap_resources) / sizeof(coap_resources[0]);
+
+static char _paths[RESOURCES_MAX / 2][PATH_LEN];
+static coap_resource_t _resources[RESOURCES_MAX];
+static const char *_lookups[LOOKUPS_NUMOF];
+
+/* LwM2M-like paths, in strcmp() order */
+static void _init_resources(unsigned numof)
+{
+    for (unsigned i = 0; i < numof / 2; i++) {
+        snprintf(_paths[i], PATH_LEN, "/3/%u/%u", i / 100, i % 100);
+    }
+    /* numbers with one, two and three digits don't sort numerically */
+    for (unsigned i = 1; i < numof / 2; i++) {
+        for (unsigned j = i; (j > 0) && (strcmp(_paths[j - 1], _paths[j]) > 0); j--) {
+            char tmp[PATH_LEN];
+
+            memcpy(tmp, _paths[j], PATH_LEN);
+            memcpy(_paths[j], _paths[j - 1], PATH_LEN);
+            memcpy(_paths[j - 1], tmp, PATH_LEN);
+        }
+    }
+    for (unsigned i = 0; i < numof / 2; i++) {
+        _resources[2 * i].path = _paths[i];
+        _resources[2 * i].methods = COAP_GET;
+        _resources[2 * i + 1].path = _paths[i];
+        _resources[2 * i + 1].methods = COAP_POST | COAP_PUT;
+    }
+    for (unsigned i = 0; i < LOOKUPS_NUMOF; i++) {
+        _lookups[i] = _paths[(i * 7919U) % (numof / 2)];
+    }
+}
+
+/* the search nanocoap and gcoap used before coap_find_resource() */
+static const coap_resource_t *_find_linear(const coap_resource_t *resources,
+                                           size_t numof, const char *path,
+                                           unsigned method_flag)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        const coap_resource_t *resource = &resources[i];
+        if (!(resource->methods & method_flag)) {
+            continue;
+        }
+
+        int res = strcmp(path, resource->path);
+        if (res > 0) {
+            continue;
+        }
+        else if (res < 0) {
+            break;
+        }
+        else {
+            return resource;
+        }
+    }
+    return NULL;
+}
+
+static uint32_t _measure(const coap_resource_t *(*find)(const coap_resource_t *,
+                                                         size_t, const char *,
+                                                         unsigned),
+                         unsigned numof, unsigned *found)
+{
+    uint32_t start = xtimer_now_usec();
+
+    *found = 0;
+    for (unsigned i = 0; i < LOOKUPS_NUMOF; i++) {
+        if (find(_resources, numof, _lookups[i], COAP_PUT) != NULL) {
+            (*found)++;
+        }
+    }
+    return ((uint64_t)(xtimer_now_usec() - start) * 1000) / LOOKUPS_NUMOF;
+}
+
+int main(void)
+{
+    puts("Start.");
+    for (unsigned i = 0; i < sizeof(_resources_numof) / sizeof(_resources_numof[0]); i++) {
+        unsigned numof = _resources_numof[i];
+        unsigned linear_found, indexed_found;
+        uint32_t linear, indexed;
+
+        _init_resources(numof);
+        linear = _measure(_find_linear, numof, &linear_found);
+        indexed = _measure(coap_find_resource, numof, &indexed_found);
+        if ((linear_found != LOOKUPS_NUMOF) || (indexed_found != LOOKUPS_NUMOF)) {
+            printf("error: %u/%u resources found\n", indexed_found, linear_found);
+            return 1;
+        }
+        printf("+ %3u resources: linear %6" PRIu32 " ns, indexed %6" PRIu32 " ns\n",
+               numof, linear, indexed);
+    }
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the cost of sending Observe notifications with gcoap
+ *              over the number of observers
+ *
+ * Registers up to OBSERVERS_MAX observations of a resource via the loopback
+ * interface, with a different token each, and measures the time to send a
+ * notification to all of them. Finally notifies a burst of changes with
+ * gcoap_obs_notify(), which are coalesced within GCOAP_OBS_MIN_INTERVAL.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "xtimer.h"
+
+#define OBSERVERS_MAX       (64U)
+#define ROUNDS              (16U)
+#define CHANGES_NUMOF       (10U)
+#define CLIENT_PORT         (GCOAP_PORT + 1)
+#define RECV_TIMEOUT        (50U * US_PER_MS)
+
+static const unsigned _observers_numof[] = { 1, 8, 64 };
+
+static ssize_t _value_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              void *ctx);
+
+static const coap_resource_t _resources[] = {
+    { "/value", COAP_GET, _value_handler, NULL },
+};
+
+static gcoap_listener_t _listener = {
+    (coap_resource_t *)&_resources[0],
+    sizeof(_resources) / sizeof(_resources[0]),
+    NULL,
+    0
+};
+
+static sock_udp_t _client;
+static sock_udp_ep_t _server = { .family = AF_INET6, .port = GCOAP_PORT };
+static uint8_t _buf[GCOAP_PDU_BUF_SIZE];
+static uint32_t _value;
+
+static ssize_t _value_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              void *ctx)
+{
+    (void)ctx;
+
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    memcpy(pdu->payload, &_value, sizeof(_value));
+    return gcoap_finish(pdu, sizeof(_value), COAP_FORMAT_OCTET);
+}
+
+static int _register(uint16_t token)
+{
+    uint8_t *pos = _buf;
+    coap_pkt_t pkt;
+    ssize_t res;
+
+    pos += coap_build_hdr((coap_hdr_t *)pos, COAP_TYPE_NON, (uint8_t *)&token,
+                          sizeof(token), COAP_METHOD_GET, token);
+    pos += coap_put_option(pos, 0, COAP_OPT_OBSERVE, NULL, 0);
+    pos += coap_put_option_uri(pos, COAP_OPT_OBSERVE, "/value",
+                               COAP_OPT_URI_PATH);
+    if (sock_udp_send(&_client, _buf, pos - _buf, &_server) < 0) {
+        return -1;
+    }
+    res = sock_udp_recv(&_client, _buf, sizeof(_buf), RECV_TIMEOUT, NULL);
+    if ((res <= 0) || (coap_parse(&pkt, _buf, res) < 0) ||
+        (coap_get_code_raw(&pkt) != COAP_CODE_CONTENT) ||
+        !coap_has_observe(&pkt)) {
+        return -1;
+    }
+    return 0;
+}
+
+static unsigned _recv_notifications(void)
+{
+    unsigned received = 0;
+
+    while (sock_udp_recv(&_client, _buf, sizeof(_buf), RECV_TIMEOUT,
+                         NULL) > 0) {
+        received++;
+    }
+    return received;
+}
+
+static void _measure(unsigned observers)
+{
+    uint32_t start, duration = 0;
+    unsigned received = 0;
+    coap_pkt_t pdu;
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        _value++;
+        start = xtimer_now_usec();
+        if (gcoap_obs_init(&pdu, _buf, sizeof(_buf),
+                           &_resources[0]) == GCOAP_OBS_INIT_OK) {
+            memcpy(pdu.payload, &_value, sizeof(_value));
+            size_t len = gcoap_finish(&pdu, sizeof(_value), COAP_FORMAT_OCTET);
+            gcoap_obs_send(_buf, len, &_resources[0]);
+        }
+        duration += xtimer_now_usec() - start;
+        received += _recv_notifications();
+    }
+    printf("+ %2u observers: %" PRIu32 " us per notification, %u/%u received\n",
+           observers, duration / (ROUNDS * observers), received,
+           ROUNDS * observers);
+}
+
+int main(void)
+{
+    sock_udp_ep_t local = { .family = AF_INET6, .port = CLIENT_PORT };
+    unsigned observers = 0;
+
+    puts("Start.");
+    ipv6_addr_set_loopback((ipv6_addr_t *)&_server.addr.ipv6);
+    gcoap_register_listener(&_listener);
+    if (sock_udp_create(&_client, &local, NULL, 0) < 0) {
+        puts("error: can't create client sock");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < sizeof(_observers_numof) / sizeof(_observers_numof[0]); i++) {
+        while (observers < _observers_numof[i]) {
+            if (_register(observers) < 0) {
+                printf("error: can't register observer %u\n", observers);
+                return 1;
+            }
+            observers++;
+        }
+        _measure(observers);
+    }
+
+    for (unsigned i = 0; i < CHANGES_NUMOF; i++) {
+        _value++;
+        gcoap_obs_notify(&_resources[0]);
+    }
+    xtimer_usleep(GCOAP_OBS_MIN_INTERVAL);
+    printf("+ %u changes: %u notifications per observer\n", CHANGES_NUMOF,
+           _recv_notifications() / observers);
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect_exact("Start.")
+    for observers in (1, 8, 64):
+        child.expect(r'\+ %2d observers: \d+ us per notification, \d+/%d received'
+                     % (observers, observers * 16))
+    # the first change is notified immediately, the others coalesced
+    child.expect_exact("+ 10 changes: 2 notifications per observer")
+    child.expect_exact("Done.")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc, timeout=120))
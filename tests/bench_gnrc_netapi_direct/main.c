@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the throughput of GNRC with layer threads and with
+ *              direct calls between the layers
+ *
+ * Sends bursts of UDP datagrams over a @ref netdev_test device that reflects
+ * every IPv6 frame back to the interface, so each datagram passes all layers
+ * down and up again. The datagrams are measured once with packets passed to
+ * the layer threads and once with @ref net_gnrc_netapi_direct.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "byteorder.h"
+#include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/gnrc/ipv6/nib/nc.h"
+#include "net/gnrc/netapi/direct.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/ipv6/addr.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/sock/udp.h"
+#include "xtimer.h"
+
+#define ROUNDS              (256U)
+#define PAYLOAD_LEN         (64U)
+#define SERVER_PORT         (6000U)
+#define RECV_TIMEOUT        (50U * US_PER_MS)
+/* all layers run on the stack of the interface with direct calls */
+#define NETIF_STACKSIZE     (2 * THREAD_STACKSIZE_DEFAULT)
+
+static const unsigned _burst_lens[] = { 1, 4, 8 };
+
+static const uint8_t _dev_addr[] = { 0x6c, 0x5d, 0xff, 0x73, 0x84, 0x6f };
+static const uint8_t _peer_addr[] = { 0x41, 0x9b, 0x9f, 0x56, 0x36, 0x46 };
+
+static char _netif_stack[NETIF_STACKSIZE];
+static netdev_test_t _dev;
+static sock_udp_t _server, _client;
+static uint8_t _tx_buf[PAYLOAD_LEN];
+static uint8_t _rx_buf[PAYLOAD_LEN];
+
+/* the frame to be received next */
+static uint8_t _frame[ETHERNET_FRAME_LEN];
+static unsigned _frame_len = 0;
+
+/* reflects IPv6 frames back to the interface */
+static int _dev_send(netdev_t *dev, const iolist_t *iolist)
+{
+    ethernet_hdr_t *eth = (ethernet_hdr_t *)_frame;
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)(eth + 1);
+    ipv6_addr_t tmp;
+    unsigned len = 0;
+
+    if (_frame_len != 0) {
+        /* previous frame was not received yet */
+        return -EBUSY;
+    }
+    for (; iolist != NULL; iolist = iolist->iol_next) {
+        if ((len + iolist->iol_len) > sizeof(_frame)) {
+            return -ENOBUFS;
+        }
+        memcpy(&_frame[len], iolist->iol_base, iolist->iol_len);
+        len += iolist->iol_len;
+    }
+    if ((len < (sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t))) ||
+        (byteorder_ntohs(eth->type) != ETHERTYPE_IPV6) ||
+        ipv6_addr_is_multicast(&ipv6->dst)) {
+        /* drop neighbor discovery and the like */
+        return (int)len;
+    }
+    memcpy(eth->dst, eth->src, sizeof(eth->dst));
+    memcpy(eth->src, _peer_addr, sizeof(eth->src));
+    /* swapping the addresses keeps the UDP checksum valid */
+    tmp = ipv6->dst;
+    ipv6->dst = ipv6->src;
+    ipv6->src = tmp;
+    _frame_len = len;
+    dev->event_callback(dev, NETDEV_EVENT_ISR);
+    return (int)len;
+}
+
+static void _dev_isr(netdev_t *dev)
+{
+    dev->event_callback(dev, NETDEV_EVENT_RX_COMPLETE);
+}
+
+static int _dev_recv(netdev_t *dev, char *buf, int len, void *info)
+{
+    int res = (int)_frame_len;
+
+    (void)dev;
+    (void)info;
+    if (buf == NULL) {
+        if (len > 0) {
+            /* frame is dropped */
+            _frame_len = 0;
+        }
+        return res;
+    }
+    if (len < res) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _frame, _frame_len);
+    _frame_len = 0;
+    return res;
+}
+
+static int _dev_get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    if (max_len < sizeof(uint16_t)) {
+        return -ENOBUFS;
+    }
+    *((uint16_t *)value) = NETDEV_TYPE_ETHERNET;
+    return sizeof(uint16_t);
+}
+
+static int _dev_get_addr(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    if (max_len < sizeof(_dev_addr)) {
+        return -ENOBUFS;
+    }
+    memcpy(value, _dev_addr, sizeof(_dev_addr));
+    return sizeof(_dev_addr);
+}
+
+/* returns the number of datagrams received */
+static unsigned _round(unsigned burst)
+{
+    unsigned received = 0;
+
+    for (unsigned i = 0; i < burst; i++) {
+        sock_udp_send(&_client, _tx_buf, PAYLOAD_LEN, NULL);
+    }
+    while (received < burst) {
+        if (sock_udp_recv(&_server, _rx_buf, PAYLOAD_LEN, RECV_TIMEOUT,
+                          NULL) <= 0) {
+            break;
+        }
+        received++;
+    }
+    return received;
+}
+
+/* returns datagrams per second */
+static uint32_t _measure(unsigned burst, bool direct, unsigned *received)
+{
+    gnrc_netapi_direct_enable(direct);
+
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        *received += _round(burst);
+    }
+    uint32_t duration = xtimer_now_usec() - start;
+    return (uint32_t)(((uint64_t)burst * ROUNDS * US_PER_SEC) / duration);
+}
+
+int main(void)
+{
+    sock_udp_ep_t local = { .family = AF_INET6, .port = SERVER_PORT };
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = SERVER_PORT };
+    ipv6_addr_t addr;
+    gnrc_netif_t *netif;
+
+    puts("Start.");
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_send_cb(&_dev, _dev_send);
+    netdev_test_set_recv_cb(&_dev, _dev_recv);
+    netdev_test_set_isr_cb(&_dev, _dev_isr);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _dev_get_device_type);
+    netdev_test_set_get_cb(&_dev, NETOPT_ADDRESS, _dev_get_addr);
+    netif = gnrc_netif_ethernet_create(_netif_stack, sizeof(_netif_stack),
+                                       GNRC_NETIF_PRIO, "reflector",
+                                       (netdev_t *)&_dev);
+    ipv6_addr_from_str(&addr, "2001:db8::1");
+    if (gnrc_netif_ipv6_addr_add(netif, &addr, 64,
+                                 GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID) < 0) {
+        puts("Unable to add address");
+        return 1;
+    }
+    ipv6_addr_from_str((ipv6_addr_t *)&remote.addr.ipv6, "2001:db8::2");
+    gnrc_ipv6_nib_nc_set((ipv6_addr_t *)&remote.addr.ipv6, netif->pid,
+                         _peer_addr, sizeof(_peer_addr));
+    if ((sock_udp_create(&_server, &local, NULL, 0) < 0) ||
+        (sock_udp_create(&_client, NULL, &remote, 0) < 0)) {
+        puts("Unable to create socks");
+        return 1;
+    }
+    memset(_tx_buf, 0xa5, sizeof(_tx_buf));
+
+    for (unsigned i = 0; i < sizeof(_burst_lens) / sizeof(_burst_lens[0]); i++) {
+        unsigned burst = _burst_lens[i];
+        unsigned received = 0;
+        uint32_t thread = _measure(burst, false, &received);
+        uint32_t direct = _measure(burst, true, &received);
+
+        printf("+ burst %u: thread %" PRIu32 " pkt/s, direct %" PRIu32
+               " pkt/s, %u/%u received\n", burst, thread, direct, received,
+               burst * ROUNDS * 2);
+    }
+    puts("Done.");
+    return 0;
+}
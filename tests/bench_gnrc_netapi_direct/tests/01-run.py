@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect_exact("Start.")
+    for burst in (1, 4, 8):
+        child.expect(r'\+ burst %d: thread \d+ pkt/s, direct \d+ pkt/s, '
+                     '%d/%d received' % (burst, burst * 256 * 2, burst * 256 * 2))
+    child.expect_exact("Done.")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc, timeout=120))
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the bulk transfer throughput of GNRC TCP
+ *
+ * Waits for a connection from a peer on the host, sends a fixed amount of
+ * data to it and closes the connection again. This is done once for every
+ * chunk size, a chunk being the amount of data handed to gnrc_tcp_send() at
+ * once. Chunks of one MSS behave like stop-and-wait, as gnrc_tcp_send()
+ * returns only after all data was acknowledged.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "net/af.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/tcp.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#define SERVER_PORT         (6000U)
+#define TOTAL_LEN           (256U * 1024U)
+#define CHUNK_MAX           (16U * 1024U)
+
+static const unsigned _chunk_lens[] = { GNRC_TCP_MSS, 4096, CHUNK_MAX };
+
+static gnrc_tcp_tcb_t _tcb;
+static uint8_t _buf[CHUNK_MAX];
+
+static void _print_link_local(void)
+{
+    gnrc_netif_t *netif = gnrc_netif_iter(NULL);
+    ipv6_addr_t addrs[GNRC_NETIF_IPV6_ADDRS_NUMOF];
+    int res = gnrc_netif_ipv6_addrs_get(netif, addrs, sizeof(addrs));
+
+    for (unsigned i = 0; i < (res / sizeof(ipv6_addr_t)); i++) {
+        if (ipv6_addr_is_link_local(&addrs[i])) {
+            char addr_str[IPV6_ADDR_MAX_STR_LEN];
+
+            ipv6_addr_to_str(addr_str, &addrs[i], sizeof(addr_str));
+            printf("Listening on [%s]:%u\n", addr_str, SERVER_PORT);
+            return;
+        }
+    }
+}
+
+/* returns the number of bytes sent */
+static uint32_t _transfer(unsigned chunk_len)
+{
+    uint32_t sent = 0;
+
+    while (sent < TOTAL_LEN) {
+        unsigned len = ((TOTAL_LEN - sent) < chunk_len) ? (TOTAL_LEN - sent) : chunk_len;
+        ssize_t res = gnrc_tcp_send(&_tcb, _buf, len, 0);
+
+        if (res <= 0) {
+            printf("gnrc_tcp_send() failed: %d\n", (int)res);
+            break;
+        }
+        sent += res;
+    }
+    return sent;
+}
+
+int main(void)
+{
+    puts("Start.");
+    memset(_buf, 0xa5, sizeof(_buf));
+    _print_link_local();
+
+    for (unsigned i = 0; i < sizeof(_chunk_lens) / sizeof(_chunk_lens[0]); i++) {
+        unsigned chunk_len = _chunk_lens[i];
+        int res;
+
+        gnrc_tcp_tcb_init(&_tcb);
+        res = gnrc_tcp_open_passive(&_tcb, AF_INET6, NULL, SERVER_PORT);
+        if (res < 0) {
+            printf("gnrc_tcp_open_passive() failed: %d\n", res);
+            return 1;
+        }
+
+        uint32_t start = xtimer_now_usec();
+        uint32_t sent = _transfer(chunk_len);
+        uint32_t duration = xtimer_now_usec() - start;
+
+        gnrc_tcp_close(&_tcb);
+        printf("+ chunk %5u: %" PRIu32 " bytes in %" PRIu32 " us, %" PRIu32 " kbit/s\n",
+               chunk_len, sent, duration,
+               (uint32_t)(((uint64_t)sent * 8 * MS_PER_SEC) / duration));
+    }
+    puts("Done.");
+    return 0;
+}
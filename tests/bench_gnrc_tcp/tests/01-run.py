@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import socket
+import sys
+import time
+
+TOTAL_LEN = 256 * 1024
+CHUNK_LENS = (1220, 4096, 16384)
+
+
+def connect(addr, port, iface):
+    """Connects to the node, which may still be closing the previous connection"""
+    for _ in range(10):
+        try:
+            return socket.create_connection(("%s%%%s" % (addr, iface), port), timeout=30)
+        except ConnectionRefusedError:
+            time.sleep(1)
+    raise ConnectionRefusedError("node is not listening")
+
+
+def receive_all(addr, port, iface):
+    """Reads until the node closes the connection"""
+    received = 0
+    with connect(addr, port, iface) as sock:
+        while True:
+            data = sock.recv(65536)
+            if not data:
+                break
+            received += len(data)
+    return received
+
+
+def testfunc(child):
+    iface = os.environ.get('PORT', 'tap0')
+    child.expect_exact("Start.")
+    child.expect(r"Listening on \[(fe80::[0-9a-f:]+)\]:(\d+)")
+    addr = child.match.group(1)
+    port = int(child.match.group(2))
+    for chunk_len in CHUNK_LENS:
+        assert receive_all(addr, port, iface) == TOTAL_LEN
+        child.expect(r'\+ chunk %5d: %d bytes in \d+ us, \d+ kbit/s' %
+                     (chunk_len, TOTAL_LEN))
+    child.expect_exact("Done.")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc, timeout=120))
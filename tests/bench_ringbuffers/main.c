@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the throughput of ringbuffer, tsrb and spscrb
+ *
+ * Pushes the same amount of data in chunks of different sizes through each
+ * ringbuffer implementation, always keeping the buffer half full so that
+ * every chunk may wrap around the end of the buffer.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "ringbuffer.h"
+#include "spscrb.h"
+#include "tsrb.h"
+#include "xtimer.h"
+
+#define BUF_SIZE            (512U)
+#define BYTES_TOTAL         (64U * 1024U)
+#define CHUNK_MAX           (256U)
+
+static const unsigned _chunk_sizes[] = { 1, 16, 64, 256 };
+
+static char _buf[BUF_SIZE];
+static char _chunk[CHUNK_MAX];
+
+static ringbuffer_t _ringbuffer;
+static tsrb_t _tsrb;
+static spscrb_t _spscrb;
+
+static void _print(const char *name, unsigned chunk, uint32_t duration)
+{
+    if (duration == 0) {
+        duration = 1;
+    }
+    printf("+ %-10s chunk %3u: %8" PRIu32 " kB/s\n", name, chunk,
+           (uint32_t)(((uint64_t)BYTES_TOTAL * US_PER_SEC) / (duration * 1000ULL)));
+}
+
+static uint32_t _bench_ringbuffer(unsigned chunk)
+{
+    uint32_t start;
+
+    ringbuffer_init(&_ringbuffer, _buf, BUF_SIZE);
+    ringbuffer_add(&_ringbuffer, _chunk, BUF_SIZE / 2);
+    start = xtimer_now_usec();
+    for (unsigned n = 0; n < BYTES_TOTAL; n += chunk) {
+        ringbuffer_add(&_ringbuffer, _chunk, chunk);
+        ringbuffer_get(&_ringbuffer, _chunk, chunk);
+    }
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t _bench_tsrb(unsigned chunk)
+{
+    uint32_t start;
+
+    tsrb_init(&_tsrb, _buf, BUF_SIZE);
+    tsrb_add(&_tsrb, _chunk, BUF_SIZE / 2);
+    start = xtimer_now_usec();
+    for (unsigned n = 0; n < BYTES_TOTAL; n += chunk) {
+        tsrb_add(&_tsrb, _chunk, chunk);
+        tsrb_get(&_tsrb, _chunk, chunk);
+    }
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t _bench_spscrb(unsigned chunk)
+{
+    uint32_t start;
+
+    spscrb_init(&_spscrb, _buf, BUF_SIZE);
+    spscrb_add(&_spscrb, _chunk, BUF_SIZE / 2);
+    start = xtimer_now_usec();
+    for (unsigned n = 0; n < BYTES_TOTAL; n += chunk) {
+        spscrb_add(&_spscrb, _chunk, chunk);
+        spscrb_get(&_spscrb, _chunk, chunk);
+    }
+    return xtimer_now_usec() - start;
+}
+
+/* byte-wise, as used by isrpipe from the UART RX interrupt */
+static uint32_t _bench_spscrb_one(void)
+{
+    uint32_t start;
+
+    spscrb_init(&_spscrb, _buf, BUF_SIZE);
+    start = xtimer_now_usec();
+    for (unsigned n = 0; n < BYTES_TOTAL; n++) {
+        spscrb_add_one(&_spscrb, (uint8_t)n);
+        spscrb_get_one(&_spscrb);
+    }
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t _bench_tsrb_one(void)
+{
+    uint32_t start;
+
+    tsrb_init(&_tsrb, _buf, BUF_SIZE);
+    start = xtimer_now_usec();
+    for (unsigned n = 0; n < BYTES_TOTAL; n++) {
+        tsrb_add_one(&_tsrb, (char)n);
+        tsrb_get_one(&_tsrb);
+    }
+    return xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    puts("Start.");
+    printf("%u bytes through a %u byte buffer\n", BYTES_TOTAL, BUF_SIZE);
+    _print("tsrb_one", 1, _bench_tsrb_one());
+    _print("spscrb_one", 1, _bench_spscrb_one());
+    for (unsigned i = 0; i < sizeof(_chunk_sizes) / sizeof(_chunk_sizes[0]); i++) {
+        unsigned chunk = _chunk_sizes[i];
+
+        _print("ringbuffer", chunk, _bench_ringbuffer(chunk));
+        _print("tsrb", chunk, _bench_tsrb(chunk));
+        _print("spscrb", chunk, _bench_spscrb(chunk));
+    }
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect_exact("Start.")
+    child.expect(r'\d+ bytes through a \d+ byte buffer')
+    for name in ("tsrb_one", "spscrb_one"):
+        child.expect(r'\+ %-10s chunk   1: +\d+ kB/s' % name)
+    for chunk in (1, 16, 64, 256):
+        for name in ("ringbuffer", "tsrb", "spscrb"):
+            child.expect(r'\+ %-10s chunk %3d: +\d+ kB/s' % (name, chunk))
+    child.expect_exact("Done.")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc, timeout=120))
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the 6LoWPAN reassembly buffer with many concurrent
+ *              senders
+ *
+ * Hands the fragments of datagrams from a number of link-layer sources to
+ * the reassembly buffer interleaved, as a border router receives them from
+ * its leaf nodes, and counts the datagrams reassembled.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "net/gnrc.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/sixlowpan.h"
+#include "xtimer.h"
+
+#define SOURCES_MAX         (16U)
+#define ROUNDS              (16U)
+#define DATAGRAM_LEN        (640U)
+#define FRAG_LEN            (80U)   /* multiple of 8 */
+
+static const unsigned _sources[] = { 4, 8, 16 };
+
+static gnrc_netreg_entry_cbd_t _cbd;
+static gnrc_netreg_entry_t _ipv6_reg;
+static unsigned _received = 0;
+
+static void _receive(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    if (cmd == GNRC_NETAPI_MSG_TYPE_RCV) {
+        _received++;
+    }
+    gnrc_pktbuf_release(pkt);
+}
+
+static void _send_frag(uint8_t src, uint16_t tag, unsigned offset)
+{
+    static const uint8_t dst[] = { 0x00, 0x01 };
+    const uint8_t l2src[] = { 0x00, src };
+    uint8_t buf[sizeof(sixlowpan_frag_n_t) + FRAG_LEN];
+    sixlowpan_frag_n_t *hdr = (sixlowpan_frag_n_t *)buf;
+    uint8_t *data;
+    size_t len;
+    gnrc_pktsnip_t *netif, *pkt;
+
+    hdr->disp_size = byteorder_htons(DATAGRAM_LEN);
+    hdr->tag = byteorder_htons(tag);
+    if (offset == 0) {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+        data = &buf[sizeof(sixlowpan_frag_t)];
+        *(data++) = SIXLOWPAN_UNCOMP;
+    }
+    else {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        hdr->offset = offset / 8;
+        data = &buf[sizeof(sixlowpan_frag_n_t)];
+    }
+    memset(data, src, FRAG_LEN);
+    len = (data - buf) + FRAG_LEN;
+
+    netif = gnrc_netif_hdr_build((uint8_t *)l2src, sizeof(l2src),
+                                 (uint8_t *)dst, sizeof(dst));
+    if (netif == NULL) {
+        return;
+    }
+    pkt = gnrc_pktbuf_add(netif, buf, len, GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    gnrc_sixlowpan_frag_handle_pkt(pkt);
+}
+
+int main(void)
+{
+    uint16_t tag = 0;
+
+    puts("Start.");
+    _cbd.cb = _receive;
+    _cbd.ctx = NULL;
+    gnrc_netreg_entry_init_cb(&_ipv6_reg, GNRC_NETREG_DEMUX_CTX_ALL, &_cbd);
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_ipv6_reg);
+
+    for (unsigned i = 0; i < sizeof(_sources) / sizeof(_sources[0]); i++) {
+        unsigned sources = _sources[i];
+        gnrc_sixlowpan_frag_rbuf_stats_t stats;
+        uint32_t start = xtimer_now_usec();
+
+        _received = 0;
+        for (unsigned r = 0; r < ROUNDS; r++) {
+            tag++;
+            /* every source sends one fragment in turn */
+            for (unsigned offset = 0; offset < DATAGRAM_LEN; offset += FRAG_LEN) {
+                for (unsigned src = 1; src <= sources; src++) {
+                    _send_frag(src, tag, offset);
+                }
+            }
+        }
+        uint32_t duration = xtimer_now_usec() - start;
+
+        gnrc_sixlowpan_frag_rbuf_get_stats(&stats);
+        printf("+ %2u sources: %u/%u datagrams in %" PRIu32 " us, "
+               "%" PRIu32 " evicted, %" PRIu32 " timed out\n", sources,
+               _received, sources * ROUNDS, duration, stats.evicted,
+               stats.timeout);
+    }
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the connection rate of a listening TCP sock
+ *
+ * A peer on the host opens bursts of connections, each sending a single
+ * byte before closing it again. The node accepts the connections one at a
+ * time, reads until the peer closed the connection and closes it as well.
+ * Connections of a burst, that arrive while the node is busy with a
+ * previous one, are established by the TCP thread and wait in the listening
+ * queue.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "net/af.h"
+#include "net/gnrc/netif.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/tcp.h"
+#include "xtimer.h"
+
+#define SERVER_PORT         (6001U)
+#define QUEUE_LEN           (8U)
+#define ROUNDS              (16U)
+
+static const unsigned _burst_lens[] = { 1, 4, QUEUE_LEN };
+
+static sock_tcp_queue_t _queue;
+static sock_tcp_t _queue_array[QUEUE_LEN];
+
+static void _print_link_local(void)
+{
+    gnrc_netif_t *netif = gnrc_netif_iter(NULL);
+    ipv6_addr_t addrs[GNRC_NETIF_IPV6_ADDRS_NUMOF];
+    int res = gnrc_netif_ipv6_addrs_get(netif, addrs, sizeof(addrs));
+
+    for (unsigned i = 0; i < (res / sizeof(ipv6_addr_t)); i++) {
+        if (ipv6_addr_is_link_local(&addrs[i])) {
+            char addr_str[IPV6_ADDR_MAX_STR_LEN];
+
+            ipv6_addr_to_str(addr_str, &addrs[i], sizeof(addr_str));
+            printf("Listening on [%s]:%u\n", addr_str, SERVER_PORT);
+            return;
+        }
+    }
+}
+
+/* returns 0 if the connection was closed by the peer after sending data */
+static int _serve(void)
+{
+    sock_tcp_t *sock;
+    uint8_t buf[8];
+    ssize_t res;
+    size_t received = 0;
+
+    if (sock_tcp_accept(&_queue, &sock, SOCK_NO_TIMEOUT) < 0) {
+        return -1;
+    }
+    while ((res = sock_tcp_read(sock, buf, sizeof(buf), SOCK_NO_TIMEOUT)) > 0) {
+        received += res;
+    }
+    sock_tcp_disconnect(sock);
+    return ((res == 0) && (received > 0)) ? 0 : -1;
+}
+
+int main(void)
+{
+    sock_tcp_ep_t local = SOCK_IPV6_EP_ANY;
+
+    puts("Start.");
+    local.port = SERVER_PORT;
+    if (sock_tcp_listen(&_queue, &local, _queue_array, QUEUE_LEN, 0) < 0) {
+        puts("Unable to listen");
+        return 1;
+    }
+    _print_link_local();
+
+    for (unsigned i = 0; i < sizeof(_burst_lens) / sizeof(_burst_lens[0]); i++) {
+        unsigned burst = _burst_lens[i];
+        unsigned total = burst * ROUNDS;
+        unsigned failed = 0;
+        uint32_t start = 0;
+
+        for (unsigned n = 0; n < total; n++) {
+            if (_serve() < 0) {
+                failed++;
+            }
+            /* count from the first connection of the bursts on */
+            if (n == 0) {
+                start = xtimer_now_usec();
+            }
+        }
+        uint32_t duration = xtimer_now_usec() - start;
+        printf("+ burst %u: %u connections in %" PRIu32 " us, %" PRIu32
+               " conn/s, %u failed\n", burst, total, duration,
+               (uint32_t)(((uint64_t)(total - 1) * US_PER_SEC) / duration),
+               failed);
+    }
+    sock_tcp_stop_listen(&_queue);
+    puts("Done.");
+    return 0;
+}
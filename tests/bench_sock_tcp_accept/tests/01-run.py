@@ -0,0 +1,43 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import socket
+import sys
+
+ROUNDS = 16
+BURST_LENS = (1, 4, 8)
+
+
+def burst(addr, port, iface, burst_len):
+    """Opens burst_len connections at once, before closing any of them"""
+    socks = [socket.create_connection(("%s%%%s" % (addr, iface), port), timeout=30)
+             for _ in range(burst_len)]
+    for sock in socks:
+        sock.sendall(b"x")
+        sock.close()
+
+
+def testfunc(child):
+    iface = os.environ.get('PORT', 'tap0')
+    child.expect_exact("Start.")
+    child.expect(r"Listening on \[(fe80::[0-9a-f:]+)\]:(\d+)")
+    addr = child.match.group(1)
+    port = int(child.match.group(2))
+    for burst_len in BURST_LENS:
+        for _ in range(ROUNDS):
+            burst(addr, port, iface, burst_len)
+        child.expect(r'\+ burst %d: %d connections in \d+ us, \d+ conn/s, 0 failed' %
+                     (burst_len, burst_len * ROUNDS))
+    child.expect_exact("Done.")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc, timeout=120))
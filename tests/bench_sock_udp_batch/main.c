@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the throughput of single and batched UDP sock
+ *              operations
+ *
+ * Sends bursts of datagrams via the loopback interface, and receives them
+ * again, once with sock_udp_send() and sock_udp_recv() for each datagram,
+ * and once with sock_udp_send_batch() and sock_udp_recv_batch() for the
+ * whole burst.
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "xtimer.h"
+
+#define BURST_MAX           (32U)
+#define ROUNDS              (64U)
+#define PAYLOAD_LEN         (64U)
+#define SERVER_PORT         (6000U)
+#define RECV_TIMEOUT        (50U * US_PER_MS)
+
+static const unsigned _burst_lens[] = { 1, 8, 32 };
+
+static sock_udp_t _server, _client;
+static uint8_t _tx_bufs[BURST_MAX][PAYLOAD_LEN];
+static uint8_t _rx_bufs[BURST_MAX][PAYLOAD_LEN];
+static sock_udp_msg_t _tx_msgs[BURST_MAX];
+static sock_udp_msg_t _rx_msgs[BURST_MAX];
+
+/* returns the number of datagrams received */
+static unsigned _round(unsigned burst, bool batch)
+{
+    unsigned received = 0;
+
+    if (batch) {
+        sock_udp_send_batch(&_client, _tx_msgs, burst);
+    }
+    else {
+        for (unsigned i = 0; i < burst; i++) {
+            sock_udp_send(&_client, _tx_bufs[i], PAYLOAD_LEN, NULL);
+        }
+    }
+    while (received < burst) {
+        int res;
+
+        if (batch) {
+            for (unsigned i = 0; i < burst - received; i++) {
+                _rx_msgs[i].len = PAYLOAD_LEN;
+            }
+            res = sock_udp_recv_batch(&_server, _rx_msgs, burst - received,
+                                      RECV_TIMEOUT);
+        }
+        else {
+            res = (int)sock_udp_recv(&_server, _rx_bufs[0], PAYLOAD_LEN,
+                                     RECV_TIMEOUT, NULL);
+            res = (res > 0) ? 1 : res;
+        }
+        if (res <= 0) {
+            break;
+        }
+        received += res;
+    }
+    return received;
+}
+
+/* returns datagrams per second */
+static uint32_t _measure(unsigned burst, bool batch, unsigned *received)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        *received += _round(burst, batch);
+    }
+    uint32_t duration = xtimer_now_usec() - start;
+    return (uint32_t)(((uint64_t)burst * ROUNDS * US_PER_SEC) / duration);
+}
+
+int main(void)
+{
+    sock_udp_ep_t local = { .family = AF_INET6, .port = SERVER_PORT };
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = SERVER_PORT };
+
+    puts("Start.");
+    ipv6_addr_set_loopback((ipv6_addr_t *)&remote.addr.ipv6);
+    if ((sock_udp_create(&_server, &local, NULL, 0) < 0) ||
+        (sock_udp_create(&_client, NULL, &remote, 0) < 0)) {
+        puts("Unable to create socks");
+        return 1;
+    }
+    for (unsigned i = 0; i < BURST_MAX; i++) {
+        memset(_tx_bufs[i], i, PAYLOAD_LEN);
+        _tx_msgs[i].data = _tx_bufs[i];
+        _tx_msgs[i].len = PAYLOAD_LEN;
+        _rx_msgs[i].data = _rx_bufs[i];
+    }
+
+    for (unsigned i = 0; i < sizeof(_burst_lens) / sizeof(_burst_lens[0]); i++) {
+        unsigned burst = _burst_lens[i];
+        unsigned received = 0;
+        uint32_t single = _measure(burst, false, &received);
+        uint32_t batch = _measure(burst, true, &received);
+
+        printf("+ burst %2u: single %" PRIu32 " msg/s, batch %" PRIu32
+               " msg/s, %u/%u received\n", burst, single, batch, received,
+               burst * ROUNDS * 2);
+    }
+    puts("Done.");
+    return 0;
+}
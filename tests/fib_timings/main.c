@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the cost of FIB lookups depending on the table size
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "net/fib.h"
+#include "net/fib/table.h"
+#include "random.h"
+#include "xtimer.h"
+
+#define TABLE_SIZE_MAX      (2048U)
+#define ADDR_SIZE           (16U)
+#define PREFIX_LEN          (64U)
+#define NEXT_HOPS_NUMOF     (8U)
+#define LOOKUPS             (10000U)
+#define SEED                (0x8d2e1b37)
+
+static const unsigned _table_sizes[] = { 16, 256, TABLE_SIZE_MAX };
+
+static fib_entry_t _entries[TABLE_SIZE_MAX];
+static fib_trie_node_t _trie_nodes[FIB_TRIE_NODES_NUMOF(TABLE_SIZE_MAX)];
+static fib_table_t _table;
+static uint8_t _prefixes[TABLE_SIZE_MAX][ADDR_SIZE];
+
+static void _fill(unsigned entries)
+{
+    uint8_t next_hop[ADDR_SIZE];
+
+    memset(next_hop, 0, sizeof(next_hop));
+    next_hop[0] = 0xfe;
+    next_hop[1] = 0x80;
+
+    for (unsigned i = 0; i < entries; i++) {
+        /* 2001:db8:xxxx:xxxx::/64 */
+        memset(_prefixes[i], 0, ADDR_SIZE);
+        _prefixes[i][0] = 0x20;
+        _prefixes[i][1] = 0x01;
+        _prefixes[i][2] = 0x0d;
+        _prefixes[i][3] = 0xb8;
+        random_bytes(&_prefixes[i][4], (PREFIX_LEN / 8) - 4);
+        next_hop[ADDR_SIZE - 1] = i % NEXT_HOPS_NUMOF;
+        fib_add_entry(&_table, 6, _prefixes[i], ADDR_SIZE,
+                      (PREFIX_LEN << FIB_FLAG_NET_PREFIX_SHIFT),
+                      next_hop, ADDR_SIZE, 0,
+                      (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+    }
+}
+
+static void _bench(unsigned entries)
+{
+    uint8_t dst[ADDR_SIZE];
+    uint8_t next_hop[ADDR_SIZE];
+    unsigned found = 0;
+
+    _table.data.entries = _entries;
+    _table.trie_nodes = _trie_nodes;
+    _table.table_type = FIB_TABLE_TYPE_SH;
+    _table.size = entries;
+    fib_init(&_table);
+
+    _fill(entries);
+
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < LOOKUPS; i++) {
+        kernel_pid_t iface;
+        uint32_t next_hop_flags;
+        size_t next_hop_size = sizeof(next_hop);
+
+        /* hit a random prefix with a random interface identifier */
+        memcpy(dst, _prefixes[random_uint32_range(0, entries)], PREFIX_LEN / 8);
+        random_bytes(&dst[PREFIX_LEN / 8], ADDR_SIZE - (PREFIX_LEN / 8));
+
+        if (fib_get_next_hop(&_table, &iface, next_hop, &next_hop_size,
+                             &next_hop_flags, dst, ADDR_SIZE, 0) == 0) {
+            found++;
+        }
+    }
+
+    uint32_t duration = xtimer_now_usec() - start;
+
+    printf("+ %4u entries: %u/%u found, %" PRIu32 " ns per lookup\n",
+           entries, found, LOOKUPS,
+           (uint32_t)(((uint64_t)duration * 1000) / LOOKUPS));
+
+    fib_deinit(&_table);
+}
+
+int main(void)
+{
+    random_init(SEED);
+
+    puts("Start.");
+
+    for (unsigned i = 0; i < (sizeof(_table_sizes) / sizeof(_table_sizes[0])); i++) {
+        _bench(_table_sizes[i]);
+    }
+
+    puts("Done.");
+
+    return 0;
+}
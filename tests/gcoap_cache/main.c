@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for the gcoap response cache
+ *
+ * Sends GET requests for a cached resource via the loopback interface and
+ * counts how often its handler runs.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "assert.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "xtimer.h"
+
+/* in seconds; a cached response must not expire between two requests */
+#define MAX_AGE             (2U)
+#define CLIENT_PORT         (GCOAP_PORT + 1)
+#define RECV_TIMEOUT        (100U * US_PER_MS)
+
+#define CALL(fn)            puts("Calling " # fn); fn; tear_down()
+
+static ssize_t _value_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              void *ctx);
+
+static const coap_resource_t _resources[] = {
+    { "/value", COAP_GET, _value_handler, NULL },
+};
+
+static gcoap_listener_t _listener = {
+    (coap_resource_t *)&_resources[0],
+    sizeof(_resources) / sizeof(_resources[0]),
+    NULL,
+    MAX_AGE
+};
+
+static sock_udp_t _client;
+static sock_udp_ep_t _server = { .family = AF_INET6, .port = GCOAP_PORT };
+static uint8_t _buf[GCOAP_PDU_BUF_SIZE];
+static coap_pkt_t _resp;
+static uint16_t _msg_id;
+static uint32_t _value;
+static volatile unsigned _handled;
+
+static ssize_t _value_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              void *ctx)
+{
+    (void)ctx;
+
+    _handled++;
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    memcpy(pdu->payload, &_value, sizeof(_value));
+    return gcoap_finish(pdu, sizeof(_value), COAP_FORMAT_OCTET);
+}
+
+static void tear_down(void)
+{
+    gcoap_cache_invalidate(&_resources[0]);
+    _handled = 0;
+}
+
+/* returns the value of option onum in _resp, or -1 if not present */
+static int64_t _resp_opt(unsigned onum)
+{
+    coap_optpos_t opt;
+    uint32_t value = 0;
+
+    coap_opt_iter_init(&_resp, &opt);
+    while (coap_opt_iter_next(&_resp, &opt)) {
+        if ((opt.onum == onum) && (opt.len <= sizeof(value))) {
+            if (onum == COAP_OPT_ETAG) {
+                /* opaque, compared as is */
+                memcpy(&value, opt.value, opt.len);
+            }
+            else {
+                for (unsigned i = 0; i < opt.len; i++) {
+                    value = (value << 8) | opt.value[i];
+                }
+            }
+            return value;
+        }
+    }
+    return -1;
+}
+
+/* sends a GET request for /value and parses the response into _resp */
+static unsigned _get(const uint32_t *etag)
+{
+    uint8_t *pos = _buf;
+    unsigned lastonum = 0;
+    ssize_t res;
+
+    _msg_id++;
+    pos += coap_build_hdr((coap_hdr_t *)pos, COAP_TYPE_NON, (uint8_t *)&_msg_id,
+                          sizeof(_msg_id), COAP_METHOD_GET, _msg_id);
+    if (etag != NULL) {
+        pos += coap_put_option(pos, 0, COAP_OPT_ETAG, (uint8_t *)etag,
+                               sizeof(*etag));
+        lastonum = COAP_OPT_ETAG;
+    }
+    pos += coap_put_option_uri(pos, lastonum, "/value", COAP_OPT_URI_PATH);
+    res = sock_udp_send(&_client, _buf, pos - _buf, &_server);
+    assert(res > 0);
+    res = sock_udp_recv(&_client, _buf, sizeof(_buf), RECV_TIMEOUT, NULL);
+    assert(res > 0);
+    res = coap_parse(&_resp, _buf, res);
+    assert(res == 0);
+    assert(memcmp(_resp.token, &_msg_id, sizeof(_msg_id)) == 0);
+    return coap_get_code_raw(&_resp);
+}
+
+static void test_gcoap_cache__miss(void)
+{
+    assert(_get(NULL) == COAP_CODE_CONTENT);
+    assert(_handled == 1);
+    assert(_resp.payload_len == sizeof(_value));
+    assert(memcmp(_resp.payload, &_value, sizeof(_value)) == 0);
+    /* the stored response is returned, with the cache options */
+    assert(_resp_opt(COAP_OPT_ETAG) >= 0);
+    assert(_resp_opt(COAP_OPT_MAX_AGE) == MAX_AGE);
+}
+
+static void test_gcoap_cache__hit(void)
+{
+    int64_t etag;
+
+    assert(_get(NULL) == COAP_CODE_CONTENT);
+    etag = _resp_opt(COAP_OPT_ETAG);
+    assert(_get(NULL) == COAP_CODE_CONTENT);
+    assert(_handled == 1);
+    assert(_resp.payload_len == sizeof(_value));
+    assert(memcmp(_resp.payload, &_value, sizeof(_value)) == 0);
+    assert(_resp_opt(COAP_OPT_ETAG) == etag);
+    assert(_resp_opt(COAP_OPT_MAX_AGE) <= MAX_AGE);
+}
+
+static void test_gcoap_cache__etag_valid(void)
+{
+    uint32_t etag;
+
+    assert(_get(NULL) == COAP_CODE_CONTENT);
+    etag = (uint32_t)_resp_opt(COAP_OPT_ETAG);
+    assert(_get(&etag) == COAP_CODE_VALID);
+    assert(_handled == 1);
+    assert(_resp.payload_len == 0);
+    assert(_resp_opt(COAP_OPT_ETAG) == etag);
+}
+
+static void test_gcoap_cache__invalidate(void)
+{
+    uint32_t etag;
+
+    assert(_get(NULL) == COAP_CODE_CONTENT);
+    etag = (uint32_t)_resp_opt(COAP_OPT_ETAG);
+    _value++;
+    gcoap_cache_invalidate(&_resources[0]);
+    /* the old ETag does not validate the new response */
+    assert(_get(&etag) == COAP_CODE_CONTENT);
+    assert(_handled == 2);
+    assert(_resp.payload_len == sizeof(_value));
+    assert(memcmp(_resp.payload, &_value, sizeof(_value)) == 0);
+    assert(_resp_opt(COAP_OPT_ETAG) != etag);
+}
+
+static void test_gcoap_cache__max_age(void)
+{
+    assert(_get(NULL) == COAP_CODE_CONTENT);
+    xtimer_usleep(MAX_AGE * US_PER_SEC + RECV_TIMEOUT);
+    assert(_get(NULL) == COAP_CODE_CONTENT);
+    assert(_handled == 2);
+    assert(_resp_opt(COAP_OPT_MAX_AGE) == MAX_AGE);
+}
+
+int main(void)
+{
+    sock_udp_ep_t local = { .family = AF_INET6, .port = CLIENT_PORT };
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&_server.addr.ipv6);
+    gcoap_register_listener(&_listener);
+    if (sock_udp_create(&_client, &local, NULL, 0) < 0) {
+        puts("error: can't create client sock");
+        return 1;
+    }
+
+    CALL(test_gcoap_cache__miss());
+    CALL(test_gcoap_cache__hit());
+    CALL(test_gcoap_cache__etag_valid());
+    CALL(test_gcoap_cache__invalidate());
+    CALL(test_gcoap_cache__max_age());
+
+    puts("ALL TESTS SUCCESSFUL");
+    return 0;
+}
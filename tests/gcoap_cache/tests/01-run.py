@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect_exact("Calling test_gcoap_cache__miss()")
+    child.expect_exact("Calling test_gcoap_cache__hit()")
+    child.expect_exact("Calling test_gcoap_cache__etag_valid()")
+    child.expect_exact("Calling test_gcoap_cache__invalidate()")
+    child.expect_exact("Calling test_gcoap_cache__max_age()")
+    child.expect_exact("ALL TESTS SUCCESSFUL")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc, timeout=120))
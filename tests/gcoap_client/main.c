@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for responses to gcoap requests and their timeouts
+ *
+ * Sends requests with gcoap_req_send2() via the loopback interface, and
+ * checks that the gcoap thread handles their responses and timeouts while it
+ * waits for messages on its sock.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "assert.h"
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+/* nobody listens on this port */
+#define UNUSED_PORT         (GCOAP_PORT + 1)
+/* tolerance for the time of the response timeout */
+#define TIMEOUT_SLACK       (50U * US_PER_MS)
+
+#define CALL(fn)            puts("Calling " # fn); fn
+
+static ssize_t _handler(coap_pkt_t *pdu, uint8_t *buf, size_t len, void *ctx);
+
+static const coap_resource_t _resources[] = {
+    { "/resp", COAP_GET, _handler, NULL },
+};
+
+static gcoap_listener_t _listener = {
+    (coap_resource_t *)&_resources[0],
+    sizeof(_resources) / sizeof(_resources[0]),
+    NULL,
+    0
+};
+
+static uint8_t _buf[GCOAP_PDU_BUF_SIZE];
+
+/* unlocked by the response handler of a gcoap request */
+static mutex_t _resp_lock = MUTEX_INIT_LOCKED;
+static unsigned _resp_state;
+static uint32_t _resp_time;
+
+static ssize_t _handler(coap_pkt_t *pdu, uint8_t *buf, size_t len, void *ctx)
+{
+    (void)ctx;
+
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+static void _resp_handler(unsigned req_state, coap_pkt_t *pdu,
+                          sock_udp_ep_t *remote)
+{
+    (void)pdu;
+    (void)remote;
+
+    _resp_state = req_state;
+    _resp_time = xtimer_now_usec();
+    mutex_unlock(&_resp_lock);
+}
+
+/* sends a gcoap request to port; returns the time it was sent */
+static uint32_t _req_send(uint16_t port)
+{
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = port };
+    coap_pkt_t pdu;
+    size_t len;
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&remote.addr.ipv6);
+    gcoap_req_init(&pdu, _buf, sizeof(_buf), COAP_METHOD_GET, "/resp");
+    len = gcoap_finish(&pdu, 0, COAP_FORMAT_NONE);
+    uint32_t now = xtimer_now_usec();
+    len = gcoap_req_send2(_buf, len, &remote, _resp_handler);
+    assert(len > 0);
+    (void)len;
+    return now;
+}
+
+static void test_gcoap_client__resp(void)
+{
+    /* the gcoap server answers its own request */
+    _req_send(GCOAP_PORT);
+    mutex_lock(&_resp_lock);
+    assert(_resp_state == GCOAP_MEMO_RESP);
+}
+
+static void test_gcoap_client__timeout(void)
+{
+    uint32_t start = _req_send(UNUSED_PORT);
+
+    mutex_lock(&_resp_lock);
+    assert(_resp_state == GCOAP_MEMO_TIMEOUT);
+    /* the timer interrupts the wait of the gcoap thread for a message */
+    assert((_resp_time - start) >= GCOAP_NON_TIMEOUT);
+    assert((_resp_time - start) < (GCOAP_NON_TIMEOUT + TIMEOUT_SLACK));
+}
+
+static void test_gcoap_client__resp_after_timeout(void)
+{
+    /* the memo of the timed out request is used again */
+    _req_send(GCOAP_PORT);
+    mutex_lock(&_resp_lock);
+    assert(_resp_state == GCOAP_MEMO_RESP);
+    /* and no timeout is reported for the answered request */
+    assert(xtimer_mutex_lock_timeout(&_resp_lock,
+                                     GCOAP_NON_TIMEOUT + TIMEOUT_SLACK) < 0);
+}
+
+int main(void)
+{
+    gcoap_register_listener(&_listener);
+
+    CALL(test_gcoap_client__resp());
+    CALL(test_gcoap_client__timeout());
+    CALL(test_gcoap_client__resp_after_timeout());
+
+    puts("ALL TESTS SUCCESSFUL");
+    return 0;
+}
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for concurrent requests to gcoap resources
+ *
+ * Sends several requests at once via the loopback interface, so they are
+ * handled by the pool of GCOAP_WORKERS_NUMOF worker threads.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "assert.h"
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "xtimer.h"
+
+#define SLOW_DELAY          (200U * US_PER_MS)
+#define CLIENT_PORT         (GCOAP_PORT + 1)
+/* long enough for all slow requests of a test to be handled */
+#define RECV_TIMEOUT        (4 * SLOW_DELAY)
+
+#define CALL(fn)            puts("Calling " # fn); fn; tear_down()
+
+static ssize_t _fast_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             void *ctx);
+static ssize_t _slow_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             void *ctx);
+
+static const coap_resource_t _resources[] = {
+    { "/fast", COAP_GET, _fast_handler, NULL },
+    { "/slow", COAP_GET, _slow_handler, NULL },
+};
+
+static gcoap_listener_t _listener = {
+    (coap_resource_t *)&_resources[0],
+    sizeof(_resources) / sizeof(_resources[0]),
+    NULL,
+    0
+};
+
+static sock_udp_t _client;
+static sock_udp_ep_t _server = { .family = AF_INET6, .port = GCOAP_PORT };
+static uint8_t _buf[GCOAP_PDU_BUF_SIZE];
+static uint16_t _msg_id;
+
+/* number of slow handlers running, and the maximum of it */
+static mutex_t _active_lock = MUTEX_INIT;
+static unsigned _active;
+static unsigned _max_active;
+
+static ssize_t _fast_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             void *ctx)
+{
+    (void)ctx;
+
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+static ssize_t _slow_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             void *ctx)
+{
+    (void)ctx;
+
+    mutex_lock(&_active_lock);
+    if (++_active > _max_active) {
+        _max_active = _active;
+    }
+    mutex_unlock(&_active_lock);
+    xtimer_usleep(SLOW_DELAY);
+    mutex_lock(&_active_lock);
+    _active--;
+    mutex_unlock(&_active_lock);
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+static void tear_down(void)
+{
+    _max_active = 0;
+}
+
+/* sends a GET request for path; returns its token */
+static uint16_t _send(const char *path)
+{
+    uint8_t *pos = _buf;
+    ssize_t res;
+
+    _msg_id++;
+    pos += coap_build_hdr((coap_hdr_t *)pos, COAP_TYPE_NON, (uint8_t *)&_msg_id,
+                          sizeof(_msg_id), COAP_METHOD_GET, _msg_id);
+    pos += coap_put_option_uri(pos, 0, path, COAP_OPT_URI_PATH);
+    res = sock_udp_send(&_client, _buf, pos - _buf, &_server);
+    assert(res > 0);
+    (void)res;
+    return _msg_id;
+}
+
+/* receives a response; returns its code and token */
+static unsigned _recv(uint16_t *token)
+{
+    coap_pkt_t pdu;
+    ssize_t res;
+
+    res = sock_udp_recv(&_client, _buf, sizeof(_buf), RECV_TIMEOUT, NULL);
+    assert(res > 0);
+    res = coap_parse(&pdu, _buf, res);
+    assert(res == 0);
+    assert(coap_get_token_len(&pdu) == sizeof(*token));
+    memcpy(token, pdu.token, sizeof(*token));
+    return coap_get_code_raw(&pdu);
+}
+
+static void test_gcoap_workers__concurrent(void)
+{
+    uint16_t tokens[GCOAP_WORKERS_NUMOF];
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < GCOAP_WORKERS_NUMOF; i++) {
+        tokens[i] = _send("/slow");
+    }
+    for (unsigned i = 0; i < GCOAP_WORKERS_NUMOF; i++) {
+        uint16_t token;
+
+        assert(_recv(&token) == COAP_CODE_CONTENT);
+        /* one response per request */
+        for (unsigned j = 0; j < GCOAP_WORKERS_NUMOF; j++) {
+            if (tokens[j] == token) {
+                tokens[j] = 0;
+                token = 0;
+                break;
+            }
+        }
+        assert(token == 0);
+    }
+    /* all handlers ran at the same time */
+    assert(_max_active == GCOAP_WORKERS_NUMOF);
+    assert((xtimer_now_usec() - start) < (2 * SLOW_DELAY));
+}
+
+static void test_gcoap_workers__fast_during_slow(void)
+{
+    uint16_t slow = _send("/slow");
+    uint16_t fast = _send("/fast");
+    uint16_t token;
+
+    /* the fast request is not held up by the slow handler */
+    assert(_recv(&token) == COAP_CODE_CONTENT);
+    assert(token == fast);
+    assert(_recv(&token) == COAP_CODE_CONTENT);
+    assert(token == slow);
+}
+
+static void test_gcoap_workers__no_buffer(void)
+{
+    uint16_t tokens[GCOAP_PDU_BUFS_NUMOF + 1];
+    uint16_t token;
+
+    for (unsigned i = 0; i < (GCOAP_PDU_BUFS_NUMOF + 1); i++) {
+        tokens[i] = _send("/slow");
+    }
+    /* the last request finds all buffers in use */
+    assert(_recv(&token) == COAP_CODE_SERVICE_UNAVAILABLE);
+    assert(token == tokens[GCOAP_PDU_BUFS_NUMOF]);
+    for (unsigned i = 0; i < GCOAP_PDU_BUFS_NUMOF; i++) {
+        assert(_recv(&token) == COAP_CODE_CONTENT);
+    }
+    assert(_max_active == GCOAP_WORKERS_NUMOF);
+}
+
+int main(void)
+{
+    sock_udp_ep_t local = { .family = AF_INET6, .port = CLIENT_PORT };
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&_server.addr.ipv6);
+    gcoap_register_listener(&_listener);
+    if (sock_udp_create(&_client, &local, NULL, 0) < 0) {
+        puts("error: can't create client sock");
+        return 1;
+    }
+
+    CALL(test_gcoap_workers__concurrent());
+    CALL(test_gcoap_workers__fast_during_slow());
+    CALL(test_gcoap_workers__no_buffer());
+
+    puts("ALL TESTS SUCCESSFUL");
+    return 0;
+}
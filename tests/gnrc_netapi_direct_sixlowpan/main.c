@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for replies generated in the receive path of a 6LoWPAN
+ *              interface with @ref net_gnrc_netapi_direct
+ *
+ * Receives an ICMPv6 echo request over a @ref netdev_test IEEE 802.15.4
+ * device and waits for the echo reply. With direct calls the reply is
+ * compressed in the thread of the interface itself.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "assert.h"
+#include "byteorder.h"
+#include "mutex.h"
+#include "net/icmpv6.h"
+#include "net/ieee802154.h"
+#include "net/inet_csum.h"
+#include "net/gnrc/netapi/direct.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/nettype.h"
+#include "net/ipv6/addr.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "xtimer.h"
+
+#define CALL(fn)            puts("Calling " # fn); fn
+
+#define DEV_PAN             (0x23)
+#define MAX_FRAG_SIZE       (102U)
+#define ECHO_ID             (0x7a1b)
+#define ECHO_SEQ            (0x0042)
+#define ECHO_PAYLOAD        "direct"
+#define ECHO_PAYLOAD_LEN    (sizeof(ECHO_PAYLOAD) - 1)
+#define ECHO_LEN            (sizeof(icmpv6_echo_t) + ECHO_PAYLOAD_LEN)
+#define REPLY_TIMEOUT       (500U * US_PER_MS)
+/* all layers run on the stack of the interface with direct calls */
+#define NETIF_STACKSIZE     (2 * THREAD_STACKSIZE_DEFAULT)
+
+static const uint8_t _dev_addr[] = {
+    0x02, 0x1f, 0x3a, 0x7b, 0x11, 0x47, 0x2c, 0x90
+};
+static const uint8_t _peer_addr[] = {
+    0x02, 0x4c, 0x9d, 0x03, 0x65, 0xe1, 0x8a, 0x2f
+};
+
+static char _netif_stack[NETIF_STACKSIZE];
+static netdev_test_t _dev;
+static mutex_t _reply = MUTEX_INIT_LOCKED;
+
+/* the frame to be received next */
+static uint8_t _frame[IEEE802154_FRAME_LEN_MAX];
+static unsigned _frame_len = 0;
+
+/* waits for the echo reply and drops all other frames, e.g. router
+ * solicitations */
+static int _dev_send(netdev_t *dev, const iolist_t *iolist)
+{
+    uint8_t frame[IEEE802154_FRAME_LEN_MAX];
+    icmpv6_echo_t *echo;
+    unsigned len = 0;
+
+    (void)dev;
+    for (; iolist != NULL; iolist = iolist->iol_next) {
+        if ((len + iolist->iol_len) > sizeof(frame)) {
+            return -ENOBUFS;
+        }
+        memcpy(&frame[len], iolist->iol_base, iolist->iol_len);
+        len += iolist->iol_len;
+    }
+    if (len < ECHO_LEN) {
+        return (int)len;
+    }
+    /* ICMPv6 is carried inline by IPHC so the echo reply ends the frame */
+    echo = (icmpv6_echo_t *)&frame[len - ECHO_LEN];
+    if ((echo->type == ICMPV6_ECHO_REP) &&
+        (byteorder_ntohs(echo->id) == ECHO_ID) &&
+        (byteorder_ntohs(echo->seq) == ECHO_SEQ) &&
+        (memcmp(echo + 1, ECHO_PAYLOAD, ECHO_PAYLOAD_LEN) == 0)) {
+        mutex_unlock(&_reply);
+    }
+    return (int)len;
+}
+
+static void _dev_isr(netdev_t *dev)
+{
+    dev->event_callback(dev, NETDEV_EVENT_RX_COMPLETE);
+}
+
+static int _dev_recv(netdev_t *dev, char *buf, int len, void *info)
+{
+    int res = (int)_frame_len;
+
+    (void)dev;
+    (void)info;
+    if (buf == NULL) {
+        if (len > 0) {
+            /* frame is dropped */
+            _frame_len = 0;
+        }
+        return res;
+    }
+    if (len < res) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _frame, _frame_len);
+    _frame_len = 0;
+    return res;
+}
+
+static int _dev_get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    if (max_len < sizeof(uint16_t)) {
+        return -ENOBUFS;
+    }
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _dev_get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    if (max_len < sizeof(uint16_t)) {
+        return -ENOBUFS;
+    }
+    *((uint16_t *)value) = MAX_FRAG_SIZE;
+    return sizeof(uint16_t);
+}
+
+static int _dev_get_src_len(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    if (max_len < sizeof(uint16_t)) {
+        return -ENOBUFS;
+    }
+    *((uint16_t *)value) = sizeof(_dev_addr);
+    return sizeof(uint16_t);
+}
+
+static int _dev_get_addr_long(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    if (max_len < sizeof(_dev_addr)) {
+        return -ENOBUFS;
+    }
+    memcpy(value, _dev_addr, sizeof(_dev_addr));
+    return sizeof(_dev_addr);
+}
+
+static void _link_local(ipv6_addr_t *addr, const uint8_t *l2addr)
+{
+    ipv6_addr_set_link_local_prefix(addr);
+    memcpy(&addr->u64[1], l2addr, sizeof(addr->u64[1]));
+    addr->u8[8] ^= 0x02;
+}
+
+/* receives an echo request from the peer to the link-local address of the
+ * interface, sent as uncompressed IPv6 */
+static void _recv_echo_req(void)
+{
+    le_uint16_t pan = byteorder_btols(byteorder_htons(DEV_PAN));
+    ipv6_hdr_t *ipv6;
+    icmpv6_echo_t *echo;
+    uint16_t csum;
+    size_t mhr_len;
+
+    mhr_len = ieee802154_set_frame_hdr(_frame, _peer_addr, sizeof(_peer_addr),
+                                       _dev_addr, sizeof(_dev_addr), pan, pan,
+                                       IEEE802154_FCF_TYPE_DATA, 0);
+    assert(mhr_len > 0);
+    _frame[mhr_len] = SIXLOWPAN_UNCOMP;
+    ipv6 = (ipv6_hdr_t *)&_frame[mhr_len + 1];
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(ECHO_LEN);
+    ipv6->nh = PROTNUM_ICMPV6;
+    ipv6->hl = 64;
+    _link_local(&ipv6->src, _peer_addr);
+    _link_local(&ipv6->dst, _dev_addr);
+    echo = (icmpv6_echo_t *)(ipv6 + 1);
+    echo->type = ICMPV6_ECHO_REQ;
+    echo->code = 0;
+    echo->csum.u16 = 0;
+    echo->id = byteorder_htons(ECHO_ID);
+    echo->seq = byteorder_htons(ECHO_SEQ);
+    memcpy(echo + 1, ECHO_PAYLOAD, ECHO_PAYLOAD_LEN);
+    csum = inet_csum(0, (uint8_t *)echo, ECHO_LEN);
+    csum = ipv6_hdr_inet_csum(csum, ipv6, PROTNUM_ICMPV6, ECHO_LEN);
+    echo->csum = byteorder_htons(~csum);
+    _frame_len = mhr_len + 1 + sizeof(ipv6_hdr_t) + ECHO_LEN;
+    ((netdev_t *)&_dev)->event_callback((netdev_t *)&_dev, NETDEV_EVENT_ISR);
+}
+
+static void test_echo__thread(void)
+{
+    gnrc_netapi_direct_enable(false);
+    _recv_echo_req();
+    assert(xtimer_mutex_lock_timeout(&_reply, REPLY_TIMEOUT) == 0);
+}
+
+static void test_echo__direct(void)
+{
+    gnrc_netapi_direct_enable(true);
+    /* the reply's source address is compressed in the interface thread,
+     * without asking that very thread for its IID */
+    _recv_echo_req();
+    assert(xtimer_mutex_lock_timeout(&_reply, REPLY_TIMEOUT) == 0);
+}
+
+int main(void)
+{
+    netdev_test_setup(&_dev, NULL);
+    _dev.netdev.pan = DEV_PAN;
+    _dev.netdev.proto = GNRC_NETTYPE_SIXLOWPAN;
+    netdev_test_set_send_cb(&_dev, _dev_send);
+    netdev_test_set_recv_cb(&_dev, _dev_recv);
+    netdev_test_set_isr_cb(&_dev, _dev_isr);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _dev_get_device_type);
+    netdev_test_set_get_cb(&_dev, NETOPT_MAX_PACKET_SIZE,
+                           _dev_get_max_packet_size);
+    netdev_test_set_get_cb(&_dev, NETOPT_SRC_LEN, _dev_get_src_len);
+    netdev_test_set_get_cb(&_dev, NETOPT_ADDRESS_LONG, _dev_get_addr_long);
+    gnrc_netif_ieee802154_create(_netif_stack, sizeof(_netif_stack),
+                                 GNRC_NETIF_PRIO, "wpan", (netdev_t *)&_dev);
+
+    CALL(test_echo__thread());
+    CALL(test_echo__direct());
+
+    puts("ALL TESTS SUCCESSFUL");
+    return 0;
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Runs the unit tests of netreg and of the UDP port table with
+ *              the `gnrc_netreg_hash` module
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+
+#include "tests-netreg.h"
+#include "tests-gnrc_udp.h"
+
+int main(void)
+{
+    TESTS_START();
+    tests_netreg();
+    tests_gnrc_udp();
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Fragmentation stress test for the packet buffer implementations
+ *
+ * Keeps a random mix of 6LoWPAN fragments, small control packets and
+ * full-MTU IPv6 packets alive in the packet buffer and releases them in
+ * random order. Build with `PKTBUF=static`, `PKTBUF=slab` or `PKTBUF=malloc`
+ * to compare the implementations.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "net/gnrc/pktbuf.h"
+#include "random.h"
+#include "xtimer.h"
+
+#define SLOTS_NUMOF         (16U)
+#define ROUNDS              (20000U)
+#define SEED                (0x5eed1e55)
+
+#define NETIF_HDR_SIZE      (24U)
+#define FRAG_HDR_SIZE       (5U)
+#define FRAG_MIN_SIZE       (40U)
+#define FRAG_MAX_SIZE       (127U)
+#define CTRL_MIN_SIZE       (24U)
+#define CTRL_MAX_SIZE       (64U)
+#define IPV6_HDR_SIZE       (40U)
+#define IPV6_MTU            (1280U)
+
+#if defined(MODULE_GNRC_PKTBUF_SLAB)
+#define BACKEND             "slab"
+#elif defined(MODULE_GNRC_PKTBUF_MALLOC)
+#define BACKEND             "malloc"
+#else
+#define BACKEND             "static"
+#endif
+
+enum {
+    KIND_FRAG = 0,
+    KIND_CTRL,
+    KIND_MTU,
+    KIND_NUMOF,
+};
+
+static const char *_kind_names[] = { "fragment", "control", "full-MTU" };
+
+static gnrc_pktsnip_t *_slots[SLOTS_NUMOF];
+static unsigned _attempts[KIND_NUMOF];
+static unsigned _successes[KIND_NUMOF];
+
+/* received 6LoWPAN fragment: netif header + frame, fragment header is marked */
+static gnrc_pktsnip_t *_alloc_frag(void)
+{
+    size_t size = random_uint32_range(FRAG_MIN_SIZE, FRAG_MAX_SIZE + 1);
+    gnrc_pktsnip_t *netif, *pkt;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, FRAG_MAX_SIZE, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    /* receive buffer is cut down to the actual frame length */
+    if ((gnrc_pktbuf_realloc_data(pkt, size) != 0) ||
+        (gnrc_pktbuf_mark(pkt, FRAG_HDR_SIZE, GNRC_NETTYPE_UNDEF) == NULL) ||
+        ((netif = gnrc_pktbuf_add(NULL, NULL, NETIF_HDR_SIZE,
+                                  GNRC_NETTYPE_NETIF)) == NULL)) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    LL_APPEND(pkt, netif);
+    return pkt;
+}
+
+static gnrc_pktsnip_t *_alloc_ctrl(void)
+{
+    size_t size = random_uint32_range(CTRL_MIN_SIZE, CTRL_MAX_SIZE + 1);
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_UNDEF);
+    gnrc_pktsnip_t *hdr;
+
+    if (pkt == NULL) {
+        return NULL;
+    }
+    hdr = gnrc_pktbuf_add(pkt, NULL, IPV6_HDR_SIZE, GNRC_NETTYPE_UNDEF);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+    }
+    return hdr;
+}
+
+static gnrc_pktsnip_t *_alloc_mtu(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, IPV6_MTU - IPV6_HDR_SIZE,
+                                          GNRC_NETTYPE_UNDEF);
+    gnrc_pktsnip_t *hdr;
+
+    if (pkt == NULL) {
+        return NULL;
+    }
+    hdr = gnrc_pktbuf_add(pkt, NULL, IPV6_HDR_SIZE, GNRC_NETTYPE_UNDEF);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+    }
+    return hdr;
+}
+
+static gnrc_pktsnip_t *_alloc(void)
+{
+    /* 60% fragments, 30% control packets, 10% full-MTU packets */
+    uint32_t r = random_uint32_range(0, 10);
+    unsigned kind = (r < 6) ? KIND_FRAG : ((r < 9) ? KIND_CTRL : KIND_MTU);
+    gnrc_pktsnip_t *pkt = NULL;
+
+    _attempts[kind]++;
+    switch (kind) {
+        case KIND_FRAG:
+            pkt = _alloc_frag();
+            break;
+        case KIND_CTRL:
+            pkt = _alloc_ctrl();
+            break;
+        default:
+            pkt = _alloc_mtu();
+            break;
+    }
+    if (pkt != NULL) {
+        _successes[kind]++;
+    }
+    return pkt;
+}
+
+int main(void)
+{
+    uint32_t start, duration;
+
+    puts("Start.");
+    printf("backend: %s\n", BACKEND);
+    random_init(SEED);
+    gnrc_pktbuf_init();
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        unsigned slot = random_uint32_range(0, SLOTS_NUMOF);
+
+        if (_slots[slot] != NULL) {
+            gnrc_pktbuf_release(_slots[slot]);
+            _slots[slot] = NULL;
+        }
+        else {
+            _slots[slot] = _alloc();
+        }
+    }
+    for (unsigned i = 0; i < SLOTS_NUMOF; i++) {
+        gnrc_pktbuf_release(_slots[i]);
+        _slots[i] = NULL;
+    }
+    duration = xtimer_now_usec() - start;
+
+    for (unsigned i = 0; i < KIND_NUMOF; i++) {
+        printf("+ %-8s: %u/%u allocated\n", _kind_names[i], _successes[i],
+               _attempts[i]);
+    }
+    printf("+ %" PRIu32 " ns per round\n",
+           (uint32_t)(((uint64_t)duration * 1000) / ROUNDS));
+#ifdef DEVELHELP
+    gnrc_pktbuf_stats();
+#endif
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect_exact("Start.")
+    child.expect('backend: (static|slab|malloc)')
+    for kind in ("fragment", "control ", "full-MTU"):
+        child.expect(r'\+ %s: \d+/\d+ allocated' % kind)
+    child.expect(r'\+ \d+ ns per round')
+    child.expect_exact("Done.")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc, timeout=60))
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the size classes of gnrc_pktbuf_slab
+ *
+ * Runs the unit tests of the packet buffer API and tests of the allocation
+ * from the size classes, including the fallback to bigger classes.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/gnrc/pktbuf.h"
+
+#include "unittests-constants.h"
+#include "tests-pktbuf.h"
+
+/* number of data blocks of all classes together */
+#define DATA_NUMOF      (GNRC_PKTBUF_SLAB_SMALL_NUMOF + \
+                         GNRC_PKTBUF_SLAB_MEDIUM_NUMOF + \
+                         GNRC_PKTBUF_SLAB_LARGE_NUMOF)
+
+#if GNRC_PKTBUF_SLAB_SNIP_NUMOF <= DATA_NUMOF
+#error "tests need a packet snip for every data block and one more"
+#endif
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+}
+
+/* adds numof packets of size bytes, returns the number of successful adds */
+static unsigned _add(unsigned numof, size_t size)
+{
+    unsigned i;
+
+    for (i = 0; i < numof; i++) {
+        if (gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_TEST) == NULL) {
+            break;
+        }
+    }
+    return i;
+}
+
+static void test_pktbuf_slab_add__too_large(void)
+{
+    gnrc_pktsnip_t *pkt;
+
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_LARGE_SIZE + 1,
+                                     GNRC_NETTYPE_TEST));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    pkt = gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_LARGE_SIZE, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_add__fallback(void)
+{
+    /* small data takes blocks of the bigger classes once its class is used up */
+    TEST_ASSERT_EQUAL_INT(DATA_NUMOF, _add(DATA_NUMOF, GNRC_PKTBUF_SLAB_SMALL_SIZE));
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL, 1, GNRC_NETTYPE_TEST));
+    /* packet snips have a class of their own */
+    TEST_ASSERT_NOT_NULL(gnrc_pktbuf_add(NULL, NULL, 0, GNRC_NETTYPE_TEST));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+}
+
+static void test_pktbuf_slab_add__no_fallback_to_smaller(void)
+{
+    const unsigned numof = GNRC_PKTBUF_SLAB_MEDIUM_NUMOF + GNRC_PKTBUF_SLAB_LARGE_NUMOF;
+
+    TEST_ASSERT_EQUAL_INT(numof, _add(numof, GNRC_PKTBUF_SLAB_SMALL_SIZE + 1));
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_SMALL_SIZE + 1,
+                                     GNRC_NETTYPE_TEST));
+    /* the small class is still free */
+    TEST_ASSERT_EQUAL_INT(GNRC_PKTBUF_SLAB_SMALL_NUMOF,
+                          _add(GNRC_PKTBUF_SLAB_SMALL_NUMOF, GNRC_PKTBUF_SLAB_SMALL_SIZE));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+}
+
+static void test_pktbuf_slab_release__fallback(void)
+{
+    const unsigned numof = GNRC_PKTBUF_SLAB_MEDIUM_NUMOF + GNRC_PKTBUF_SLAB_LARGE_NUMOF;
+    gnrc_pktsnip_t *pkt;
+
+    TEST_ASSERT_EQUAL_INT(GNRC_PKTBUF_SLAB_SMALL_NUMOF,
+                          _add(GNRC_PKTBUF_SLAB_SMALL_NUMOF, GNRC_PKTBUF_SLAB_SMALL_SIZE));
+    pkt = gnrc_pktbuf_add(NULL, NULL, 1, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    /* the block goes back to the class it was taken from */
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT_EQUAL_INT(numof, _add(numof, GNRC_PKTBUF_SLAB_MEDIUM_SIZE));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+}
+
+static void test_pktbuf_slab_mark__shared_block(void)
+{
+    const unsigned numof = GNRC_PKTBUF_SLAB_SMALL_NUMOF - 1;
+    gnrc_pktsnip_t *pkt, *hdr;
+
+    TEST_ASSERT_EQUAL_INT(numof, _add(numof, GNRC_PKTBUF_SLAB_SMALL_SIZE));
+    pkt = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16), GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    hdr = gnrc_pktbuf_mark(pkt, 4, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(hdr);
+    /* the header keeps the block in use when the payload is released */
+    pkt->next = NULL;
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING16, hdr->data, 4));
+    /* the block is freed once with the header */
+    gnrc_pktbuf_release(hdr);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT_EQUAL_INT(DATA_NUMOF - numof, _add(DATA_NUMOF, 1));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+}
+
+static void test_pktbuf_slab_realloc_data__shrink_to_smaller(void)
+{
+    gnrc_pktsnip_t *pkt;
+    void *old_data;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_LARGE_SIZE, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    old_data = pkt->data;
+    memcpy(pkt->data, TEST_STRING16, sizeof(TEST_STRING16));
+    /* e.g. a receive buffer cut to the actual frame length */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, sizeof(TEST_STRING16)));
+    TEST_ASSERT(old_data != pkt->data);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16, pkt->data);
+    /* the large block is free again */
+    TEST_ASSERT_EQUAL_INT(GNRC_PKTBUF_SLAB_LARGE_NUMOF,
+                          _add(GNRC_PKTBUF_SLAB_LARGE_NUMOF, GNRC_PKTBUF_SLAB_LARGE_SIZE));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+}
+
+static void test_pktbuf_slab_realloc_data__shrink_shared(void)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+    void *old_data;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_LARGE_SIZE, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    hdr = gnrc_pktbuf_mark(pkt, 8, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(hdr);
+    old_data = pkt->data;
+    /* the block is shared with the header, so the data is not moved */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 8));
+    TEST_ASSERT(old_data == pkt->data);
+    TEST_ASSERT_EQUAL_INT(8, pkt->size);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab_realloc_data__grow(void)
+{
+    gnrc_pktsnip_t *pkt;
+    void *old_data;
+
+    pkt = gnrc_pktbuf_add(NULL, TEST_STRING8, sizeof(TEST_STRING8), GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    old_data = pkt->data;
+    /* grows within its block */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, GNRC_PKTBUF_SLAB_SMALL_SIZE));
+    TEST_ASSERT(old_data == pkt->data);
+    /* moves to a block of the next class */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, GNRC_PKTBUF_SLAB_SMALL_SIZE + 1));
+    TEST_ASSERT(old_data != pkt->data);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING8, pkt->data);
+    TEST_ASSERT_EQUAL_INT(ENOMEM, gnrc_pktbuf_realloc_data(pkt, GNRC_PKTBUF_SLAB_LARGE_SIZE + 1));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static Test *tests_pktbuf_slab_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_pktbuf_slab_add__too_large),
+        new_TestFixture(test_pktbuf_slab_add__fallback),
+        new_TestFixture(test_pktbuf_slab_add__no_fallback_to_smaller),
+        new_TestFixture(test_pktbuf_slab_release__fallback),
+        new_TestFixture(test_pktbuf_slab_mark__shared_block),
+        new_TestFixture(test_pktbuf_slab_realloc_data__shrink_to_smaller),
+        new_TestFixture(test_pktbuf_slab_realloc_data__shrink_shared),
+        new_TestFixture(test_pktbuf_slab_realloc_data__grow),
+    };
+
+    EMB_UNIT_TESTCALLER(pktbuf_slab_tests, set_up, NULL, fixtures);
+
+    return (Test *)&pktbuf_slab_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    tests_pktbuf();
+    TESTS_RUN(tests_pktbuf_slab_tests());
+    TESTS_END();
+
+    return 0;
+}
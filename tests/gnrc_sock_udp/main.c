@@ -651,6 +651,209 @@ static void test_sock_udp_send__no_sock(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_recv_batch__EAGAIN(void)
+{
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_msg_t msgs[] = { { _test_buffer, sizeof(_test_buffer), NULL } };
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(-EAGAIN == sock_udp_recv_batch(&_sock, msgs, 1, 0));
+    assert(_check_net());
+}
+
+static void test_sock_udp_recv_batch__socketed(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t results[3];
+    sock_udp_msg_t msgs[] = {
+        { &_test_buffer[0], 16, &results[0] },
+        { &_test_buffer[16], 16, &results[1] },
+        { &_test_buffer[32], 16, &results[2] },
+    };
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE + 1,
+                          _TEST_PORT_LOCAL, "EFGHIJ", sizeof("EFGHIJ"),
+                          _TEST_NETIF));
+    /* returns when the queued messages are received */
+    assert(2 == sock_udp_recv_batch(&_sock, msgs, 3, SOCK_NO_TIMEOUT));
+    assert(sizeof("ABCD") == msgs[0].len);
+    assert(memcmp(msgs[0].data, "ABCD", sizeof("ABCD")) == 0);
+    assert(_TEST_PORT_REMOTE == results[0].port);
+    assert(sizeof("EFGHIJ") == msgs[1].len);
+    assert(memcmp(msgs[1].data, "EFGHIJ", sizeof("EFGHIJ")) == 0);
+    assert(AF_INET6 == results[1].family);
+    assert(memcmp(&results[1].addr, &src_addr, sizeof(results[1].addr)) == 0);
+    assert(_TEST_PORT_REMOTE + 1 == results[1].port);
+    assert(_TEST_NETIF == results[1].netif);
+    assert(16 == msgs[2].len);
+    assert(_check_net());
+}
+
+static void test_sock_udp_recv_buf(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t result;
+    void *data = NULL, *ctx = NULL;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(sizeof("ABCD") == sock_udp_recv_buf(&_sock, &data, &ctx,
+                                               SOCK_NO_TIMEOUT, &result));
+    assert(data != NULL);
+    assert(ctx != NULL);
+    assert(memcmp(data, "ABCD", sizeof("ABCD")) == 0);
+    assert(AF_INET6 == result.family);
+    assert(memcmp(&result.addr, &src_addr, sizeof(result.addr)) == 0);
+    assert(_TEST_PORT_REMOTE == result.port);
+    assert(_TEST_NETIF == result.netif);
+    /* the packet is held until the end of the data */
+    assert(!_check_net());
+    assert(0 == sock_udp_recv_buf(&_sock, &data, &ctx, SOCK_NO_TIMEOUT,
+                                  NULL));
+    assert(data == NULL);
+    assert(ctx == NULL);
+    assert(_check_net());
+}
+
+static unsigned _cb_count;
+
+static void _recv_cb(sock_udp_t *sock, void *arg)
+{
+    assert(sock == &_sock);
+    assert(arg == &_cb_count);
+    _cb_count++;
+}
+
+static void test_sock_udp_set_cb(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+
+    _cb_count = 0;
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    sock_udp_set_cb(&_sock, _recv_cb, &_cb_count);
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(1 == _cb_count);
+    /* the message is available when the callback is called */
+    assert(sizeof("ABCD") == sock_udp_recv(&_sock, _test_buffer,
+                                           sizeof(_test_buffer), 0, NULL));
+    assert(_check_net());
+}
+
+static void test_sock_udp_send_batch__socketed(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t other_addr = { .u8 = _TEST_ADDR_WRONG };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    sock_udp_ep_t other = { .addr = { .ipv6 = _TEST_ADDR_WRONG },
+                            .family = AF_INET6,
+                            .port = _TEST_PORT_REMOTE + 1 };
+    const sock_udp_msg_t msgs[] = {
+        { "ABCD", sizeof("ABCD"), NULL },
+        { "EFGHIJ", sizeof("EFGHIJ"), &other },
+    };
+
+    assert(0 == sock_udp_create(&_sock, &local, &remote, SOCK_FLAGS_REUSE_EP));
+    assert(2 == sock_udp_send_batch(&_sock, msgs, 2));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                         _TEST_NETIF, false));
+    assert(_check_packet(&src_addr, &other_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE + 1, "EFGHIJ", sizeof("EFGHIJ"),
+                         _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
+static void test_sock_udp_sendv(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    iolist_t tail = { NULL, "EF", sizeof("EF") };
+    iolist_t empty = { &tail, NULL, 0 };
+    iolist_t head = { &empty, "ABCD", sizeof("ABCD") - 1 };
+
+    assert(0 == sock_udp_create(&_sock, &local, &remote, SOCK_FLAGS_REUSE_EP));
+    assert(sizeof("ABCDEF") == sock_udp_sendv(&_sock, &head, NULL));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "ABCDEF", sizeof("ABCDEF"),
+                         _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
+static void test_sock_udp_send_batch__EINVAL_port(void)
+{
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .netif = _TEST_NETIF };
+    const sock_udp_msg_t msgs[] = {
+        { "ABCD", sizeof("ABCD"), (sock_udp_ep_t *)&remote },
+    };
+
+    assert(-EINVAL == sock_udp_send_batch(NULL, msgs, 1));
+    assert(_check_net());
+}
+
+static void test_sock_udp_send_batch__unsocketed_no_local(void)
+{
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .netif = _TEST_NETIF,
+                                          .port = _TEST_PORT_REMOTE };
+    const sock_udp_msg_t msgs[] = {
+        { "ABCD", sizeof("ABCD"), (sock_udp_ep_t *)&remote },
+        { "EFGHIJ", sizeof("EFGHIJ"), (sock_udp_ep_t *)&remote },
+    };
+    sock_udp_ep_t local;
+
+    assert(0 == sock_udp_create(&_sock, NULL, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(2 == sock_udp_send_batch(&_sock, msgs, 2));
+    assert(_check_packet(&ipv6_addr_unspecified, &dst_addr, 0,
+                         _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"), _TEST_NETIF,
+                         true));
+    assert(_check_packet(&ipv6_addr_unspecified, &dst_addr, 0,
+                         _TEST_PORT_REMOTE, "EFGHIJ", sizeof("EFGHIJ"),
+                         _TEST_NETIF, true));
+    /* the first message bound the sock */
+    assert(0 == sock_udp_get_local(&_sock, &local));
+    assert(0 != local.port);
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
 int main(void)
 {
     _net_init();
@@ -680,6 +883,10 @@ int main(void)
     CALL(test_sock_udp_recv__unsocketed_with_remote());
     CALL(test_sock_udp_recv__with_timeout());
     CALL(test_sock_udp_recv__non_blocking());
+    CALL(test_sock_udp_recv_batch__EAGAIN());
+    CALL(test_sock_udp_recv_batch__socketed());
+    CALL(test_sock_udp_recv_buf());
+    CALL(test_sock_udp_set_cb());
     _prepare_send_checks();
     CALL(test_sock_udp_send__EAFNOSUPPORT());
     CALL(test_sock_udp_send__EINVAL_addr());
@@ -697,6 +904,10 @@ int main(void)
     CALL(test_sock_udp_send__unsocketed());
     CALL(test_sock_udp_send__no_sock_no_netif());
     CALL(test_sock_udp_send__no_sock());
+    CALL(test_sock_udp_send_batch__socketed());
+    CALL(test_sock_udp_send_batch__EINVAL_port());
+    CALL(test_sock_udp_send_batch__unsocketed_no_local());
+    CALL(test_sock_udp_sendv());
 
     puts("ALL TESTS SUCCESSFUL");
 
@@ -49,6 +49,9 @@ def testfunc(child):
     child.expect_exact(u"Calling test_sock_udp_send__unsocketed()")
     child.expect_exact(u"Calling test_sock_udp_send__no_sock_no_netif()")
     child.expect_exact(u"Calling test_sock_udp_send__no_sock()")
+    child.expect_exact(u"Calling test_sock_udp_send_batch__socketed()")
+    child.expect_exact(u"Calling test_sock_udp_send_batch__EINVAL_port()")
+    child.expect_exact(u"Calling test_sock_udp_send_batch__unsocketed_no_local()")
     child.expect_exact(u"ALL TESTS SUCCESSFUL")
 
 
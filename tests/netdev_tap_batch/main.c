@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput test for batched frame reception of netdev_tap
+ *
+ * Sends bursts of frames from the second TAP interface to the first one
+ * and prints the throughput and the receive batch statistics of the first
+ * interface.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "msg.h"
+#include "net/ethernet.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/netstats.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define BURSTS_NUMOF        (64U)
+#define BURST_LEN           (32U)
+#define PAYLOAD_LEN         (1024U)
+#define BURST_TIMEOUT       (500U * US_PER_MS)
+#define MAGIC               "netdev_tap_batch"
+
+#define MAIN_QUEUE_SIZE     (64U)
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+
+static int _send_frame(gnrc_netif_t *netif, uint8_t *dst)
+{
+    gnrc_pktsnip_t *payload, *pkt;
+
+    payload = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_LEN, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return -1;
+    }
+    memset(payload->data, 0, PAYLOAD_LEN);
+    memcpy(payload->data, MAGIC, sizeof(MAGIC));
+    pkt = gnrc_netif_hdr_build(NULL, 0, dst, ETHERNET_ADDR_LEN);
+    if (pkt == NULL) {
+        gnrc_pktbuf_release(payload);
+        return -1;
+    }
+    LL_APPEND(pkt, payload);
+    if (gnrc_netapi_send(netif->pid, pkt) < 1) {
+        gnrc_pktbuf_release(pkt);
+        return -1;
+    }
+    return 0;
+}
+
+/* returns the number of test frames received until timeout or count */
+static unsigned _recv_frames(unsigned count)
+{
+    unsigned received = 0;
+    msg_t msg;
+
+    while ((received < count) &&
+           (xtimer_msg_receive_timeout(&msg, BURST_TIMEOUT) >= 0)) {
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            gnrc_pktsnip_t *pkt = msg.content.ptr;
+
+            /* the host may send its own frames to the interface */
+            if ((pkt->size >= sizeof(MAGIC)) &&
+                (memcmp(pkt->data, MAGIC, sizeof(MAGIC)) == 0)) {
+                received++;
+            }
+            gnrc_pktbuf_release(pkt);
+        }
+    }
+    return received;
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(
+                                    GNRC_NETREG_DEMUX_CTX_ALL,
+                                    sched_active_pid
+                                );
+    gnrc_netif_t *rx_netif, *tx_netif;
+    uint8_t dst[ETHERNET_ADDR_LEN];
+    netstats_t *stats;
+    uint32_t start, duration;
+    unsigned received = 0;
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    puts("Start.");
+    rx_netif = gnrc_netif_iter(NULL);
+    tx_netif = gnrc_netif_iter(rx_netif);
+    if ((rx_netif == NULL) || (tx_netif == NULL)) {
+        puts("Two interfaces required, run with PORT=\"tap0 tap1\"");
+        return 1;
+    }
+    if (gnrc_netapi_get(rx_netif->pid, NETOPT_ADDRESS, 0, dst,
+                        sizeof(dst)) != sizeof(dst)) {
+        puts("Unable to get address of receiving interface");
+        return 1;
+    }
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entry);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < BURSTS_NUMOF; i++) {
+        unsigned sent = 0;
+
+        for (unsigned j = 0; j < BURST_LEN; j++) {
+            if (_send_frame(tx_netif, dst) == 0) {
+                sent++;
+            }
+        }
+        received += _recv_frames(sent);
+    }
+    duration = xtimer_now_usec() - start;
+    gnrc_netreg_unregister(GNRC_NETTYPE_UNDEF, &entry);
+
+    printf("+ %u/%u frames received\n", received, BURSTS_NUMOF * BURST_LEN);
+    printf("+ %" PRIu32 " frames/s\n",
+           (uint32_t)(((uint64_t)received * US_PER_SEC) / duration));
+    if (gnrc_netapi_get(rx_netif->pid, NETOPT_STATS, NETSTATS_LAYER2, &stats,
+                        sizeof(&stats)) < 0) {
+        puts("Unable to get statistics of receiving interface");
+        return 1;
+    }
+    printf("+ RX batches %u (max. %u frames)\n",
+           (unsigned)stats->rx_batches, (unsigned)stats->rx_batch_max);
+    puts("Done.");
+    return 0;
+}
@@ -17,6 +17,8 @@ def testfunc(child):
     child.expect_exact(' + succeeded.')
     child.expect_exact('Executing test_receive()')
     child.expect_exact(' + succeeded.')
+    child.expect_exact('Executing test_receive_iolist()')
+    child.expect_exact(' + succeeded.')
     child.expect_exact('Executing test_set_addr()')
     child.expect_exact(' + succeeded.')
     child.expect_exact('ALL TESTS SUCCESSFUL')
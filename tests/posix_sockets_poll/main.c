@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for poll() and non-blocking receives on sockets
+ *
+ * Polls two UDP sockets, and sends datagrams to them via the loopback
+ * interface. Then polls a TCP listening socket and the connection accepted
+ * from it, while a client connects, sends and closes via the loopback
+ * interface.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "assert.h"
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define PORT                (6000U)
+#define TCP_PORT            (PORT + 2)
+/* in milliseconds, as for poll() */
+#define POLL_TIMEOUT        (100U)
+#define SEND_DELAY          (50U * US_PER_MS)
+
+#define CALL(fn)            puts("Calling " # fn); fn; tear_down()
+
+static char _sender_stack[THREAD_STACKSIZE_DEFAULT];
+static char _poller_stack[THREAD_STACKSIZE_DEFAULT];
+static char _client_stack[THREAD_STACKSIZE_DEFAULT];
+static int _socks[2];
+static int _sender;
+static int _listener;
+static int _conn;
+static volatile int _poller_res;
+/* unlocked for each step of the TCP client */
+static mutex_t _client_step = MUTEX_INIT_LOCKED;
+static struct pollfd _fds[2];
+static char _buf[16];
+
+static void _send(unsigned idx)
+{
+    struct sockaddr_in6 dst = { .sin6_family = AF_INET6,
+                                .sin6_port = htons(PORT + idx) };
+
+    memcpy(&dst.sin6_addr, &in6addr_loopback, sizeof(dst.sin6_addr));
+    ssize_t res = sendto(_sender, "ABCD", sizeof("ABCD"), 0,
+                         (struct sockaddr *)&dst, sizeof(dst));
+    assert(res == sizeof("ABCD"));
+    (void)res;
+}
+
+static void *_sender_thread(void *arg)
+{
+    xtimer_usleep(SEND_DELAY);
+    _send((unsigned)(uintptr_t)arg);
+    return NULL;
+}
+
+static void *_poller_thread(void *arg)
+{
+    struct pollfd fd = { .fd = _socks[0], .events = POLLIN };
+
+    (void)arg;
+    _poller_res = poll(&fd, 1, POLL_TIMEOUT);
+    return NULL;
+}
+
+/* connects to the TCP listener, then sends and closes step by step */
+static void *_client_thread(void *arg)
+{
+    struct sockaddr_in6 dst = { .sin6_family = AF_INET6,
+                                .sin6_port = htons(TCP_PORT) };
+    int client = socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
+
+    (void)arg;
+    assert(client >= 0);
+    memcpy(&dst.sin6_addr, &in6addr_loopback, sizeof(dst.sin6_addr));
+    assert(connect(client, (struct sockaddr *)&dst, sizeof(dst)) == 0);
+    mutex_lock(&_client_step);
+    assert(send(client, "ABCD", sizeof("ABCD"), 0) == sizeof("ABCD"));
+    mutex_lock(&_client_step);
+    close(client);
+    return NULL;
+}
+
+static void tear_down(void)
+{
+    for (unsigned i = 0; i < 2; i++) {
+        while (recv(_socks[i], _buf, sizeof(_buf), MSG_DONTWAIT) > 0) {}
+    }
+}
+
+static void test_poll__timeout(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    assert(poll(_fds, 2, POLL_TIMEOUT) == 0);
+    assert((xtimer_now_usec() - start) >= (POLL_TIMEOUT * US_PER_MS));
+    assert(_fds[0].revents == 0);
+    assert(_fds[1].revents == 0);
+}
+
+static void test_poll__ready(void)
+{
+    _send(1);
+    /* waits for the datagram to pass the stack */
+    assert(poll(_fds, 2, POLL_TIMEOUT) == 1);
+    assert(_fds[0].revents == 0);
+    assert(_fds[1].revents == POLLIN);
+    /* stays ready until the datagram is read */
+    assert(poll(_fds, 2, 0) == 1);
+    assert(recv(_socks[1], _buf, sizeof(_buf), 0) == sizeof("ABCD"));
+    assert(poll(_fds, 2, 0) == 0);
+}
+
+static void test_poll__wakeup(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    thread_create(_sender_stack, sizeof(_sender_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _sender_thread, (void *)0, "sender");
+    /* without timeout */
+    assert(poll(_fds, 2, -1) == 1);
+    assert((xtimer_now_usec() - start) >= SEND_DELAY);
+    assert(_fds[0].revents == POLLIN);
+    assert(_fds[1].revents == 0);
+    assert(recv(_socks[0], _buf, sizeof(_buf), 0) == sizeof("ABCD"));
+}
+
+static void test_poll__two_pollers(void)
+{
+    _poller_res = -1;
+    thread_create(_poller_stack, sizeof(_poller_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _poller_thread, NULL, "poller");
+    thread_create(_sender_stack, sizeof(_sender_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _sender_thread, (void *)0, "sender");
+    assert(poll(_fds, 2, -1) == 1);
+    assert(_fds[0].revents == POLLIN);
+    /* the other thread polling the socket was woken up as well */
+    assert(_poller_res == 1);
+    assert(recv(_socks[0], _buf, sizeof(_buf), 0) == sizeof("ABCD"));
+}
+
+static void test_poll__tcp_accept(void)
+{
+    struct pollfd fd = { .fd = _listener, .events = POLLIN };
+
+    assert(poll(&fd, 1, 0) == 0);
+    thread_create(_client_stack, sizeof(_client_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _client_thread, NULL, "client");
+    assert(poll(&fd, 1, POLL_TIMEOUT) == 1);
+    assert(fd.revents == POLLIN);
+    assert((_conn = accept(_listener, NULL, NULL)) >= 0);
+    assert(poll(&fd, 1, 0) == 0);
+}
+
+static void test_poll__tcp_recv(void)
+{
+    struct pollfd fd = { .fd = _conn, .events = POLLIN | POLLOUT };
+
+    assert(poll(&fd, 1, 0) == 1);
+    assert(fd.revents == POLLOUT);
+    fd.events = POLLIN;
+    mutex_unlock(&_client_step);
+    assert(poll(&fd, 1, POLL_TIMEOUT) == 1);
+    assert(fd.revents == POLLIN);
+    assert(recv(_conn, _buf, sizeof(_buf), 0) == sizeof("ABCD"));
+    assert(poll(&fd, 1, 0) == 0);
+}
+
+static void test_poll__tcp_close(void)
+{
+    struct pollfd fd = { .fd = _conn, .events = POLLIN };
+
+    mutex_unlock(&_client_step);
+    /* the end of the stream is read without blocking */
+    assert(poll(&fd, 1, POLL_TIMEOUT) == 1);
+    assert(fd.revents == POLLIN);
+    assert(recv(_conn, _buf, sizeof(_buf), 0) == 0);
+    close(_conn);
+}
+
+static void test_recv__MSG_DONTWAIT(void)
+{
+    assert(recv(_socks[0], _buf, sizeof(_buf), MSG_DONTWAIT) == -1);
+    assert(errno == EAGAIN);
+}
+
+static void test_recv__O_NONBLOCK(void)
+{
+    assert(fcntl(_socks[0], F_SETFL, O_NONBLOCK) == 0);
+    assert(recv(_socks[0], _buf, sizeof(_buf), 0) == -1);
+    assert(errno == EAGAIN);
+    assert(fcntl(_socks[0], F_SETFL, 0) == 0);
+}
+
+int main(void)
+{
+    struct sockaddr_in6 tcp_local = { .sin6_family = AF_INET6,
+                                      .sin6_port = htons(TCP_PORT) };
+
+    for (unsigned i = 0; i < 2; i++) {
+        struct sockaddr_in6 local = { .sin6_family = AF_INET6,
+                                      .sin6_port = htons(PORT + i) };
+
+        _socks[i] = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+        if ((_socks[i] < 0) ||
+            (bind(_socks[i], (struct sockaddr *)&local, sizeof(local)) < 0)) {
+            puts("error: can't create sockets");
+            return 1;
+        }
+        _fds[i].fd = _socks[i];
+        _fds[i].events = POLLIN;
+    }
+    if ((_sender = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP)) < 0) {
+        puts("error: can't create sockets");
+        return 1;
+    }
+    if (((_listener = socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP)) < 0) ||
+        (bind(_listener, (struct sockaddr *)&tcp_local,
+              sizeof(tcp_local)) < 0) ||
+        (listen(_listener, 1) < 0)) {
+        puts("error: can't create sockets");
+        return 1;
+    }
+
+    CALL(test_poll__timeout());
+    CALL(test_poll__ready());
+    CALL(test_poll__wakeup());
+    CALL(test_poll__two_pollers());
+    CALL(test_poll__tcp_accept());
+    CALL(test_poll__tcp_recv());
+    CALL(test_poll__tcp_close());
+    CALL(test_recv__MSG_DONTWAIT());
+    CALL(test_recv__O_NONBLOCK());
+
+    puts("ALL TESTS SUCCESSFUL");
+    return 0;
+}
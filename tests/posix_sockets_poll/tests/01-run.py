@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect_exact("Calling test_poll__timeout()")
+    child.expect_exact("Calling test_poll__ready()")
+    child.expect_exact("Calling test_poll__wakeup()")
+    child.expect_exact("Calling test_poll__two_pollers()")
+    child.expect_exact("Calling test_poll__tcp_accept()")
+    child.expect_exact("Calling test_poll__tcp_recv()")
+    child.expect_exact("Calling test_poll__tcp_close()")
+    child.expect_exact("Calling test_recv__MSG_DONTWAIT()")
+    child.expect_exact("Calling test_recv__O_NONBLOCK()")
+    child.expect_exact("ALL TESTS SUCCESSFUL")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc, timeout=120))
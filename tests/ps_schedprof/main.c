@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief ps schedprof test app
+ *
+ * Fills the message queue of a thread up to a known level and lets a timer
+ * wake up another thread a known number of times, so that `ps` and
+ * `schedprof` have something to show.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define QUEUE_SIZE      (8U)
+#define QUEUED_NUMOF    (5U)
+#define WAKEUPS_NUMOF   (10U)
+#define WAKEUP_INTERVAL (10U * US_PER_MS)
+
+static char _stack_queue[THREAD_STACKSIZE_DEFAULT];
+static char _stack_wakeup[THREAD_STACKSIZE_DEFAULT];
+static msg_t _queue[QUEUE_SIZE];
+
+static void *_queue_fn(void *arg)
+{
+    msg_t msg;
+
+    (void)arg;
+    msg_init_queue(_queue, QUEUE_SIZE);
+    /* wait for main to fill the queue */
+    thread_sleep();
+    while (1) {
+        msg_receive(&msg);
+    }
+    return NULL;
+}
+
+static void *_wakeup_fn(void *arg)
+{
+    (void)arg;
+
+    for (unsigned i = 0; i < WAKEUPS_NUMOF; i++) {
+        xtimer_usleep(WAKEUP_INTERVAL);
+    }
+    /* stay in the thread list */
+    thread_sleep();
+    return NULL;
+}
+
+int main(void)
+{
+    kernel_pid_t pid;
+
+    pid = thread_create(_stack_queue, sizeof(_stack_queue),
+                        THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                        _queue_fn, NULL, "queue");
+    for (unsigned i = 0; i < QUEUED_NUMOF; i++) {
+        msg_t msg = { .type = i };
+        msg_try_send(&msg, pid);
+    }
+    thread_wakeup(pid);
+    thread_create(_stack_wakeup, sizeof(_stack_wakeup),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _wakeup_fn, NULL, "wakeup");
+    xtimer_usleep(2 * WAKEUPS_NUMOF * WAKEUP_INTERVAL);
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(NULL, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+THREAD = r'thread,%d,%s,\d+,\d+,%s,\d+,\d+,\d+,\d+,%d,%d'
+
+
+def _check_ps(child):
+    child.sendline('ps')
+    child.expect(r'\| runtime  \| switches \| lat max    avg \| irqoff max '
+                 r'\| msgq')
+    child.expect(r'\t  3 \| queue .* \|    5')
+
+
+def _check_schedprof(child):
+    child.sendline('schedprof')
+    child.expect_exact('#thread,pid,name,runtime_us,switches,wakeups,'
+                       'lat_max_us,lat_avg_us,irq_off_us,irq_off_max_us,'
+                       'msgq_max,msgq_size')
+    child.expect(THREAD % (1, 'idle', r'\d+', 0, 0))
+    child.expect(THREAD % (2, 'main', r'\d+', 0, 0))
+    child.expect(THREAD % (3, 'queue', r'\d+', 5, 8))
+    # created, woken up by each timer and by nothing else
+    child.expect(THREAD % (4, 'wakeup', '11', 0, 0))
+    child.expect_exact('#irq,isr_count,isr_us,isr_max_us,irq_off_us,'
+                       'irq_off_max_us')
+    child.expect(r'irq,\d+,\d+,\d+,\d+,\d+')
+
+
+def _check_reset(child):
+    child.sendline('schedprof reset')
+    child.sendline('schedprof')
+    child.expect(THREAD % (3, 'queue', r'\d+', 0, 8))
+
+
+def testfunc(child):
+    _check_ps(child)
+    _check_schedprof(child)
+    _check_reset(child)
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
@@ -21,7 +21,9 @@
 
 #define TEST_FIB_TABLE_SIZE (20)
 static fib_entry_t _entries[TEST_FIB_TABLE_SIZE];
+static fib_trie_node_t _trie_nodes[FIB_TRIE_NODES_NUMOF(TEST_FIB_TABLE_SIZE)];
 static fib_table_t test_fib_table = { .data.entries = _entries,
+                                      .trie_nodes = _trie_nodes,
                                       .table_type = FIB_TABLE_TYPE_SH,
                                       .size = TEST_FIB_TABLE_SIZE,
                                       .mtx_access = MUTEX_INIT,
@@ -976,6 +978,210 @@ static void test_fib_20_replace_prefix(void)
     fib_deinit(&test_fib_table);
 }
 
+/*
+* @brief testing longest prefix match with nested prefixes
+* It is expected to always get the next hop of the longest matching prefix,
+* also after removing some of the prefixes
+*/
+static void test_fib_21_longest_prefix_match(void)
+{
+    size_t add_buf_size = 16;
+    uint8_t addr_dst[add_buf_size];
+    uint8_t addr_nxt[add_buf_size];
+    uint8_t addr_lookup[add_buf_size];
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+    /* prefix lengths of the nested routes, 0 is the default route */
+    static const uint8_t prefix_lens[] = { 0, 16, 32, 48, 56 };
+
+    memset(addr_dst, 0, add_buf_size);
+    memset(addr_nxt, 0, add_buf_size);
+
+    for (size_t i = 0; i < sizeof(prefix_lens); ++i) {
+        memset(addr_dst, 0, add_buf_size);
+        for (size_t j = 0; j < (prefix_lens[i] / 8U); j++) {
+            addr_dst[j] = j + 1;
+        }
+        addr_nxt[0] = prefix_lens[i];
+        fib_add_entry(&test_fib_table, 42, addr_dst, add_buf_size,
+                      ((uint32_t)prefix_lens[i] << FIB_FLAG_NET_PREFIX_SHIFT),
+                      addr_nxt, add_buf_size, 0x23, 100000);
+    }
+
+    TEST_ASSERT_EQUAL_INT(5, fib_get_num_used_entries(&test_fib_table));
+
+    /* match the destination with 1..n leading bytes of the prefixes */
+    for (size_t i = 0; i < 8; i++) {
+        uint8_t expect = 0;
+
+        memset(addr_lookup, 0xff, add_buf_size);
+        for (size_t j = 0; j < i; j++) {
+            addr_lookup[j] = j + 1;
+        }
+        for (size_t j = 0; j < sizeof(prefix_lens); ++j) {
+            if (prefix_lens[j] <= (i * 8U)) {
+                expect = prefix_lens[j];
+            }
+        }
+
+        add_buf_size = 16;
+        TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_table, &iface_id,
+                                                  addr_nxt, &add_buf_size,
+                                                  &next_hop_flags, addr_lookup,
+                                                  add_buf_size, 0x23));
+        TEST_ASSERT_EQUAL_INT(expect, addr_nxt[0]);
+    }
+
+    /* remove the /48 prefix, so the /32 prefix must take over */
+    memset(addr_dst, 0, add_buf_size);
+    for (size_t j = 0; j < 6; j++) {
+        addr_dst[j] = j + 1;
+    }
+    fib_remove_entry(&test_fib_table, addr_dst, add_buf_size);
+    TEST_ASSERT_EQUAL_INT(4, fib_get_num_used_entries(&test_fib_table));
+
+    memset(addr_lookup, 0xff, add_buf_size);
+    for (size_t j = 0; j < 6; j++) {
+        addr_lookup[j] = j + 1;
+    }
+    TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_table, &iface_id,
+                                              addr_nxt, &add_buf_size,
+                                              &next_hop_flags, addr_lookup,
+                                              add_buf_size, 0x23));
+    TEST_ASSERT_EQUAL_INT(32, addr_nxt[0]);
+
+    /* the /56 prefix is still reachable */
+    addr_lookup[6] = 7;
+    add_buf_size = 16;
+    TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_table, &iface_id,
+                                              addr_nxt, &add_buf_size,
+                                              &next_hop_flags, addr_lookup,
+                                              add_buf_size, 0x23));
+    TEST_ASSERT_EQUAL_INT(56, addr_nxt[0]);
+
+    /* without a default route unrelated destinations are unreachable */
+    memset(addr_dst, 0, add_buf_size);
+    fib_remove_entry(&test_fib_table, addr_dst, add_buf_size);
+    memset(addr_lookup, 0xff, add_buf_size);
+    add_buf_size = 16;
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH,
+                          fib_get_next_hop(&test_fib_table, &iface_id,
+                                           addr_nxt, &add_buf_size,
+                                           &next_hop_flags, addr_lookup,
+                                           add_buf_size, 0x23));
+
+#if (TEST_FIB_SHOW_OUTPUT == 1)
+    fib_print_routes(&test_fib_table);
+    puts("");
+#endif
+    fib_deinit(&test_fib_table);
+}
+
+/*
+* @brief testing entries with expired lifetime
+* It is expected that an expired entry is not used anymore and its slot is
+* given back
+*/
+static void test_fib_22_lifetime_expired(void)
+{
+    size_t add_buf_size = 16;
+    char addr_dst[] = "Test address221";
+    char addr_nxt[] = "Test address222";
+    char addr_lookup[add_buf_size];
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_table, 42,
+                                           (uint8_t *)addr_dst, add_buf_size - 1,
+                                           0x22, (uint8_t *)addr_nxt,
+                                           add_buf_size - 1, 0x22, 1));
+    TEST_ASSERT_EQUAL_INT(1, fib_get_num_used_entries(&test_fib_table));
+
+    xtimer_usleep(10 * US_PER_MS);
+
+    memcpy(addr_lookup, addr_dst, add_buf_size);
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH,
+                          fib_get_next_hop(&test_fib_table, &iface_id,
+                                           (uint8_t *)addr_nxt, &add_buf_size,
+                                           &next_hop_flags,
+                                           (uint8_t *)addr_lookup,
+                                           add_buf_size - 1, 0x22));
+    TEST_ASSERT_EQUAL_INT(0, fib_get_num_used_entries(&test_fib_table));
+    TEST_ASSERT_EQUAL_INT(0, universal_address_get_num_used_entries());
+
+    fib_deinit(&test_fib_table);
+}
+
+/*
+* @brief testing two entries for the same prefix with different next hops
+* It is expected that both entries are kept, that the entry added first is
+* used for the prefix and that the other one takes over once it is removed
+*/
+static void test_fib_23_same_prefix(void)
+{
+    size_t add_buf_size = 16;
+    uint8_t addr_dst[add_buf_size];
+    uint8_t addr_nxt[add_buf_size];
+    uint8_t addr_lookup[add_buf_size];
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+    uint32_t prefix_flags = ((uint32_t)32 << FIB_FLAG_NET_PREFIX_SHIFT);
+
+    /* 2001:db8::1/32 via next hop 1 and 2001:db8::2/32 via next hop 2 */
+    for (uint8_t i = 1; i <= 2; i++) {
+        memset(addr_dst, 0, add_buf_size);
+        memset(addr_nxt, 0, add_buf_size);
+        addr_dst[0] = 0x20;
+        addr_dst[1] = 0x01;
+        addr_dst[2] = 0x0d;
+        addr_dst[3] = 0xb8;
+        addr_dst[15] = i;
+        addr_nxt[0] = i;
+        TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_table, 42, addr_dst,
+                                               add_buf_size, prefix_flags,
+                                               addr_nxt, add_buf_size, 0x23,
+                                               100000));
+    }
+
+    TEST_ASSERT_EQUAL_INT(2, fib_get_num_used_entries(&test_fib_table));
+
+    /* the exact addresses still resolve to their own next hop */
+    add_buf_size = 16;
+    TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_table, &iface_id,
+                                              addr_nxt, &add_buf_size,
+                                              &next_hop_flags, addr_dst,
+                                              add_buf_size, 0x23));
+    TEST_ASSERT_EQUAL_INT(2, addr_nxt[0]);
+
+    /* other addresses of the prefix use the entry added first */
+    memcpy(addr_lookup, addr_dst, add_buf_size);
+    addr_lookup[15] = 0x42;
+    add_buf_size = 16;
+    TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_table, &iface_id,
+                                              addr_nxt, &add_buf_size,
+                                              &next_hop_flags, addr_lookup,
+                                              add_buf_size, 0x23));
+    TEST_ASSERT_EQUAL_INT(1, addr_nxt[0]);
+
+    /* remove the first entry, so the second one must take over */
+    addr_dst[15] = 1;
+    fib_remove_entry(&test_fib_table, addr_dst, add_buf_size);
+    TEST_ASSERT_EQUAL_INT(1, fib_get_num_used_entries(&test_fib_table));
+
+    add_buf_size = 16;
+    TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_table, &iface_id,
+                                              addr_nxt, &add_buf_size,
+                                              &next_hop_flags, addr_lookup,
+                                              add_buf_size, 0x23));
+    TEST_ASSERT_EQUAL_INT(2, addr_nxt[0]);
+
+#if (TEST_FIB_SHOW_OUTPUT == 1)
+    fib_print_routes(&test_fib_table);
+    puts("");
+#endif
+    fib_deinit(&test_fib_table);
+}
+
 Test *tests_fib_tests(void)
 {
     fib_init(&test_fib_table);
@@ -1000,6 +1206,9 @@ Test *tests_fib_tests(void)
                         new_TestFixture(test_fib_18_get_next_hop_invalid_parameters),
                         new_TestFixture(test_fib_19_default_gateway),
                         new_TestFixture(test_fib_20_replace_prefix),
+                        new_TestFixture(test_fib_21_longest_prefix_match),
+                        new_TestFixture(test_fib_22_lifetime_expired),
+                        new_TestFixture(test_fib_23_same_prefix),
     };
 
     EMB_UNIT_TESTCALLER(fib_tests, NULL, NULL, fixtures);
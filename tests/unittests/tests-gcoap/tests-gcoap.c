@@ -124,6 +124,40 @@ static void test_gcoap__client_get_resp(void)
     }
 }
 
+/*
+ * Client GET request with a Block2 option, but without a query string.
+ * Test that the request parses back with the same block.
+ */
+static void test_gcoap__client_get_block2_req(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu, parsed;
+    coap_block_t block = { .num = 2, .szx = 2, .more = false };
+    coap_block_t parsed_block = { 0 };
+    char path[] = "/large";
+
+    gcoap_req_init(&pdu, &buf[0], GCOAP_PDU_BUF_SIZE, COAP_METHOD_GET,
+                   &path[0]);
+    coap_set_block2(&pdu, &block);
+    ssize_t len = gcoap_finish(&pdu, 0, COAP_FORMAT_NONE);
+
+    /* Uri-Path "large", then Block2 with delta 12 */
+    uint8_t options[] = { 0xb5, 0x6c, 0x61, 0x72, 0x67, 0x65, 0xc1, 0x22 };
+
+    TEST_ASSERT_EQUAL_INT(4 + GCOAP_TOKENLEN + sizeof(options), len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&buf[4 + GCOAP_TOKENLEN], options,
+                                    sizeof(options)));
+
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&parsed, &buf[0], len));
+    TEST_ASSERT_EQUAL_STRING(&path[0], (char *)&parsed.url[0]);
+    TEST_ASSERT_EQUAL_STRING("", (char *)&parsed.qs[0]);
+    TEST_ASSERT(coap_get_block2(&parsed, &parsed_block));
+    TEST_ASSERT_EQUAL_INT(block.num, parsed_block.num);
+    TEST_ASSERT_EQUAL_INT(block.szx, parsed_block.szx);
+    TEST_ASSERT(!parsed_block.more);
+    TEST_ASSERT(!coap_get_block1(&parsed, &parsed_block));
+}
+
 /*
  * Helper for server_get tests below.
  * Request from libcoap example for gcoap_cli /cli/stats resource
@@ -283,6 +317,7 @@ Test *tests_gcoap_tests(void)
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_gcoap__client_get_req),
         new_TestFixture(test_gcoap__client_get_resp),
+        new_TestFixture(test_gcoap__client_get_block2_req),
         new_TestFixture(test_gcoap__server_get_req),
         new_TestFixture(test_gcoap__server_get_resp),
         new_TestFixture(test_gcoap__server_con_req),
@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp/tcb.h"
+#include "internal/rcvbuf.h"
+
+#include "tests-gnrc_tcp.h"
+
+/* sequence numbers wrap around during the tests */
+#define ISS             (0xfffffffaU)
+#define WND             (64U)
+
+static const char _data[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+static gnrc_tcp_tcb_t _tcb;
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    memset(&_tcb, 0, sizeof(_tcb));
+    _tcb.rcv_nxt = ISS;
+    _tcb.rcv_wnd = WND;
+}
+
+static void tear_down(void)
+{
+    _rcvbuf_clear(&_tcb);
+}
+
+/* adds _data[off..off+len) as a segment; the buffer holds its own reference */
+static int _add(uint32_t off, uint32_t len)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, (void *)&_data[off], len,
+                                          GNRC_NETTYPE_UNDEF);
+    int res;
+
+    if (pkt == NULL) {
+        return -ENOBUFS;
+    }
+    res = _rcvbuf_add(&_tcb, pkt, ISS + off, len);
+    gnrc_pktbuf_release(pkt);
+    return res;
+}
+
+/* reads all readable data and compares it with _data[off..off+len); the
+ * packets of all segments read are released */
+static void _check_read(uint32_t off, uint32_t len)
+{
+    char buf[sizeof(_data)];
+
+    TEST_ASSERT_EQUAL_INT(len, _rcvbuf_get_avail(&_tcb));
+    TEST_ASSERT_EQUAL_INT(len, _rcvbuf_get(&_tcb, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, &_data[off], len));
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_avail(&_tcb));
+    if (_tcb.rcv_buf_num == 0) {
+        TEST_ASSERT(gnrc_pktbuf_is_empty());
+    }
+}
+
+static void test_rcvbuf_add__in_order(void)
+{
+    TEST_ASSERT_EQUAL_INT(4, _add(0, 4));
+    TEST_ASSERT_EQUAL_INT(4, _add(4, 4));
+    TEST_ASSERT_EQUAL_INT(ISS + 8, _tcb.rcv_nxt);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_BUF_SIZE - 8, _rcvbuf_get_free(&_tcb));
+    _check_read(0, 8);
+}
+
+static void test_rcvbuf_add__out_of_order(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _add(8, 4));
+    TEST_ASSERT_EQUAL_INT(0, _add(4, 4));
+    TEST_ASSERT_EQUAL_INT(ISS, _tcb.rcv_nxt);
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_avail(&_tcb));
+    /* filling the gap makes all segments readable */
+    TEST_ASSERT_EQUAL_INT(12, _add(0, 4));
+    TEST_ASSERT_EQUAL_INT(ISS + 12, _tcb.rcv_nxt);
+    _check_read(0, 12);
+}
+
+static void test_rcvbuf_add__duplicate(void)
+{
+    TEST_ASSERT_EQUAL_INT(4, _add(0, 4));
+    TEST_ASSERT_EQUAL_INT(0, _add(8, 4));
+    /* already received in order, and out of order */
+    TEST_ASSERT_EQUAL_INT(0, _add(0, 4));
+    TEST_ASSERT_EQUAL_INT(0, _add(8, 4));
+    TEST_ASSERT_EQUAL_INT(2, _tcb.rcv_buf_num);
+    /* partially received before */
+    TEST_ASSERT_EQUAL_INT(8, _add(2, 6));
+    _check_read(0, 12);
+}
+
+static void test_rcvbuf_add__overlap_prev(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _add(4, 4));
+    /* the first two bytes are held by the previous segment */
+    TEST_ASSERT_EQUAL_INT(0, _add(6, 4));
+    TEST_ASSERT_EQUAL_INT(ISS + 8, _tcb.rcv_buf[1].seq);
+    TEST_ASSERT_EQUAL_INT(2, _tcb.rcv_buf[1].len);
+    TEST_ASSERT_EQUAL_INT(10, _add(0, 4));
+    _check_read(0, 10);
+}
+
+static void test_rcvbuf_add__overlap_next(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _add(6, 4));
+    /* the last two bytes are held by the next segment */
+    TEST_ASSERT_EQUAL_INT(0, _add(4, 4));
+    TEST_ASSERT_EQUAL_INT(ISS + 4, _tcb.rcv_buf[0].seq);
+    TEST_ASSERT_EQUAL_INT(2, _tcb.rcv_buf[0].len);
+    TEST_ASSERT_EQUAL_INT(10, _add(0, 4));
+    _check_read(0, 10);
+}
+
+static void test_rcvbuf_add__beyond_window(void)
+{
+    _tcb.rcv_wnd = 6;
+    TEST_ASSERT_EQUAL_INT(0, _add(6, 4));
+    TEST_ASSERT_EQUAL_INT(6, _add(0, 8));
+    _check_read(0, 6);
+}
+
+static void test_rcvbuf_add__full_drop_highest(void)
+{
+    for (unsigned i = 1; i <= GNRC_TCP_RCV_SEGS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _add(i * 2, 2));
+    }
+    /* the new segment is the highest one */
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, _add((GNRC_TCP_RCV_SEGS + 1) * 2, 2));
+    /* the highest segment is dropped for the one filling the gap */
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_SEGS * 2, _add(0, 2));
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_SEGS, _tcb.rcv_buf_num);
+    _check_read(0, GNRC_TCP_RCV_SEGS * 2);
+}
+
+static void test_rcvbuf_add__full_in_order(void)
+{
+    for (unsigned i = 0; i < GNRC_TCP_RCV_SEGS; i++) {
+        TEST_ASSERT_EQUAL_INT(2, _add(i * 2, 2));
+    }
+    /* unread segments are never dropped, although the window is open */
+    TEST_ASSERT(_rcvbuf_get_free(&_tcb) > 2);
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, _add(GNRC_TCP_RCV_SEGS * 2, 2));
+    _check_read(0, GNRC_TCP_RCV_SEGS * 2);
+    TEST_ASSERT_EQUAL_INT(2, _add(GNRC_TCP_RCV_SEGS * 2, 2));
+    _check_read(GNRC_TCP_RCV_SEGS * 2, 2);
+}
+
+static void test_rcvbuf_add__fin_after_gap(void)
+{
+    /* the segment carrying FIN ends at ISS + 8; FIN is only processed
+     * once rcv_nxt reaches that */
+    TEST_ASSERT_EQUAL_INT(0, _add(4, 4));
+    TEST_ASSERT_EQUAL_INT(ISS, _tcb.rcv_nxt);
+    TEST_ASSERT_EQUAL_INT(8, _add(0, 4));
+    TEST_ASSERT_EQUAL_INT(ISS + 8, _tcb.rcv_nxt);
+    _check_read(0, 8);
+}
+
+static void test_rcvbuf_get__partial(void)
+{
+    char buf[3];
+
+    TEST_ASSERT_EQUAL_INT(4, _add(0, 4));
+    TEST_ASSERT_EQUAL_INT(4, _add(4, 4));
+    TEST_ASSERT_EQUAL_INT(3, _rcvbuf_get(&_tcb, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, &_data[0], sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(3, _rcvbuf_get(&_tcb, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, &_data[3], sizeof(buf)));
+    _check_read(6, 2);
+}
+
+Test *tests_gnrc_tcp_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rcvbuf_add__in_order),
+        new_TestFixture(test_rcvbuf_add__out_of_order),
+        new_TestFixture(test_rcvbuf_add__duplicate),
+        new_TestFixture(test_rcvbuf_add__overlap_prev),
+        new_TestFixture(test_rcvbuf_add__overlap_next),
+        new_TestFixture(test_rcvbuf_add__beyond_window),
+        new_TestFixture(test_rcvbuf_add__full_drop_highest),
+        new_TestFixture(test_rcvbuf_add__full_in_order),
+        new_TestFixture(test_rcvbuf_add__fin_after_gap),
+        new_TestFixture(test_rcvbuf_get__partial),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_tcp_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_tcp_tests;
+}
+
+void tests_gnrc_tcp(void)
+{
+    TESTS_RUN(tests_gnrc_tcp_tests());
+}
+/** @} */
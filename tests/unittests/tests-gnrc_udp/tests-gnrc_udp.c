@@ -16,7 +16,9 @@
 
 #include "embUnit.h"
 
+#include "net/gnrc/netreg.h"
 #include "net/gnrc/udp.h"
+#include "net/gnrc/udp/ports.h"
 #include "net/ipv6/hdr.h"
 
 #include "unittests-constants.h"
@@ -30,6 +32,20 @@ static gnrc_pktsnip_t zero_snip = {
     .type = GNRC_NETTYPE_UNDEF,
 };
 
+#define TEST_DYN_PORT   (GNRC_UDP_PORTS_DYN_MIN + 42U)
+#define TEST_PORT       (5683U)
+
+static gnrc_netreg_entry_t entries[] = {
+    GNRC_NETREG_ENTRY_INIT_PID(TEST_DYN_PORT, TEST_UINT8),
+    GNRC_NETREG_ENTRY_INIT_PID(TEST_DYN_PORT, TEST_UINT8 + 1),
+    GNRC_NETREG_ENTRY_INIT_PID(TEST_PORT, TEST_UINT8),
+};
+
+static void set_up(void)
+{
+    gnrc_netreg_init();
+}
+
 static void test_gnrc_udp__csum_null(void)
 {
     gnrc_pktsnip_t *hdr = NULL;
@@ -240,6 +256,65 @@ static void test_gnrc_udp__csum_all(void)
     }
 }
 
+static void test_gnrc_udp__ports_used(void)
+{
+    gnrc_udp_ports_stats_t stats;
+
+    TEST_ASSERT(!gnrc_udp_ports_used(TEST_DYN_PORT));
+    TEST_ASSERT(!gnrc_udp_ports_used(TEST_PORT));
+    for (unsigned i = 0; i < sizeof(entries) / sizeof(entries[0]); i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_UDP,
+                                                      &entries[i]));
+    }
+    TEST_ASSERT(gnrc_udp_ports_used(TEST_DYN_PORT));
+    TEST_ASSERT(gnrc_udp_ports_used(TEST_PORT));
+    gnrc_udp_ports_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(2, stats.bound);
+    TEST_ASSERT_EQUAL_INT(1, stats.dyn_bound);
+
+    gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &entries[0]);
+    TEST_ASSERT(gnrc_udp_ports_used(TEST_DYN_PORT));
+    /* unregistering twice must not change the table */
+    gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &entries[0]);
+    TEST_ASSERT(gnrc_udp_ports_used(TEST_DYN_PORT));
+    gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &entries[1]);
+    TEST_ASSERT(!gnrc_udp_ports_used(TEST_DYN_PORT));
+    gnrc_udp_ports_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.bound);
+    TEST_ASSERT_EQUAL_INT(0, stats.dyn_bound);
+}
+
+static void test_gnrc_udp__ports_demux(void)
+{
+    gnrc_udp_ports_stats_t stats;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_UDP,
+                                                  &entries[2]));
+    TEST_ASSERT(gnrc_udp_ports_demux(TEST_PORT));
+    TEST_ASSERT(!gnrc_udp_ports_demux(TEST_DYN_PORT));
+    gnrc_udp_ports_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.demux_hits);
+    TEST_ASSERT_EQUAL_INT(1, stats.demux_misses);
+}
+
+static void test_gnrc_udp__ports_alloc(void)
+{
+    gnrc_udp_ports_stats_t stats;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_UDP,
+                                                  &entries[0]));
+    /* every port of the range is a candidate once in this loop */
+    for (unsigned i = 0; i < GNRC_UDP_PORTS_DYN_NUM; i++) {
+        uint16_t port = gnrc_udp_ports_alloc();
+
+        TEST_ASSERT(port >= GNRC_UDP_PORTS_DYN_MIN);
+        TEST_ASSERT(port != TEST_DYN_PORT);
+    }
+    gnrc_udp_ports_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(GNRC_UDP_PORTS_DYN_NUM, stats.allocs);
+    TEST_ASSERT_EQUAL_INT(0, stats.alloc_fails);
+}
+
 Test *tests_gnrc_udp_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -252,9 +327,12 @@ Test *tests_gnrc_udp_tests(void)
         new_TestFixture(test_gnrc_udp__csum_ffff),
         new_TestFixture(test_gnrc_udp__csum_zero),
         new_TestFixture(test_gnrc_udp__csum_all),
+        new_TestFixture(test_gnrc_udp__ports_used),
+        new_TestFixture(test_gnrc_udp__ports_demux),
+        new_TestFixture(test_gnrc_udp__ports_alloc),
     };
 
-    EMB_UNIT_TESTCALLER(gnrc_udp_tests, NULL, NULL, fixtures);
+    EMB_UNIT_TESTCALLER(gnrc_udp_tests, set_up, NULL, fixtures);
 
     return (Test *)&gnrc_udp_tests;
 }
@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -40,10 +41,257 @@ static void test_nanocoap__req_msgid(void)
     TEST_ASSERT_EQUAL_INT(msgid, coap_get_id(&pkt));
 }
 
+/*
+ * Looks up resources by path and method, including several resources for
+ * the same path.
+ */
+static void test_nanocoap__find_resource(void)
+{
+    static const coap_resource_t resources[] = {
+        { "/a", COAP_GET, NULL, NULL },
+        { "/b", COAP_GET, NULL, NULL },
+        { "/b", COAP_POST | COAP_PUT, NULL, NULL },
+        { "/b/c", COAP_GET, NULL, NULL },
+        { "/d", COAP_DELETE, NULL, NULL },
+    };
+    const unsigned numof = sizeof(resources) / sizeof(resources[0]);
+
+    TEST_ASSERT(&resources[0] == coap_find_resource(resources, numof, "/a",
+                                                    COAP_GET));
+    TEST_ASSERT(&resources[1] == coap_find_resource(resources, numof, "/b",
+                                                    COAP_GET));
+    TEST_ASSERT(&resources[2] == coap_find_resource(resources, numof, "/b",
+                                                    COAP_PUT));
+    TEST_ASSERT(&resources[3] == coap_find_resource(resources, numof, "/b/c",
+                                                    COAP_GET));
+    TEST_ASSERT(&resources[4] == coap_find_resource(resources, numof, "/d",
+                                                    COAP_DELETE));
+    /* method not allowed */
+    TEST_ASSERT_NULL(coap_find_resource(resources, numof, "/a", COAP_POST));
+    TEST_ASSERT_NULL(coap_find_resource(resources, numof, "/b", COAP_DELETE));
+    /* path not found */
+    TEST_ASSERT_NULL(coap_find_resource(resources, numof, "/", COAP_GET));
+    TEST_ASSERT_NULL(coap_find_resource(resources, numof, "/c", COAP_GET));
+    TEST_ASSERT_NULL(coap_find_resource(resources, numof, "/e", COAP_DELETE));
+    TEST_ASSERT_NULL(coap_find_resource(resources, 0, "/a", COAP_GET));
+}
+
+#define BLOCK_REPR_LEN  (100U)
+
+static ssize_t _block2_producer(void *arg, size_t offset, uint8_t *buf,
+                                size_t len)
+{
+    (void)arg;
+    size_t i;
+
+    for (i = 0; (i < len) && ((offset + i) < BLOCK_REPR_LEN); i++) {
+        buf[i] = (uint8_t)(offset + i);
+    }
+    return i;
+}
+
+static size_t _block_req(uint8_t *buf, unsigned code, uint16_t onum,
+                         const coap_block_t *block, size_t payload_len)
+{
+    uint8_t *pktpos = buf;
+
+    pktpos += coap_build_hdr((coap_hdr_t *)pktpos, COAP_TYPE_CON, NULL, 0,
+                             code, 0x1234);
+    pktpos += coap_put_option_uri(pktpos, 0, "/blk", COAP_OPT_URI_PATH);
+    pktpos += coap_put_option_block(pktpos, COAP_OPT_URI_PATH, onum, block);
+    if (payload_len) {
+        *pktpos++ = 0xff;
+        memset(pktpos, 0xab, payload_len);
+        pktpos += payload_len;
+    }
+    return pktpos - buf;
+}
+
+/*
+ * Encodes and parses Block options, and rejects the reserved block size.
+ */
+static void test_nanocoap__block_option(void)
+{
+    uint8_t buf[64];
+    coap_block_t block = { .num = 1000, .szx = 2, .more = true };
+    coap_block_t parsed;
+    coap_pkt_t pkt;
+
+    size_t len = _block_req(buf, COAP_METHOD_PUT, COAP_OPT_BLOCK1, &block, 32);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, len));
+    TEST_ASSERT(!coap_get_block2(&pkt, &parsed));
+    TEST_ASSERT(coap_get_block1(&pkt, &parsed));
+    TEST_ASSERT_EQUAL_INT(1000, parsed.num);
+    TEST_ASSERT_EQUAL_INT(2, parsed.szx);
+    TEST_ASSERT(parsed.more);
+    TEST_ASSERT_EQUAL_INT(32, pkt.payload_len);
+
+    /* value 0 is still written with one byte */
+    block.num = 0;
+    block.szx = 0;
+    block.more = false;
+    TEST_ASSERT_EQUAL_INT(2, coap_put_option_block(buf, COAP_OPT_URI_PATH,
+                                                   COAP_OPT_BLOCK2, &block));
+
+    block.szx = 7;
+    len = _block_req(buf, COAP_METHOD_GET, COAP_OPT_BLOCK2, &block, 0);
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, coap_parse(&pkt, buf, len));
+}
+
+/*
+ * Serves the blocks of a representation, with the block size limited by the
+ * response buffer.
+ */
+static void test_nanocoap__reply_block2(void)
+{
+    uint8_t buf[128];
+    coap_block_t block = { .num = 1, .szx = 2, .more = false };
+    coap_block_t parsed;
+    coap_pkt_t pkt;
+
+    /* second block of 64 bytes, and the last one */
+    size_t len = _block_req(buf, COAP_METHOD_GET, COAP_OPT_BLOCK2, &block, 0);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, len));
+    ssize_t res = coap_reply_block2(&pkt, COAP_CODE_CONTENT, buf, sizeof(buf),
+                                    COAP_FORMAT_OCTET, _block2_producer, NULL);
+    TEST_ASSERT(res > 0);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, res));
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_CONTENT, coap_get_code_raw(&pkt));
+    TEST_ASSERT(coap_get_block2(&pkt, &parsed));
+    TEST_ASSERT_EQUAL_INT(1, parsed.num);
+    TEST_ASSERT_EQUAL_INT(2, parsed.szx);
+    TEST_ASSERT(!parsed.more);
+    TEST_ASSERT_EQUAL_INT(BLOCK_REPR_LEN - 64, pkt.payload_len);
+    TEST_ASSERT_EQUAL_INT(64, pkt.payload[0]);
+
+    /* 1024 bytes requested, but only 32 fit into the buffer */
+    block.num = 0;
+    block.szx = 6;
+    len = _block_req(buf, COAP_METHOD_GET, COAP_OPT_BLOCK2, &block, 0);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, len));
+    res = coap_reply_block2(&pkt, COAP_CODE_CONTENT, buf, 64,
+                            COAP_FORMAT_OCTET, _block2_producer, NULL);
+    TEST_ASSERT(res > 0);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, res));
+    TEST_ASSERT(coap_get_block2(&pkt, &parsed));
+    TEST_ASSERT_EQUAL_INT(0, parsed.num);
+    TEST_ASSERT_EQUAL_INT(1, parsed.szx);
+    TEST_ASSERT(parsed.more);
+    TEST_ASSERT_EQUAL_INT(32, pkt.payload_len);
+    TEST_ASSERT_EQUAL_INT(31, pkt.payload[31]);
+}
+
+static size_t _block1_received;
+
+static int _block1_consumer(void *arg, size_t offset, const uint8_t *data,
+                            size_t len, bool more)
+{
+    (void)arg;
+    (void)data;
+    (void)more;
+
+    if (offset != _block1_received) {
+        return -EINVAL;
+    }
+    _block1_received += len;
+    return 0;
+}
+
+/*
+ * Passes the blocks of a request to a consumer, and replies to blocks out of
+ * sequence with 4.08.
+ */
+static void test_nanocoap__reply_block1(void)
+{
+    uint8_t buf[128];
+    coap_block_t block = { .num = 0, .szx = 1, .more = true };
+    coap_block_t parsed;
+    coap_pkt_t pkt;
+
+    _block1_received = 0;
+    size_t len = _block_req(buf, COAP_METHOD_PUT, COAP_OPT_BLOCK1, &block, 32);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, len));
+    ssize_t res = coap_reply_block1(&pkt, buf, sizeof(buf), _block1_consumer,
+                                    NULL);
+    TEST_ASSERT(res > 0);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, res));
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_CONTINUE, coap_get_code_raw(&pkt));
+    TEST_ASSERT(coap_get_block1(&pkt, &parsed));
+    TEST_ASSERT_EQUAL_INT(0, parsed.num);
+    TEST_ASSERT(parsed.more);
+
+    block.num = 1;
+    block.more = false;
+    len = _block_req(buf, COAP_METHOD_PUT, COAP_OPT_BLOCK1, &block, 10);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, len));
+    res = coap_reply_block1(&pkt, buf, sizeof(buf), _block1_consumer, NULL);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, res));
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_CHANGED, coap_get_code_raw(&pkt));
+    TEST_ASSERT_EQUAL_INT(42, _block1_received);
+
+    block.num = 3;
+    len = _block_req(buf, COAP_METHOD_PUT, COAP_OPT_BLOCK1, &block, 10);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, len));
+    res = coap_reply_block1(&pkt, buf, sizeof(buf), _block1_consumer, NULL);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, res));
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_REQUEST_ENTITY_INCOMPLETE,
+                          coap_get_code_raw(&pkt));
+}
+
+/*
+ * Iterates over the options of a packet, with and without payload.
+ */
+static void test_nanocoap__opt_iter(void)
+{
+    uint8_t buf[64];
+    uint8_t etag[] = { 0xde, 0xad, 0xbe, 0xef };
+    coap_block_t block = { .num = 20, .szx = 2, .more = false };
+    coap_optpos_t opt;
+    coap_pkt_t pkt;
+
+    uint8_t *pos = buf + coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON,
+                                        NULL, 0, COAP_METHOD_GET, 1);
+    pos += coap_put_option(pos, 0, COAP_OPT_ETAG, etag, sizeof(etag));
+    pos += coap_put_option_uri(pos, COAP_OPT_ETAG, "/a/b", COAP_OPT_URI_PATH);
+    pos += coap_put_option_block(pos, COAP_OPT_URI_PATH, COAP_OPT_BLOCK2,
+                                 &block);
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, pos - buf));
+
+    coap_opt_iter_init(&pkt, &opt);
+    TEST_ASSERT(coap_opt_iter_next(&pkt, &opt));
+    TEST_ASSERT_EQUAL_INT(COAP_OPT_ETAG, opt.onum);
+    TEST_ASSERT_EQUAL_INT(sizeof(etag), opt.len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(etag, opt.value, sizeof(etag)));
+    TEST_ASSERT(coap_opt_iter_next(&pkt, &opt));
+    TEST_ASSERT_EQUAL_INT(COAP_OPT_URI_PATH, opt.onum);
+    TEST_ASSERT_EQUAL_INT('a', *opt.value);
+    TEST_ASSERT(coap_opt_iter_next(&pkt, &opt));
+    TEST_ASSERT_EQUAL_INT(COAP_OPT_URI_PATH, opt.onum);
+    TEST_ASSERT_EQUAL_INT('b', *opt.value);
+    TEST_ASSERT(coap_opt_iter_next(&pkt, &opt));
+    TEST_ASSERT_EQUAL_INT(COAP_OPT_BLOCK2, opt.onum);
+    TEST_ASSERT(!coap_opt_iter_next(&pkt, &opt));
+
+    /* stops at the payload marker */
+    *pos++ = 0xff;
+    *pos++ = COAP_OPT_ETAG;
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pkt, buf, pos - buf));
+    coap_opt_iter_init(&pkt, &opt);
+    for (unsigned i = 0; i < 4; i++) {
+        TEST_ASSERT(coap_opt_iter_next(&pkt, &opt));
+    }
+    TEST_ASSERT(!coap_opt_iter_next(&pkt, &opt));
+}
+
 Test *tests_nanocoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_nanocoap__req_msgid),
+        new_TestFixture(test_nanocoap__find_resource),
+        new_TestFixture(test_nanocoap__block_option),
+        new_TestFixture(test_nanocoap__reply_block2),
+        new_TestFixture(test_nanocoap__reply_block1),
+        new_TestFixture(test_nanocoap__opt_iter),
     };
 
     EMB_UNIT_TESTCALLER(nanocoap_tests, NULL, NULL, fixtures);
@@ -26,6 +26,10 @@ static gnrc_netreg_entry_t entries[] = {
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 1)
 };
 
+#define MANY_ENTRIES_NUMOF  (24U)
+
+static gnrc_netreg_entry_t many_entries[MANY_ENTRIES_NUMOF];
+
 static void set_up(void)
 {
     gnrc_netreg_init();
@@ -139,6 +143,62 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+void test_netreg_getnext__interleaved(void)
+{
+    gnrc_netreg_entry_t other = GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16 + 1,
+                                                           TEST_UINT8 + 2);
+    gnrc_netreg_entry_t *res = NULL;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &other));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[1]));
+    TEST_ASSERT_EQUAL_INT(2, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16 + 1));
+    /* most recently registered entry comes first */
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16)));
+    TEST_ASSERT(&entries[1] == res);
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_getnext(res)));
+    TEST_ASSERT(&entries[0] == res);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16 + 1)));
+    TEST_ASSERT(&other == res);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &other);
+}
+
+void test_netreg_lookup__many_entries(void)
+{
+    for (unsigned i = 0; i < MANY_ENTRIES_NUMOF; i++) {
+        gnrc_netreg_entry_init_pid(&many_entries[i], TEST_UINT16 + i,
+                                   TEST_UINT8);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST,
+                                                      &many_entries[i]));
+    }
+    /* same demux context, but different type */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entries[0]));
+    for (unsigned i = 0; i < MANY_ENTRIES_NUMOF; i++) {
+        TEST_ASSERT(&many_entries[i] == gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                           TEST_UINT16 + i));
+        TEST_ASSERT_NULL(gnrc_netreg_getnext(&many_entries[i]));
+    }
+    for (unsigned i = 0; i < MANY_ENTRIES_NUMOF; i += 2) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &many_entries[i]);
+    }
+    for (unsigned i = 0; i < MANY_ENTRIES_NUMOF; i++) {
+        gnrc_netreg_entry_t *res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                      TEST_UINT16 + i);
+        if (i & 1) {
+            TEST_ASSERT(&many_entries[i] == res);
+        }
+        else {
+            TEST_ASSERT_NULL(res);
+        }
+    }
+    TEST_ASSERT(&entries[0] == gnrc_netreg_lookup(GNRC_NETTYPE_UNDEF,
+                                                  TEST_UINT16));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_UNDEF, TEST_UINT16));
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -155,6 +215,8 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__2_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
+        new_TestFixture(test_netreg_getnext__interleaved),
+        new_TestFixture(test_netreg_lookup__many_entries),
     };
 
     EMB_UNIT_TESTCALLER(netreg_tests, set_up, NULL, fixtures);
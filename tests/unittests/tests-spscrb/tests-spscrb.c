@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <limits.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "spscrb.h"
+
+#include "tests-spscrb.h"
+
+#define BUF_SIZE    (8U)
+
+static uint8_t _buf[BUF_SIZE];
+static spscrb_t _rb;
+
+static const uint8_t _data[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                 0x08, 0x09, 0x0a, 0x0b, 0x0c };
+
+static void set_up(void)
+{
+    memset(_buf, 0, sizeof(_buf));
+    spscrb_init(&_rb, _buf, sizeof(_buf));
+}
+
+static void test_spscrb_init(void)
+{
+    static uint8_t buf[BUF_SIZE];
+    spscrb_t rb = SPSCRB_INIT(buf);
+
+    TEST_ASSERT(rb.buf == buf);
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, rb.size);
+    TEST_ASSERT_EQUAL_INT(0, spscrb_avail(&rb));
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, spscrb_free(&rb));
+    TEST_ASSERT_EQUAL_INT(1, spscrb_empty(&rb));
+    TEST_ASSERT_EQUAL_INT(0, spscrb_full(&rb));
+}
+
+static void test_spscrb_add_one_get_one(void)
+{
+    TEST_ASSERT_EQUAL_INT(-1, spscrb_get_one(&_rb));
+    for (unsigned i = 0; i < BUF_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0, spscrb_add_one(&_rb, _data[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(1, spscrb_full(&_rb));
+    TEST_ASSERT_EQUAL_INT(-1, spscrb_add_one(&_rb, 0xff));
+    for (unsigned i = 0; i < BUF_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(_data[i], spscrb_get_one(&_rb));
+    }
+    TEST_ASSERT_EQUAL_INT(1, spscrb_empty(&_rb));
+    TEST_ASSERT_EQUAL_INT(-1, spscrb_get_one(&_rb));
+}
+
+static void test_spscrb_add_get(void)
+{
+    uint8_t out[sizeof(_data)];
+
+    /* only as much as fits is added */
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, spscrb_add(&_rb, _data, sizeof(_data)));
+    TEST_ASSERT_EQUAL_INT(0, spscrb_add(&_rb, _data, sizeof(_data)));
+    TEST_ASSERT_EQUAL_INT(3, spscrb_get(&_rb, out, 3));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, _data, 3));
+    /* only as much as is available is returned */
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE - 3, spscrb_get(&_rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, &_data[3], BUF_SIZE - 3));
+    TEST_ASSERT_EQUAL_INT(0, spscrb_get(&_rb, out, sizeof(out)));
+}
+
+static void test_spscrb_wraparound(void)
+{
+    uint8_t out[BUF_SIZE];
+
+    /* move positions to the middle of the buffer */
+    TEST_ASSERT_EQUAL_INT(5, spscrb_add(&_rb, _data, 5));
+    TEST_ASSERT_EQUAL_INT(5, spscrb_get(&_rb, out, 5));
+    /* write and read across the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, spscrb_add(&_rb, &_data[2], BUF_SIZE));
+    TEST_ASSERT_EQUAL_INT(1, spscrb_full(&_rb));
+    TEST_ASSERT_EQUAL_INT(_data[2], _buf[5]);
+    TEST_ASSERT_EQUAL_INT(_data[5], _buf[0]);
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, spscrb_get(&_rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, &_data[2], BUF_SIZE));
+}
+
+static void test_spscrb_index_overflow(void)
+{
+    uint8_t out[3];
+
+    /* indices are free running, so their difference must survive overflow */
+    atomic_init(&_rb.reads, UINT_MAX - 1);
+    atomic_init(&_rb.writes, UINT_MAX - 1);
+    TEST_ASSERT_EQUAL_INT(1, spscrb_empty(&_rb));
+    TEST_ASSERT_EQUAL_INT(3, spscrb_add(&_rb, _data, 3));
+    TEST_ASSERT_EQUAL_INT(3, spscrb_avail(&_rb));
+    TEST_ASSERT_EQUAL_INT(3, spscrb_get(&_rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, _data, 3));
+    TEST_ASSERT_EQUAL_INT(1, spscrb_empty(&_rb));
+}
+
+static void test_spscrb_write_peek_commit(void)
+{
+    spscrb_seg_t seg[2];
+    uint8_t out[BUF_SIZE];
+
+    TEST_ASSERT_EQUAL_INT(6, spscrb_add(&_rb, _data, 6));
+    TEST_ASSERT_EQUAL_INT(4, spscrb_get(&_rb, out, 4));
+    /* free space: 2 bytes at the end, 4 at the start of the buffer */
+    TEST_ASSERT_EQUAL_INT(6, spscrb_write_peek(&_rb, seg));
+    TEST_ASSERT(seg[0].data == &_buf[6]);
+    TEST_ASSERT_EQUAL_INT(2, seg[0].len);
+    TEST_ASSERT(seg[1].data == _buf);
+    TEST_ASSERT_EQUAL_INT(4, seg[1].len);
+    /* nothing is visible before the commit */
+    memcpy(seg[0].data, &_data[6], seg[0].len);
+    memcpy(seg[1].data, &_data[8], 1);
+    TEST_ASSERT_EQUAL_INT(2, spscrb_avail(&_rb));
+    spscrb_write_commit(&_rb, 3);
+    TEST_ASSERT_EQUAL_INT(5, spscrb_avail(&_rb));
+    for (unsigned i = 4; i < 9; i++) {
+        TEST_ASSERT_EQUAL_INT(_data[i], spscrb_get_one(&_rb));
+    }
+}
+
+static void test_spscrb_read_peek_commit(void)
+{
+    spscrb_seg_t seg[2];
+    uint8_t out[BUF_SIZE];
+
+    /* data: 3 bytes at the end, 2 at the start of the buffer */
+    TEST_ASSERT_EQUAL_INT(5, spscrb_add(&_rb, _data, 5));
+    TEST_ASSERT_EQUAL_INT(5, spscrb_get(&_rb, out, 5));
+    TEST_ASSERT_EQUAL_INT(5, spscrb_add(&_rb, _data, 5));
+    TEST_ASSERT_EQUAL_INT(5, spscrb_read_peek(&_rb, seg));
+    TEST_ASSERT(seg[0].data == &_buf[5]);
+    TEST_ASSERT_EQUAL_INT(3, seg[0].len);
+    TEST_ASSERT(seg[1].data == _buf);
+    TEST_ASSERT_EQUAL_INT(2, seg[1].len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(seg[0].data, _data, 3));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(seg[1].data, &_data[3], 2));
+    /* data stays in the buffer until it is committed */
+    TEST_ASSERT_EQUAL_INT(5, spscrb_avail(&_rb));
+    spscrb_read_commit(&_rb, 4);
+    TEST_ASSERT_EQUAL_INT(1, spscrb_read_peek(&_rb, seg));
+    TEST_ASSERT(seg[0].data == &_buf[1]);
+    TEST_ASSERT_EQUAL_INT(1, seg[0].len);
+    TEST_ASSERT_EQUAL_INT(0, seg[1].len);
+    TEST_ASSERT_EQUAL_INT(_data[4], seg[0].data[0]);
+}
+
+static void test_spscrb_peek_empty_full(void)
+{
+    spscrb_seg_t seg[2];
+
+    TEST_ASSERT_EQUAL_INT(0, spscrb_read_peek(&_rb, seg));
+    TEST_ASSERT_EQUAL_INT(0, seg[0].len);
+    TEST_ASSERT_EQUAL_INT(0, seg[1].len);
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, spscrb_write_peek(&_rb, seg));
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, seg[0].len);
+    TEST_ASSERT_EQUAL_INT(0, seg[1].len);
+    spscrb_write_commit(&_rb, BUF_SIZE);
+    TEST_ASSERT_EQUAL_INT(1, spscrb_full(&_rb));
+    TEST_ASSERT_EQUAL_INT(0, spscrb_write_peek(&_rb, seg));
+    TEST_ASSERT_EQUAL_INT(0, seg[0].len);
+    TEST_ASSERT_EQUAL_INT(0, seg[1].len);
+}
+
+Test *tests_spscrb_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_spscrb_init),
+        new_TestFixture(test_spscrb_add_one_get_one),
+        new_TestFixture(test_spscrb_add_get),
+        new_TestFixture(test_spscrb_wraparound),
+        new_TestFixture(test_spscrb_index_overflow),
+        new_TestFixture(test_spscrb_write_peek_commit),
+        new_TestFixture(test_spscrb_read_peek_commit),
+        new_TestFixture(test_spscrb_peek_empty_full),
+    };
+
+    EMB_UNIT_TESTCALLER(spscrb_tests, set_up, NULL, fixtures);
+
+    return (Test *)&spscrb_tests;
+}
+
+void tests_spscrb(void)
+{
+    TESTS_RUN(tests_spscrb_tests());
+}
+/** @} */
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the cost of xtimer_set() and xtimer_remove() over
+ *              the number of armed timers
+ *
+ * Build with `XTIMER_IMPL=list` or `XTIMER_IMPL=wheel` to compare the
+ * sorted list and the timing wheel backends.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "random.h"
+#include "xtimer.h"
+
+#define TIMERS_NUMOF        (256U)
+#define PROBES_NUMOF        (32U)
+#define ROUNDS              (32U)
+#define SEED                (0x7131e5)
+
+/* armed timers must not fire while measuring */
+#define OFFSET_MIN          (10U * US_PER_SEC)
+#define OFFSET_MAX          (60U * US_PER_SEC)
+
+#ifdef MODULE_XTIMER_WHEEL
+#define BACKEND             "wheel"
+#else
+#define BACKEND             "list"
+#endif
+
+static const unsigned _armed_numof[] = { 0, 16, 64, 256 };
+
+static xtimer_t _timers[TIMERS_NUMOF];
+static xtimer_t _probes[PROBES_NUMOF];
+static uint32_t _offsets[PROBES_NUMOF];
+
+static void _cb(void *arg)
+{
+    (void)arg;
+    puts("error: timer fired while measuring");
+}
+
+static void _measure(unsigned armed)
+{
+    uint32_t start, set_time, remove_time;
+
+    for (unsigned i = 0; i < armed; i++) {
+        xtimer_set(&_timers[i], random_uint32_range(OFFSET_MIN, OFFSET_MAX));
+    }
+    set_time = 0;
+    remove_time = 0;
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        for (unsigned i = 0; i < PROBES_NUMOF; i++) {
+            _offsets[i] = random_uint32_range(OFFSET_MIN, OFFSET_MAX);
+        }
+
+        start = xtimer_now_usec();
+        for (unsigned i = 0; i < PROBES_NUMOF; i++) {
+            xtimer_set(&_probes[i], _offsets[i]);
+        }
+        set_time += xtimer_now_usec() - start;
+
+        start = xtimer_now_usec();
+        for (unsigned i = 0; i < PROBES_NUMOF; i++) {
+            xtimer_remove(&_probes[i]);
+        }
+        remove_time += xtimer_now_usec() - start;
+    }
+
+    for (unsigned i = 0; i < armed; i++) {
+        xtimer_remove(&_timers[i]);
+    }
+
+    /* up to PROBES_NUMOF probes are armed in addition to the timers */
+    printf("+ %4u armed: set %" PRIu32 " ns, remove %" PRIu32 " ns\n", armed,
+           (uint32_t)(((uint64_t)set_time * 1000) / (ROUNDS * PROBES_NUMOF)),
+           (uint32_t)(((uint64_t)remove_time * 1000) / (ROUNDS * PROBES_NUMOF)));
+}
+
+int main(void)
+{
+    puts("Start.");
+    printf("backend: %s\n", BACKEND);
+    random_init(SEED);
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        _timers[i].callback = _cb;
+    }
+    for (unsigned i = 0; i < PROBES_NUMOF; i++) {
+        _probes[i].callback = _cb;
+    }
+
+    for (unsigned i = 0; i < sizeof(_armed_numof) / sizeof(_armed_numof[0]); i++) {
+        _measure(_armed_numof[i]);
+    }
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,35 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2018 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+class TestFailed(Exception):
+    pass
+
+
+def expect_unless_fired(child, pattern):
+    res = child.expect([pattern, r'error: timer fired while measuring'])
+    if res == 1:
+        raise TestFailed("timer fired while measuring")
+
+
+def testfunc(child):
+    child.expect_exact("Start.")
+    child.expect('backend: (list|wheel)')
+    for armed in (0, 16, 64, 256):
+        expect_unless_fired(child,
+                            r'\+ %4d armed: set \d+ ns, remove \d+ ns' % armed)
+    expect_unless_fired(child, r'Done\.')
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc, timeout=120))
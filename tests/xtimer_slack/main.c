@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2018 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for timer coalescing with xtimer and evtimer slack
+ *
+ * Sets timers and events with random offsets and checks that they fire
+ * neither early nor later than their slack allows, and prints the number of
+ * wakeups that were saved.
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "evtimer.h"
+#include "random.h"
+#include "xtimer.h"
+
+#define TIMERS_NUMOF        (32U)
+#define SEED                (0x51ac4)
+
+#define OFFSET_MAX          (1000U)     /* in ms */
+#define SLACK               (50U)       /* in ms */
+/* the callbacks of a wakeup take some time, timers must never fire early */
+#define TOLERANCE           (1U)        /* in ms */
+
+typedef struct {
+    evtimer_event_t event;
+    uint32_t target;
+    int in_time;
+} test_event_t;
+
+static xtimer_t _timers[TIMERS_NUMOF];
+static uint32_t _targets[TIMERS_NUMOF];
+static int _in_time[TIMERS_NUMOF];
+
+static evtimer_t _evtimer;
+static test_event_t _events[TIMERS_NUMOF];
+
+static int _check(uint32_t target)
+{
+    int32_t late = xtimer_now_usec() - target;
+
+    return (late >= 0) && (late <= (int32_t)((SLACK + TOLERANCE) * US_PER_MS));
+}
+
+static void _timer_cb(void *arg)
+{
+    unsigned i = (uintptr_t)arg;
+
+    _in_time[i] = _check(_targets[i]);
+}
+
+static void _event_cb(evtimer_event_t *event)
+{
+    test_event_t *ev = (test_event_t *)event;
+
+    ev->in_time = _check(ev->target);
+}
+
+int main(void)
+{
+    xtimer_slack_stats_t before, after;
+    uint32_t offsets[TIMERS_NUMOF];
+    uint32_t start;
+    unsigned in_time = 0;
+
+    puts("Start.");
+    random_init(SEED);
+
+    xtimer_slack_stats(&before);
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        uint32_t offset = random_uint32_range(1, OFFSET_MAX) * US_PER_MS;
+
+        _timers[i].callback = _timer_cb;
+        _timers[i].arg = (void *)(uintptr_t)i;
+        _targets[i] = xtimer_now_usec() + offset;
+        xtimer_set_slack(&_timers[i], offset, SLACK * US_PER_MS);
+    }
+    xtimer_usleep((OFFSET_MAX + (2 * SLACK)) * US_PER_MS);
+    xtimer_slack_stats(&after);
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        in_time += _in_time[i];
+    }
+    printf("+ xtimer: %u/%u fired in time, %u wakeups, %u saved\n",
+           in_time, TIMERS_NUMOF,
+           (unsigned)(after.wakeups - before.wakeups),
+           (unsigned)(after.saved - before.saved));
+
+    evtimer_init(&_evtimer, _event_cb);
+    evtimer_set_slack(&_evtimer, SLACK);
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        offsets[i] = random_uint32_range(1, OFFSET_MAX);
+    }
+    /* evtimer rounds the time left for its first event to milliseconds when
+     * an event is added, so add all events right after another, relative to
+     * the same start: as long as this takes less than half a millisecond,
+     * the first event is set again with its full offset, i.e. late, never
+     * early */
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        _events[i].event.offset = offsets[i];
+        _events[i].target = start + (offsets[i] * US_PER_MS);
+        evtimer_add(&_evtimer, &_events[i].event);
+    }
+    xtimer_usleep((OFFSET_MAX + (2 * SLACK)) * US_PER_MS);
+    in_time = 0;
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        in_time += _events[i].in_time;
+    }
+    printf("+ evtimer: %u/%u fired in time, %u saved\n",
+           in_time, TIMERS_NUMOF, (unsigned)_evtimer.saved);
+    puts("Done.");
+    return 0;
+}